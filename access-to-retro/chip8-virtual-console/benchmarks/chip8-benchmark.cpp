@@ -0,0 +1,835 @@
+/**
+ * @file chip8-benchmark.cpp
+ * @details Measures the emulator core without the frontend: CPU ticks on synthetic instruction mixes, sprite drawing
+ *          at different heights and positions in both resolutions, scrolling, packing and presenting the screen, and
+ *          whole frames (with and without instruction trace) and load time analysis of real ROMs.
+ *
+ *          Usage: access-to-retro-chip8-bench [<rom>...] [--output <file>] [--counters]
+ *
+ *          Results are written as JSON (to standard output unless '--output' is given). Benchmarks always come in the
+ *          same order and with the same names, so results of two releases can be compared line by line. Every
+ *          benchmark is calibrated to run for at least 'MIN_SAMPLE_DURATION' per sample and each sample starts from
+ *          the same state, times are nanoseconds per unit of work.
+ *
+ *          '--counters' also counts hardware events (cycles, instructions, branch misses and L1d misses) around the
+ *          measured samples and reports them per unit of work and per emulated instruction, which shows why a change
+ *          is slower (e.g. mispredicted branches in the instruction decoder) and not just that it is. Events the
+ *          system does not support are reported as null.
+ */
+
+#include <access-to-retro-dev/access-to-retro-dev.h>
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "emulator/emulator.hpp"
+#include "emulator/instruction-trace.hpp"
+#include "emulator/rom-database.hpp"
+#include "perf-counters.hpp"
+
+AR_API AR_DEFINE_FN;
+
+AR_API AR_STARTUP_FN;
+
+AR_API AR_QUIT_FN;
+
+/// @brief Version of the JSON output, increased whenever a field or benchmark changes meaning
+static constexpr uint32_t SCHEMA_VERSION = 1;
+
+/// @brief Number of samples per benchmark, median and 99th percentile are taken from them
+static constexpr std::size_t SAMPLE_COUNT = 51;
+
+/// @brief Shortest duration of a single sample, shorter samples are dominated by the clock's resolution
+static constexpr std::chrono::milliseconds MIN_SAMPLE_DURATION { 5 };
+
+/// @brief Seed of the random number generator, same seed keeps ROM runs comparable between releases
+static constexpr uint32_t RANDOM_SEED = 0xC8C8C8C8;
+
+/// @brief Address the synthetic programs and sprites are written to
+static constexpr uint16_t PROGRAM_START = 0x200;
+
+/// @brief Address of sprite data used by the draw benchmarks
+static constexpr uint16_t SPRITE_ADDRESS = 0x300;
+
+/// @brief Synthetic instruction mix, endless loop executed by the CPU benchmarks
+struct instruction_mix
+{
+    /// @brief Name of the benchmark
+    std::string name;
+
+    /// @brief Encoded instructions (opcodes) written from 'PROGRAM_START'
+    std::vector<uint16_t> program;
+};
+
+/// @brief Sprite drawing case
+struct draw_case
+{
+    /// @brief Name of the benchmark
+    std::string name;
+
+    /// @brief Horizontal position of the sprite
+    ar_byte x;
+
+    /// @brief Vertical position of the sprite
+    ar_byte y;
+
+    /// @brief Number of sprite rows, 0 draws a 16x16 sprite in SUPER-CHIP's high resolution
+    ar_byte height;
+
+    /// @brief Whether the screen is in SUPER-CHIP's high resolution (128x64)
+    bool high_resolution = false;
+
+    /// @brief Whether pixels past the edges are clipped instead of wrapping around
+    bool clip = false;
+};
+
+/// @brief Scroll case, always in SUPER-CHIP's high resolution
+struct scroll_case
+{
+    /// @brief Name of the benchmark
+    std::string name;
+
+    /// @brief Scroll instruction (00CN, 00DN, 00FB or 00FC)
+    uint16_t opcode;
+
+    /// @brief Mask of scrolled planes, 0x3 scrolls both XO-CHIP planes
+    ar_byte planes;
+};
+
+/// @brief Result of a single benchmark
+struct benchmark_result
+{
+    /// @brief Name of the benchmark
+    std::string name;
+
+    /// @brief Unit of work the times are for
+    std::string unit;
+
+    /// @brief Number of emulated instructions a unit of work executes, 0 if it does not execute any
+    uint32_t emulated_instructions = 0;
+
+    /// @brief Units of work per sample
+    uint64_t iterations = 0;
+
+    /// @brief Fastest sample, nanoseconds per unit
+    double min_ns = 0.0;
+
+    /// @brief Median sample, nanoseconds per unit
+    double median_ns = 0.0;
+
+    /// @brief 99th percentile sample, nanoseconds per unit
+    double p99_ns = 0.0;
+
+    /// @brief Hardware events of all samples, per unit of work
+    std::array<std::optional<double>, ar::chip8::PERF_EVENT_COUNT> counters {};
+};
+
+/// @brief Hardware event counters, only set when '--counters' is given and events are available
+static std::unique_ptr<ar::chip8::perf_counters> g_perf_counters;
+
+/*
+ * Every mix loops forever without leaving its few instructions, register setup at the start is skipped by the jump.
+ *  - alu: arithmetic and logic instructions, skips and register copies
+ *  - memory: BCD, register dumps and fills, 'I' arithmetic, font lookup, calls and returns
+ *  - draw: sprite drawing with wrapping coordinates (screen is only cleared once)
+ *  - random_timers_input: random numbers, delay and sound timers and key checks (random key stays below 16)
+ */
+static const std::vector<instruction_mix> g_instruction_mixes = {
+        { "cpu_tick/alu",
+                { 0x6A05, 0x6B03, 0x8AB4, 0x8AB5, 0x8AB1, 0x8AB2, 0x8AB3, 0x8A06, 0x8A0E, 0x7A11, 0x3A00, 0x4B00,
+                        0x8BA0, 0x9AB0, 0x5AB0, 0x1204 } },
+        { "cpu_tick/memory",
+                { 0xA300, 0x6012, 0xF033, 0xF255, 0xF265, 0xF01E, 0x2210, 0x1200, 0xF029, 0x00EE } },
+        { "cpu_tick/draw",
+                { 0x00E0, 0xA300, 0x6000, 0x6100, 0xD015, 0x7008, 0xD01F, 0x7104, 0xF029, 0xD01A, 0xA300, 0x1208 } },
+        { "cpu_tick/random_timers_input",
+                { 0xC00F, 0xF015, 0xF107, 0xF018, 0xE09E, 0xE0A1, 0xC17F, 0x1200 } },
+};
+
+/*
+ * Heights and positions of the draw benchmarks, 'wrap' and 'clip' cases cross both the right and the bottom edge. In
+ * high resolution a row is split into two 64-bit halves, 'half' cases cross from the left one into the right one.
+ */
+static const std::vector<draw_case> g_draw_cases = {
+        { "gpu_draw/h1/aligned",   8,  8,  1 },
+        { "gpu_draw/h5/aligned",   8,  8,  5 },
+        { "gpu_draw/h15/aligned",  8,  8,  15 },
+        { "gpu_draw/h1/unaligned", 3,  5,  1 },
+        { "gpu_draw/h5/unaligned", 3,  5,  5 },
+        { "gpu_draw/h15/unaligned", 3, 5,  15 },
+        { "gpu_draw/h1/wrap",      60, 31, 1 },
+        { "gpu_draw/h5/wrap",      60, 30, 5 },
+        { "gpu_draw/h15/wrap",     60, 30, 15 },
+        { "gpu_draw/hires/h15/aligned", 8,   8,  15, true },
+        { "gpu_draw/hires/h15/half",    60,  8,  15, true },
+        { "gpu_draw/hires/h15/wrap",    124, 60, 15, true },
+        { "gpu_draw/hires/h0/aligned",  8,   8,  0,  true },
+        { "gpu_draw/hires/h0/right",    80,  8,  0,  true },
+        { "gpu_draw/hires/h0/half",     56,  8,  0,  true },
+        { "gpu_draw/hires/h0/wrap",     120, 56, 0,  true },
+        { "gpu_draw/hires/h0/clip",     120, 56, 0,  true, true },
+};
+
+/// @brief Scroll benchmarks, cost of a scroll does not depend on the pixels so rows scrolled in empty do not matter
+static const std::vector<scroll_case> g_scroll_cases = {
+        { "gpu_scroll/hires/down",        0x00C4, 0x1 },
+        { "gpu_scroll/hires/up",          0x00D4, 0x1 },
+        { "gpu_scroll/hires/right",       0x00FB, 0x1 },
+        { "gpu_scroll/hires/left",        0x00FC, 0x1 },
+        { "gpu_scroll/hires/left/planes", 0x00FC, 0x3 },
+};
+
+/****************************************************************************************************
+ Helpers
+****************************************************************************************************/
+
+/**
+ * @brief Read whole file
+ * @param path Path of the file
+ * @param bytes Bytes of the file
+ * @return Whether the file could be read
+ */
+static bool read_file(const std::string& path, std::vector<ar_byte>& bytes)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    return true;
+}
+
+/**
+ * @brief Escape a string for a JSON string
+ * @param value String value
+ * @return Quoted string
+ */
+static std::string escape_json(const std::string& value)
+{
+    std::string escaped = "\"";
+    for (char character : value)
+    {
+        if (character == '"' || character == '\\')
+        {
+            escaped += '\\';
+        }
+
+        escaped += static_cast<unsigned char>(character) < 0x20 ? ' ' : character;
+    }
+
+    return escaped + "\"";
+}
+
+/**
+ * @brief Measure a benchmark
+ * @details Number of units per sample is doubled until a sample takes at least 'MIN_SAMPLE_DURATION', then
+ *          'SAMPLE_COUNT' samples are taken. Setup runs before every sample and is neither timed nor counted.
+ * @param name Name of the benchmark
+ * @param unit Unit of work
+ * @param emulated_instructions Number of emulated instructions per unit of work
+ * @param setup Resets the state, called before every sample
+ * @param run Does the given number of units of work
+ * @return Result of the benchmark
+ */
+template<typename setup_fn, typename run_fn>
+static benchmark_result measure(const std::string& name, const std::string& unit, uint32_t emulated_instructions,
+                                setup_fn&& setup, run_fn&& run)
+{
+    using clock = std::chrono::steady_clock;
+
+    uint64_t iterations = 1;
+    for (;;)
+    {
+        setup();
+
+        auto start = clock::now();
+        run(iterations);
+
+        if (clock::now() - start >= MIN_SAMPLE_DURATION)
+        {
+            break;
+        }
+
+        iterations *= 2;
+    }
+
+    std::vector<double> samples(SAMPLE_COUNT);
+    std::array<std::optional<uint64_t>, ar::chip8::PERF_EVENT_COUNT> counter_totals {};
+    counter_totals.fill(0);
+
+    for (double& sample : samples)
+    {
+        setup();
+
+        if (g_perf_counters != nullptr)
+        {
+            g_perf_counters->start();
+        }
+
+        auto start = clock::now();
+        run(iterations);
+        auto end = clock::now();
+
+        sample = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations);
+
+        // Event has no total when a single sample missed it, a partial total would look like an improvement
+        ar::chip8::perf_counts counts = g_perf_counters != nullptr ? g_perf_counters->stop()
+                                                                   : ar::chip8::perf_counts {};
+        for (std::size_t i = 0; i < ar::chip8::PERF_EVENT_COUNT; i++)
+        {
+            counter_totals[i] = counts[i].has_value() && counter_totals[i].has_value() ?
+                                std::optional<uint64_t>(*counter_totals[i] + *counts[i]) : std::nullopt;
+        }
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    // Nearest rank, with 51 samples the 99th percentile is the slowest one
+    auto p99_rank = static_cast<std::size_t>(std::ceil(static_cast<double>(SAMPLE_COUNT) * 0.99));
+
+    benchmark_result result { name, unit, emulated_instructions, iterations, samples.front(),
+                              samples[SAMPLE_COUNT / 2], samples[p99_rank - 1] };
+
+    for (std::size_t i = 0; i < ar::chip8::PERF_EVENT_COUNT; i++)
+    {
+        if (counter_totals[i].has_value())
+        {
+            result.counters[i] = static_cast<double>(*counter_totals[i]) /
+                                 static_cast<double>(iterations * SAMPLE_COUNT);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Start the virtual console the same way the frontend does, with fixed random seed
+ * @param rom ROM to run, has to outlive the run
+ */
+static void start_virtual_console(const std::vector<ar_byte>& rom)
+{
+    _ar_vc_define();
+
+    ar_create_executable(rom.data(), rom.size());
+
+    _ar_vc_startup();
+
+    ar::chip8::emulator::get_global_emulator()->access_cpu().set_random_seed(RANDOM_SEED);
+}
+
+/****************************************************************************************************
+ Benchmarks
+****************************************************************************************************/
+
+/**
+ * @brief Measure CPU ticks on a synthetic instruction mix
+ * @param mix Instruction mix
+ * @return Result, time per executed instruction
+ */
+static benchmark_result measure_instruction_mix(const instruction_mix& mix)
+{
+    std::unique_ptr<ar::chip8::emulator> emulator;
+
+    auto setup = [&]
+    {
+        emulator = std::make_unique<ar::chip8::emulator>();
+        emulator->access_cpu().set_random_seed(RANDOM_SEED);
+
+        ar::chip8::ram_memory& ram = emulator->access_ram();
+
+        for (std::size_t i = 0; i < mix.program.size(); i++)
+        {
+            auto address = static_cast<uint16_t>(PROGRAM_START + i * 2);
+
+            ram.write(address, static_cast<ar_byte>(mix.program[i] >> 8));
+            ram.write(static_cast<uint16_t>(address + 1), static_cast<ar_byte>(mix.program[i] & 0xFF));
+        }
+
+        for (uint16_t i = 0; i < 16; i++)
+        {
+            ram.write(static_cast<uint16_t>(SPRITE_ADDRESS + i), static_cast<ar_byte>(0xA5 ^ (i * 0x11)));
+        }
+    };
+
+    auto run = [&](uint64_t iterations)
+    {
+        ar::chip8::cpu& cpu = emulator->access_cpu();
+
+        for (uint64_t i = 0; i < iterations; i++)
+        {
+            cpu.tick();
+        }
+    };
+
+    return measure(mix.name, "instruction", 1, setup, run);
+}
+
+/**
+ * @brief Measure drawing a single sprite
+ * @param draw Height and position of the sprite
+ * @return Result, time per drawn sprite
+ */
+static benchmark_result measure_draw(const draw_case& draw)
+{
+    std::unique_ptr<ar::chip8::emulator> emulator;
+
+    auto setup = [&]
+    {
+        emulator = std::make_unique<ar::chip8::emulator>();
+
+        // 16x16 sprites need SUPER-CHIP, it draws 8 pixel wide ones the same way CHIP8 does
+        if (draw.high_resolution)
+        {
+            emulator->set_machine_model(ar::chip8::machine_model::super_chip);
+            emulator->access_gpu().set_high_resolution(true);
+        }
+
+        // Mixed rows, every row turns some pixels on and some off (16x16 sprites have two bytes per row)
+        for (uint16_t i = 0; i < 32; i++)
+        {
+            emulator->access_ram().write(static_cast<uint16_t>(SPRITE_ADDRESS + i),
+                                         static_cast<ar_byte>(0xA5 ^ (i * 0x11)));
+        }
+    };
+
+    auto run = [&](uint64_t iterations)
+    {
+        ar::chip8::gpu& gpu = emulator->access_gpu();
+
+        for (uint64_t i = 0; i < iterations; i++)
+        {
+            if (draw.clip)
+            {
+                static_cast<void>(gpu.draw<true>(draw.x, draw.y, draw.height, SPRITE_ADDRESS));
+            }
+            else
+            {
+                static_cast<void>(gpu.draw<false>(draw.x, draw.y, draw.height, SPRITE_ADDRESS));
+            }
+        }
+    };
+
+    return measure(draw.name, "sprite", 0, setup, run);
+}
+
+/**
+ * @brief Measure scrolling the high resolution screen
+ * @param scroll Scroll instruction and planes
+ * @return Result, time per scroll
+ */
+static benchmark_result measure_scroll(const scroll_case& scroll)
+{
+    std::unique_ptr<ar::chip8::emulator> emulator;
+
+    auto setup = [&]
+    {
+        emulator = std::make_unique<ar::chip8::emulator>();
+        emulator->set_machine_model(ar::chip8::machine_model::xo_chip);
+
+        ar::chip8::gpu& gpu = emulator->access_gpu();
+        gpu.set_high_resolution(true);
+        gpu.select_planes(0x3);
+
+        // Both planes of the whole screen filled with font sprites
+        for (ar_byte y = 0; y < ar::chip8::HIGH_RESOLUTION_Y; y = static_cast<ar_byte>(y + 5))
+        {
+            for (ar_byte x = 0; x < ar::chip8::HIGH_RESOLUTION_X; x = static_cast<ar_byte>(x + 8))
+            {
+                static_cast<void>(gpu.draw<true>(x, y, 5, static_cast<uint16_t>(0x050 + ((x + y) % 16) * 5)));
+            }
+        }
+
+        gpu.select_planes(scroll.planes);
+    };
+
+    auto run = [&](uint64_t iterations)
+    {
+        ar::chip8::gpu& gpu = emulator->access_gpu();
+
+        for (uint64_t i = 0; i < iterations; i++)
+        {
+            switch (scroll.opcode & 0xFFF0)
+            {
+                case 0x00C0:
+                    gpu.scroll_down(static_cast<ar_byte>(scroll.opcode & 0xF));
+                    break;
+
+                case 0x00D0:
+                    gpu.scroll_up(static_cast<ar_byte>(scroll.opcode & 0xF));
+                    break;
+
+                default:
+                    if (scroll.opcode == 0x00FB)
+                    {
+                        gpu.scroll_right();
+                    }
+                    else
+                    {
+                        gpu.scroll_left();
+                    }
+                    break;
+            }
+        }
+    };
+
+    return measure(scroll.name, "scroll", 0, setup, run);
+}
+
+/**
+ * @brief Measure packing the screen into library's 1bpp frame buffer and presenting it
+ * @return Result, time per presented frame
+ */
+static benchmark_result measure_render()
+{
+    // Only the library's frame buffer is needed, the program never runs
+    std::vector<ar_byte> rom = { 0x12, 0x00 };
+    start_virtual_console(rom);
+
+    ar::chip8::gpu& gpu = ar::chip8::emulator::get_global_emulator()->access_gpu();
+
+    // Half of the screen lit in a checkerboard of font sprites, packing cost depends on lit pixels
+    for (ar_byte y = 0; y < ar::chip8::SCREEN_RESOLUTION_Y; y = static_cast<ar_byte>(y + 5))
+    {
+        for (ar_byte x = 0; x < ar::chip8::SCREEN_RESOLUTION_X; x = static_cast<ar_byte>(x + 8))
+        {
+            static_cast<void>(gpu.draw<false>(x, y, 5, static_cast<uint16_t>(0x050 + ((x + y) % 16) * 5)));
+        }
+    }
+
+    benchmark_result result = measure("gpu_render/1bpp", "frame", 0, [] {}, [&](uint64_t iterations)
+    {
+        for (uint64_t i = 0; i < iterations; i++)
+        {
+            gpu.render();
+        }
+    });
+
+    _ar_vc_quit();
+
+    return result;
+}
+
+/**
+ * @brief Measure whole frames of a ROM, each sample starts the ROM from its first frame
+ * @param name Name of the benchmark
+ * @param rom ROM to run
+ * @return Result, time per emulated frame
+ */
+static benchmark_result measure_rom(const std::string& name, const std::vector<ar_byte>& rom)
+{
+    bool started = false;
+
+    auto setup = [&]
+    {
+        if (started)
+        {
+            _ar_vc_quit();
+        }
+
+        start_virtual_console(rom);
+        started = true;
+    };
+
+    auto run = [](uint64_t iterations)
+    {
+        std::shared_ptr<ar::chip8::emulator> emulator = ar::chip8::emulator::get_global_emulator();
+
+        for (uint64_t i = 0; i < iterations; i++)
+        {
+            emulator->run_frame();
+        }
+    };
+
+    benchmark_result result = measure(name, "frame", ar::chip8::INSTRUCTIONS_PER_FRAME, setup, run);
+
+    _ar_vc_quit();
+
+    return result;
+}
+
+/**
+ * @brief Measure whole frames of a ROM recording the instruction trace, compared to 'frame/' it is the cost of tracing
+ * @param name Name of the benchmark
+ * @param rom ROM to run
+ * @return Result, time per emulated frame
+ */
+static benchmark_result measure_traced_rom(const std::string& name, const std::vector<ar_byte>& rom)
+{
+    std::unique_ptr<ar::chip8::instruction_trace> trace;
+
+    // Game keeps its quirks the same way it does in 'frame/', tracing policy only adds the trace callback
+    ar::chip8::cpu_quirks quirks = ar::chip8::rom_database().find_profile(
+            ar::chip8::get_rom_hash(rom.data(), rom.size())).value_or(ar::chip8::rom_profile {}).quirks;
+
+    auto setup = [&]
+    {
+        if (trace != nullptr)
+        {
+            ar::chip8::emulator::get_global_emulator()->access_cpu().set_trace_callback(nullptr, nullptr);
+            _ar_vc_quit();
+        }
+
+        start_virtual_console(rom);
+
+        std::shared_ptr<ar::chip8::emulator> emulator = ar::chip8::emulator::get_global_emulator();
+        trace = std::make_unique<ar::chip8::instruction_trace>(*emulator);
+
+        emulator->access_cpu().set_trace_callback(&ar::chip8::instruction_trace::record_instruction_callback,
+                                                  trace.get());
+        emulator->set_cpu_configuration(ar::chip8::cpu_configuration { .quirks = quirks, .tracing = true });
+    };
+
+    auto run = [](uint64_t iterations)
+    {
+        std::shared_ptr<ar::chip8::emulator> emulator = ar::chip8::emulator::get_global_emulator();
+
+        for (uint64_t i = 0; i < iterations; i++)
+        {
+            emulator->run_frame();
+        }
+    };
+
+    benchmark_result result = measure(name, "frame", ar::chip8::INSTRUCTIONS_PER_FRAME, setup, run);
+
+    ar::chip8::emulator::get_global_emulator()->access_cpu().set_trace_callback(nullptr, nullptr);
+    _ar_vc_quit();
+
+    return result;
+}
+
+/**
+ * @brief Measure static analysis of a ROM, runs once when the game loads so it has to stay in microseconds
+ * @param name Name of the benchmark
+ * @param rom ROM to analyse
+ * @return Result, time per analysis
+ */
+static benchmark_result measure_analysis(const std::string& name, const std::vector<ar_byte>& rom)
+{
+    start_virtual_console(rom);
+
+    std::shared_ptr<ar::chip8::emulator> emulator = ar::chip8::emulator::get_global_emulator();
+
+    // Same analysis the virtual console runs when the game loads, its code map is reused by every iteration
+    benchmark_result result = measure(name, "analysis", 0, [] {}, [&](uint64_t iterations)
+    {
+        for (uint64_t i = 0; i < iterations; i++)
+        {
+            emulator->analyze_rom();
+        }
+    });
+
+    _ar_vc_quit();
+
+    return result;
+}
+
+/**
+ * @brief Format an optional number for JSON
+ * @param value Value
+ * @return Number with three decimals, 'null' without value
+ */
+static std::string to_json_number(std::optional<double> value)
+{
+    if (!value.has_value())
+    {
+        return "null";
+    }
+
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(3) << *value;
+
+    return stream.str();
+}
+
+/**
+ * @brief Write hardware events of a benchmark as JSON object
+ * @param output Stream to write to
+ * @param result Result of the benchmark
+ */
+static void write_counters(std::ostream& output, const benchmark_result& result)
+{
+    const auto& counters = result.counters;
+
+    std::optional<double> cycles       = counters[static_cast<std::size_t>(ar::chip8::perf_event::cycles)];
+    std::optional<double> instructions = counters[static_cast<std::size_t>(ar::chip8::perf_event::instructions)];
+
+    output << "{";
+    for (std::size_t i = 0; i < ar::chip8::PERF_EVENT_COUNT; i++)
+    {
+        output << "\"" << ar::chip8::perf_counters::get_event_name(static_cast<ar::chip8::perf_event>(i)) << "\": "
+               << to_json_number(counters[i]) << ", ";
+    }
+
+    output << "\"ipc\": " << to_json_number(cycles.has_value() && instructions.has_value() && *cycles > 0.0 ?
+                                            std::optional<double>(*instructions / *cycles) : std::nullopt);
+
+    // Host events spent on each instruction of the guest, only for benchmarks executing guest instructions
+    output << ", \"per_emulated_instruction\": ";
+    if (result.emulated_instructions == 0)
+    {
+        output << "null}";
+        return;
+    }
+
+    output << "{";
+    for (std::size_t i = 0; i < ar::chip8::PERF_EVENT_COUNT; i++)
+    {
+        output << (i == 0 ? "" : ", ") << "\""
+               << ar::chip8::perf_counters::get_event_name(static_cast<ar::chip8::perf_event>(i)) << "\": "
+               << to_json_number(counters[i].has_value() ?
+                                 std::optional<double>(*counters[i] / result.emulated_instructions) : std::nullopt);
+    }
+    output << "}}";
+}
+
+/**
+ * @brief Write results as JSON, one benchmark per line
+ * @param output Stream to write to
+ * @param results Results in the order they were measured
+ */
+static void write_results(std::ostream& output, const std::vector<benchmark_result>& results)
+{
+    output << std::fixed << std::setprecision(3);
+    output << "{\n";
+    output << "  \"schema_version\": " << SCHEMA_VERSION << ",\n";
+    output << "  \"instructions_per_frame\": " << ar::chip8::INSTRUCTIONS_PER_FRAME << ",\n";
+    output << "  \"samples\": " << SAMPLE_COUNT << ",\n";
+    output << "  \"perf_counters\": " << (g_perf_counters != nullptr ? "true" : "false") << ",\n";
+    output << "  \"benchmarks\": [\n";
+
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        const benchmark_result& result = results[i];
+
+        output << "    {\"name\": " << escape_json(result.name) << ", \"unit\": " << escape_json(result.unit)
+               << ", \"emulated_instructions\": " << result.emulated_instructions
+               << ", \"iterations\": " << result.iterations << ", \"min_ns\": " << result.min_ns
+               << ", \"median_ns\": " << result.median_ns << ", \"p99_ns\": " << result.p99_ns
+               << ", \"per_second\": " << (result.median_ns > 0.0 ? 1e9 / result.median_ns : 0.0);
+
+        if (g_perf_counters != nullptr)
+        {
+            output << ", \"counters\": ";
+            write_counters(output, result);
+        }
+
+        output << "}" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+
+    output << "  ]\n";
+    output << "}\n";
+}
+
+/****************************************************************************************************
+ Entry point
+****************************************************************************************************/
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> rom_paths;
+    std::string output_path;
+    bool counters = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "--output" && i + 1 < argc)
+        {
+            output_path = argv[++i];
+        }
+        else if (arg == "--counters")
+        {
+            counters = true;
+        }
+        else if (arg.starts_with("-"))
+        {
+            std::cerr << "Usage: " << argv[0] << " [<rom>...] [--output <file>] [--counters]" << std::endl;
+            return 1;
+        }
+        else
+        {
+            rom_paths.push_back(arg);
+        }
+    }
+
+    if (counters)
+    {
+        g_perf_counters = std::make_unique<ar::chip8::perf_counters>();
+
+        // Timings are still useful without the events, so missing events are only reported
+        if (!g_perf_counters->get_error().empty())
+        {
+            std::cerr << g_perf_counters->get_error() << std::endl;
+        }
+
+        if (!g_perf_counters->is_available())
+        {
+            std::cerr << "Hardware events are not available, measuring time only" << std::endl;
+            g_perf_counters.reset();
+        }
+    }
+
+    std::vector<benchmark_result> results;
+
+    for (const instruction_mix& mix : g_instruction_mixes)
+    {
+        results.push_back(measure_instruction_mix(mix));
+    }
+
+    for (const draw_case& draw : g_draw_cases)
+    {
+        results.push_back(measure_draw(draw));
+    }
+
+    for (const scroll_case& scroll : g_scroll_cases)
+    {
+        results.push_back(measure_scroll(scroll));
+    }
+
+    results.push_back(measure_render());
+
+    for (const std::string& rom_path : rom_paths)
+    {
+        std::vector<ar_byte> rom;
+        if (!read_file(rom_path, rom) || rom.empty() || rom.size() > ar::chip8::XO_CHIP_RAM_SIZE - PROGRAM_START)
+        {
+            std::cerr << "Unable to read ROM '" << rom_path << "'" << std::endl;
+            return 1;
+        }
+
+        std::string rom_name = rom_path.substr(rom_path.find_last_of("/\\") + 1);
+
+        results.push_back(measure_rom("frame/" + rom_name, rom));
+        results.push_back(measure_traced_rom("trace/" + rom_name, rom));
+        results.push_back(measure_analysis("analysis/" + rom_name, rom));
+    }
+
+    if (output_path.empty())
+    {
+        write_results(std::cout, results);
+        return 0;
+    }
+
+    std::ofstream output(output_path);
+    write_results(output, results);
+
+    if (!output)
+    {
+        std::cerr << "Unable to write results to '" << output_path << "'" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include "perf-counters.hpp"
+
+#if defined(__linux__)
+
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/// @brief Layout of a read with 'PERF_FORMAT_TOTAL_TIME_ENABLED' and 'PERF_FORMAT_TOTAL_TIME_RUNNING'
+struct perf_read_format
+{
+    uint64_t value;
+    uint64_t time_enabled;
+    uint64_t time_running;
+};
+
+/**
+ * @brief Open a single user space event of the calling thread, disabled
+ * @param type Event type ('PERF_TYPE_*')
+ * @param config Event of the type
+ * @return File descriptor, -1 on error (errno is set)
+ */
+static int open_event(uint32_t type, uint64_t config)
+{
+    perf_event_attr attributes {};
+    attributes.size           = sizeof(attributes);
+    attributes.type           = type;
+    attributes.config         = config;
+    attributes.disabled       = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv     = 1;
+    attributes.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+}
+
+ar::chip8::perf_counters::perf_counters()
+{
+    const std::array<std::pair<uint32_t, uint64_t>, PERF_EVENT_COUNT> events = { {
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+            { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+    } };
+
+    for (std::size_t i = 0; i < PERF_EVENT_COUNT; i++)
+    {
+        _descriptors[i] = open_event(events[i].first, events[i].second);
+
+        if (_descriptors[i] == -1 && _error.empty())
+        {
+            _error = std::string("Unable to open '") + get_event_name(static_cast<ar::chip8::perf_event>(i)) +
+                     "' perf event (" + std::strerror(errno) + ")";
+        }
+    }
+}
+
+ar::chip8::perf_counters::~perf_counters()
+{
+    for (int descriptor : _descriptors)
+    {
+        if (descriptor != -1)
+        {
+            close(descriptor);
+        }
+    }
+}
+
+void ar::chip8::perf_counters::start()
+{
+    for (int descriptor : _descriptors)
+    {
+        if (descriptor != -1)
+        {
+            ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+            ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+ar::chip8::perf_counts ar::chip8::perf_counters::stop()
+{
+    for (int descriptor : _descriptors)
+    {
+        if (descriptor != -1)
+        {
+            ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    ar::chip8::perf_counts counts;
+
+    for (std::size_t i = 0; i < PERF_EVENT_COUNT; i++)
+    {
+        perf_read_format result {};
+
+        if (_descriptors[i] == -1 || read(_descriptors[i], &result, sizeof(result)) != sizeof(result) ||
+            result.time_running == 0)
+        {
+            continue;
+        }
+
+        // More events than hardware counters, kernel shares them and the value only covers the running time
+        counts[i] = result.time_running == result.time_enabled ? result.value :
+                    static_cast<uint64_t>(static_cast<double>(result.value) *
+                                          static_cast<double>(result.time_enabled) /
+                                          static_cast<double>(result.time_running));
+    }
+
+    return counts;
+}
+
+#else
+
+ar::chip8::perf_counters::perf_counters() :
+        _error("Perf events are only available on Linux")
+{
+    _descriptors.fill(-1);
+}
+
+ar::chip8::perf_counters::~perf_counters() = default;
+
+void ar::chip8::perf_counters::start()
+{
+}
+
+ar::chip8::perf_counts ar::chip8::perf_counters::stop()
+{
+    return {};
+}
+
+#endif
+
+bool ar::chip8::perf_counters::is_available() const
+{
+    for (int descriptor : _descriptors)
+    {
+        if (descriptor != -1)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+const std::string& ar::chip8::perf_counters::get_error() const
+{
+    return _error;
+}
+
+const char* ar::chip8::perf_counters::get_event_name(ar::chip8::perf_event event)
+{
+    switch (event)
+    {
+        case ar::chip8::perf_event::cycles:
+            return "cycles";
+
+        case ar::chip8::perf_event::instructions:
+            return "instructions";
+
+        case ar::chip8::perf_event::branch_misses:
+            return "branch_misses";
+
+        case ar::chip8::perf_event::l1d_misses:
+            return "l1d_misses";
+
+        default:
+            return "unknown";
+    }
+}
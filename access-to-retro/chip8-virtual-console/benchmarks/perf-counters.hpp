@@ -0,0 +1,86 @@
+/**
+ * @file benchmarks/perf-counters.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_PERF_COUNTERS_HPP
+#define ACCESS_TO_RETRO_PERF_COUNTERS_HPP
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace ar::chip8
+{
+    /// @brief Hardware events counted by 'perf_counters'
+    enum class perf_event
+    {
+        cycles,
+        instructions,
+        branch_misses,
+        l1d_misses,
+    };
+
+    /// @brief Number of events in 'perf_event'
+    constexpr std::size_t PERF_EVENT_COUNT = 4;
+
+    /// @brief Counted values of a measured region, events the system does not support have no value
+    using perf_counts = std::array<std::optional<uint64_t>, PERF_EVENT_COUNT>;
+
+    /**
+     * @brief Hardware performance counters of the calling thread (Linux 'perf_event_open')
+     * @details Every event is opened on its own, so a machine without some of the events (L1d misses are often
+     *          missing in virtual machines) still counts the rest. Only user space is counted. On other systems, or
+     *          when perf events are not permitted ('/proc/sys/kernel/perf_event_paranoid'), no event is available and
+     *          measuring does nothing.
+     */
+    class perf_counters
+    {
+    public:
+        /// @brief Default constructor, opens all events (disabled)
+        perf_counters();
+
+        ~perf_counters();
+
+        perf_counters(const perf_counters&) = delete;
+
+        perf_counters& operator=(const perf_counters&) = delete;
+
+        /**
+         * @brief Check whether any event could be opened
+         * @return Whether counting is possible
+         */
+        [[nodiscard]] bool is_available() const;
+
+        /**
+         * @brief Get why events could not be opened
+         * @return Error of the first event that failed, empty if all events were opened
+         */
+        [[nodiscard]] const std::string& get_error() const;
+
+        /// @brief Reset and start counting
+        void start();
+
+        /**
+         * @brief Stop counting and read the events
+         * @return Counted values since 'start', scaled up if the kernel had to multiplex the counters
+         */
+        perf_counts stop();
+
+        /**
+         * @brief Get name of an event as used in reports
+         * @param event Event
+         * @return Name of the event
+         */
+        static const char* get_event_name(ar::chip8::perf_event event);
+
+    private:
+        /// @brief File descriptors of the events, -1 for events that could not be opened
+        std::array<int, PERF_EVENT_COUNT> _descriptors {};
+
+        /// @brief Why the first failed event could not be opened
+        std::string _error;
+    };
+}
+
+#endif //ACCESS_TO_RETRO_PERF_COUNTERS_HPP
@@ -3,7 +3,16 @@
  */
 
 #include <access-to-retro-dev/access-to-retro-dev.h>
+#include <csignal>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#if !defined(_WIN32)
+#include <signal.h>
+#endif
 #include "emulator/emulator.hpp"
+#include "emulator/instruction-trace.hpp"
+#include "emulator/rom-database.hpp"
 
 // Define basic information about the emulator for the Access to Retro library
 constexpr const char* NAME    = "access-to-retro-chip8";
@@ -11,14 +20,135 @@ constexpr const char* SYSTEM  = "CHIP8";
 constexpr const char* AUTHOR  = "Daniel Wenda";
 constexpr const char* ROM_EXT = "*.ch8";
 
-constexpr unsigned FRAME_RATE = 60;
-
 // Use CHIP8's resolution multiplied by 10 for default resolution (integer scaling) to avoid stretching
 constexpr unsigned DEFAULT_WINDOW_WIDTH  = ar::chip8::SCREEN_RESOLUTION_X * 10;
 constexpr unsigned DEFAULT_WINDOW_HEIGHT = ar::chip8::SCREEN_RESOLUTION_Y * 10;
 
 constexpr ar_version VERSION { .major = 1, .minor = 0, .patch = 0 };
 
+/// @brief Environment variable with path the instruction trace is written to, games run without tracing when not set
+constexpr const char* TRACE_PATH_ENV = "AR_CHIP8_TRACE";
+
+/// @brief Signals that write the instruction trace before the process dies
+constexpr int TRACE_CRASH_SIGNALS[] = { SIGSEGV, SIGABRT, SIGFPE, SIGILL };
+
+#if defined(_WIN32)
+/// @brief Handlers of 'TRACE_CRASH_SIGNALS' installed before the trace's ones (by the frontend or a crash reporter)
+static void (* g_previous_crash_handlers[std::size(TRACE_CRASH_SIGNALS)])(int) = { };
+#else
+/// @brief Actions of 'TRACE_CRASH_SIGNALS' installed before the trace's ones (by the frontend or a crash reporter)
+static struct sigaction g_previous_crash_actions[std::size(TRACE_CRASH_SIGNALS)] = { };
+#endif
+
+/// @brief Instruction trace of the running game, only exists when 'TRACE_PATH_ENV' is set
+static std::unique_ptr<ar::chip8::instruction_trace> g_trace;
+
+/// @brief File the instruction trace is written to, opened at startup because crash handlers cannot open files
+static int g_trace_file = -1;
+
+/// @brief Machine model of the traced game
+static ar::chip8::machine_model g_trace_model = ar::chip8::machine_model::chip8;
+
+/**
+ * @brief Get position of a signal in 'TRACE_CRASH_SIGNALS'
+ * @param signal One of 'TRACE_CRASH_SIGNALS'
+ * @return Index of the signal, also used for its previous handler
+ */
+static constexpr std::size_t get_crash_signal_index(int signal)
+{
+    std::size_t index = 0;
+    while (index + 1 < std::size(TRACE_CRASH_SIGNALS) && TRACE_CRASH_SIGNALS[index] != signal)
+    {
+        index++;
+    }
+
+    return index;
+}
+
+#if defined(_WIN32)
+/**
+ * @brief Write the instruction trace when the emulator crashes, then pass the signal to the previous handler
+ * @param signal Signal that was raised
+ */
+static void write_trace_on_crash(int signal)
+{
+    static_cast<void>(g_trace->write(g_trace_file, g_trace_model));
+
+    void (* previous)(int) = g_previous_crash_handlers[get_crash_signal_index(signal)];
+    std::signal(signal, previous);
+
+    if (previous != SIG_DFL && previous != SIG_IGN)
+    {
+        previous(signal);
+        return;
+    }
+
+    std::raise(signal);
+}
+#else
+/**
+ * @brief Write the instruction trace when the emulator crashes, then pass the signal to the previous handler
+ * @details Only async-signal-safe calls: the trace is written to the already open file with 'write' alone. Previous
+ *          action is restored first, so default and ignored signals do what they would have done without the trace.
+ * @param signal Signal that was raised
+ * @param info Details of the signal, passed on to the previous handler
+ * @param context Interrupted context, passed on to the previous handler
+ */
+static void write_trace_on_crash(int signal, siginfo_t* info, void* context)
+{
+    static_cast<void>(g_trace->write(g_trace_file, g_trace_model));
+
+    const struct sigaction& previous = g_previous_crash_actions[get_crash_signal_index(signal)];
+    sigaction(signal, &previous, nullptr);
+
+    if ((previous.sa_flags & SA_SIGINFO) != 0)
+    {
+        previous.sa_sigaction(signal, info, context);
+    }
+    else if (previous.sa_handler != SIG_DFL && previous.sa_handler != SIG_IGN)
+    {
+        previous.sa_handler(signal);
+    }
+    else
+    {
+        // Signal is blocked inside the handler, it is delivered with the restored action once this returns
+        std::raise(signal);
+    }
+}
+#endif
+
+/// @brief Make crash signals write the instruction trace, previous handlers are kept and called afterwards
+static void install_crash_handlers()
+{
+    for (std::size_t i = 0; i < std::size(TRACE_CRASH_SIGNALS); i++)
+    {
+#if defined(_WIN32)
+        void (* previous)(int) = std::signal(TRACE_CRASH_SIGNALS[i], write_trace_on_crash);
+        g_previous_crash_handlers[i] = previous != SIG_ERR ? previous : SIG_DFL;
+#else
+        struct sigaction action = { };
+        action.sa_sigaction = write_trace_on_crash;
+        action.sa_flags     = SA_SIGINFO;
+        sigemptyset(&action.sa_mask);
+
+        sigaction(TRACE_CRASH_SIGNALS[i], &action, &g_previous_crash_actions[i]);
+#endif
+    }
+}
+
+/// @brief Give crash signals back to the handlers that were installed before 'install_crash_handlers'
+static void restore_crash_handlers()
+{
+    for (std::size_t i = 0; i < std::size(TRACE_CRASH_SIGNALS); i++)
+    {
+#if defined(_WIN32)
+        std::signal(TRACE_CRASH_SIGNALS[i], g_previous_crash_handlers[i]);
+#else
+        sigaction(TRACE_CRASH_SIGNALS[i], &g_previous_crash_actions[i], nullptr);
+#endif
+    }
+}
+
 /**
  * @brief Defines virtual console's metadata for the frontend to use.
  * @details Runs when the virtual console is loaded by the frontend (not when it's started).
@@ -31,10 +161,10 @@ constexpr ar_version VERSION { .major = 1, .minor = 0, .patch = 0 };
 AR_DEFINE_REQUIRED_FN(AR_DEFINE_FN)
 {
     ar_define(NAME, SYSTEM, AUTHOR, ROM_EXT, VERSION,
-              FRAME_RATE, DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT);
+              ar::chip8::FRAME_RATE, DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT);
 
-    // Set graphics method to SDL
-    ar_graphics_set_method(ar_graphics_method_sdl);
+    // Frontend draws the frame buffer presented by the GPU, emulator never touches SDL
+    ar_graphics_set_method(ar_graphics_method_frame_buffer);
 
     return 0;
 }
@@ -46,17 +176,87 @@ AR_DEFINE_REQUIRED_FN(AR_DEFINE_FN)
  * @remark This function NEEDS to be defined for the Access to Retro library.
  * @return Error code:
  *  - 0: No error
- *  - Anything else: In this virtual console it's the result from ar_init.
+ *  - Anything else: In this virtual console it's the result from ar_graphics_create_frame_buffer_with_format or
+ *    ar_audio_configure.
  */
 AR_DEFINE_REQUIRED_FN(AR_STARTUP_FN)
 {
     ar_init();
 
+    ar_executable* executable = ar_get_executable();
+
+    // Known games get their machine model, clock speed and quirks, unknown ones run as CHIP8 with the defaults
+    ar::chip8::rom_profile profile = ar::chip8::rom_database().find_profile(
+            ar::chip8::get_rom_hash(executable->raw_bytes, executable->size)).value_or(ar::chip8::rom_profile {});
+
+    if (profile.model == ar::chip8::machine_model::chip8)
+    {
+        // CHIP8 is monochrome, default 1bpp palette is already black and white
+        if (ar_err_code result = ar_graphics_create_frame_buffer_with_format(ar::chip8::SCREEN_RESOLUTION_X,
+                                                                             ar::chip8::SCREEN_RESOLUTION_Y,
+                                                                             ar_pixel_format_1bpp); result != 0)
+        {
+            return result;
+        }
+    }
+    else
+    {
+        // Both resolutions fit into a 128x64 frame buffer, each pixel indexes the palette with bits of both planes
+        if (ar_err_code result = ar_graphics_create_frame_buffer_with_format(ar::chip8::HIGH_RESOLUTION_X,
+                                                                             ar::chip8::HIGH_RESOLUTION_Y,
+                                                                             ar_pixel_format_2bpp_indexed); result != 0)
+        {
+            return result;
+        }
+
+        // First plane alone stays white like on CHIP8, second plane alone and both planes are shades of grey
+        ar_pixel* palette = ar_graphics_get_frame_buffer()->palette;
+
+        palette[0] = ar_pixel { .r = 0x00, .g = 0x00, .b = 0x00, .a = 0xFF };
+        palette[1] = ar_pixel { .r = 0xFF, .g = 0xFF, .b = 0xFF, .a = 0xFF };
+        palette[2] = ar_pixel { .r = 0xAA, .g = 0xAA, .b = 0xAA, .a = 0xFF };
+        palette[3] = ar_pixel { .r = 0x55, .g = 0x55, .b = 0x55, .a = 0xFF };
+    }
+
     ar::chip8::emulator::create_global_emulator();
 
-    ar::chip8::emulator::get_global_emulator()->access_ram().load_binary(ar_get_executable());
+    std::shared_ptr<ar::chip8::emulator> emulator = ar::chip8::emulator::get_global_emulator();
 
-    return 0;
+    // Memory size and the big font depend on the machine, the game is loaded after that
+    emulator->set_machine_model(profile.model);
+    emulator->access_ram().load_binary(executable);
+
+    // Code and data of the game are found once, before its first instruction runs
+    emulator->analyze_rom();
+
+    // Opt-in trace of every instruction, kept in memory and written when the game closes or the emulator crashes
+    if (const char* trace_path = std::getenv(TRACE_PATH_ENV); trace_path != nullptr && *trace_path != '\0')
+    {
+        g_trace_file = ar::chip8::instruction_trace::open_file(trace_path);
+    }
+
+    // Game runs without the trace when its file could not be created
+    if (g_trace_file >= 0)
+    {
+        g_trace_model = profile.model;
+        g_trace       = std::make_unique<ar::chip8::instruction_trace>(*emulator);
+
+        emulator->access_cpu().set_trace_callback(&ar::chip8::instruction_trace::record_instruction_callback,
+                                                  g_trace.get());
+
+        install_crash_handlers();
+    }
+
+    // Selects CPU instantiation used by the main thread, games without quirks or tracing run the default one
+    emulator->set_cpu_configuration(ar::chip8::cpu_configuration { .quirks = profile.quirks,
+                                                                   .tracing = g_trace != nullptr });
+    emulator->set_clock_speed(profile.clock_speed);
+
+    // Frontend can change clock speed while the game runs, main thread picks it up every frame
+    ar_set_vc_clock_speed(profile.clock_speed);
+
+    // Mono is enough for a single square wave beep
+    return ar_audio_configure(ar::chip8::SAMPLE_RATE, 1, ar_audio_format_s16);
 }
 
 /**
@@ -66,5 +266,17 @@ AR_DEFINE_REQUIRED_FN(AR_STARTUP_FN)
  */
 AR_DEFINE_REQUIRED_FN(AR_QUIT_FN)
 {
+    if (g_trace != nullptr)
+    {
+        restore_crash_handlers();
+
+        static_cast<void>(g_trace->write(g_trace_file, g_trace_model));
+        static_cast<void>(ar::chip8::instruction_trace::close_file(g_trace_file));
+        g_trace_file = -1;
+
+        ar::chip8::emulator::get_global_emulator()->access_cpu().set_trace_callback(nullptr, nullptr);
+        g_trace.reset();
+    }
+
     ar_quit();
 }
@@ -0,0 +1,53 @@
+#include <cmath>
+#include "beeper.hpp"
+
+/// @brief Phase increment per sample, fixed point fraction of the period (2^32 / samples per period)
+static constexpr uint32_t PHASE_INCREMENT = static_cast<uint32_t>((uint64_t { ar::chip8::BEEP_FREQUENCY } << 32) /
+                                                                  ar::chip8::SAMPLE_RATE);
+
+/// @brief Bits of the phase below the index of the pattern's sample, 128 samples take the top 7 bits
+static constexpr uint32_t PATTERN_SAMPLE_SHIFT = 25;
+
+void ar::chip8::beeper::tick(bool active)
+{
+    if (active && _pattern_enabled)
+    {
+        // Each sample of the pattern is either high or low, the pattern loops for as long as the beep sounds
+        for (int16_t& sample : _samples)
+        {
+            uint32_t index = _phase >> PATTERN_SAMPLE_SHIFT;
+            bool high      = (_pattern[index / 8] & (0x80 >> (index % 8))) != 0;
+
+            sample = static_cast<int16_t>(high ? ar::chip8::BEEP_AMPLITUDE : -ar::chip8::BEEP_AMPLITUDE);
+            _phase += _pattern_phase_increment;
+        }
+    }
+    else if (active)
+    {
+        // Square wave, high for the first half of the period
+        for (int16_t& sample : _samples)
+        {
+            sample = static_cast<int16_t>((_phase & 0x80000000) == 0 ? ar::chip8::BEEP_AMPLITUDE : -ar::chip8::BEEP_AMPLITUDE);
+            _phase += PHASE_INCREMENT;
+        }
+    }
+    else
+    {
+        // Silence is pushed too so that the audio stream stays aligned to timer ticks
+        _samples.fill(0);
+        _phase = 0;
+    }
+
+    ar_audio_push_samples(_samples.data(), ar::chip8::SAMPLES_PER_TIMER_TICK);
+}
+
+void ar::chip8::beeper::set_pattern(const std::array<ar_byte, ar::chip8::AUDIO_PATTERN_SIZE>& pattern, ar_byte pitch)
+{
+    // Samples per second of the pattern, fixed point increment is a fraction of a single sample (2^25)
+    double pattern_rate = 4000.0 * std::exp2((pitch - ar::chip8::DEFAULT_AUDIO_PITCH) / 48.0);
+    double increment    = pattern_rate * (1u << PATTERN_SAMPLE_SHIFT) / ar::chip8::SAMPLE_RATE;
+
+    _pattern                 = pattern;
+    _pattern_phase_increment = static_cast<uint32_t>(increment);
+    _pattern_enabled         = true;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file emulator/beeper.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_BEEPER_HPP
+#define ACCESS_TO_RETRO_BEEPER_HPP
+
+#include <access-to-retro-dev/access-to-retro-dev.h>
+#include <array>
+
+namespace ar::chip8
+{
+    /// @brief Sample rate of the audio output (frames per second)
+    constexpr uint32_t SAMPLE_RATE = 48000;
+
+    /// @brief Frequency at which CHIP8's timers count down
+    constexpr uint32_t TIMER_FREQUENCY = 60;
+
+    /// @brief Number of samples generated per each timer tick, sound timer can only change once per tick
+    constexpr uint32_t SAMPLES_PER_TIMER_TICK = SAMPLE_RATE / TIMER_FREQUENCY;
+
+    /// @brief Frequency of the beep (A4)
+    constexpr uint32_t BEEP_FREQUENCY = 440;
+
+    /// @brief Amplitude of the beep, quarter of the maximum to not be too loud
+    constexpr int16_t BEEP_AMPLITUDE = 8192;
+
+    /// @brief Number of bytes in XO-CHIP's audio pattern (128 one bit samples)
+    constexpr std::size_t AUDIO_PATTERN_SIZE = 16;
+
+    /// @brief Default pitch of XO-CHIP's audio pattern, plays the pattern at 4000 samples per second
+    constexpr ar_byte DEFAULT_AUDIO_PITCH = 64;
+
+    /**
+     * @brief Class representing CHIP8's buzzer
+     * @details CHIP8 beeps for as long as its sound timer is above 0, the timer only changes every timer tick so the
+     *          beeper generates exactly one timer tick worth of samples each time it ticks. This way the beep always
+     *          starts and ends on a timer tick boundary in the audio stream, no matter how the main thread is paced.
+     */
+    class beeper
+    {
+    public:
+        /**
+         * @brief Generate one timer tick worth of samples and push them to the audio output
+         * @param active Whether the beep should sound during this timer tick (silence otherwise)
+         */
+        void tick(bool active);
+
+        /**
+         * @brief Play XO-CHIP's audio pattern instead of the square wave
+         * @param pattern 128 one bit samples, the first one is the top bit of the first byte
+         * @param pitch Pitch, the pattern plays at 4000 * 2 ^ ((pitch - 64) / 48) samples per second
+         */
+        void set_pattern(const std::array<ar_byte, ar::chip8::AUDIO_PATTERN_SIZE>& pattern, ar_byte pitch);
+
+    private:
+        /// @brief Phase of the wave (0 to 2^32 is one period), kept between ticks so the wave is continuous
+        uint32_t _phase = 0;
+
+        /// @brief Phase increment per sample of the audio pattern, depends on the pitch
+        uint32_t _pattern_phase_increment = 0;
+
+        /// @brief Audio pattern, played when set
+        std::array<ar_byte, ar::chip8::AUDIO_PATTERN_SIZE> _pattern {};
+
+        /// @brief Whether the audio pattern is played instead of the square wave
+        bool _pattern_enabled = false;
+
+        /// @brief Buffer for a single tick worth of samples, mono
+        std::array<int16_t, ar::chip8::SAMPLES_PER_TIMER_TICK> _samples {};
+    };
+}
+
+#endif //ACCESS_TO_RETRO_BEEPER_HPP
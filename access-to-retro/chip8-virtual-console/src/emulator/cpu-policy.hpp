@@ -0,0 +1,147 @@
+/**
+ * @file emulator/cpu-policy.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_CPU_POLICY_HPP
+#define ACCESS_TO_RETRO_CPU_POLICY_HPP
+
+#include "machine-model.hpp"
+
+namespace ar::chip8
+{
+    /**
+     * @brief Behaviours that differ between CHIP8 interpreters, each game expects the ones of the interpreter it was
+     *        written for
+     * @details All quirks disabled is the behaviour this emulator always had.
+     */
+    struct cpu_quirks
+    {
+        /// @brief 0x8XY6 and 0x8XYE shift VY into VX (COSMAC VIP) instead of shifting VX in place
+        bool shift_uses_vy = false;
+
+        /// @brief 0xFX55 and 0xFX65 leave I pointing after the last register (COSMAC VIP) instead of not changing it
+        bool load_store_increments_i = false;
+
+        /// @brief 0xBNNN jumps to NNN + VX where X is the highest digit of NNN (SUPER-CHIP) instead of NNN + V0
+        bool jump_uses_vx = false;
+
+        /// @brief 0x8XY1, 0x8XY2 and 0x8XY3 reset VF (COSMAC VIP)
+        bool logic_resets_vf = false;
+
+        /// @brief Sprites are cut at the edges of the screen instead of wrapping around to the other side
+        bool clip_sprites = false;
+
+        /// @brief 0xDXYN waits for the next frame (COSMAC VIP), games drawing once per frame rely on it for their speed
+        bool wait_for_vblank = false;
+
+        constexpr bool operator==(const cpu_quirks&) const = default;
+    };
+
+    /// @brief Quirk sets that have their own CPU instantiation, any other combination of quirks is checked at runtime
+    enum class quirk_set
+    {
+        /// @brief No quirks, behaviour of this emulator and most modern games
+        chip8,
+
+        /// @brief Original COSMAC VIP interpreter
+        cosmac_vip,
+
+        /// @brief SUPER-CHIP 1.1 interpreter
+        super_chip,
+
+        /// @brief Quirks are read from the CPU at runtime, used for combinations of quirks not listed above
+        custom
+    };
+
+    /**
+     * @brief Get quirks of a quirk set
+     * @param set Quirk set, 'custom' has no quirks of its own
+     * @return Quirks of the set
+     */
+    constexpr ar::chip8::cpu_quirks get_quirk_set_quirks(ar::chip8::quirk_set set)
+    {
+        switch (set)
+        {
+            case ar::chip8::quirk_set::cosmac_vip:
+                return { .shift_uses_vy = true, .load_store_increments_i = true, .logic_resets_vf = true,
+                         .clip_sprites = true, .wait_for_vblank = true };
+
+            case ar::chip8::quirk_set::super_chip:
+                return { .jump_uses_vx = true, .clip_sprites = true };
+
+            case ar::chip8::quirk_set::chip8:
+            case ar::chip8::quirk_set::custom:
+            default:
+                return {};
+        }
+    }
+
+    /**
+     * @brief Find quirk set with exactly the given quirks
+     * @param quirks Quirks
+     * @return Matching quirk set, 'custom' if there is none
+     */
+    constexpr ar::chip8::quirk_set find_quirk_set(const ar::chip8::cpu_quirks& quirks)
+    {
+        for (ar::chip8::quirk_set set : { ar::chip8::quirk_set::chip8, ar::chip8::quirk_set::cosmac_vip,
+                                          ar::chip8::quirk_set::super_chip })
+        {
+            if (get_quirk_set_quirks(set) == quirks)
+            {
+                return set;
+            }
+        }
+
+        return ar::chip8::quirk_set::custom;
+    }
+
+    /**
+     * @brief Compile time configuration of the CPU, each policy is a separate instantiation of the instruction decoder
+     *        and the frame loop so disabled features cost nothing (not even a branch)
+     * @tparam model_value Machine whose instructions are decoded, CHIP8 never checks for the extensions
+     * @tparam quirk_set_value Quirks the instructions are compiled with
+     * @tparam tracing Whether trace callback is called after every instruction
+     * @tparam breakpoints Whether the CPU halts at breakpoints
+     */
+    template<ar::chip8::machine_model model_value, ar::chip8::quirk_set quirk_set_value, bool tracing,
+             bool breakpoints>
+    struct cpu_policy
+    {
+        /// @brief Machine whose instructions are decoded
+        static constexpr ar::chip8::machine_model MODEL = model_value;
+
+        /// @brief Quirk set the instructions are compiled with
+        static constexpr ar::chip8::quirk_set QUIRK_SET = quirk_set_value;
+
+        /// @brief Whether quirks are read from the CPU at runtime instead of 'QUIRKS'
+        static constexpr bool RUNTIME_QUIRKS = quirk_set_value == ar::chip8::quirk_set::custom;
+
+        /// @brief Quirks the instructions are compiled with, unused with runtime quirks
+        static constexpr ar::chip8::cpu_quirks QUIRKS = ar::chip8::get_quirk_set_quirks(quirk_set_value);
+
+        /// @brief Whether trace callback is called after every instruction
+        static constexpr bool TRACING = tracing;
+
+        /// @brief Whether the CPU halts at breakpoints
+        static constexpr bool BREAKPOINTS = breakpoints;
+    };
+
+    /// @brief Policy of normal runs, CHIP8 without quirks, tracing or breakpoints
+    using default_cpu_policy = ar::chip8::cpu_policy<ar::chip8::machine_model::chip8, ar::chip8::quirk_set::chip8,
+                                                     false, false>;
+
+    /// @brief Runtime configuration of the CPU, the emulator selects matching policy when it is set
+    struct cpu_configuration
+    {
+        /// @brief Quirks expected by the game
+        ar::chip8::cpu_quirks quirks {};
+
+        /// @brief Whether trace callback is called after every instruction
+        bool tracing = false;
+
+        /// @brief Whether the CPU halts at breakpoints
+        bool breakpoints = false;
+    };
+}
+
+#endif //ACCESS_TO_RETRO_CPU_POLICY_HPP
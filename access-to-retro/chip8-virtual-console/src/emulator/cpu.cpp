@@ -1,3 +1,4 @@
+#include <cstdlib>
 #include <ctime>
 #include "cpu.hpp"
 
@@ -6,7 +7,8 @@ ar::chip8::cpu::cpu(ar::chip8::ram_memory& ram_link, ar::chip8::gpu& gpu_link, a
         _ram_link(ram_link),
         _controller_link(controller_link)
 {
-
+    // Security doesn't matter so time is fine as a seed
+    set_random_seed(static_cast<uint32_t>(time(nullptr)));
 }
 
 void ar::chip8::cpu::tick_timers()
@@ -24,13 +26,168 @@ void ar::chip8::cpu::tick_timers()
     }
 }
 
+bool ar::chip8::cpu::is_sound_timer_active() const
+{
+    return _sound_timer > 0;
+}
+
+bool ar::chip8::cpu::is_audio_pattern_loaded() const
+{
+    return _audio_pattern_loaded;
+}
+
+const std::array<ar_byte, ar::chip8::AUDIO_PATTERN_SIZE>& ar::chip8::cpu::get_audio_pattern() const
+{
+    return _audio_pattern;
+}
+
+ar_byte ar::chip8::cpu::get_audio_pitch() const
+{
+    return _audio_pitch;
+}
+
+uint16_t ar::chip8::cpu::get_program_counter() const
+{
+    return _special_register_pc;
+}
+
+uint16_t ar::chip8::cpu::get_encoded_instruction() const
+{
+    return _encoded_instruction;
+}
+
+const std::array<ar_byte, ar::chip8::GENERAL_REGISTER_COUNT>& ar::chip8::cpu::get_general_registers() const
+{
+    return _general_registers;
+}
+
+uint16_t ar::chip8::cpu::get_address_register() const
+{
+    return _special_register_i;
+}
+
+void ar::chip8::cpu::set_random_seed(uint32_t seed)
+{
+    _random_state = seed != 0 ? seed : 1;
+}
+
+uint64_t ar::chip8::cpu::hash_state(uint64_t hash) const
+{
+    hash = ar::chip8::hash_state_bytes(hash, _general_registers.data(), _general_registers.size());
+    hash = ar::chip8::hash_state_bytes(hash, &_special_register_pc, sizeof(_special_register_pc));
+    hash = ar::chip8::hash_state_bytes(hash, &_special_register_i, sizeof(_special_register_i));
+    hash = ar::chip8::hash_state_bytes(hash, &_delay_timer, sizeof(_delay_timer));
+    hash = ar::chip8::hash_state_bytes(hash, &_sound_timer, sizeof(_sound_timer));
+
+    // Stack can only be read from the top, hash a copy of it
+    std::stack<uint16_t> call_stack = _call_stack;
+    while (!call_stack.empty())
+    {
+        uint16_t address = call_stack.top();
+        hash = ar::chip8::hash_state_bytes(hash, &address, sizeof(address));
+
+        call_stack.pop();
+    }
+
+    // CHIP8 games can't touch the extensions, keep their hashes the same as before the extensions existed
+    if (_model != ar::chip8::machine_model::chip8)
+    {
+        hash = ar::chip8::hash_state_bytes(hash, _flag_registers.data(), _flag_registers.size());
+        hash = ar::chip8::hash_state_bytes(hash, _audio_pattern.data(), _audio_pattern.size());
+        hash = ar::chip8::hash_state_bytes(hash, &_audio_pitch, sizeof(_audio_pitch));
+        hash = ar::chip8::hash_state_bytes(hash, &_audio_pattern_loaded, sizeof(_audio_pattern_loaded));
+    }
+
+    return hash;
+}
+
+void ar::chip8::cpu::set_custom_quirks(const ar::chip8::cpu_quirks& quirks)
+{
+    _custom_quirks = quirks;
+}
+
+void ar::chip8::cpu::set_machine_model(ar::chip8::machine_model model)
+{
+    _model = model;
+}
+
+ar::chip8::machine_model ar::chip8::cpu::get_machine_model() const
+{
+    return _model;
+}
+
+void ar::chip8::cpu::set_trace_callback(ar::chip8::cpu_trace_callback callback, void* user_data)
+{
+    _trace_callback  = callback;
+    _trace_user_data = user_data;
+}
+
+void ar::chip8::cpu::set_breakpoint(uint16_t address, bool enabled)
+{
+    _breakpoints.set(address % ar::chip8::XO_CHIP_RAM_SIZE, enabled);
+}
+
+void ar::chip8::cpu::clear_breakpoints()
+{
+    _breakpoints.reset();
+}
+
+bool ar::chip8::cpu::is_halted() const
+{
+    return _halted;
+}
+
+void ar::chip8::cpu::resume()
+{
+    _resuming = _halted;
+    _halted   = false;
+}
+
 void ar::chip8::cpu::tick()
 {
+    tick<ar::chip8::default_cpu_policy>();
+}
+
+template<typename policy>
+void ar::chip8::cpu::tick()
+{
+    uint16_t address = _special_register_pc;
+
+    if constexpr (policy::BREAKPOINTS)
+    {
+        // Instruction at the breakpoint runs once the CPU resumes
+        if (_halted || (_breakpoints[address % ar::chip8::XO_CHIP_RAM_SIZE] && !_resuming))
+        {
+            _halted = true;
+            return;
+        }
+
+        _resuming = false;
+    }
+
     // Fetch...
     fetch();
 
     // ... decode and execute.
-    decode_and_execute();
+    decode_and_execute<policy>();
+
+    if constexpr (policy::TRACING)
+    {
+        if (_trace_callback != nullptr)
+        {
+            _trace_callback(*this, address, _trace_user_data);
+        }
+    }
+}
+
+ar_byte ar::chip8::cpu::get_random_byte()
+{
+    // Xorshift32, plenty for games and the same sequence for the same seed on every platform (unlike 'rand')
+    _random_state ^= _random_state << 13;
+    _random_state ^= _random_state >> 17;
+    _random_state ^= _random_state << 5;
+
+    return static_cast<ar_byte>(_random_state >> 24);
 }
 
 void ar::chip8::cpu::increment_program_counter()
@@ -39,6 +196,21 @@ void ar::chip8::cpu::increment_program_counter()
     _special_register_pc += 2;
 }
 
+template<typename policy>
+void ar::chip8::cpu::skip_next_instruction()
+{
+    // Only XO-CHIP has a 4 byte instruction, other machines never read the next opcode
+    if constexpr (policy::MODEL == ar::chip8::machine_model::xo_chip)
+    {
+        if (_ram_link.read_instruction(_special_register_pc) == 0xF000)
+        {
+            increment_program_counter();
+        }
+    }
+
+    increment_program_counter();
+}
+
 void ar::chip8::cpu::fetch()
 {
     // Opcode is en encoded instruction, in CHIP8 opcodes are 16bit long
@@ -48,6 +220,7 @@ void ar::chip8::cpu::fetch()
     increment_program_counter();
 }
 
+template<typename policy>
 void ar::chip8::cpu::decode_and_execute()
 {
     /*
@@ -80,8 +253,17 @@ void ar::chip8::cpu::decode_and_execute()
                     fn_return();
                     break;
 
-                    // Opcode: 0x0NNN
+                    // Opcode: 0x00CN, 0x00DN, 0x00FB - 0x00FF on SUPER-CHIP and XO-CHIP, 0x0NNN otherwise
                 default:
+                    if constexpr (policy::MODEL != ar::chip8::machine_model::chip8)
+                    {
+                        if (ar::chip8::is_screen_instruction(_encoded_instruction, policy::MODEL))
+                        {
+                            execute_screen_instruction();
+                            break;
+                        }
+                    }
+
                     fn_call();
                     break;
 
@@ -100,17 +282,32 @@ void ar::chip8::cpu::decode_and_execute()
 
             // Opcode 0x3XNN
         case 0x3000:
-            skip_if_vx_eq_nn();
+            skip_if_vx_eq_nn<policy>();
             break;
 
             // Opcode 0x4XNN
         case 0x4000:
-            skip_if_vx_neq_nn();
+            skip_if_vx_neq_nn<policy>();
             break;
 
-            // Opcode 0x5XY0
+            // Opcode 0x5XY0, XO-CHIP also has 0x5XY2 and 0x5XY3
         case 0x5000:
-            skip_if_vx_eq_vy();
+            if constexpr (policy::MODEL == ar::chip8::machine_model::xo_chip)
+            {
+                if ((_encoded_instruction & 0x000F) == 0x2)
+                {
+                    dump_vx_to_vy_at_i();
+                    break;
+                }
+
+                if ((_encoded_instruction & 0x000F) == 0x3)
+                {
+                    fill_vx_to_vy_from_i();
+                    break;
+                }
+            }
+
+            skip_if_vx_eq_vy<policy>();
             break;
 
             // Opcode 0x6XNN
@@ -135,17 +332,17 @@ void ar::chip8::cpu::decode_and_execute()
 
                     // Opcode 0x8XY1
                 case 0x1:
-                    set_vx_to_vx_or_vy();
+                    set_vx_to_vx_or_vy<policy>();
                     break;
 
                     // Opcode 0x8XY2
                 case 0x2:
-                    set_vx_to_vx_and_vy();
+                    set_vx_to_vx_and_vy<policy>();
                     break;
 
                     // Opcode 0x8XY3
                 case 0x3:
-                    set_vx_to_vx_xor_vy();
+                    set_vx_to_vx_xor_vy<policy>();
                     break;
 
                     // Opcode 0x8XY4
@@ -160,7 +357,7 @@ void ar::chip8::cpu::decode_and_execute()
 
                 case 0x6:
                     // Opcode 0x8XY6
-                    store_least_sig_vx();
+                    store_least_sig_vx<policy>();
                     break;
 
                     // Opcode 0x8XY7
@@ -170,7 +367,7 @@ void ar::chip8::cpu::decode_and_execute()
 
                     // Opcode 0x8XYE
                 case 0xE:
-                    store_most_sig_vx();
+                    store_most_sig_vx<policy>();
                     break;
 
             }
@@ -178,7 +375,7 @@ void ar::chip8::cpu::decode_and_execute()
 
             // Opcode 0x9XY0
         case 0x9000:
-            skip_if_vx_neq_vy();
+            skip_if_vx_neq_vy<policy>();
             break;
 
             // Opcode 0xANNN
@@ -188,7 +385,7 @@ void ar::chip8::cpu::decode_and_execute()
 
             // Opcode 0xBNNN
         case 0xB000:
-            jump_add_v0();
+            jump_add_v0<policy>();
             break;
 
             // Opcode 0xCXNN
@@ -198,7 +395,7 @@ void ar::chip8::cpu::decode_and_execute()
 
             // Opcode 0xDXYN
         case 0xD000:
-            draw();
+            draw<policy>();
             break;
 
             // Opcode starting with E for ex: 0xEABC
@@ -208,12 +405,12 @@ void ar::chip8::cpu::decode_and_execute()
             {
                 // Opcode 0xEX9E
                 case 0x9E:
-                    skip_if_vx_key_pressed();
+                    skip_if_vx_key_pressed<policy>();
                     break;
 
                     // Opcode 0xEXA1
                 case 0xA1:
-                    skip_if_vx_key_not_pressed();
+                    skip_if_vx_key_not_pressed<policy>();
                     break;
             }
             break;
@@ -223,7 +420,37 @@ void ar::chip8::cpu::decode_and_execute()
             // Multiple opcodes start with F so confirm which one it is based on last byte
             switch (_encoded_instruction & 0x00FF)
             {
-                // Opcode 0xFX07
+                // Opcode 0xF000 NNNN (XO-CHIP)
+                case 0x00:
+                    if constexpr (policy::MODEL == ar::chip8::machine_model::xo_chip)
+                    {
+                        if (_encoded_instruction == 0xF000)
+                        {
+                            set_i_to_long_nnnn();
+                        }
+                    }
+                    break;
+
+                    // Opcode 0xFN01 (XO-CHIP)
+                case 0x01:
+                    if constexpr (policy::MODEL == ar::chip8::machine_model::xo_chip)
+                    {
+                        select_planes();
+                    }
+                    break;
+
+                    // Opcode 0xF002 (XO-CHIP)
+                case 0x02:
+                    if constexpr (policy::MODEL == ar::chip8::machine_model::xo_chip)
+                    {
+                        if (_encoded_instruction == 0xF002)
+                        {
+                            load_audio_pattern_from_i();
+                        }
+                    }
+                    break;
+
+                    // Opcode 0xFX07
                 case 0x07:
                     set_vx_to_delay_timer();
                     break;
@@ -253,19 +480,51 @@ void ar::chip8::cpu::decode_and_execute()
                     set_i_to_sprite_location_for_vx();
                     break;
 
+                    // Opcode 0xFX30 (SUPER-CHIP)
+                case 0x30:
+                    if constexpr (policy::MODEL != ar::chip8::machine_model::chip8)
+                    {
+                        set_i_to_big_sprite_location_for_vx();
+                    }
+                    break;
+
                     // Opcode 0xFX33
                 case 0x33:
                     store_vcx_bcd_at_i();
                     break;
 
+                    // Opcode 0xFX3A (XO-CHIP)
+                case 0x3A:
+                    if constexpr (policy::MODEL == ar::chip8::machine_model::xo_chip)
+                    {
+                        set_audio_pitch_to_vx();
+                    }
+                    break;
+
                     // Opcode 0xFX55
                 case 0x55:
-                    dump_general_registers_at_i();
+                    dump_general_registers_at_i<policy>();
                     break;
 
                     // Opcode 0xFX65
                 case 0x65:
-                    fill_general_registers_from_i();
+                    fill_general_registers_from_i<policy>();
+                    break;
+
+                    // Opcode 0xFX75 (SUPER-CHIP)
+                case 0x75:
+                    if constexpr (policy::MODEL != ar::chip8::machine_model::chip8)
+                    {
+                        save_flag_registers();
+                    }
+                    break;
+
+                    // Opcode 0xFX85 (SUPER-CHIP)
+                case 0x85:
+                    if constexpr (policy::MODEL != ar::chip8::machine_model::chip8)
+                    {
+                        restore_flag_registers();
+                    }
                     break;
             }
             break;
@@ -307,6 +566,56 @@ void ar::chip8::cpu::clear_screen()
     _gpu_link.clear_screen();
 }
 
+void ar::chip8::cpu::execute_screen_instruction()
+{
+    switch (_encoded_instruction & 0x00F0)
+    {
+        // Opcode 0x00CN
+        case 0xC0:
+            _gpu_link.scroll_down(get_n_argument_from_opcode());
+            break;
+
+            // Opcode 0x00DN
+        case 0xD0:
+            _gpu_link.scroll_up(get_n_argument_from_opcode());
+            break;
+
+        default:
+            switch (_encoded_instruction)
+            {
+                // Opcode 0x00FB
+                case 0x00FB:
+                    _gpu_link.scroll_right();
+                    break;
+
+                    // Opcode 0x00FC
+                case 0x00FC:
+                    _gpu_link.scroll_left();
+                    break;
+
+                    // Opcode 0x00FD -> Exit the interpreter, the frontend owns the process so just stop here
+                case 0x00FD:
+                    _special_register_pc -= 2;
+                    break;
+
+                    // Opcode 0x00FE
+                case 0x00FE:
+                    _gpu_link.set_high_resolution(false);
+                    break;
+
+                    // Opcode 0x00FF
+                case 0x00FF:
+                    _gpu_link.set_high_resolution(true);
+                    break;
+
+                    // Only screen instructions get here, see 'is_screen_instruction'
+                default:
+                    break;
+            }
+            break;
+    }
+}
+
 void ar::chip8::cpu::fn_return()
 {
     // Get new program counter value from the top of the call stack
@@ -329,6 +638,7 @@ void ar::chip8::cpu::fn_call()
     _special_register_pc = get_nnn_argument_from_opcode();
 }
 
+template<typename policy>
 void ar::chip8::cpu::skip_if_vx_eq_nn()
 {
     ar_byte register_index = get_x_argument_from_opcode();
@@ -336,11 +646,11 @@ void ar::chip8::cpu::skip_if_vx_eq_nn()
 
     if (_general_registers[register_index] == nn_value)
     {
-        // Increment program counter again to skip next instruction
-        increment_program_counter();
+        skip_next_instruction<policy>();
     }
 }
 
+template<typename policy>
 void ar::chip8::cpu::skip_if_vx_neq_nn()
 {
     ar_byte register_index = get_x_argument_from_opcode();
@@ -348,11 +658,11 @@ void ar::chip8::cpu::skip_if_vx_neq_nn()
 
     if (_general_registers[register_index] != nn_value)
     {
-        // Increment program counter again to skip next instruction
-        increment_program_counter();
+        skip_next_instruction<policy>();
     }
 }
 
+template<typename policy>
 void ar::chip8::cpu::skip_if_vx_eq_vy()
 {
     ar_byte register_index_x = get_x_argument_from_opcode();
@@ -360,8 +670,41 @@ void ar::chip8::cpu::skip_if_vx_eq_vy()
 
     if (_general_registers[register_index_x] == _general_registers[register_index_y])
     {
-        // Increment program counter again to skip next instruction
-        increment_program_counter();
+        skip_next_instruction<policy>();
+    }
+}
+
+void ar::chip8::cpu::dump_vx_to_vy_at_i()
+{
+    ar_byte register_index_x = get_x_argument_from_opcode();
+    ar_byte register_index_y = get_y_argument_from_opcode();
+
+    // Registers can go in either direction, I is never changed
+    int step  = register_index_x <= register_index_y ? 1 : -1;
+    int count = std::abs(register_index_y - register_index_x) + 1;
+
+    for (int i = 0; i < count; i++)
+    {
+        auto address = static_cast<uint16_t>(_special_register_i + i);
+
+        _ram_link.write(address, _general_registers[register_index_x + i * step]);
+    }
+}
+
+void ar::chip8::cpu::fill_vx_to_vy_from_i()
+{
+    ar_byte register_index_x = get_x_argument_from_opcode();
+    ar_byte register_index_y = get_y_argument_from_opcode();
+
+    // Registers can go in either direction, I is never changed
+    int step  = register_index_x <= register_index_y ? 1 : -1;
+    int count = std::abs(register_index_y - register_index_x) + 1;
+
+    for (int i = 0; i < count; i++)
+    {
+        auto address = static_cast<uint16_t>(_special_register_i + i);
+
+        _general_registers[register_index_x + i * step] = _ram_link.read(address);
     }
 }
 
@@ -387,28 +730,46 @@ void ar::chip8::cpu::set_vx_to_vy()
     _general_registers[register_index_x] = _general_registers[register_index_y];
 }
 
+template<typename policy>
 void ar::chip8::cpu::set_vx_to_vx_or_vy()
 {
     ar_byte register_index_x = get_x_argument_from_opcode();
     ar_byte register_index_y = get_y_argument_from_opcode();
 
     _general_registers[register_index_x] |= _general_registers[register_index_y];
+
+    if (get_quirks<policy>().logic_resets_vf)
+    {
+        _general_registers[0xF] = 0;
+    }
 }
 
+template<typename policy>
 void ar::chip8::cpu::set_vx_to_vx_and_vy()
 {
     ar_byte register_index_x = get_x_argument_from_opcode();
     ar_byte register_index_y = get_y_argument_from_opcode();
 
     _general_registers[register_index_x] &= _general_registers[register_index_y];
+
+    if (get_quirks<policy>().logic_resets_vf)
+    {
+        _general_registers[0xF] = 0;
+    }
 }
 
+template<typename policy>
 void ar::chip8::cpu::set_vx_to_vx_xor_vy()
 {
     ar_byte register_index_x = get_x_argument_from_opcode();
     ar_byte register_index_y = get_y_argument_from_opcode();
 
     _general_registers[register_index_x] ^= _general_registers[register_index_y];
+
+    if (get_quirks<policy>().logic_resets_vf)
+    {
+        _general_registers[0xF] = 0;
+    }
 }
 
 void ar::chip8::cpu::add_vy_to_vx()
@@ -437,10 +798,17 @@ void ar::chip8::cpu::sub_vy_from_vx()
     _general_registers[0xF] = (int16_t) (sub_res) >= 0x0;
 }
 
+template<typename policy>
 void ar::chip8::cpu::store_least_sig_vx()
 {
     ar_byte register_index_x = get_x_argument_from_opcode();
 
+    // COSMAC VIP shifts VY into VX
+    if (get_quirks<policy>().shift_uses_vy)
+    {
+        _general_registers[register_index_x] = _general_registers[get_y_argument_from_opcode()];
+    }
+
     // Store least significant bit in VF
     _general_registers[0xF] = (_general_registers[register_index_x] & 1) == 1;
 
@@ -461,10 +829,17 @@ void ar::chip8::cpu::set_vx_to_vy_sub_vx()
     _general_registers[0xF] = (int16_t) (sub_res) >= 0x0;
 }
 
+template<typename policy>
 void ar::chip8::cpu::store_most_sig_vx()
 {
     ar_byte register_index_x = get_x_argument_from_opcode();
 
+    // COSMAC VIP shifts VY into VX
+    if (get_quirks<policy>().shift_uses_vy)
+    {
+        _general_registers[register_index_x] = _general_registers[get_y_argument_from_opcode()];
+    }
+
     // Get most significant bit
     _general_registers[0xF] = (_general_registers[register_index_x] & 0b10000000) == 0b10000000;
 
@@ -472,6 +847,7 @@ void ar::chip8::cpu::store_most_sig_vx()
     _general_registers[register_index_x] <<= 1;
 }
 
+template<typename policy>
 void ar::chip8::cpu::skip_if_vx_neq_vy()
 {
     ar_byte register_index_x = get_x_argument_from_opcode();
@@ -479,8 +855,7 @@ void ar::chip8::cpu::skip_if_vx_neq_vy()
 
     if (_general_registers[register_index_x] != _general_registers[register_index_y])
     {
-        // Increment program counter again to skip next instruction
-        increment_program_counter();
+        skip_next_instruction<policy>();
     }
 }
 
@@ -489,22 +864,24 @@ void ar::chip8::cpu::set_i_to_nnn()
     _special_register_i = get_nnn_argument_from_opcode();
 }
 
+template<typename policy>
 void ar::chip8::cpu::jump_add_v0()
 {
+    // SUPER-CHIP reads the offset from VX where X is the highest digit of the address (0xBXNN)
+    ar_byte register_index = get_quirks<policy>().jump_uses_vx ? get_x_argument_from_opcode() : 0;
+
     // Absolute jump so just set PC
-    _special_register_pc = get_nnn_argument_from_opcode() + _general_registers[0];
+    _special_register_pc = get_nnn_argument_from_opcode() + _general_registers[register_index];
 }
 
 void ar::chip8::cpu::set_vx_to_rand_and_nn()
 {
     ar_byte register_index_x = get_x_argument_from_opcode();
 
-    // Seed the number generator, security doesn't matter so time is fine as a seed
-    srand(static_cast<unsigned>(time(nullptr)));
-
-    _general_registers[register_index_x] = (rand() % 0x100) & get_nn_argument_from_opcode();
+    _general_registers[register_index_x] = get_random_byte() & get_nn_argument_from_opcode();
 }
 
+template<typename policy>
 void ar::chip8::cpu::draw()
 {
     // Get draw coordinates from registers
@@ -515,31 +892,61 @@ void ar::chip8::cpu::draw()
     ar_byte sprite_height = get_n_argument_from_opcode();
 
     // Send job to the GPU
-    _general_registers[0xF] = _gpu_link.draw(draw_at_x, draw_at_y, sprite_height, _special_register_i);
+    if (get_quirks<policy>().clip_sprites)
+    {
+        _general_registers[0xF] = _gpu_link.draw<true>(draw_at_x, draw_at_y, sprite_height, _special_register_i);
+    }
+    else
+    {
+        _general_registers[0xF] = _gpu_link.draw<false>(draw_at_x, draw_at_y, sprite_height, _special_register_i);
+    }
 }
 
+template<typename policy>
 void ar::chip8::cpu::skip_if_vx_key_pressed()
 {
     auto key = static_cast<ar::chip8::key>(_general_registers[get_x_argument_from_opcode()]);
 
     if (_controller_link.is_key_pressed(key))
     {
-        // Skip next instruction
-        increment_program_counter();
+        skip_next_instruction<policy>();
     }
 }
 
+template<typename policy>
 void ar::chip8::cpu::skip_if_vx_key_not_pressed()
 {
     auto key = static_cast<ar::chip8::key>(_general_registers[get_x_argument_from_opcode()]);
 
     if (!_controller_link.is_key_pressed(key))
     {
-        // Skip next instruction
-        increment_program_counter();
+        skip_next_instruction<policy>();
     }
 }
 
+void ar::chip8::cpu::set_i_to_long_nnnn()
+{
+    // Address is the next 2 bytes, skip over them
+    _special_register_i = _ram_link.read_instruction(_special_register_pc);
+
+    increment_program_counter();
+}
+
+void ar::chip8::cpu::select_planes()
+{
+    _gpu_link.select_planes(get_x_argument_from_opcode());
+}
+
+void ar::chip8::cpu::load_audio_pattern_from_i()
+{
+    for (std::size_t i = 0; i < _audio_pattern.size(); i++)
+    {
+        _audio_pattern[i] = _ram_link.read(static_cast<uint16_t>(_special_register_i + i));
+    }
+
+    _audio_pattern_loaded = true;
+}
+
 void ar::chip8::cpu::set_vx_to_delay_timer()
 {
     ar_byte register_index_x = get_x_argument_from_opcode();
@@ -595,6 +1002,22 @@ void ar::chip8::cpu::set_i_to_sprite_location_for_vx()
     _special_register_i = _general_registers[register_index_x] * 5;
 }
 
+void ar::chip8::cpu::set_i_to_big_sprite_location_for_vx()
+{
+    ar_byte register_index_x = get_x_argument_from_opcode();
+    auto character           = static_cast<ar_byte>(_general_registers[register_index_x] & 0xF);
+
+    // Big font characters are 10 bytes each, there are only 16 of them
+    _special_register_i = static_cast<uint16_t>(ar::chip8::BIG_FONT_ADDRESS + character * 10);
+}
+
+void ar::chip8::cpu::set_audio_pitch_to_vx()
+{
+    ar_byte register_index_x = get_x_argument_from_opcode();
+
+    _audio_pitch = _general_registers[register_index_x];
+}
+
 void ar::chip8::cpu::store_vcx_bcd_at_i()
 {
     ar_byte register_index_x = get_x_argument_from_opcode();
@@ -606,6 +1029,7 @@ void ar::chip8::cpu::store_vcx_bcd_at_i()
     _ram_link.write(_special_register_i + 2, register_x_value % 10);
 }
 
+template<typename policy>
 void ar::chip8::cpu::dump_general_registers_at_i()
 {
     ar_byte x_arg = get_x_argument_from_opcode();
@@ -614,8 +1038,15 @@ void ar::chip8::cpu::dump_general_registers_at_i()
     {
         _ram_link.write(_special_register_i + i, _general_registers[i]);
     }
+
+    // COSMAC VIP incremented I while storing
+    if (get_quirks<policy>().load_store_increments_i)
+    {
+        _special_register_i = static_cast<uint16_t>(_special_register_i + x_arg + 1);
+    }
 }
 
+template<typename policy>
 void ar::chip8::cpu::fill_general_registers_from_i()
 {
     ar_byte x_arg = get_x_argument_from_opcode();
@@ -624,4 +1055,59 @@ void ar::chip8::cpu::fill_general_registers_from_i()
     {
         _general_registers[i] = _ram_link.read(_special_register_i + i);
     }
+
+    // COSMAC VIP incremented I while loading
+    if (get_quirks<policy>().load_store_increments_i)
+    {
+        _special_register_i = static_cast<uint16_t>(_special_register_i + x_arg + 1);
+    }
+}
+
+void ar::chip8::cpu::save_flag_registers()
+{
+    ar_byte x_arg = get_x_argument_from_opcode();
+
+    for (ar_byte i = 0; i <= x_arg; i++)
+    {
+        _flag_registers[i] = _general_registers[i];
+    }
+}
+
+void ar::chip8::cpu::restore_flag_registers()
+{
+    ar_byte x_arg = get_x_argument_from_opcode();
+
+    for (ar_byte i = 0; i <= x_arg; i++)
+    {
+        _general_registers[i] = _flag_registers[i];
+    }
 }
+
+/****************************************************************************************************
+ Policy instantiations
+****************************************************************************************************/
+
+/**
+ * @brief Instantiate 'cpu::tick' for a machine model and a quirk set with tracing and breakpoints on and off
+ * @param MODEL Machine model
+ * @param QUIRK_SET Quirk set
+ */
+#define AR_CHIP8_INSTANTIATE_TICK(MODEL, QUIRK_SET) \
+template void ar::chip8::cpu::tick<ar::chip8::cpu_policy<MODEL, QUIRK_SET, false, false> >(); \
+template void ar::chip8::cpu::tick<ar::chip8::cpu_policy<MODEL, QUIRK_SET, false, true> >(); \
+template void ar::chip8::cpu::tick<ar::chip8::cpu_policy<MODEL, QUIRK_SET, true, false> >(); \
+template void ar::chip8::cpu::tick<ar::chip8::cpu_policy<MODEL, QUIRK_SET, true, true> >();
+
+// Every policy 'emulator::set_cpu_configuration' can select
+AR_CHIP8_INSTANTIATE_TICK(ar::chip8::machine_model::chip8, ar::chip8::quirk_set::chip8)
+AR_CHIP8_INSTANTIATE_TICK(ar::chip8::machine_model::chip8, ar::chip8::quirk_set::cosmac_vip)
+AR_CHIP8_INSTANTIATE_TICK(ar::chip8::machine_model::chip8, ar::chip8::quirk_set::super_chip)
+AR_CHIP8_INSTANTIATE_TICK(ar::chip8::machine_model::chip8, ar::chip8::quirk_set::custom)
+AR_CHIP8_INSTANTIATE_TICK(ar::chip8::machine_model::super_chip, ar::chip8::quirk_set::chip8)
+AR_CHIP8_INSTANTIATE_TICK(ar::chip8::machine_model::super_chip, ar::chip8::quirk_set::cosmac_vip)
+AR_CHIP8_INSTANTIATE_TICK(ar::chip8::machine_model::super_chip, ar::chip8::quirk_set::super_chip)
+AR_CHIP8_INSTANTIATE_TICK(ar::chip8::machine_model::super_chip, ar::chip8::quirk_set::custom)
+AR_CHIP8_INSTANTIATE_TICK(ar::chip8::machine_model::xo_chip, ar::chip8::quirk_set::chip8)
+AR_CHIP8_INSTANTIATE_TICK(ar::chip8::machine_model::xo_chip, ar::chip8::quirk_set::cosmac_vip)
+AR_CHIP8_INSTANTIATE_TICK(ar::chip8::machine_model::xo_chip, ar::chip8::quirk_set::super_chip)
+AR_CHIP8_INSTANTIATE_TICK(ar::chip8::machine_model::xo_chip, ar::chip8::quirk_set::custom)
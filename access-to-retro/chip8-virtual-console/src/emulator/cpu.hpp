@@ -7,9 +7,14 @@
 
 #include <access-to-retro-dev/access-to-retro-dev.h>
 #include <array>
+#include <bitset>
 #include <stack>
+#include "beeper.hpp"
 #include "controller.hpp"
+#include "cpu-policy.hpp"
+#include "machine-model.hpp"
 #include "ram-memory.hpp"
+#include "state-hash.hpp"
 #include "gpu.hpp"
 
 namespace ar::chip8
@@ -17,6 +22,16 @@ namespace ar::chip8
     /// @brief Represents a number of general registers that CHIP8 cpu has
     constexpr std::size_t GENERAL_REGISTER_COUNT = 16;
 
+    class cpu;
+
+    /**
+     * @brief Called after every instruction by CPUs with tracing policy
+     * @param cpu CPU that executed the instruction, its encoded instruction is the executed one
+     * @param address Address of the executed instruction
+     * @param user_data Pointer given to 'set_trace_callback'
+     */
+    typedef void(* cpu_trace_callback)(const ar::chip8::cpu& cpu, uint16_t address, void* user_data);
+
     /// @brief Class representing CHIP8's CPU emulator
     class cpu
     {
@@ -32,9 +47,144 @@ namespace ar::chip8
         /// @brief Indicate that timers should be updated (should update at 60hz)
         void tick_timers();
 
-        /// @brief Fetch - decode - execute a single instruction (should run at 600hz [cpu clock speed])
+        /**
+         * @brief Fetch - decode - execute a single instruction (should run at 600hz [cpu clock speed])
+         * @details Runs with the default policy, CHIP8 without quirks.
+         */
+        void tick();
+
+        /**
+         * @brief Fetch - decode - execute a single instruction with given policy
+         * @details Instantiated in 'cpu.cpp' for every policy 'emulator::set_cpu_configuration' can select.
+         * @tparam policy CPU policy, see 'ar::chip8::cpu_policy'
+         */
+        template<typename policy>
         void tick();
 
+        /**
+         * @brief Get quirks instructions run with
+         * @tparam policy CPU policy
+         * @return Policy's quirks, or the ones set by 'set_custom_quirks' for policies with runtime quirks
+         */
+        template<typename policy>
+        [[nodiscard]] const ar::chip8::cpu_quirks& get_quirks() const
+        {
+            if constexpr (policy::RUNTIME_QUIRKS)
+            {
+                return _custom_quirks;
+            }
+            else
+            {
+                return policy::QUIRKS;
+            }
+        }
+
+        /**
+         * @brief Set quirks used by policies with runtime quirks
+         * @param quirks Quirks expected by the game
+         */
+        void set_custom_quirks(const ar::chip8::cpu_quirks& quirks);
+
+        /**
+         * @brief Set machine the CPU emulates, extended instructions only run on machines that have them
+         * @param model Machine model
+         */
+        void set_machine_model(ar::chip8::machine_model model);
+
+        /**
+         * @brief Getter for machine model
+         * @return Machine the CPU emulates
+         */
+        [[nodiscard]] ar::chip8::machine_model get_machine_model() const;
+
+        /**
+         * @brief Set function called after every instruction by CPUs with tracing policy
+         * @param callback Function to call, nullptr to stop calling it
+         * @param user_data Pointer passed to the callback
+         */
+        void set_trace_callback(ar::chip8::cpu_trace_callback callback, void* user_data);
+
+        /**
+         * @brief Set or remove a breakpoint, CPUs with breakpoints policy halt before executing its instruction
+         * @param address Address of the instruction
+         * @param enabled Whether the breakpoint is set
+         */
+        void set_breakpoint(uint16_t address, bool enabled);
+
+        /// @brief Remove all breakpoints
+        void clear_breakpoints();
+
+        /**
+         * @brief Check whether the CPU has halted at a breakpoint, halted CPU does not execute any instructions
+         * @return Whether the CPU is halted
+         */
+        [[nodiscard]] bool is_halted() const;
+
+        /// @brief Continue after a breakpoint, instruction at the breakpoint is executed by the next tick
+        void resume();
+
+        /**
+         * @brief Check whether the beep should sound
+         * @return Whether sound timer is above 0
+         */
+        [[nodiscard]] bool is_sound_timer_active() const;
+
+        /**
+         * @brief Check whether an XO-CHIP game has loaded its own audio pattern, beeper plays a square wave otherwise
+         * @return Whether the audio pattern was loaded (0xF002)
+         */
+        [[nodiscard]] bool is_audio_pattern_loaded() const;
+
+        /**
+         * @brief Getter for XO-CHIP's audio pattern
+         * @return 128 one bit samples, the first one is the top bit of the first byte
+         */
+        [[nodiscard]] const std::array<ar_byte, ar::chip8::AUDIO_PATTERN_SIZE>& get_audio_pattern() const;
+
+        /**
+         * @brief Getter for XO-CHIP's audio pitch
+         * @return Pitch set by 0xFX3A
+         */
+        [[nodiscard]] ar_byte get_audio_pitch() const;
+
+        /**
+         * @brief Getter for program counter
+         * @return Address of the next instruction
+         */
+        [[nodiscard]] uint16_t get_program_counter() const;
+
+        /**
+         * @brief Getter for last fetched instruction
+         * @return Last encoded instruction (opcode)
+         */
+        [[nodiscard]] uint16_t get_encoded_instruction() const;
+
+        /**
+         * @brief Getter for general registers
+         * @return V0 - VF
+         */
+        [[nodiscard]] const std::array<ar_byte, ar::chip8::GENERAL_REGISTER_COUNT>& get_general_registers() const;
+
+        /**
+         * @brief Getter for address register
+         * @return Value of I
+         */
+        [[nodiscard]] uint16_t get_address_register() const;
+
+        /**
+         * @brief Seed random number generator used by 0xCXNN, lets golden tests run the same way every time
+         * @param seed New seed, 0 is replaced with 1 (generator would only return zeros)
+         */
+        void set_random_seed(uint32_t seed);
+
+        /**
+         * @brief Continue state hash with registers, timers and call stack
+         * @details SUPER-CHIP and XO-CHIP state (flag registers, audio) is only hashed on those machines.
+         * @param hash Hash so far
+         * @return Updated hash
+         */
+        [[nodiscard]] uint64_t hash_state(uint64_t hash) const;
+
     private:
         /// @brief Reference to GPU so that CPU can access and control it
         ar::chip8::gpu& _gpu_link;
@@ -51,6 +201,9 @@ namespace ar::chip8
         /// @brief Last encoded instruction (opcode)
         uint16_t _encoded_instruction = 0x0000;
 
+        /// @brief Machine the CPU emulates
+        ar::chip8::machine_model _model = ar::chip8::machine_model::chip8;
+
         // ****************** Registers ******************
 
         /// @brief General registers, used by game developers for anything they want, they are also called V0...VF
@@ -73,15 +226,69 @@ namespace ar::chip8
         /// @brief Counts down at 60hz until 0. Used by games to time events, can be set and read by instructions
         ar_byte _delay_timer = 0x00;
 
+        /// @brief State of xorshift random number generator, seeded with current time unless set
+        uint32_t _random_state = 1;
+
+        // ****************** Extensions ******************
+
+        /// @brief SUPER-CHIP's flag registers (RPL), saved and restored by 0xFX75 and 0xFX85
+        std::array<ar_byte, ar::chip8::GENERAL_REGISTER_COUNT> _flag_registers { 0 };
+
+        /// @brief XO-CHIP's audio pattern, loaded by 0xF002
+        std::array<ar_byte, ar::chip8::AUDIO_PATTERN_SIZE> _audio_pattern { 0 };
+
+        /// @brief XO-CHIP's audio pitch, set by 0xFX3A
+        ar_byte _audio_pitch = ar::chip8::DEFAULT_AUDIO_PITCH;
+
+        /// @brief Whether the audio pattern was loaded
+        bool _audio_pattern_loaded = false;
+
+        // ****************** Debugging ******************
+
+        /// @brief Quirks used by policies with runtime quirks
+        ar::chip8::cpu_quirks _custom_quirks {};
+
+        /// @brief Function called after every instruction by CPUs with tracing policy
+        ar::chip8::cpu_trace_callback _trace_callback = nullptr;
+
+        /// @brief Pointer passed to the trace callback
+        void* _trace_user_data = nullptr;
+
+        /// @brief Addresses of instructions the CPU halts at
+        std::bitset<ar::chip8::XO_CHIP_RAM_SIZE> _breakpoints {};
+
+        /// @brief Whether the CPU has halted at a breakpoint
+        bool _halted = false;
+
+        /// @brief Whether the next tick executes the instruction at a breakpoint instead of halting again
+        bool _resuming = false;
+
+        /**
+         * @brief Get next random byte
+         * @return Random byte
+         */
+        [[nodiscard]] ar_byte get_random_byte();
+
         // ****************** CPU Tick Functions ******************
 
         /// @brief Increments program counter to the next instruction after fetch has completed
         void increment_program_counter();
 
+        /**
+         * @brief Skip the next instruction, XO-CHIP's 0xF000 NNNN is 4 bytes long so it is skipped whole
+         * @tparam policy CPU policy, only XO-CHIP looks at the next instruction
+         */
+        template<typename policy>
+        void skip_next_instruction();
+
         /// @brief Fetch parth of fetch - decode - execute loop
         void fetch();
 
-        /// @brief Decode and execute part of fetch - decode - execute loop
+        /**
+         * @brief Decode and execute part of fetch - decode - execute loop
+         * @tparam policy CPU policy, its quirks are compiled into the instructions
+         */
+        template<typename policy>
         void decode_and_execute();
 
         /******************* Instructions Functions *******************/
@@ -121,6 +328,9 @@ namespace ar::chip8
         /// @brief Opcode 0x00E0 -> Send clear screen job to GPU
         void clear_screen();
 
+        /// @brief Opcodes 0x00CN, 0x00DN, 0x00FB - 0x00FF -> SUPER-CHIP and XO-CHIP scrolling and resolution
+        void execute_screen_instruction();
+
         /// @brief Opcode 0x00EE -> Return from a function
         void fn_return();
 
@@ -131,14 +341,23 @@ namespace ar::chip8
         void fn_call();
 
         /// @brief Opcode 0x3XNN -> Skip next instruction if value in if VX == NN
+        template<typename policy>
         void skip_if_vx_eq_nn();
 
         /// @brief Opcode 0x4XNN -> Skip next instruction if value in VX != NN
+        template<typename policy>
         void skip_if_vx_neq_nn();
 
         /// @brief Opcode 0x5XN0 -> Skip next instruction if value in VX == value in VY
+        template<typename policy>
         void skip_if_vx_eq_vy();
 
+        /// @brief Opcode 0x5XY2 -> XO-CHIP: Dump values in general registers from VX to VY at address in I
+        void dump_vx_to_vy_at_i();
+
+        /// @brief Opcode 0x5XY3 -> XO-CHIP: Restore values of general registers from VX to VY from address in I
+        void fill_vx_to_vy_from_i();
+
         /// @brief Opcode 0x6XNN -> Set VX to NN
         void set_vx_to_nn();
 
@@ -149,12 +368,15 @@ namespace ar::chip8
         void set_vx_to_vy();
 
         /// @brief Opcode 0x8XY1 -> Set VX to VX | VY
+        template<typename policy>
         void set_vx_to_vx_or_vy();
 
         /// @brief Opcode 0x8XY2 -> Set VX to VX & VY
+        template<typename policy>
         void set_vx_to_vx_and_vy();
 
         /// @brief Opcode 0x8XY3 -> Set VX to VX ~ VY
+        template<typename policy>
         void set_vx_to_vx_xor_vy();
 
         /// @brief Opcode 0x8XY4 -> Add value in VY to VX
@@ -164,35 +386,51 @@ namespace ar::chip8
         void sub_vy_from_vx();
 
         /// @brief Opcode 0x8XY6 -> Store least significant bit from value in VX in VF and shift VX to the right by 1
+        template<typename policy>
         void store_least_sig_vx();
 
         /// @brief Opcode 0x8XY7 -> Set VX to value in VY minus value in VX
         void set_vx_to_vy_sub_vx();
 
         /// @brief Opcode 0x8XYE -> Store most significant bit from value in VX in VF and shift VX to the left by 1
+        template<typename policy>
         void store_most_sig_vx();
 
         /// @brief Opcode 0x9XY0 -> Skip next instruction if value in VX != value in VY
+        template<typename policy>
         void skip_if_vx_neq_vy();
 
         /// @brief Opcode 0xANNN -> Set special register I to NNN
         void set_i_to_nnn();
 
         /// @brief Opcode 0xBNNN -> Jump to address (NNN + value in V0)
+        template<typename policy>
         void jump_add_v0();
 
         /// @brief Opcode 0xCXNN -> Set VX to NN & Random number
         void set_vx_to_rand_and_nn();
 
         /// @brief Opcode 0xDXYN -> Send draw job to GPU
+        template<typename policy>
         void draw();
 
         /// @brief Opcode 0xEX9E -> Skip next instruction if key with index stored in VX is pressed
+        template<typename policy>
         void skip_if_vx_key_pressed();
 
         /// @brief Opcode 0xEXA1 -> SKip next instruction if key with index stored in VX is NOT pressed
+        template<typename policy>
         void skip_if_vx_key_not_pressed();
 
+        /// @brief Opcode 0xF000 NNNN -> XO-CHIP: Set special register I to the 16-bit address NNNN
+        void set_i_to_long_nnnn();
+
+        /// @brief Opcode 0xFN01 -> XO-CHIP: Select planes N for drawing, clearing and scrolling
+        void select_planes();
+
+        /// @brief Opcode 0xF002 -> XO-CHIP: Load audio pattern from memory starting at address in I
+        void load_audio_pattern_from_i();
+
         /// @brief Opcode 0xFX07 -> Set VX to value of delay timer
         void set_vx_to_delay_timer();
 
@@ -211,14 +449,28 @@ namespace ar::chip8
         /// @brief Opcode 0xFX29 -> Set I to location of the sprite for the font character with index stored in VX
         void set_i_to_sprite_location_for_vx();
 
+        /// @brief Opcode 0xFX30 -> SUPER-CHIP: Set I to location of the big font character with index stored in VX
+        void set_i_to_big_sprite_location_for_vx();
+
+        /// @brief Opcode 0xFX3A -> XO-CHIP: Set audio pitch to value in VX
+        void set_audio_pitch_to_vx();
+
         /// @brief Opcode 0xFX33 -> Stored binary-coded decimal representation of value in VX at address in I
         void store_vcx_bcd_at_i();
 
         /// @brief Opcode 0xFX55 -> Dump values in general registers from V0 to VX to memory starting at address in I
+        template<typename policy>
         void dump_general_registers_at_i();
 
         /// @brief Opcode 0xFX65 -> Restore values from general registers from V0 to VX from memory starting at I
+        template<typename policy>
         void fill_general_registers_from_i();
+
+        /// @brief Opcode 0xFX75 -> SUPER-CHIP: Save values of general registers from V0 to VX to flag registers
+        void save_flag_registers();
+
+        /// @brief Opcode 0xFX85 -> SUPER-CHIP: Restore values of general registers from V0 to VX from flag registers
+        void restore_flag_registers();
     };
 }
 
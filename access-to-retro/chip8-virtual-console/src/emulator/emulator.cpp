@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <memory>
 #include "emulator.hpp"
 
@@ -39,3 +40,112 @@ ar::chip8::controller& ar::chip8::emulator::access_controller()
 {
     return _controller;
 }
+
+ar::chip8::beeper& ar::chip8::emulator::access_beeper()
+{
+    return _beeper;
+}
+
+void ar::chip8::emulator::set_cpu_configuration(const ar::chip8::cpu_configuration& configuration)
+{
+    _cpu.set_custom_quirks(configuration.quirks);
+    _cpu_configuration = configuration;
+
+    select_cpu_policy();
+}
+
+void ar::chip8::emulator::set_machine_model(ar::chip8::machine_model model)
+{
+    _cpu.set_machine_model(model);
+    _gpu.set_machine_model(model);
+
+    _ram.set_size(model == ar::chip8::machine_model::xo_chip ? ar::chip8::XO_CHIP_RAM_SIZE : ar::chip8::RAM_SIZE);
+
+    if (model != ar::chip8::machine_model::chip8)
+    {
+        _ram.load_big_font();
+    }
+
+    select_cpu_policy();
+}
+
+void ar::chip8::emulator::select_cpu_policy()
+{
+    switch (_cpu.get_machine_model())
+    {
+        case ar::chip8::machine_model::super_chip:
+            select_quirk_set<ar::chip8::machine_model::super_chip>();
+            break;
+
+        case ar::chip8::machine_model::xo_chip:
+            select_quirk_set<ar::chip8::machine_model::xo_chip>();
+            break;
+
+        case ar::chip8::machine_model::chip8:
+        default:
+            select_quirk_set<ar::chip8::machine_model::chip8>();
+            break;
+    }
+}
+
+void ar::chip8::emulator::analyze_rom()
+{
+    _rom_analysis.analyze(_ram, _cpu.get_machine_model());
+}
+
+const ar::chip8::rom_analysis& ar::chip8::emulator::get_rom_analysis() const
+{
+    return _rom_analysis;
+}
+
+void ar::chip8::emulator::set_clock_speed(uint32_t clock_speed)
+{
+    clock_speed = std::max(clock_speed, 1u);
+
+    // Phase is counted in cycles of the old clock speed, rescale it to keep how much of the timer tick passed
+    _timer_phase = static_cast<uint32_t>(static_cast<uint64_t>(_timer_phase) * clock_speed / _clock_speed);
+    _clock_speed = clock_speed;
+}
+
+uint32_t ar::chip8::emulator::get_clock_speed() const
+{
+    return _clock_speed;
+}
+
+void ar::chip8::emulator::run_frame()
+{
+    // Policy is selected once, each frame only costs a single indirect call
+    (this->*_run_frame_fn)();
+}
+
+uint64_t ar::chip8::emulator::get_cycle_count() const
+{
+    return _cycle_count;
+}
+
+uint64_t ar::chip8::emulator::get_state_hash()
+{
+    uint64_t hash = ar::chip8::STATE_HASH_BASIS;
+
+    hash = _cpu.hash_state(hash);
+    hash = _ram.hash_state(hash);
+
+    return _gpu.hash_state(hash);
+}
+
+void ar::chip8::emulator::tick_timers()
+{
+    // XO-CHIP games can replace the square wave with their own pattern at any time
+    if (_cpu.is_audio_pattern_loaded())
+    {
+        _beeper.set_pattern(_cpu.get_audio_pattern(), _cpu.get_audio_pitch());
+    }
+
+    // Beep for the whole timer tick if sound timer is still running
+    _beeper.tick(_cpu.is_sound_timer_active());
+
+    _cpu.tick_timers();
+
+    // COSMAC VIP ticks timers in its vertical blank interrupt, game waiting for it can continue
+    _waiting_for_vblank = false;
+}
@@ -10,8 +10,10 @@
 #include "frame-buffer.hpp"
 #include "controller.hpp"
 #include "ram-memory.hpp"
+#include "beeper.hpp"
 #include "gpu.hpp"
 #include "cpu.hpp"
+#include "rom-analysis.hpp"
 
 /// @brief Root namespace of the project
 namespace ar::chip8
@@ -22,9 +24,16 @@ namespace ar::chip8
     /// @brief CHIP8's Frame time (time per each frame shown in milliseconds)
     constexpr double FRAME_TIME = (1 / static_cast<double>(FRAME_RATE)) * 1000;
 
-    /// @brief CHIP8's clock speed (600 hz)
+    /// @brief CHIP8's default clock speed (600 hz), games in the ROM database can run faster or slower
     constexpr uint32_t CLOCK_SPEED = 600;
 
+    /**
+     * @brief Number of instructions executed per frame at the default clock speed
+     * @details Clock speed is how many instructions are executed per second and frame rate is how many frames are
+     *          shown per second, so for frame rate of 60 and clock speed of 600hz it's 600 / 60 = 10.
+     */
+    constexpr uint32_t INSTRUCTIONS_PER_FRAME = CLOCK_SPEED / FRAME_RATE;
+
     /// @brief Main emulator object
     class emulator
     {
@@ -64,6 +73,147 @@ namespace ar::chip8
          */
         [[nodiscard]] ar::chip8::ram_memory& access_ram();
 
+        /**
+         * @brief Getter for beeper object
+         * @return Emulator's beeper object
+         */
+        [[nodiscard]] ar::chip8::beeper& access_beeper();
+
+        /**
+         * @brief Select CPU policy matching the configuration and the machine model, used by 'run_frame' from now on
+         * @details Quirk sets with their own policy are compiled into the instructions, other combinations of quirks
+         *          are checked by each instruction at runtime. Machine model is always compiled in.
+         * @param configuration CPU configuration
+         */
+        void set_cpu_configuration(const ar::chip8::cpu_configuration& configuration);
+
+        /**
+         * @brief Set machine the game was written for, has to be called before the game is loaded
+         * @details Sets memory size and extended instructions of CPU and GPU, SUPER-CHIP and XO-CHIP also get the big
+         *          font loaded. CPU policy of the model is selected with the current CPU configuration.
+         * @param model Machine model
+         */
+        void set_machine_model(ar::chip8::machine_model model);
+
+        /**
+         * @brief Analyse the loaded game, has to be called after the game is loaded
+         * @details Runs once when the game loads, before its first instruction. The result is kept for disassembly
+         *          views and tools, the interpreter still decodes each instruction when it executes it.
+         */
+        void analyze_rom();
+
+        /**
+         * @brief Getter for static analysis of the loaded game
+         * @return Analysis made by the last 'analyze_rom', empty before the first one
+         */
+        [[nodiscard]] const ar::chip8::rom_analysis& get_rom_analysis() const;
+
+        /**
+         * @brief Set number of instructions executed per second, can be changed between frames while the game runs
+         * @details Timers keep ticking at 60 hz of emulated time, the part of the current timer tick that already
+         *          passed is kept.
+         * @param clock_speed Clock speed in hz, at least 1
+         */
+        void set_clock_speed(uint32_t clock_speed);
+
+        /**
+         * @brief Get number of instructions executed per second
+         * @return Clock speed in hz
+         */
+        [[nodiscard]] uint32_t get_clock_speed() const;
+
+        /**
+         * @brief Emulate a single frame: execute a frame worth of CPU cycles, tick beeper and timers and present the
+         *        screen if it changed
+         * @details Each frame adds clock speed / frame rate cycles to the budget, the fraction of a cycle that is left
+         *          over is carried to the next frame so any clock speed is kept exactly on average. Timers tick on
+         *          their own 60 hz schedule counted in cycles (emulated time), not once per frame, so they stay
+         *          correct whatever the clock speed is.
+         * @param on_instruction Called after each executed instruction, lets tests inspect the state without slowing
+         *                       down normal runs (empty function is inlined away)
+         * @tparam policy CPU policy the instructions are executed with
+         */
+        template<typename policy = ar::chip8::default_cpu_policy, typename instruction_callback>
+        void run_frame(instruction_callback&& on_instruction)
+        {
+            // Budget is counted in 1 / frame rate of a cycle, whatever does not make a whole cycle waits for next frame
+            _cycle_budget += _clock_speed;
+
+            uint32_t cycles = _cycle_budget / ar::chip8::FRAME_RATE;
+            _cycle_budget %= ar::chip8::FRAME_RATE;
+
+            for (uint32_t i = 0; i < cycles; i++)
+            {
+                if constexpr (policy::TRACING)
+                {
+                    _cycle_count++;
+                }
+
+                // CPU idles while it waits for the vertical blank, timers keep running
+                if (!_waiting_for_vblank)
+                {
+                    // Execute one instruction (one cpu tick)
+                    _cpu.tick<policy>();
+
+                    if constexpr (policy::BREAKPOINTS)
+                    {
+                        // Whole machine stops at a breakpoint, including timers, until the CPU is resumed
+                        if (_cpu.is_halted())
+                        {
+                            return;
+                        }
+                    }
+
+                    on_instruction();
+
+                    // Sprite drawing waits for the vertical blank, which comes with the next timer tick
+                    if (_cpu.get_quirks<policy>().wait_for_vblank &&
+                        (_cpu.get_encoded_instruction() & 0xF000) == 0xD000)
+                    {
+                        _waiting_for_vblank = true;
+                    }
+                }
+
+                // Timer tick is due every clock speed / 60 cycles, counted in 1 / clock speed of a timer tick
+                _timer_phase += ar::chip8::TIMER_FREQUENCY;
+
+                while (_timer_phase >= _clock_speed)
+                {
+                    _timer_phase -= _clock_speed;
+                    tick_timers();
+                }
+            }
+
+            /*
+             * Present at the end of the frame, on the same thread that draws. Presenting only flips library's frame
+             * buffer so it never waits for the screen, frontend's present thread shows the frame.
+             */
+            if (_gpu.get_draw_flag())
+            {
+                _gpu.render();
+
+                // Let emulator know rendering happened (clear CPU's draw flag)
+                _gpu.set_draw_flag(false);
+            }
+        }
+
+        /// @brief Emulate a single frame without inspecting instructions, with policy selected by the configuration
+        void run_frame();
+
+        /**
+         * @brief Get number of emulated cycles, numbers instructions in traces
+         * @details Only frame loops with tracing policy count cycles, cycles the CPU waits for the vertical blank are
+         *          counted too.
+         * @return Cycles emulated with tracing policy
+         */
+        [[nodiscard]] uint64_t get_cycle_count() const;
+
+        /**
+         * @brief Hash whole machine state (CPU, RAM and screen), equal hashes mean the emulator behaves the same
+         * @return 64-bit FNV-1a hash of the state
+         */
+        [[nodiscard]] uint64_t get_state_hash();
+
     private:
         /// @brief Object emulating CHIP8's controller
         ar::chip8::controller _controller {};
@@ -76,6 +226,105 @@ namespace ar::chip8
 
         /// @brief Object emulating CHIP8's CPU
         ar::chip8::cpu _cpu;
+
+        /// @brief Object emulating CHIP8's buzzer
+        ar::chip8::beeper _beeper {};
+
+        /// @brief Code, data and basic blocks of the loaded game
+        ar::chip8::rom_analysis _rom_analysis {};
+
+        /// @brief Instructions executed per second
+        uint32_t _clock_speed = ar::chip8::CLOCK_SPEED;
+
+        /// @brief Fraction of a cycle carried over from the previous frame, in 1 / frame rate of a cycle
+        uint32_t _cycle_budget = 0;
+
+        /// @brief Time since the last timer tick, in 1 / clock speed of a timer tick
+        uint32_t _timer_phase = 0;
+
+        /// @brief Cycles emulated by frame loops with tracing policy
+        uint64_t _cycle_count = 0;
+
+        /// @brief Whether the CPU waits for the vertical blank (next timer tick) before executing next instruction
+        bool _waiting_for_vblank = false;
+
+        /// @brief CPU configuration the frame loop was selected with, selected again when machine model changes
+        ar::chip8::cpu_configuration _cpu_configuration {};
+
+        /// @brief Tick delay and sound timers and the beeper, each tick is also the vertical blank
+        void tick_timers();
+
+        /// @brief Select frame loop of the machine model and the CPU configuration
+        void select_cpu_policy();
+
+        /// @brief Frame loop instantiated for the selected CPU policy
+        void (ar::chip8::emulator::* _run_frame_fn)() = &ar::chip8::emulator::run_frame_with_policy<
+                ar::chip8::default_cpu_policy>;
+
+        /**
+         * @brief Emulate a single frame with given CPU policy
+         * @tparam policy CPU policy
+         */
+        template<typename policy>
+        void run_frame_with_policy()
+        {
+            run_frame<policy>([] {});
+        }
+
+        /**
+         * @brief Select frame loop of a machine model with quirk set of the CPU configuration
+         * @tparam model Machine model
+         */
+        template<ar::chip8::machine_model model>
+        void select_quirk_set()
+        {
+            bool tracing     = _cpu_configuration.tracing;
+            bool breakpoints = _cpu_configuration.breakpoints;
+
+            switch (ar::chip8::find_quirk_set(_cpu_configuration.quirks))
+            {
+                case ar::chip8::quirk_set::chip8:
+                    select_run_frame<model, ar::chip8::quirk_set::chip8>(tracing, breakpoints);
+                    break;
+
+                case ar::chip8::quirk_set::cosmac_vip:
+                    select_run_frame<model, ar::chip8::quirk_set::cosmac_vip>(tracing, breakpoints);
+                    break;
+
+                case ar::chip8::quirk_set::super_chip:
+                    select_run_frame<model, ar::chip8::quirk_set::super_chip>(tracing, breakpoints);
+                    break;
+
+                case ar::chip8::quirk_set::custom:
+                default:
+                    select_run_frame<model, ar::chip8::quirk_set::custom>(tracing, breakpoints);
+                    break;
+            }
+        }
+
+        /**
+         * @brief Select frame loop of a machine model and a quirk set
+         * @param tracing Whether the CPU calls trace callback
+         * @param breakpoints Whether the CPU halts at breakpoints
+         * @tparam model Machine model
+         * @tparam quirks Quirk set
+         */
+        template<ar::chip8::machine_model model, ar::chip8::quirk_set quirks>
+        void select_run_frame(bool tracing, bool breakpoints)
+        {
+            if (tracing)
+            {
+                _run_frame_fn = breakpoints
+                                ? &emulator::run_frame_with_policy<cpu_policy<model, quirks, true, true> >
+                                : &emulator::run_frame_with_policy<cpu_policy<model, quirks, true, false> >;
+            }
+            else
+            {
+                _run_frame_fn = breakpoints
+                                ? &emulator::run_frame_with_policy<cpu_policy<model, quirks, false, true> >
+                                : &emulator::run_frame_with_policy<cpu_policy<model, quirks, false, false> >;
+            }
+        }
     };
 }
 
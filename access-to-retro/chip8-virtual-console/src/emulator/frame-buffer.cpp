@@ -1,41 +1,126 @@
+#include <algorithm>
 #include "frame-buffer.hpp"
 
-ar::chip8::frame_buffer::frame_buffer()
+void ar::chip8::frame_buffer::clear(ar_byte planes)
 {
-    clear();
+    for (uint32_t plane = 0; plane < ar::chip8::PLANE_COUNT; plane++)
+    {
+        if ((planes & (1 << plane)) != 0)
+        {
+            _planes[plane].fill({});
+        }
+    }
+}
+
+void ar::chip8::frame_buffer::set_high_resolution(bool high_resolution)
+{
+    _high_resolution = high_resolution;
+
+    // Rows of the other resolution mean nothing in this one
+    clear(0xFF);
+}
+
+bool ar::chip8::frame_buffer::is_high_resolution() const
+{
+    return _high_resolution;
 }
 
-void ar::chip8::frame_buffer::clear()
+uint32_t ar::chip8::frame_buffer::get_width() const
 {
-    for (uint32_t i = 0; i < (ar::chip8::SCREEN_RESOLUTION_X * ar::chip8::SCREEN_RESOLUTION_Y); i++)
+    return _high_resolution ? ar::chip8::HIGH_RESOLUTION_X : ar::chip8::SCREEN_RESOLUTION_X;
+}
+
+uint32_t ar::chip8::frame_buffer::get_height() const
+{
+    return _high_resolution ? ar::chip8::HIGH_RESOLUTION_Y : ar::chip8::SCREEN_RESOLUTION_Y;
+}
+
+void ar::chip8::frame_buffer::scroll_down(ar_byte planes, uint32_t rows)
+{
+    uint32_t height = get_height();
+    rows = std::min(rows, height);
+
+    for (uint32_t plane = 0; plane < ar::chip8::PLANE_COUNT; plane++)
     {
-        _raw_pixels[i] = ar_pixel { 0, 0, 0, 255 };
+        if ((planes & (1 << plane)) != 0)
+        {
+            auto begin = _planes[plane].begin();
+
+            std::copy_backward(begin, begin + (height - rows), begin + height);
+            std::fill(begin, begin + rows, ar::chip8::pixel_row {});
+        }
     }
 }
 
-void ar::chip8::frame_buffer::flip_pixel_channels(unsigned x, unsigned y)
+void ar::chip8::frame_buffer::scroll_up(ar_byte planes, uint32_t rows)
 {
-    ar_pixel& target_pixel = get_pixel_at(x, y);
+    uint32_t height = get_height();
+    rows = std::min(rows, height);
 
-    // Flip value of each colour channel
-    target_pixel.r = target_pixel.r == PIXEL_TURNED_ON_CHANNEL_VALUE ? PIXEL_TURNED_OFF_CHANNEL_VALUE
-                                                                     : PIXEL_TURNED_ON_CHANNEL_VALUE;
-    target_pixel.g = target_pixel.g == PIXEL_TURNED_ON_CHANNEL_VALUE ? PIXEL_TURNED_OFF_CHANNEL_VALUE
-                                                                     : PIXEL_TURNED_ON_CHANNEL_VALUE;
-    target_pixel.b = target_pixel.b == PIXEL_TURNED_ON_CHANNEL_VALUE ? PIXEL_TURNED_OFF_CHANNEL_VALUE
-                                                                     : PIXEL_TURNED_ON_CHANNEL_VALUE;
+    for (uint32_t plane = 0; plane < ar::chip8::PLANE_COUNT; plane++)
+    {
+        if ((planes & (1 << plane)) != 0)
+        {
+            auto begin = _planes[plane].begin();
+
+            std::copy(begin + rows, begin + height, begin);
+            std::fill(begin + (height - rows), begin + height, ar::chip8::pixel_row {});
+        }
+    }
 }
 
-ar_pixel& ar::chip8::frame_buffer::get_pixel_at(unsigned x, unsigned y)
+void ar::chip8::frame_buffer::scroll_right(ar_byte planes, uint32_t pixels)
 {
-    std::size_t index = (y % ar::chip8::SCREEN_RESOLUTION_Y) *
-                        ar::chip8::SCREEN_RESOLUTION_X + (x % ar::chip8::SCREEN_RESOLUTION_X);
+    if (pixels == 0)
+    {
+        return;
+    }
 
-    return _raw_pixels.at(index);
+    for (uint32_t plane = 0; plane < ar::chip8::PLANE_COUNT; plane++)
+    {
+        if ((planes & (1 << plane)) == 0)
+        {
+            continue;
+        }
+
+        // Whole row is a single 64/128-bit shift, pixels leaving 'left' move into 'right'
+        for (ar::chip8::pixel_row& row : _planes[plane])
+        {
+            if (_high_resolution)
+            {
+                row.right = (row.right >> pixels) | (row.left << (64 - pixels));
+            }
+
+            row.left >>= pixels;
+        }
+    }
+}
+
+void ar::chip8::frame_buffer::scroll_left(ar_byte planes, uint32_t pixels)
+{
+    if (pixels == 0)
+    {
+        return;
+    }
+
+    for (uint32_t plane = 0; plane < ar::chip8::PLANE_COUNT; plane++)
+    {
+        if ((planes & (1 << plane)) == 0)
+        {
+            continue;
+        }
+
+        // Pixels leaving 'right' move into 'left', low resolution has nothing in 'right'
+        for (ar::chip8::pixel_row& row : _planes[plane])
+        {
+            row.left = (row.left << pixels) | (row.right >> (64 - pixels));
+            row.right <<= pixels;
+        }
+    }
 }
 
-std::array<ar_pixel, ar::chip8::SCREEN_RESOLUTION_X * ar::chip8::SCREEN_RESOLUTION_Y>&
-ar::chip8::frame_buffer::get_pixels()
+const std::array<ar::chip8::pixel_row, ar::chip8::HIGH_RESOLUTION_Y>& ar::chip8::frame_buffer::get_plane(
+        uint32_t plane) const
 {
-    return _raw_pixels;
+    return _planes[plane];
 }
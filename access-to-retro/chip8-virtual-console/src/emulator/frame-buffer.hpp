@@ -13,46 +13,158 @@ namespace ar::chip8
     /// @brief CHIP8's screen resolution height
     constexpr uint32_t SCREEN_RESOLUTION_Y = 32;
 
-    /// @brief Value of colour channels when pixel is turned off
-    constexpr ar_byte PIXEL_TURNED_OFF_CHANNEL_VALUE = 0x00;
+    /// @brief SUPER-CHIP's high resolution width
+    constexpr uint32_t HIGH_RESOLUTION_X = 128;
 
-    /// @brief Value of colour channels when pixel is turned on
-    constexpr ar_byte PIXEL_TURNED_ON_CHANNEL_VALUE = 0xFF;
+    /// @brief SUPER-CHIP's high resolution height
+    constexpr uint32_t HIGH_RESOLUTION_Y = 64;
 
-    /// @brief Represents a CHIP8's internal frame buffer object
+    /// @brief Number of bit planes, only XO-CHIP draws into the second one
+    constexpr uint32_t PLANE_COUNT = 2;
+
+    /// @brief Row of up to 128 pixels, one bit per pixel, leftmost pixel is the top bit of 'left'
+    struct pixel_row
+    {
+        /// @brief Pixels 0 - 63, the whole row in low resolution
+        uint64_t left;
+
+        /// @brief Pixels 64 - 127, always empty in low resolution
+        uint64_t right;
+    };
+
+    /**
+     * @brief Represents a CHIP8's internal frame buffer object
+     * @details Each plane is an array of packed rows, so a sprite row is drawn with a single XOR (and its collision
+     *          is a single AND) and scrolling moves whole rows. Low resolution (64x32) uses the first 32 rows and
+     *          only 'left' half of them.
+     */
     class frame_buffer
     {
     public:
-        frame_buffer();
+        /**
+         * @brief Clear bit planes
+         * @param planes Mask of planes to clear, bit 0 is the first plane
+         */
+        void clear(ar_byte planes);
+
+        /**
+         * @brief Switch between low (64x32) and high (128x64) resolution, clears the whole screen
+         * @param high_resolution Whether to use high resolution
+         */
+        void set_high_resolution(bool high_resolution);
 
         /**
-         * @brief Flip colour channels in individual pixel, CHIP8 is black and white so no need to set individual values
-         * @param x X position of the pixel
-         * @param y Y position of the pixel
+         * @brief Check resolution
+         * @return Whether the frame buffer is in high resolution
          */
-        void flip_pixel_channels(unsigned x, unsigned y);
+        [[nodiscard]] bool is_high_resolution() const;
 
-        /// @brief Clears the frame buffer by setting each pixel to rgba(0,0,0,255)
-        void clear();
+        /**
+         * @brief Get width of the screen in current resolution
+         * @return Width in pixels
+         */
+        [[nodiscard]] uint32_t get_width() const;
 
         /**
-         * @brief Getter for pixel arrays
-         * @return Raw pixel array
+         * @brief Get height of the screen in current resolution
+         * @return Height in pixels
          */
-        [[nodiscard]] std::array<ar_pixel, ar::chip8::SCREEN_RESOLUTION_X * ar::chip8::SCREEN_RESOLUTION_Y>&
-        get_pixels();
+        [[nodiscard]] uint32_t get_height() const;
 
         /**
-         * @brief Getter for a specific pixel
-         * @param x X position of the pixel
-         * @param y Y position of the pixel
-         * @return Targeted pixel
+         * @brief XOR a sprite row into a plane
+         * @param plane Index of the plane
+         * @param x X position of the sprite's leftmost pixel, smaller than the width
+         * @param y Y position of the row, smaller than the height
+         * @param sprite_row Pixels of the sprite row, leftmost pixel is the top bit of 'sprite_width' bits
+         * @param sprite_width Width of the sprite (8 or 16)
+         * @return Whether any pixel got turned off (collision)
+         * @tparam clip Whether pixels past the right edge are cut instead of wrapping around to the left edge
          */
-        ar_pixel& get_pixel_at(unsigned x, unsigned y);
+        template<bool clip>
+        bool draw_row(uint32_t plane, uint32_t x, uint32_t y, uint16_t sprite_row, uint32_t sprite_width)
+        {
+            ar::chip8::pixel_row& row = _planes[plane][y];
+
+            // Sprite is moved to the top bits, then shifted to its position as a single 64/128-bit number
+            uint64_t sprite = uint64_t { sprite_row } << (64 - sprite_width);
+            ar::chip8::pixel_row mask {};
+
+            if (!_high_resolution)
+            {
+                mask.left = sprite >> x;
+
+                // Pixels shifted out on the right come back on the left
+                if constexpr (!clip)
+                {
+                    mask.left |= x != 0 ? sprite << (64 - x) : 0;
+                }
+            }
+            else if (x < 64)
+            {
+                mask.left  = sprite >> x;
+                mask.right = x != 0 ? sprite << (64 - x) : 0;
+            }
+            else
+            {
+                mask.right = sprite >> (x - 64);
+
+                if constexpr (!clip)
+                {
+                    mask.left = x != 64 ? sprite << (128 - x) : 0;
+                }
+            }
+
+            bool collision = ((row.left & mask.left) | (row.right & mask.right)) != 0;
+
+            row.left ^= mask.left;
+            row.right ^= mask.right;
+
+            return collision;
+        }
+
+        /**
+         * @brief Scroll planes down, rows scrolled in at the top are empty
+         * @param planes Mask of planes to scroll
+         * @param rows Number of rows
+         */
+        void scroll_down(ar_byte planes, uint32_t rows);
+
+        /**
+         * @brief Scroll planes up, rows scrolled in at the bottom are empty
+         * @param planes Mask of planes to scroll
+         * @param rows Number of rows
+         */
+        void scroll_up(ar_byte planes, uint32_t rows);
+
+        /**
+         * @brief Scroll planes right, pixels scrolled in on the left are empty
+         * @param planes Mask of planes to scroll
+         * @param pixels Number of pixels, smaller than 64
+         */
+        void scroll_right(ar_byte planes, uint32_t pixels);
+
+        /**
+         * @brief Scroll planes left, pixels scrolled in on the right are empty
+         * @param planes Mask of planes to scroll
+         * @param pixels Number of pixels, smaller than 64
+         */
+        void scroll_left(ar_byte planes, uint32_t pixels);
+
+        /**
+         * @brief Getter for rows of a plane
+         * @param plane Index of the plane
+         * @return Rows of the plane, only the first 'get_height' are used
+         */
+        [[nodiscard]] const std::array<ar::chip8::pixel_row, ar::chip8::HIGH_RESOLUTION_Y>& get_plane(
+                uint32_t plane) const;
 
     private:
-        /// @brief Array of raw pixel colours
-        std::array<ar_pixel, ar::chip8::SCREEN_RESOLUTION_X * ar::chip8::SCREEN_RESOLUTION_Y> _raw_pixels {};
+        /// @brief Packed rows of each plane
+        std::array<std::array<ar::chip8::pixel_row, ar::chip8::HIGH_RESOLUTION_Y>, ar::chip8::PLANE_COUNT> _planes {};
+
+        /// @brief Whether the screen is in high resolution
+        bool _high_resolution = false;
     };
 }
 
@@ -1,77 +1,152 @@
-#include <SDL.h>
+#include <algorithm>
+#include <cstring>
 #include "gpu.hpp"
 
+/// @brief Each bit of a byte moved to the lower bit of a 2-bit pair, turns 8 pixels of a plane into 2bpp pixels
+static constexpr std::array<uint16_t, 256> SPREAD_BITS = []
+{
+    std::array<uint16_t, 256> table {};
+    for (uint32_t value = 0; value < table.size(); value++)
+    {
+        for (uint32_t bit = 0; bit < 8; bit++)
+        {
+            table[value] = static_cast<uint16_t>(table[value] | (((value >> bit) & 1) << (bit * 2)));
+        }
+    }
+
+    return table;
+}();
+
+/// @brief Each bit of a byte repeated twice, turns 8 low resolution pixels into 16 high resolution ones
+static constexpr std::array<uint16_t, 256> DOUBLE_BITS = []
+{
+    std::array<uint16_t, 256> table {};
+    for (uint32_t value = 0; value < table.size(); value++)
+    {
+        for (uint32_t bit = 0; bit < 8; bit++)
+        {
+            table[value] = static_cast<uint16_t>(table[value] | (((value >> bit) & 1) * 3 << (bit * 2)));
+        }
+    }
+
+    return table;
+}();
+
+/**
+ * @brief Get 8 pixels of a packed row
+ * @param row Row
+ * @param group Index of the 8 pixels (0 - 15)
+ * @return Pixels, leftmost one is the top bit
+ */
+static uint8_t get_pixel_group(const ar::chip8::pixel_row& row, uint32_t group)
+{
+    uint64_t half = group < 8 ? row.left : row.right;
+
+    return static_cast<uint8_t>(half >> (56 - (group % 8) * 8));
+}
+
+/**
+ * @brief Write 8 pixels of both planes as 2bpp pixels
+ * @param destination First of 2 bytes to write
+ * @param first_plane Pixels of the first plane
+ * @param second_plane Pixels of the second plane
+ */
+static void write_2bpp_pixels(uint8_t* destination, uint8_t first_plane, uint8_t second_plane)
+{
+    // First plane is the lower bit of palette index, second plane the upper one
+    auto pixels = static_cast<uint16_t>(SPREAD_BITS[first_plane] | SPREAD_BITS[second_plane] << 1);
+
+    destination[0] = static_cast<uint8_t>(pixels >> 8);
+    destination[1] = static_cast<uint8_t>(pixels);
+}
+
 ar::chip8::gpu::gpu(ar::chip8::ram_memory& ram_link) :
         _ram_link(ram_link)
 {
-    /*
-     * Create new SDL texture that will be rendered to the screen, CHIP8's GPU framebuffer will be used to
-     * render to this texture.
-     *
-     * Pixel format is set to ABGR8888 - 4 channels, 8 bit each. (a,b,g,r)
-     *
-     * Texture access set to STATIC for SDL_UpdateTexture to work
-     *
-     * Texture size set to CHIP8's screen resolution, this can then be scaled to the window using up-scaling
-     */
-    _frame_buffer_texture = SDL_CreateTexture(ar_graphics_get_sdl_renderer(), SDL_PIXELFORMAT_ABGR8888,
-                                              SDL_TEXTUREACCESS_STATIC,
-                                              ar::chip8::SCREEN_RESOLUTION_X, ar::chip8::SCREEN_RESOLUTION_Y);
 }
 
-ar::chip8::gpu::~gpu()
+void ar::chip8::gpu::set_machine_model(ar::chip8::machine_model model)
 {
-    SDL_DestroyTexture(_frame_buffer_texture);
+    _model = model;
 }
 
 void ar::chip8::gpu::render()
 {
-    update_texture_with_frame_buffer();
+    ar_profile_begin("gpu::render");
+
+    ar_frame_buffer* library_frame_buffer = ar_graphics_get_frame_buffer();
+
+    if (library_frame_buffer->format == ar_pixel_format_2bpp_indexed)
+    {
+        render_2bpp(library_frame_buffer);
+    }
+    else
+    {
+        render_1bpp(library_frame_buffer);
+    }
+
+    ar_graphics_present();
+
+    ar_profile_end();
+}
+
+void ar::chip8::gpu::render_1bpp(ar_frame_buffer* library_frame_buffer)
+{
+    const auto& plane = _frame_buffer.get_plane(0);
+    auto* rows = static_cast<uint8_t*>(library_frame_buffer->data);
 
-    SDL_Renderer* renderer = ar_graphics_get_sdl_renderer();
+    // Library's frame buffer is 1bpp with the leftmost pixel in the top bit, same as packed rows
+    for (uint32_t y = 0; y < ar::chip8::SCREEN_RESOLUTION_Y; y++)
+    {
+        uint8_t* row = rows + y * library_frame_buffer->pitch;
 
-    // Clear screen -> Copy texture to renderer -> Show renderer on screen
-    SDL_RenderClear(renderer);
-    SDL_RenderCopy(renderer, _frame_buffer_texture, nullptr, nullptr);
-    SDL_RenderPresent(renderer);
+        for (uint32_t group = 0; group < ar::chip8::SCREEN_RESOLUTION_X / 8; group++)
+        {
+            row[group] = get_pixel_group(plane[y], group);
+        }
+    }
 }
 
-void ar::chip8::gpu::update_texture_with_frame_buffer()
+void ar::chip8::gpu::render_2bpp(ar_frame_buffer* library_frame_buffer)
 {
-    auto& pixels = _frame_buffer.get_pixels();
+    const auto& first_plane  = _frame_buffer.get_plane(0);
+    const auto& second_plane = _frame_buffer.get_plane(1);
+    auto* rows = static_cast<uint8_t*>(library_frame_buffer->data);
 
-    // Create new texture pixel array. Texture is in format of ABGR8888, each pixel is a 32-bit integer
-    uint32_t current_texture_pixel_array[ar::chip8::SCREEN_RESOLUTION_X * ar::chip8::SCREEN_RESOLUTION_Y] = { 0 };
+    uint32_t pitch = library_frame_buffer->pitch;
 
-    for (uint32_t i = 0; i < ar::chip8::SCREEN_RESOLUTION_X * ar::chip8::SCREEN_RESOLUTION_Y; i++)
+    if (_frame_buffer.is_high_resolution())
     {
-        ar_pixel& pixel = pixels.at(i);
-
-        /*
-         * Texture is in format of ABGR8888, each pixel is a 32-bit integer
-         * For example: 0xDDCCBBAA where:
-         *  - 0xDD is A
-         *  - 0xCC is B
-         *  - 0xBB is G
-         *  - 0xAA is R
-         *
-         * This 32-bit integer can be constructed using ar_pixel object.
-         *
-         * Construct uint32_t from byte color channels using bitwise operations
-         */
-
-        uint32_t pixel_value = 0x00000000;
-
-        pixel_value = pixel_value | (static_cast<uint32_t>(pixel.a << 24));
-        pixel_value = pixel_value | (static_cast<uint32_t>(pixel.b << 16));
-        pixel_value = pixel_value | (static_cast<uint32_t>(pixel.g << 8));
-        pixel_value = pixel_value | (pixel.r);
-
-        current_texture_pixel_array[i] = pixel_value;
+        for (uint32_t y = 0; y < ar::chip8::HIGH_RESOLUTION_Y; y++)
+        {
+            uint8_t* row = rows + y * pitch;
+
+            for (uint32_t group = 0; group < ar::chip8::HIGH_RESOLUTION_X / 8; group++)
+            {
+                write_2bpp_pixels(row + group * 2, get_pixel_group(first_plane[y], group),
+                                  get_pixel_group(second_plane[y], group));
+            }
+        }
+
+        return;
     }
 
-    SDL_UpdateTexture(_frame_buffer_texture, nullptr, &current_texture_pixel_array,
-                      SCREEN_RESOLUTION_X * 4);
+    // Frame buffer is always 128x64, low resolution pixels are 2x2 blocks
+    for (uint32_t y = 0; y < ar::chip8::SCREEN_RESOLUTION_Y; y++)
+    {
+        uint8_t* row = rows + y * 2 * pitch;
+
+        for (uint32_t group = 0; group < ar::chip8::SCREEN_RESOLUTION_X / 8; group++)
+        {
+            uint16_t first  = DOUBLE_BITS[get_pixel_group(first_plane[y], group)];
+            uint16_t second = DOUBLE_BITS[get_pixel_group(second_plane[y], group)];
+
+            write_2bpp_pixels(row + group * 4, static_cast<uint8_t>(first >> 8), static_cast<uint8_t>(second >> 8));
+            write_2bpp_pixels(row + group * 4 + 2, static_cast<uint8_t>(first), static_cast<uint8_t>(second));
+        }
+
+        std::memcpy(row + pitch, row, pitch);
+    }
 }
 
 void ar::chip8::gpu::set_draw_flag(bool new_value)
@@ -84,49 +159,141 @@ bool ar::chip8::gpu::get_draw_flag() const
     return _draw_flag;
 }
 
+uint64_t ar::chip8::gpu::hash_state(uint64_t hash)
+{
+    const auto& first_plane  = _frame_buffer.get_plane(0);
+    const auto& second_plane = _frame_buffer.get_plane(1);
+
+    bool high_resolution = _frame_buffer.is_high_resolution();
+    uint32_t height      = _frame_buffer.get_height();
+
+    // Low resolution rows are hashed as 64-bit numbers, that's how CHIP8's screen has always been hashed
+    for (uint32_t y = 0; y < height; y++)
+    {
+        hash = ar::chip8::hash_state_bytes(hash, &first_plane[y].left, sizeof(first_plane[y].left));
+
+        if (high_resolution)
+        {
+            hash = ar::chip8::hash_state_bytes(hash, &first_plane[y].right, sizeof(first_plane[y].right));
+        }
+    }
+
+    bool second_plane_used = std::any_of(second_plane.begin(), second_plane.end(), [](const ar::chip8::pixel_row& row)
+    {
+        return row.left != 0 || row.right != 0;
+    });
+
+    if (high_resolution || second_plane_used || _selected_planes != 0x1)
+    {
+        hash = ar::chip8::hash_state_bytes(hash, &high_resolution, sizeof(high_resolution));
+        hash = ar::chip8::hash_state_bytes(hash, &_selected_planes, sizeof(_selected_planes));
+        hash = ar::chip8::hash_state_bytes(hash, second_plane.data(), sizeof(ar::chip8::pixel_row) * height);
+    }
+
+    return ar::chip8::hash_state_bytes(hash, &_draw_flag, sizeof(_draw_flag));
+}
+
 void ar::chip8::gpu::clear_screen()
 {
     // Clear the frame buffer
-    _frame_buffer.clear();
+    _frame_buffer.clear(_selected_planes);
 
     // Set the draw flag to update the screen
     set_draw_flag(true);
 }
 
+void ar::chip8::gpu::set_high_resolution(bool high_resolution)
+{
+    _frame_buffer.set_high_resolution(high_resolution);
+
+    set_draw_flag(true);
+}
+
+void ar::chip8::gpu::select_planes(ar_byte planes)
+{
+    _selected_planes = planes & 0x3;
+}
+
+void ar::chip8::gpu::scroll_down(ar_byte rows)
+{
+    _frame_buffer.scroll_down(_selected_planes, rows);
+
+    set_draw_flag(true);
+}
+
+void ar::chip8::gpu::scroll_up(ar_byte rows)
+{
+    _frame_buffer.scroll_up(_selected_planes, rows);
+
+    set_draw_flag(true);
+}
+
+void ar::chip8::gpu::scroll_right()
+{
+    _frame_buffer.scroll_right(_selected_planes, 4);
+
+    set_draw_flag(true);
+}
+
+void ar::chip8::gpu::scroll_left()
+{
+    _frame_buffer.scroll_left(_selected_planes, 4);
+
+    set_draw_flag(true);
+}
+
+template<bool clip>
 ar_byte ar::chip8::gpu::draw(ar_byte x, ar_byte y, ar_byte height, uint16_t register_i_value)
 {
+    uint32_t screen_width  = _frame_buffer.get_width();
+    uint32_t screen_height = _frame_buffer.get_height();
+
+    // Position always wraps around, only the parts of the sprite past the edges are clipped
+    uint32_t start_x = x % screen_width;
+    uint32_t start_y = y % screen_height;
+
+    // SUPER-CHIP draws 16x16 sprites (two bytes per row) when height is 0, CHIP8 draws nothing
+    bool large_sprite = height == 0 && _model != ar::chip8::machine_model::chip8;
+
+    uint32_t sprite_height = large_sprite ? 16 : height;
+    uint32_t sprite_width  = large_sprite ? 16 : 8;
+
     // Whether any pixel has flipped to turned off, this will decide the return value and the value of register VF
     bool any_pixel_turned_off = false;
 
-    // Height is defined by the caller
-    for (ar_byte current_height = 0; current_height < height; current_height++)
-    {
-        // Start of pixel row
-        ar_byte row_addr = _ram_link.read(register_i_value + current_height);
+    auto sprite_address = static_cast<uint16_t>(register_i_value);
 
-        // Every sprite has a width of 8
-        for (ar_byte current_width = 0; current_width < 8; current_width++)
+    for (uint32_t plane = 0; plane < ar::chip8::PLANE_COUNT; plane++)
+    {
+        if ((_selected_planes & (1 << plane)) == 0)
         {
-            // Checks if this sprite pixel needs to be drawn
-            if ((row_addr & (1 << (7 - current_width))) != 0)
-            {
-                // Add sprite coordinates to draw location to get this pixel location
-                ar_byte flip_pixel_x_cord = x + current_width;
-                ar_byte flip_pixel_y_cord = y + current_height;
-
-                // Flip the pixel
-                _frame_buffer.flip_pixel_channels(flip_pixel_x_cord, flip_pixel_y_cord);
+            continue;
+        }
 
-                // Check if flipping the pixel turned it off
-                auto& target_pixel = _frame_buffer.get_pixel_at(flip_pixel_x_cord, flip_pixel_y_cord);
+        for (uint32_t row = 0; row < sprite_height; row++)
+        {
+            uint32_t screen_y = start_y + row;
 
-                // Only need to check R because CHIP8 display is monochrome
-                if (target_pixel.r == ar::chip8::PIXEL_TURNED_OFF_CHANNEL_VALUE)
+            // Frame buffer wraps rows around, clipped rows have to be skipped before that
+            if (screen_y >= screen_height)
+            {
+                if constexpr (clip)
                 {
-                    any_pixel_turned_off = true;
+                    continue;
                 }
+
+                screen_y -= screen_height;
             }
+
+            uint16_t sprite_row = large_sprite
+                                  ? _ram_link.read_instruction(static_cast<uint16_t>(sprite_address + row * 2))
+                                  : _ram_link.read(static_cast<uint16_t>(sprite_address + row));
+
+            any_pixel_turned_off |= _frame_buffer.draw_row<clip>(plane, start_x, screen_y, sprite_row, sprite_width);
         }
+
+        // Sprite of the next plane follows this one
+        sprite_address = static_cast<uint16_t>(sprite_address + sprite_height * (sprite_width / 8));
     }
 
     // Set draw flag to update the screen
@@ -135,3 +302,8 @@ ar_byte ar::chip8::gpu::draw(ar_byte x, ar_byte y, ar_byte height, uint16_t regi
     // Return whether any pixel have flipped to turned off
     return static_cast<ar_byte>(any_pixel_turned_off);
 }
+
+// Sprites either wrap around or are clipped, see 'cpu_quirks::clip_sprites'
+template ar_byte ar::chip8::gpu::draw<false>(ar_byte x, ar_byte y, ar_byte height, uint16_t register_i_value);
+
+template ar_byte ar::chip8::gpu::draw<true>(ar_byte x, ar_byte y, ar_byte height, uint16_t register_i_value);
@@ -5,9 +5,10 @@
 #ifndef ACCESS_TO_RETRO_GPU_HPP
 #define ACCESS_TO_RETRO_GPU_HPP
 
-#include <SDL.h>
 #include "frame-buffer.hpp"
+#include "machine-model.hpp"
 #include "ram-memory.hpp"
+#include "state-hash.hpp"
 
 namespace ar::chip8
 {
@@ -20,9 +21,20 @@ namespace ar::chip8
          * @param ram_link Link to the RAM memory
          */
         explicit gpu(ar::chip8::ram_memory& ram_link);
-        ~gpu();
 
-        /// @brief Render internal GPU state to the screen
+        /**
+         * @brief Set machine the GPU emulates, decides whether 0xDXY0 draws a 16x16 sprite
+         * @param model Machine model
+         */
+        void set_machine_model(ar::chip8::machine_model model);
+
+        /**
+         * @brief Render internal GPU state to the screen
+         * @details Packs the frame into library's frame buffer and presents it, the frontend does the actual drawing.
+         *          1bpp frame buffer (64x32) shows the first plane, 2bpp one (128x64) shows both planes as palette
+         *          entries 0 - 3 with low resolution pixels doubled.
+         * @warning Library's frame buffer has to be created before ('ar_graphics_create_frame_buffer')
+         */
         void render();
 
         /**
@@ -37,19 +49,62 @@ namespace ar::chip8
          */
         [[nodiscard]] bool get_draw_flag() const;
 
+        /**
+         * @brief Continue state hash with the screen (one bit per pixel, rows packed) and the draw flag
+         * @details High resolution, plane selection and the second plane are only hashed once a game uses them, so
+         *          hashes of CHIP8 games do not depend on the extensions.
+         * @param hash Hash so far
+         * @return Updated hash
+         */
+        [[nodiscard]] uint64_t hash_state(uint64_t hash);
+
         /******************* Instructions Functions *******************/
 
-        /// @brief Clear the screen and set draw flag so that the screen updates to empty
+        /// @brief Clear selected planes of the screen and set draw flag so that the screen updates to empty
         void clear_screen();
 
         /**
-         * @brief Draw a sprite on the screen
+         * @brief Switch between low and high resolution, screen is cleared
+         * @param high_resolution Whether to use high resolution (128x64)
+         */
+        void set_high_resolution(bool high_resolution);
+
+        /**
+         * @brief Select planes that are drawn, cleared and scrolled
+         * @param planes Mask of planes, bit 0 is the first plane
+         */
+        void select_planes(ar_byte planes);
+
+        /**
+         * @brief Scroll selected planes down
+         * @param rows Number of rows
+         */
+        void scroll_down(ar_byte rows);
+
+        /**
+         * @brief Scroll selected planes up
+         * @param rows Number of rows
+         */
+        void scroll_up(ar_byte rows);
+
+        /// @brief Scroll selected planes right by 4 pixels
+        void scroll_right();
+
+        /// @brief Scroll selected planes left by 4 pixels
+        void scroll_left();
+
+        /**
+         * @brief Draw a sprite into selected planes
+         * @details Each selected plane gets its own sprite, stored one after another starting at I.
          * @param x X coordinate where the sprite should be drawn
          * @param y Y coordinate where the sprite should be drawn
-         * @param height Height of the sprite
+         * @param height Height of the sprite, 0 is a 16x16 sprite on SUPER-CHIP and XO-CHIP (nothing on CHIP8)
          * @param register_i_value Value of special register I
          * @return Value to which general register 0xF (VF) should be set
+         * @tparam clip Whether parts of the sprite outside of the screen are cut instead of wrapping around, position
+         *              itself always wraps
          */
+        template<bool clip>
         [[nodiscard]] ar_byte draw(ar_byte x, ar_byte y, ar_byte height, uint16_t register_i_value);
 
     private:
@@ -59,16 +114,26 @@ namespace ar::chip8
         /// @brief CHIP8's screen frame buffer
         ar::chip8::frame_buffer _frame_buffer {};
 
+        /// @brief Machine the GPU emulates
+        ar::chip8::machine_model _model = ar::chip8::machine_model::chip8;
+
+        /// @brief Mask of planes that are drawn, cleared and scrolled
+        ar_byte _selected_planes = 0x1;
+
         /// @brief Indicates whether next GPU tick should render to the screen
         bool _draw_flag = false;
 
-        /// @brief SDL's texture object to render framebuffer to
-        SDL_Texture* _frame_buffer_texture = nullptr;
+        /**
+         * @brief Pack the first plane into 1bpp frame buffer
+         * @param library_frame_buffer Library's frame buffer
+         */
+        void render_1bpp(ar_frame_buffer* library_frame_buffer);
 
         /**
-         * @brief Updates frame buffer texture with frame buffer pixels
+         * @brief Pack both planes into 2bpp frame buffer
+         * @param library_frame_buffer Library's frame buffer
          */
-        void update_texture_with_frame_buffer();
+        void render_2bpp(ar_frame_buffer* library_frame_buffer);
     };
 }
 
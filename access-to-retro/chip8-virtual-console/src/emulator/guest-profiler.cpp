@@ -0,0 +1,273 @@
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include "guest-profiler.hpp"
+
+/// @brief Index of 'unknown' pattern, opcodes the CPU ignores
+static constexpr std::size_t UNKNOWN_PATTERN = ar::chip8::INSTRUCTION_PATTERN_COUNT - 1;
+
+/// @brief Names of instruction patterns in the order of their indexes
+static constexpr std::array<const char*, ar::chip8::INSTRUCTION_PATTERN_COUNT> INSTRUCTION_PATTERN_NAMES =
+        {
+                "00E0", "00EE", "0NNN", "1NNN", "2NNN", "3XNN", "4XNN", "5XY0", "6XNN", "7XNN",
+                "8XY0", "8XY1", "8XY2", "8XY3", "8XY4", "8XY5", "8XY6", "8XY7", "8XYE",
+                "9XY0", "ANNN", "BNNN", "CXNN", "DXYN", "EX9E", "EXA1",
+                "FX07", "FX0A", "FX15", "FX18", "FX1E", "FX29", "FX33", "FX55", "FX65",
+                "unknown"
+        };
+
+ar::chip8::guest_profiler::guest_profiler(const ar::chip8::cpu& cpu) :
+        _cpu(cpu),
+        _next_address(cpu.get_program_counter())
+{
+    // Root is the code running when profiling started, usually the entry point at 0x200
+    _call_nodes.push_back({ _next_address, 0, 0, 0, {} });
+}
+
+void ar::chip8::guest_profiler::record_instruction()
+{
+    // Program counter already points to the next instruction, the executed one is where the previous one pointed to
+    uint16_t address = _next_address;
+    uint16_t opcode  = _cpu.get_encoded_instruction();
+
+    _next_address = _cpu.get_program_counter();
+
+    _address_counts[address % ar::chip8::XO_CHIP_RAM_SIZE]++;
+    _pattern_counts[get_instruction_pattern(opcode)]++;
+
+    // Calling instruction belongs to the caller, returning one to the callee
+    _call_nodes[_current_node].instructions++;
+
+    // SUPER-CHIP and XO-CHIP reuse some 0x0NNN opcodes for the screen, those are not calls
+    bool machine_code_call = (opcode & 0xF000) == 0x0000 && opcode != 0x00E0 && opcode != 0x00EE &&
+                             !ar::chip8::is_screen_instruction(opcode, _cpu.get_machine_model());
+
+    if ((opcode & 0xF000) == 0x2000 || machine_code_call)
+    {
+        enter_function(static_cast<uint16_t>(opcode & 0x0FFF));
+    }
+    else if (opcode == 0x00EE)
+    {
+        leave_function();
+    }
+}
+
+uint64_t ar::chip8::guest_profiler::get_instruction_count() const
+{
+    uint64_t count = 0;
+    for (uint64_t pattern_count : _pattern_counts)
+    {
+        count += pattern_count;
+    }
+
+    return count;
+}
+
+std::vector<ar::chip8::hot_address> ar::chip8::guest_profiler::get_hot_addresses(std::size_t count) const
+{
+    std::vector<ar::chip8::hot_address> addresses;
+    for (std::size_t address = 0; address < _address_counts.size(); address++)
+    {
+        if (_address_counts[address] != 0)
+        {
+            addresses.push_back({ static_cast<uint16_t>(address), _address_counts[address] });
+        }
+    }
+
+    // Equal counts are ordered by address so that reports do not change between runs
+    auto hotter = [](const ar::chip8::hot_address& a, const ar::chip8::hot_address& b)
+    {
+        return a.count != b.count ? a.count > b.count : a.address < b.address;
+    };
+
+    count = std::min(count, addresses.size());
+    std::partial_sort(addresses.begin(), addresses.begin() + static_cast<std::ptrdiff_t>(count), addresses.end(),
+                      hotter);
+    addresses.resize(count);
+
+    return addresses;
+}
+
+const std::array<uint64_t, ar::chip8::INSTRUCTION_PATTERN_COUNT>& ar::chip8::guest_profiler::get_opcode_histogram() const
+{
+    return _pattern_counts;
+}
+
+uint64_t ar::chip8::guest_profiler::get_unmatched_return_count() const
+{
+    return _unmatched_return_count;
+}
+
+void ar::chip8::guest_profiler::write_folded_stacks(std::ostream& output) const
+{
+    std::vector<std::string> lines;
+
+    for (const call_node& node : _call_nodes)
+    {
+        if (node.instructions == 0)
+        {
+            continue;
+        }
+
+        // Walk up to the root, stack is written from the root down
+        std::string stack;
+        for (const call_node* frame = &node; ; frame = &_call_nodes[frame->parent])
+        {
+            char function[8];
+            std::snprintf(function, sizeof(function), "0x%03X", frame->function);
+
+            stack = stack.empty() ? std::string(function) : std::string(function) + ";" + stack;
+
+            if (frame->depth == 0)
+            {
+                break;
+            }
+        }
+
+        lines.push_back(stack + " " + std::to_string(node.instructions));
+    }
+
+    // Nodes are in the order the calls were first seen, sorted output can be compared between runs
+    std::sort(lines.begin(), lines.end());
+
+    for (const std::string& line : lines)
+    {
+        output << line << "\n";
+    }
+}
+
+std::size_t ar::chip8::guest_profiler::get_instruction_pattern(uint16_t opcode)
+{
+    // Same decoding as 'cpu::decode_and_execute', opcodes it ignores are 'unknown'
+    switch (opcode & 0xF000)
+    {
+        case 0x0000:
+            return opcode == 0x00E0 ? 0 : (opcode == 0x00EE ? 1 : 2);
+
+        case 0x8000:
+        {
+            std::size_t n = opcode & 0x000F;
+            if (n <= 0x7)
+            {
+                return 10 + n;
+            }
+
+            return n == 0xE ? 18 : UNKNOWN_PATTERN;
+        }
+
+        case 0x9000:
+            return 19;
+
+        case 0xA000:
+            return 20;
+
+        case 0xB000:
+            return 21;
+
+        case 0xC000:
+            return 22;
+
+        case 0xD000:
+            return 23;
+
+        case 0xE000:
+            switch (opcode & 0x00FF)
+            {
+                case 0x9E:
+                    return 24;
+
+                case 0xA1:
+                    return 25;
+
+                default:
+                    return UNKNOWN_PATTERN;
+            }
+
+        case 0xF000:
+            switch (opcode & 0x00FF)
+            {
+                case 0x07:
+                    return 26;
+
+                case 0x0A:
+                    return 27;
+
+                case 0x15:
+                    return 28;
+
+                case 0x18:
+                    return 29;
+
+                case 0x1E:
+                    return 30;
+
+                case 0x29:
+                    return 31;
+
+                case 0x33:
+                    return 32;
+
+                case 0x55:
+                    return 33;
+
+                case 0x65:
+                    return 34;
+
+                default:
+                    return UNKNOWN_PATTERN;
+            }
+
+        default:
+            // Opcodes 0x1NNN to 0x7XNN have a single pattern each, right after the 0x0 ones
+            return 2 + static_cast<std::size_t>(opcode >> 12);
+    }
+}
+
+const char* ar::chip8::guest_profiler::get_instruction_pattern_name(std::size_t pattern)
+{
+    return pattern < INSTRUCTION_PATTERN_NAMES.size() ? INSTRUCTION_PATTERN_NAMES[pattern] : "unknown";
+}
+
+void ar::chip8::guest_profiler::enter_function(uint16_t function)
+{
+    call_node& current = _call_nodes[_current_node];
+    if (current.depth == ar::chip8::MAX_PROFILED_CALL_DEPTH || _overflow_depth != 0)
+    {
+        _overflow_depth++;
+        return;
+    }
+
+    for (uint32_t child : current.children)
+    {
+        if (_call_nodes[child].function == function)
+        {
+            _current_node = child;
+            return;
+        }
+    }
+
+    // First call of this function from this stack
+    auto child = static_cast<uint32_t>(_call_nodes.size());
+    _call_nodes.push_back({ function, _current_node, current.depth + 1, 0, {} });
+
+    // Pushing may have moved the nodes, 'current' is not valid anymore
+    _call_nodes[_current_node].children.push_back(child);
+    _current_node = child;
+}
+
+void ar::chip8::guest_profiler::leave_function()
+{
+    if (_overflow_depth != 0)
+    {
+        _overflow_depth--;
+        return;
+    }
+
+    if (_call_nodes[_current_node].depth == 0)
+    {
+        _unmatched_return_count++;
+        return;
+    }
+
+    _current_node = _call_nodes[_current_node].parent;
+}
@@ -0,0 +1,154 @@
+/**
+ * @file emulator/guest-profiler.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_GUEST_PROFILER_HPP
+#define ACCESS_TO_RETRO_GUEST_PROFILER_HPP
+
+#include <array>
+#include <ostream>
+#include <vector>
+#include "ram-memory.hpp"
+#include "cpu.hpp"
+
+namespace ar::chip8
+{
+    /// @brief Number of instruction patterns told apart by the opcode histogram (all opcodes and 'unknown')
+    constexpr std::size_t INSTRUCTION_PATTERN_COUNT = 36;
+
+    /// @brief Deepest call stack the guest profiler keeps apart, deeper calls are counted in the deepest function
+    constexpr std::size_t MAX_PROFILED_CALL_DEPTH = 16;
+
+    /// @brief Executed address and how many times it was executed
+    struct hot_address
+    {
+        /// @brief Address of the instruction
+        uint16_t address;
+
+        /// @brief Number of times the instruction was executed
+        uint64_t count;
+    };
+
+    /**
+     * @brief Profiles the game running on the emulator (guest code), not the emulator itself
+     * @details Counts executions of every address and every instruction pattern and follows calls ('2NNN', '0NNN') and
+     *          returns ('00EE') to count instructions per call stack. Profiler is passed to the emulator through
+     *          'run_frame' instruction callback, so it costs nothing unless a tool runs frames with it:
+     *
+     *          emulator.run_frame([&] { profiler.record_instruction(); });
+     */
+    class guest_profiler
+    {
+    public:
+        /**
+         * @brief Default constructor, call stack starts in a function at the current program counter
+         * @param cpu CPU of the profiled emulator
+         */
+        explicit guest_profiler(const ar::chip8::cpu& cpu);
+
+        /// @brief Record the instruction CPU has just executed, has to be called after every instruction
+        void record_instruction();
+
+        /**
+         * @brief Get number of recorded instructions
+         * @return Recorded instruction count
+         */
+        [[nodiscard]] uint64_t get_instruction_count() const;
+
+        /**
+         * @brief Get most executed addresses, these are the loops worth optimising (or skipping while they wait)
+         * @param count Maximum number of addresses
+         * @return Addresses ordered from the most executed one
+         */
+        [[nodiscard]] std::vector<ar::chip8::hot_address> get_hot_addresses(std::size_t count) const;
+
+        /**
+         * @brief Get number of executions of each instruction pattern
+         * @return Counts indexed by 'get_instruction_pattern'
+         */
+        [[nodiscard]] const std::array<uint64_t, ar::chip8::INSTRUCTION_PATTERN_COUNT>& get_opcode_histogram() const;
+
+        /**
+         * @brief Get number of returns that had no matching call, games that manipulate the stack by themselves have
+         *        them and their call stacks are not reliable
+         * @return Unmatched return count
+         */
+        [[nodiscard]] uint64_t get_unmatched_return_count() const;
+
+        /**
+         * @brief Write instructions executed in each call stack in folded format (for ex: '0x200;0x2A4;0x31C 1500'),
+         *        read by flame graph tools such as 'flamegraph.pl' and speedscope
+         * @param output Stream to write to
+         */
+        void write_folded_stacks(std::ostream& output) const;
+
+        /**
+         * @brief Get instruction pattern of an opcode
+         * @param opcode Encoded instruction
+         * @return Index into the histogram, see 'get_instruction_pattern_name'
+         */
+        [[nodiscard]] static std::size_t get_instruction_pattern(uint16_t opcode);
+
+        /**
+         * @brief Get name of an instruction pattern
+         * @param pattern Index of the pattern
+         * @return Name of the pattern (for ex: "8XY4")
+         */
+        [[nodiscard]] static const char* get_instruction_pattern_name(std::size_t pattern);
+
+    private:
+        /// @brief Function in a call stack, instructions are counted for the whole stack leading to it
+        struct call_node
+        {
+            /// @brief Address of the function
+            uint16_t function;
+
+            /// @brief Index of the calling node, root is its own parent
+            uint32_t parent;
+
+            /// @brief Number of functions below this one (0 for the root)
+            uint32_t depth;
+
+            /// @brief Instructions executed in this function while called through this stack
+            uint64_t instructions;
+
+            /// @brief Indexes of called functions' nodes, games call only a handful of functions from each one
+            std::vector<uint32_t> children;
+        };
+
+        /// @brief CPU of the profiled emulator
+        const ar::chip8::cpu& _cpu;
+
+        /// @brief Address of the next executed instruction, program counter after the previous one
+        uint16_t _next_address;
+
+        /// @brief Executions of each address, XO-CHIP's 64kb of them are too many to keep inside the object
+        std::vector<uint64_t> _address_counts = std::vector<uint64_t>(ar::chip8::XO_CHIP_RAM_SIZE);
+
+        /// @brief Executions of each instruction pattern
+        std::array<uint64_t, ar::chip8::INSTRUCTION_PATTERN_COUNT> _pattern_counts { 0 };
+
+        /// @brief Call stacks seen so far, the first node is the root
+        std::vector<call_node> _call_nodes;
+
+        /// @brief Node of the function currently executing
+        uint32_t _current_node = 0;
+
+        /// @brief Calls deeper than 'MAX_PROFILED_CALL_DEPTH' that have not returned yet
+        uint32_t _overflow_depth = 0;
+
+        /// @brief Number of returns without a matching call
+        uint64_t _unmatched_return_count = 0;
+
+        /**
+         * @brief Move into a called function
+         * @param function Address of the function
+         */
+        void enter_function(uint16_t function);
+
+        /// @brief Move back into the calling function
+        void leave_function();
+    };
+}
+
+#endif //ACCESS_TO_RETRO_GUEST_PROFILER_HPP
@@ -0,0 +1,462 @@
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include "instruction-trace.hpp"
+
+#if defined(_WIN32)
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <unistd.h>
+#endif
+
+/// @brief Start of a written trace
+static constexpr std::array<char, 4> TRACE_MAGIC = { 'A', 'R', '8', 'T' };
+
+/// @brief Version of the written trace, changes whenever the format does
+static constexpr ar_byte TRACE_FORMAT_VERSION = 1;
+
+/// @brief Chunk header: cycle (8 bytes), address (2 bytes), I (2 bytes) and general registers
+static constexpr std::size_t CHUNK_HEADER_SIZE = 12 + ar::chip8::GENERAL_REGISTER_COUNT;
+
+/// @brief Largest record: tag, cycle, address, opcode, register mask, all registers and I
+static constexpr std::size_t MAX_RECORD_SIZE = 1 + 10 + 3 + 2 + 2 + ar::chip8::GENERAL_REGISTER_COUNT + 3;
+
+/// @brief Tag bit, cycle is not the one after the previous record, its delta follows
+static constexpr ar_byte TAG_CYCLE = 0x01;
+
+/// @brief Tag bit, address is not right after the previous one, zigzag delta from there follows
+static constexpr ar_byte TAG_ADDRESS = 0x02;
+
+/// @brief Tag bit, I changed, zigzag delta follows after the registers
+static constexpr ar_byte TAG_ADDRESS_REGISTER = 0x04;
+
+/// @brief Number of changed general registers is stored in the tag's upper bits
+static constexpr uint32_t TAG_REGISTER_COUNT_SHIFT = 3;
+
+/**
+ * @brief Write unsigned LEB128 varint
+ * @param cursor Write position
+ * @param value Value
+ * @return Position after the varint
+ */
+static ar_byte* write_varint(ar_byte* cursor, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        *cursor++ = static_cast<ar_byte>(value | 0x80);
+        value >>= 7;
+    }
+
+    *cursor++ = static_cast<ar_byte>(value);
+
+    return cursor;
+}
+
+/**
+ * @brief Read unsigned LEB128 varint
+ * @param cursor Read position, moved after the varint
+ * @param end End of the readable bytes
+ * @param value Value
+ * @return Whether a whole varint was read
+ */
+static bool read_varint(const ar_byte*& cursor, const ar_byte* end, uint64_t& value)
+{
+    value = 0;
+
+    for (uint32_t shift = 0; cursor < end && shift < 64; shift += 7)
+    {
+        ar_byte byte = *cursor++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Map a signed delta to an unsigned one, small deltas either way stay small
+ * @param delta Delta
+ * @return Zigzag encoded delta
+ */
+static uint32_t zigzag_encode(int32_t delta)
+{
+    return (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31);
+}
+
+/**
+ * @brief Map a zigzag encoded delta back
+ * @param value Zigzag encoded delta
+ * @return Delta
+ */
+static int32_t zigzag_decode(uint64_t value)
+{
+    return static_cast<int32_t>(static_cast<uint32_t>(value >> 1) ^ (0u - static_cast<uint32_t>(value & 1)));
+}
+
+ar::chip8::instruction_trace::instruction_trace(const ar::chip8::emulator& emulator, std::size_t chunk_count) :
+        _emulator(emulator),
+        _buffer(std::max<std::size_t>(chunk_count, 1) * ar::chip8::TRACE_CHUNK_SIZE),
+        _chunk_sizes(std::max<std::size_t>(chunk_count, 1))
+{
+    clear();
+}
+
+void ar::chip8::instruction_trace::record_instruction(const ar::chip8::cpu& cpu, uint16_t address)
+{
+    if (_cursor > _chunk_limit)
+    {
+        start_chunk();
+    }
+
+    uint64_t cycle = _emulator.get_cycle_count();
+    uint16_t address_register = cpu.get_address_register();
+    const std::array<ar_byte, ar::chip8::GENERAL_REGISTER_COUNT>& registers = cpu.get_general_registers();
+
+    // Writes go through a local cursor, stores through the member would have to be reloaded after every byte
+    ar_byte* cursor = _cursor;
+
+    // Tag is written last, once it is known what follows
+    ar_byte* tag_position = cursor++;
+    uint32_t tag          = 0;
+
+    if (cycle != _cycle + 1)
+    {
+        tag |= TAG_CYCLE;
+        cursor = write_varint(cursor, cycle - _cycle);
+    }
+
+    if (address != static_cast<uint16_t>(_address + 2))
+    {
+        tag |= TAG_ADDRESS;
+        cursor = write_varint(cursor, zigzag_encode(int32_t { address } - int32_t { _address } - 2));
+    }
+
+    uint16_t opcode = cpu.get_encoded_instruction();
+    cursor[0] = static_cast<ar_byte>(opcode >> 8);
+    cursor[1] = static_cast<ar_byte>(opcode);
+    cursor += 2;
+
+    // Registers are compared 8 at a time, most instructions change one of them or none
+    std::array<uint64_t, 2> current {};
+    std::array<uint64_t, 2> previous {};
+    std::memcpy(current.data(), registers.data(), sizeof(current));
+    std::memcpy(previous.data(), _registers.data(), sizeof(previous));
+
+    uint32_t changed       = 0;
+    uint32_t changed_count = 0;
+    for (uint32_t word = 0; word < current.size(); word++)
+    {
+        uint64_t difference = current[word] ^ previous[word];
+        while (difference != 0)
+        {
+            auto index = static_cast<uint32_t>(std::countr_zero(difference)) / 8;
+            difference &= ~(uint64_t { 0xFF } << (index * 8));
+
+            changed |= 1u << (word * 8 + index);
+            changed_count++;
+        }
+    }
+
+    // Single changed register is stored as its index, shorter than the mask
+    if (changed_count == 1)
+    {
+        auto index = static_cast<uint32_t>(std::countr_zero(changed));
+
+        cursor[0] = static_cast<ar_byte>(index);
+        cursor[1] = registers[index];
+        cursor += 2;
+    }
+    else if (changed_count > 1)
+    {
+        cursor[0] = static_cast<ar_byte>(changed);
+        cursor[1] = static_cast<ar_byte>(changed >> 8);
+        cursor += 2;
+
+        for (uint32_t mask = changed; mask != 0; mask &= mask - 1)
+        {
+            *cursor++ = registers[static_cast<uint32_t>(std::countr_zero(mask))];
+        }
+    }
+
+    if (address_register != _address_register)
+    {
+        tag |= TAG_ADDRESS_REGISTER;
+        cursor = write_varint(cursor, zigzag_encode(int32_t { address_register } - int32_t { _address_register }));
+    }
+
+    *tag_position = static_cast<ar_byte>(tag | changed_count << TAG_REGISTER_COUNT_SHIFT);
+
+    _cursor           = cursor;
+    _cycle            = cycle;
+    _address          = address;
+    _address_register = address_register;
+    _registers        = registers;
+    _instruction_count++;
+}
+
+void ar::chip8::instruction_trace::record_instruction_callback(const ar::chip8::cpu& cpu, uint16_t address,
+                                                              void* user_data)
+{
+    static_cast<ar::chip8::instruction_trace*>(user_data)->record_instruction(cpu, address);
+}
+
+void ar::chip8::instruction_trace::clear()
+{
+    _cycle             = 0;
+    _address           = 0;
+    _address_register  = 0;
+    _registers         = {};
+    _instruction_count = 0;
+
+    // Next chunk is the first one, it starts empty
+    _chunk       = _chunk_sizes.size() - 1;
+    _chunk_count = 0;
+    start_chunk();
+}
+
+uint64_t ar::chip8::instruction_trace::get_instruction_count() const
+{
+    return _instruction_count;
+}
+
+void ar::chip8::instruction_trace::start_chunk()
+{
+    if (_chunk_count != 0)
+    {
+        _chunk_sizes[_chunk] = static_cast<uint16_t>(_cursor - &_buffer[_chunk * ar::chip8::TRACE_CHUNK_SIZE]);
+    }
+
+    // Oldest chunk is overwritten once all of them are used
+    _chunk       = (_chunk + 1) % _chunk_sizes.size();
+    _chunk_count = std::min(_chunk_count + 1, _chunk_sizes.size());
+
+    ar_byte* chunk = &_buffer[_chunk * ar::chip8::TRACE_CHUNK_SIZE];
+
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        chunk[i] = static_cast<ar_byte>(_cycle >> (i * 8));
+    }
+
+    chunk[8]  = static_cast<ar_byte>(_address);
+    chunk[9]  = static_cast<ar_byte>(_address >> 8);
+    chunk[10] = static_cast<ar_byte>(_address_register);
+    chunk[11] = static_cast<ar_byte>(_address_register >> 8);
+    std::copy(_registers.begin(), _registers.end(), chunk + 12);
+
+    _cursor      = chunk + CHUNK_HEADER_SIZE;
+    _chunk_limit = chunk + ar::chip8::TRACE_CHUNK_SIZE - MAX_RECORD_SIZE;
+}
+
+/**
+ * @brief Write all bytes to a file descriptor, only calls 'write' so it is async-signal-safe
+ * @param file_descriptor File descriptor
+ * @param bytes Bytes to write
+ * @param size Number of bytes
+ * @return Whether all bytes were written
+ */
+static bool write_bytes(int file_descriptor, const ar_byte* bytes, std::size_t size)
+{
+    while (size > 0)
+    {
+#if defined(_WIN32)
+        int written = _write(file_descriptor, bytes, static_cast<unsigned>(std::min<std::size_t>(size, INT_MAX)));
+#else
+        ssize_t written = ::write(file_descriptor, bytes, size);
+#endif
+
+        // Signal arriving before anything was written is the only error worth another try
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (written <= 0)
+        {
+            return false;
+        }
+
+        bytes += written;
+        size -= static_cast<std::size_t>(written);
+    }
+
+    return true;
+}
+
+bool ar::chip8::instruction_trace::write(int file_descriptor, ar::chip8::machine_model model) const
+{
+    std::array<ar_byte, 6> header = { static_cast<ar_byte>(TRACE_MAGIC[0]), static_cast<ar_byte>(TRACE_MAGIC[1]),
+                                      static_cast<ar_byte>(TRACE_MAGIC[2]), static_cast<ar_byte>(TRACE_MAGIC[3]),
+                                      TRACE_FORMAT_VERSION, static_cast<ar_byte>(model) };
+
+    bool written = write_bytes(file_descriptor, header.data(), header.size());
+
+    std::size_t chunk_total = _chunk_sizes.size();
+    for (std::size_t i = 0; i < _chunk_count && written; i++)
+    {
+        std::size_t    chunk = (_chunk + chunk_total - _chunk_count + 1 + i) % chunk_total;
+        const ar_byte* start = &_buffer[chunk * ar::chip8::TRACE_CHUNK_SIZE];
+
+        // Current chunk is still being written, its size is only known from the cursor
+        auto size = chunk == _chunk ? static_cast<uint16_t>(_cursor - start) : _chunk_sizes[chunk];
+        std::array<ar_byte, 2> size_bytes = { static_cast<ar_byte>(size), static_cast<ar_byte>(size >> 8) };
+
+        written = write_bytes(file_descriptor, size_bytes.data(), size_bytes.size()) &&
+                  write_bytes(file_descriptor, start, size);
+    }
+
+    return written;
+}
+
+int ar::chip8::instruction_trace::open_file(const char* path)
+{
+#if defined(_WIN32)
+    return _open(path, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    return ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+#endif
+}
+
+bool ar::chip8::instruction_trace::close_file(int file_descriptor)
+{
+#if defined(_WIN32)
+    return _close(file_descriptor) == 0;
+#else
+    return ::close(file_descriptor) == 0;
+#endif
+}
+
+bool ar::chip8::instruction_trace::decode(const ar_byte* bytes, std::size_t size,
+                                          std::vector<ar::chip8::trace_entry>& entries,
+                                          ar::chip8::machine_model& model)
+{
+    if (size < 6 || std::memcmp(bytes, TRACE_MAGIC.data(), TRACE_MAGIC.size()) != 0 ||
+        bytes[4] != TRACE_FORMAT_VERSION || bytes[5] > static_cast<ar_byte>(ar::chip8::machine_model::xo_chip))
+    {
+        return false;
+    }
+
+    model = static_cast<ar::chip8::machine_model>(bytes[5]);
+
+    const ar_byte* cursor = bytes + 6;
+    const ar_byte* end    = bytes + size;
+
+    while (cursor < end)
+    {
+        if (end - cursor < 2)
+        {
+            return false;
+        }
+
+        std::size_t chunk_size = cursor[0] | static_cast<std::size_t>(cursor[1]) << 8;
+        cursor += 2;
+
+        if (chunk_size < CHUNK_HEADER_SIZE || static_cast<std::size_t>(end - cursor) < chunk_size)
+        {
+            return false;
+        }
+
+        const ar_byte* chunk_end = cursor + chunk_size;
+
+        // Every chunk starts from the state it was created with, so it does not need the previous ones
+        ar::chip8::trace_entry entry;
+        for (uint32_t i = 0; i < 8; i++)
+        {
+            entry.cycle |= static_cast<uint64_t>(cursor[i]) << (i * 8);
+        }
+
+        entry.address          = static_cast<uint16_t>(cursor[8] | cursor[9] << 8);
+        entry.address_register = static_cast<uint16_t>(cursor[10] | cursor[11] << 8);
+        std::copy(cursor + 12, cursor + CHUNK_HEADER_SIZE, entry.registers.begin());
+        cursor += CHUNK_HEADER_SIZE;
+
+        while (cursor < chunk_end)
+        {
+            ar_byte  tag   = *cursor++;
+            uint64_t value = 0;
+
+            if ((tag & TAG_CYCLE) != 0)
+            {
+                if (!read_varint(cursor, chunk_end, value))
+                {
+                    return false;
+                }
+
+                entry.cycle += value;
+            }
+            else
+            {
+                entry.cycle++;
+            }
+
+            int32_t address_delta = 0;
+            if ((tag & TAG_ADDRESS) != 0)
+            {
+                if (!read_varint(cursor, chunk_end, value))
+                {
+                    return false;
+                }
+
+                address_delta = zigzag_decode(value);
+            }
+
+            entry.address = static_cast<uint16_t>(entry.address + 2 + address_delta);
+
+            uint32_t changed_count = tag >> TAG_REGISTER_COUNT_SHIFT;
+            std::size_t needed = 2 + (changed_count == 0 ? 0 : changed_count == 1 ? 2 : 2 + changed_count);
+            if (changed_count > ar::chip8::GENERAL_REGISTER_COUNT ||
+                static_cast<std::size_t>(chunk_end - cursor) < needed)
+            {
+                return false;
+            }
+
+            entry.opcode = static_cast<uint16_t>(cursor[0] << 8 | cursor[1]);
+            cursor += 2;
+
+            entry.changed_registers = 0;
+            if (changed_count == 1)
+            {
+                entry.changed_registers = static_cast<uint16_t>(1u << (cursor[0] & 0x0F));
+                entry.registers[cursor[0] & 0x0F] = cursor[1];
+                cursor += 2;
+            }
+            else if (changed_count > 1)
+            {
+                entry.changed_registers = static_cast<uint16_t>(cursor[0] | cursor[1] << 8);
+                cursor += 2;
+
+                if (static_cast<uint32_t>(std::popcount(entry.changed_registers)) != changed_count)
+                {
+                    return false;
+                }
+
+                for (uint32_t mask = entry.changed_registers; mask != 0; mask &= mask - 1)
+                {
+                    entry.registers[static_cast<uint32_t>(std::countr_zero(mask))] = *cursor++;
+                }
+            }
+
+            entry.address_register_changed = (tag & TAG_ADDRESS_REGISTER) != 0;
+            if (entry.address_register_changed)
+            {
+                if (!read_varint(cursor, chunk_end, value))
+                {
+                    return false;
+                }
+
+                entry.address_register = static_cast<uint16_t>(entry.address_register + zigzag_decode(value));
+            }
+
+            entries.push_back(entry);
+        }
+    }
+
+    return true;
+}
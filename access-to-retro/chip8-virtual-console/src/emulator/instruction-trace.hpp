@@ -0,0 +1,173 @@
+/**
+ * @file emulator/instruction-trace.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_INSTRUCTION_TRACE_HPP
+#define ACCESS_TO_RETRO_INSTRUCTION_TRACE_HPP
+
+#include <access-to-retro-dev/access-to-retro-dev.h>
+#include <array>
+#include <vector>
+#include "emulator.hpp"
+
+namespace ar::chip8
+{
+    /// @brief Size of a chunk of the trace, each one starts with a full copy of the state and decodes on its own
+    constexpr std::size_t TRACE_CHUNK_SIZE = 4096;
+
+    /// @brief Number of chunks kept when not given, 1 MB holds the last ~200 000 instructions (about 5 minutes)
+    constexpr std::size_t DEFAULT_TRACE_CHUNK_COUNT = 256;
+
+    /// @brief Single instruction read back from a trace
+    struct trace_entry
+    {
+        /// @brief Cycle the instruction was executed in, see 'emulator::get_cycle_count'
+        uint64_t cycle = 0;
+
+        /// @brief Address of the instruction
+        uint16_t address = 0;
+
+        /// @brief Encoded instruction (opcode)
+        uint16_t opcode = 0;
+
+        /// @brief Bit for each general register the instruction changed (bit 0 is V0)
+        uint16_t changed_registers = 0;
+
+        /// @brief Whether the instruction changed I
+        bool address_register_changed = false;
+
+        /// @brief General registers after the instruction
+        std::array<ar_byte, ar::chip8::GENERAL_REGISTER_COUNT> registers {};
+
+        /// @brief I after the instruction
+        uint16_t address_register = 0;
+    };
+
+    /**
+     * @brief Records every executed instruction into a fixed-size ring buffer of compact binary records
+     * @details Recorder is called by CPUs with tracing policy (see 'record_instruction_callback'), runs without it
+     *          don't have a single instruction of tracing compiled in. Each record is a tag byte, the opcode and the
+     *          registers the instruction changed, cycle and address are only stored when they are not the next ones
+     *          and then as zigzag varint deltas, so most instructions take 3 - 5 bytes.
+     *
+     *          Buffer is split into 'TRACE_CHUNK_SIZE' chunks, each one starts with the cycle, address and registers
+     *          the deltas continue from. Once the buffer is full the oldest chunk is dropped as a whole, whatever is
+     *          left always decodes. Nothing is allocated after the recorder is created.
+     *
+     *          Written trace is "AR8T", format version, machine model, then each chunk as 16-bit little endian size
+     *          followed by its bytes, oldest chunk first.
+     */
+    class instruction_trace
+    {
+    public:
+        /**
+         * @brief Default constructor
+         * @param emulator Emulator whose cycles number the instructions
+         * @param chunk_count Number of 'TRACE_CHUNK_SIZE' chunks, at least 1
+         */
+        explicit instruction_trace(const ar::chip8::emulator& emulator,
+                                   std::size_t chunk_count = ar::chip8::DEFAULT_TRACE_CHUNK_COUNT);
+
+        /**
+         * @brief Record an executed instruction
+         * @param cpu CPU that executed the instruction
+         * @param address Address of the instruction
+         */
+        void record_instruction(const ar::chip8::cpu& cpu, uint16_t address);
+
+        /**
+         * @brief Trace callback for 'cpu::set_trace_callback'
+         * @param cpu CPU that executed the instruction
+         * @param address Address of the instruction
+         * @param user_data Pointer to the trace
+         */
+        static void record_instruction_callback(const ar::chip8::cpu& cpu, uint16_t address, void* user_data);
+
+        /// @brief Drop all records
+        void clear();
+
+        /**
+         * @brief Get number of instructions recorded since the trace was created or cleared, including dropped ones
+         * @return Number of recorded instructions
+         */
+        [[nodiscard]] uint64_t get_instruction_count() const;
+
+        /**
+         * @brief Write the trace
+         * @details Only calls 'write' on the file descriptor, nothing is allocated or buffered, so it is
+         *          async-signal-safe and can run in a handler of the signal the emulator crashed with.
+         * @param file_descriptor File opened by 'open_file'
+         * @param model Machine model the game runs on, the decoder needs it for 4 byte instructions
+         * @return Whether the trace was written
+         */
+        bool write(int file_descriptor, ar::chip8::machine_model model) const;
+
+        /**
+         * @brief Open (create or truncate) a file for 'write'
+         * @details Crash handlers cannot open files, the file has to be opened before the game starts.
+         * @param path Path of the file
+         * @return File descriptor, negative if the file could not be opened
+         */
+        static int open_file(const char* path);
+
+        /**
+         * @brief Close a file opened by 'open_file'
+         * @param file_descriptor File descriptor
+         * @return Whether everything written reached the file
+         */
+        static bool close_file(int file_descriptor);
+
+        /**
+         * @brief Decode a written trace
+         * @param bytes Written trace
+         * @param size Size of the trace
+         * @param entries Recorded instructions, oldest first
+         * @param model Machine model stored in the trace
+         * @return Whether the trace is valid, entries decoded before an error are kept
+         */
+        static bool decode(const ar_byte* bytes, std::size_t size, std::vector<ar::chip8::trace_entry>& entries,
+                           ar::chip8::machine_model& model);
+
+    private:
+        /// @brief Emulator whose cycles number the instructions
+        const ar::chip8::emulator& _emulator;
+
+        /// @brief Chunks one after another
+        std::vector<ar_byte> _buffer;
+
+        /// @brief Used bytes of each chunk
+        std::vector<uint16_t> _chunk_sizes;
+
+        /// @brief Chunk written to
+        std::size_t _chunk = 0;
+
+        /// @brief Number of chunks with records
+        std::size_t _chunk_count = 0;
+
+        /// @brief Write position in the current chunk
+        ar_byte* _cursor = nullptr;
+
+        /// @brief Position after which a record may not fit in the current chunk
+        ar_byte* _chunk_limit = nullptr;
+
+        /// @brief Cycle of the last record
+        uint64_t _cycle = 0;
+
+        /// @brief Address of the last record
+        uint16_t _address = 0;
+
+        /// @brief I after the last record
+        uint16_t _address_register = 0;
+
+        /// @brief General registers after the last record
+        std::array<ar_byte, ar::chip8::GENERAL_REGISTER_COUNT> _registers {};
+
+        /// @brief Number of recorded instructions
+        uint64_t _instruction_count = 0;
+
+        /// @brief Close the current chunk and start the next one with the state of the last record
+        void start_chunk();
+    };
+}
+
+#endif //ACCESS_TO_RETRO_INSTRUCTION_TRACE_HPP
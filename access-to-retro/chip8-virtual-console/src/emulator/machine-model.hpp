@@ -0,0 +1,49 @@
+/**
+ * @file emulator/machine-model.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_MACHINE_MODEL_HPP
+#define ACCESS_TO_RETRO_MACHINE_MODEL_HPP
+
+#include <cstdint>
+
+namespace ar::chip8
+{
+    /**
+     * @brief Machine the game was written for, each one extends the previous one
+     * @details Selected once when the game starts (from the ROM database), CHIP8 games never see the extensions so
+     *          opcodes that the extensions reuse behave exactly as they always did.
+     */
+    enum class machine_model : uint8_t
+    {
+        /// @brief 64x32 screen, 4kb of memory
+        chip8,
+
+        /// @brief SUPER-CHIP 1.1: 128x64 high resolution mode, 16x16 sprites, big font, scrolling and flag registers
+        super_chip,
+
+        /// @brief XO-CHIP: SUPER-CHIP with 64kb of memory, two bit planes and audio patterns
+        xo_chip
+    };
+
+    /**
+     * @brief Check whether a 0x0NNN opcode is a screen instruction of the machine (0x00CN, 0x00DN, 0x00FB - 0x00FF)
+     *        instead of a call of machine code
+     * @param opcode Opcode starting with 0
+     * @param model Machine model
+     * @return Whether the opcode is a screen instruction
+     */
+    constexpr bool is_screen_instruction(uint16_t opcode, ar::chip8::machine_model model)
+    {
+        if (model == ar::chip8::machine_model::chip8)
+        {
+            return false;
+        }
+
+        // Scrolling up (0x00DN) only exists on XO-CHIP
+        return (opcode & 0xFFF0) == 0x00C0 || (opcode >= 0x00FB && opcode <= 0x00FF) ||
+               (model == ar::chip8::machine_model::xo_chip && (opcode & 0xFFF0) == 0x00D0);
+    }
+}
+
+#endif //ACCESS_TO_RETRO_MACHINE_MODEL_HPP
@@ -1,5 +1,9 @@
+#include <algorithm>
 #include "ram-memory.hpp"
 
+/// @brief Address where games are loaded
+constexpr std::size_t PROGRAM_START = 0x200;
+
 ar::chip8::ram_memory::ram_memory()
 {
     // Load fontset at 0x050
@@ -9,23 +13,46 @@ ar::chip8::ram_memory::ram_memory()
     }
 }
 
+void ar::chip8::ram_memory::set_size(std::size_t size)
+{
+    _address_mask = static_cast<uint16_t>(std::clamp<std::size_t>(size, 1, ar::chip8::XO_CHIP_RAM_SIZE) - 1);
+}
+
+std::size_t ar::chip8::ram_memory::get_size() const
+{
+    return std::size_t { _address_mask } + 1;
+}
+
+const ar_byte* ar::chip8::ram_memory::get_data() const
+{
+    return _raw_memory.data();
+}
+
+void ar::chip8::ram_memory::load_big_font()
+{
+    std::copy(ar::chip8::BIG_FONTSET.begin(), ar::chip8::BIG_FONTSET.end(),
+              _raw_memory.begin() + ar::chip8::BIG_FONT_ADDRESS);
+}
+
 void ar::chip8::ram_memory::load_binary(ar_executable* executable)
 {
+    std::size_t size = std::min<std::size_t>(executable->size, get_size() - PROGRAM_START);
+
     // Load binary at 0x200
-    for (std::size_t i = 0; i < executable->size; i++)
+    for (std::size_t i = 0; i < size; i++)
     {
-        _raw_memory[i + 0x200] = executable->raw_bytes[i];
+        _raw_memory[i + PROGRAM_START] = executable->raw_bytes[i];
     }
 }
 
 void ar::chip8::ram_memory::write(uint16_t addr, ar_byte value)
 {
-    _raw_memory[addr] = value;
+    _raw_memory[addr & _address_mask] = value;
 }
 
 ar_byte ar::chip8::ram_memory::read(uint16_t addr) const
 {
-    return _raw_memory[addr];
+    return _raw_memory[addr & _address_mask];
 }
 
 uint16_t ar::chip8::ram_memory::read_instruction(uint16_t pc_value) const
@@ -33,3 +60,8 @@ uint16_t ar::chip8::ram_memory::read_instruction(uint16_t pc_value) const
     // Combine bytes at PC and PC+1 to construct an instruction
     return static_cast<uint16_t>((read(pc_value) << 8) | read(pc_value + 1));
 }
+
+uint64_t ar::chip8::ram_memory::hash_state(uint64_t hash) const
+{
+    return ar::chip8::hash_state_bytes(hash, _raw_memory.data(), get_size());
+}
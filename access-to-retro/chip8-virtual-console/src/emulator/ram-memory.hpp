@@ -8,6 +8,7 @@
 #include <access-to-retro-dev/access-to-retro-dev.h>
 #include <cstdlib>
 #include <array>
+#include "state-hash.hpp"
 
 namespace ar::chip8
 {
@@ -32,17 +33,66 @@ namespace ar::chip8
                                                       0xF0, 0x80, 0xF0, 0x80, 0x80,
                                               };
 
+    /// @brief SUPER-CHIP's big font data (8x10 digits 0 - F), this array needs to be loaded to memory at 0x0A0
+    constexpr std::array<ar_byte, 160> BIG_FONTSET =
+                                                  {
+                                                          0x3C, 0x7E, 0xE7, 0xC3, 0xC3, 0xC3, 0xC3, 0xE7, 0x7E, 0x3C,
+                                                          0x18, 0x38, 0x58, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x3C,
+                                                          0x3E, 0x7F, 0xC3, 0x06, 0x0C, 0x18, 0x30, 0x60, 0xFF, 0xFF,
+                                                          0x3C, 0x7E, 0xC3, 0x03, 0x0E, 0x0E, 0x03, 0xC3, 0x7E, 0x3C,
+                                                          0x06, 0x0E, 0x1E, 0x36, 0x66, 0xC6, 0xFF, 0xFF, 0x06, 0x06,
+                                                          0xFF, 0xFF, 0xC0, 0xC0, 0xFC, 0xFE, 0x03, 0xC3, 0x7E, 0x3C,
+                                                          0x3E, 0x7C, 0xC0, 0xC0, 0xFC, 0xFE, 0xC3, 0xC3, 0x7E, 0x3C,
+                                                          0xFF, 0xFF, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x60, 0x60,
+                                                          0x3C, 0x7E, 0xC3, 0xC3, 0x7E, 0x7E, 0xC3, 0xC3, 0x7E, 0x3C,
+                                                          0x3C, 0x7E, 0xC3, 0xC3, 0x7F, 0x3F, 0x03, 0x03, 0x3E, 0x7C,
+                                                          0x3C, 0x7E, 0xC3, 0xC3, 0xFF, 0xFF, 0xC3, 0xC3, 0xC3, 0xC3,
+                                                          0xFC, 0xFE, 0xC3, 0xC3, 0xFE, 0xFE, 0xC3, 0xC3, 0xFE, 0xFC,
+                                                          0x3C, 0x7E, 0xC3, 0xC0, 0xC0, 0xC0, 0xC0, 0xC3, 0x7E, 0x3C,
+                                                          0xFC, 0xFE, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xFE, 0xFC,
+                                                          0xFF, 0xFF, 0xC0, 0xC0, 0xFC, 0xFC, 0xC0, 0xC0, 0xFF, 0xFF,
+                                                          0xFF, 0xFF, 0xC0, 0xC0, 0xFC, 0xFC, 0xC0, 0xC0, 0xC0, 0xC0,
+                                                  };
+
+    /// @brief Address of the big font in memory
+    constexpr uint16_t BIG_FONT_ADDRESS = 0x0A0;
+
     /// @brief Represents the size of CHIP8 RAM - 4kb
     constexpr std::size_t RAM_SIZE = 4096;
 
+    /// @brief Represents the size of XO-CHIP RAM - 64kb, the most any machine model has
+    constexpr std::size_t XO_CHIP_RAM_SIZE = 65536;
+
     /// @brief Represents random access memory of CHIP8
     class ram_memory
     {
     public:
         ram_memory();
 
+        /**
+         * @brief Set size of the memory, addresses wrap around at it
+         * @param size Size of the memory, power of two up to 'XO_CHIP_RAM_SIZE'
+         */
+        void set_size(std::size_t size);
+
+        /**
+         * @brief Getter for size of the memory
+         * @return Size in bytes
+         */
+        [[nodiscard]] std::size_t get_size() const;
+
+        /**
+         * @brief Getter for raw memory, lets static analysis read the whole memory at once
+         * @return First of 'get_size' bytes
+         */
+        [[nodiscard]] const ar_byte* get_data() const;
+
+        /// @brief Load SUPER-CHIP's big font at 'BIG_FONT_ADDRESS', CHIP8 games may use that memory for themselves
+        void load_big_font();
+
         /**
          * @brief Loads a game ROM into the memory
+         * @details Bytes that do not fit into the memory are not loaded.
          * @param executable Access to retro library executable
          */
         void load_binary(ar_executable* executable);
@@ -69,10 +119,19 @@ namespace ar::chip8
          */
         [[nodiscard]] uint16_t read_instruction(uint16_t pc_value) const;
 
+        /**
+         * @brief Continue state hash with the whole memory (only up to its size)
+         * @param hash Hash so far
+         * @return Updated hash
+         */
+        [[nodiscard]] uint64_t hash_state(uint64_t hash) const;
 
     private:
-        /// @brief Raw representation of the memory using an array
-        std::array<ar_byte, ar::chip8::RAM_SIZE> _raw_memory { 0 };
+        /// @brief Raw representation of the memory using an array, large enough for every machine model
+        std::array<ar_byte, ar::chip8::XO_CHIP_RAM_SIZE> _raw_memory { 0 };
+
+        /// @brief Mask applied to every address, size of the memory minus one
+        uint16_t _address_mask = ar::chip8::RAM_SIZE - 1;
     };
 }
 
@@ -0,0 +1,573 @@
+#include <algorithm>
+#include <cstdio>
+#include "rom-analysis.hpp"
+
+/// @brief Address where games start
+static constexpr uint32_t PROGRAM_START = 0x200;
+
+/**
+ * @brief Get opcode at an address
+ * @param memory Memory
+ * @param address Address, the opcode has to fit in the memory
+ * @return Opcode
+ */
+static uint16_t read_opcode(const uint8_t* memory, uint32_t address)
+{
+    return static_cast<uint16_t>(memory[address] << 8 | memory[address + 1]);
+}
+
+/**
+ * @brief Get length of the instruction at an address
+ * @param memory Memory
+ * @param size Size of the memory
+ * @param address Address of the instruction
+ * @param model Machine model
+ * @return 2, 4 for XO-CHIP's 0xF000 NNNN, 0 if the instruction does not fit in the memory
+ */
+static uint32_t get_instruction_length(const uint8_t* memory, std::size_t size, uint32_t address,
+                                       ar::chip8::machine_model model)
+{
+    if (size - address < 2)
+    {
+        return 0;
+    }
+
+    if (model != ar::chip8::machine_model::xo_chip || read_opcode(memory, address) != 0xF000)
+    {
+        return 2;
+    }
+
+    return size - address < 4 ? 0 : 4;
+}
+
+/**
+ * @brief Check whether the CPU executes an opcode of the 0x8, 0xE and 0xF groups, it ignores the others
+ * @param opcode Opcode
+ * @param model Machine model
+ * @return Whether the opcode is executed
+ */
+static bool is_known_opcode(uint16_t opcode, ar::chip8::machine_model model)
+{
+    bool xo_chip    = model == ar::chip8::machine_model::xo_chip;
+    bool super_chip = model != ar::chip8::machine_model::chip8;
+
+    switch (opcode & 0xF000)
+    {
+        case 0x8000:
+            return (opcode & 0x000F) <= 0x7 || (opcode & 0x000F) == 0xE;
+
+        case 0xE000:
+            return (opcode & 0x00FF) == 0x9E || (opcode & 0x00FF) == 0xA1;
+
+        case 0xF000:
+            switch (opcode & 0x00FF)
+            {
+                case 0x00:
+                    return xo_chip && opcode == 0xF000;
+
+                case 0x01:
+                case 0x3A:
+                    return xo_chip;
+
+                case 0x02:
+                    return xo_chip && opcode == 0xF002;
+
+                case 0x30:
+                case 0x75:
+                case 0x85:
+                    return super_chip;
+
+                case 0x07:
+                case 0x0A:
+                case 0x15:
+                case 0x18:
+                case 0x1E:
+                case 0x29:
+                case 0x33:
+                case 0x55:
+                case 0x65:
+                    return true;
+
+                default:
+                    return false;
+            }
+
+        default:
+            return true;
+    }
+}
+
+/**
+ * @brief Decoder for the developer library's control flow walk, follows 'cpu::decode_and_execute'
+ * @param memory Memory
+ * @param size Size of the memory
+ * @param address Address of the instruction
+ * @param user_data Pointer to the machine model
+ * @return Instruction's control flow
+ */
+static ar_code_flow decode_flow(const uint8_t* memory, std::size_t size, uint32_t address, void* user_data)
+{
+    ar::chip8::machine_model model = *static_cast<const ar::chip8::machine_model*>(user_data);
+
+    ar_code_flow flow { get_instruction_length(memory, size, address, model), ar_code_flow_next, 0, false };
+    if (flow.length == 0)
+    {
+        return flow;
+    }
+
+    uint16_t opcode = read_opcode(memory, address);
+
+    // Memory is zeroed past the end of the game, running into it is never intended
+    if (opcode == 0x0000 || !is_known_opcode(opcode, model))
+    {
+        flow.length = 0;
+        return flow;
+    }
+
+    flow.target = opcode & 0x0FFFu;
+
+    switch (opcode & 0xF000)
+    {
+        case 0x0000:
+            if (opcode == 0x00EE)
+            {
+                flow.kind = ar_code_flow_return;
+            }
+            else if (opcode == 0x00FD && ar::chip8::is_screen_instruction(opcode, model))
+            {
+                // CPU stays on the exit instruction forever
+                flow.kind = ar_code_flow_stop;
+            }
+            else if (opcode != 0x00E0 && !ar::chip8::is_screen_instruction(opcode, model))
+            {
+                flow.kind = ar_code_flow_call;
+            }
+            break;
+
+        case 0x1000:
+            flow.kind = ar_code_flow_jump;
+            break;
+
+        case 0x2000:
+            flow.kind = ar_code_flow_call;
+            break;
+
+        case 0x5000:
+            if (model == ar::chip8::machine_model::xo_chip && (opcode & 0x000F) == 0x2)
+            {
+                flow.writes_memory = true;
+                break;
+            }
+
+            if (model == ar::chip8::machine_model::xo_chip && (opcode & 0x000F) == 0x3)
+            {
+                break;
+            }
+
+            [[fallthrough]];
+
+        case 0x3000:
+        case 0x4000:
+        case 0x9000:
+        case 0xE000:
+        {
+            // Skips jump over the next instruction, which is 4 bytes long for XO-CHIP's 0xF000 NNNN
+            uint32_t next_length = get_instruction_length(memory, size, address + 2, model);
+
+            flow.kind   = ar_code_flow_branch;
+            flow.target = address + 2 + std::max<uint32_t>(next_length, 2);
+            break;
+        }
+
+        case 0xB000:
+            flow.kind = ar_code_flow_indirect;
+            break;
+
+        case 0xF000:
+            flow.writes_memory = (opcode & 0x00FF) == 0x33 || (opcode & 0x00FF) == 0x55;
+            break;
+
+        default:
+            break;
+    }
+
+    return flow;
+}
+
+/**
+ * @brief Get name of a register for the disassembly
+ * @param index Register index
+ * @return Name, for example 'VA'
+ */
+static std::string register_name(uint32_t index)
+{
+    return std::string("V") + "0123456789ABCDEF"[index & 0xF];
+}
+
+ar::chip8::rom_analysis::~rom_analysis()
+{
+    ar_code_map_destroy(&_code_map);
+}
+
+void ar::chip8::rom_analysis::analyze(const ar::chip8::ram_memory& ram, ar::chip8::machine_model model)
+{
+    _instructions.clear();
+    _blocks.clear();
+    _code_writes.clear();
+
+    // Map is only allocated again when the machine model changes the size of the memory
+    if (_code_map.size != ram.get_size())
+    {
+        ar_code_map_destroy(&_code_map);
+        if (ar_code_map_create(&_code_map, ram.get_size()) != 0)
+        {
+            _memory_size = 0;
+            _instruction_index.clear();
+            return;
+        }
+    }
+
+    _memory_size = ram.get_size();
+    _instruction_index.assign(_memory_size, NO_INSTRUCTION);
+
+    const ar_byte* memory = ram.get_data();
+    uint32_t entry        = PROGRAM_START;
+
+    ar_code_map_analyze(&_code_map, memory, &entry, 1, decode_flow, &model);
+
+    _instructions.reserve(_code_map.instruction_count);
+    _blocks.reserve(_code_map.block_count);
+
+    // Map only tells where instructions start, read them once more in address order to build the flat array
+    uint32_t block_end = 0;
+    for (uint32_t address = 0; address < _memory_size; address++)
+    {
+        uint8_t flags = _code_map.flags[address];
+        if ((flags & AR_CODE_INSTRUCTION) == 0)
+        {
+            continue;
+        }
+
+        uint16_t opcode = read_opcode(memory, address);
+        uint32_t length = get_instruction_length(memory, _memory_size, address, model);
+
+        // Overlapping instructions also cut the block, neither one continues into the other
+        if ((flags & AR_CODE_BLOCK_START) != 0 || address != block_end || _blocks.empty())
+        {
+            _blocks.push_back({ static_cast<uint16_t>(address), 0, static_cast<uint32_t>(_instructions.size()), 0 });
+        }
+
+        ar::chip8::basic_block& block = _blocks.back();
+        block.end = static_cast<uint16_t>(address + length);
+        block.instruction_count++;
+        block_end = address + length;
+
+        _instruction_index[address] = static_cast<uint32_t>(_instructions.size());
+        _instructions.push_back({ static_cast<uint16_t>(address), opcode,
+                                  static_cast<uint16_t>(length == 4 ? read_opcode(memory, address + 2) : 0),
+                                  static_cast<uint8_t>(length), flags, static_cast<uint32_t>(_blocks.size() - 1) });
+    }
+
+    find_code_writes();
+}
+
+void ar::chip8::rom_analysis::find_code_writes()
+{
+    for (const ar::chip8::basic_block& block : _blocks)
+    {
+        // Blocks can be entered from anywhere, I is only known once the block sets it
+        bool     i_known = false;
+        uint16_t i_value = 0;
+
+        for (uint32_t index = block.first_instruction; index < block.first_instruction + block.instruction_count;
+             index++)
+        {
+            const ar::chip8::decoded_instruction& instruction = _instructions[index];
+            uint16_t opcode = instruction.opcode;
+            uint32_t x      = (opcode & 0x0F00u) >> 8;
+            uint32_t y      = (opcode & 0x00F0u) >> 4;
+
+            if ((opcode & 0xF000) == 0xA000)
+            {
+                i_known = true;
+                i_value = opcode & 0x0FFF;
+                continue;
+            }
+
+            if (instruction.length == 4)
+            {
+                i_known = true;
+                i_value = instruction.long_address;
+                continue;
+            }
+
+            if ((instruction.flags & AR_CODE_WRITES_MEMORY) != 0)
+            {
+                uint16_t length = 3;
+                if ((opcode & 0xF0FF) == 0xF055)
+                {
+                    length = static_cast<uint16_t>(x + 1);
+                }
+                else if ((opcode & 0xF000) == 0x5000)
+                {
+                    length = static_cast<uint16_t>((x > y ? x - y : y - x) + 1);
+                }
+
+                bool hits_code = !i_known;
+                for (uint32_t offset = 0; offset < length && !hits_code; offset++)
+                {
+                    hits_code = (_code_map.flags[(i_value + offset) % _memory_size] &
+                                 (AR_CODE_INSTRUCTION | AR_CODE_OPERAND)) != 0;
+                }
+
+                if (hits_code)
+                {
+                    _code_writes.push_back({ instruction.address, i_value, length, i_known });
+                }
+            }
+
+            // Instructions that move I to a value the analysis does not follow
+            switch (opcode & 0xF0FF)
+            {
+                case 0xF01E:
+                case 0xF029:
+                case 0xF030:
+                case 0xF055:
+                case 0xF065:
+                    i_known = false;
+                    break;
+
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+const std::vector<ar::chip8::decoded_instruction>& ar::chip8::rom_analysis::get_instructions() const
+{
+    return _instructions;
+}
+
+const std::vector<ar::chip8::basic_block>& ar::chip8::rom_analysis::get_blocks() const
+{
+    return _blocks;
+}
+
+const std::vector<ar::chip8::code_write>& ar::chip8::rom_analysis::get_code_writes() const
+{
+    return _code_writes;
+}
+
+const ar::chip8::decoded_instruction* ar::chip8::rom_analysis::find_instruction(uint16_t address) const
+{
+    if (address >= _instruction_index.size() || _instruction_index[address] == NO_INSTRUCTION)
+    {
+        return nullptr;
+    }
+
+    return &_instructions[_instruction_index[address]];
+}
+
+uint8_t ar::chip8::rom_analysis::get_flags(uint16_t address) const
+{
+    return address < _memory_size ? _code_map.flags[address] : 0;
+}
+
+std::size_t ar::chip8::rom_analysis::get_memory_size() const
+{
+    return _memory_size;
+}
+
+std::string ar::chip8::disassemble(uint16_t opcode, uint16_t long_address, ar::chip8::machine_model model)
+{
+    std::string vx  = register_name(opcode >> 8);
+    std::string vy  = register_name(opcode >> 4);
+    uint32_t    nnn = opcode & 0x0FFFu;
+    uint32_t    nn  = opcode & 0x00FFu;
+    uint32_t    n   = opcode & 0x000Fu;
+
+    char text[32];
+    std::snprintf(text, sizeof(text), "DW 0x%04X", opcode);
+
+    if (opcode == 0x0000 || !is_known_opcode(opcode, model))
+    {
+        return text;
+    }
+
+    switch (opcode & 0xF000)
+    {
+        case 0x0000:
+            if (opcode == 0x00E0)
+            {
+                return "CLS";
+            }
+
+            if (opcode == 0x00EE)
+            {
+                return "RET";
+            }
+
+            if (!ar::chip8::is_screen_instruction(opcode, model))
+            {
+                std::snprintf(text, sizeof(text), "SYS 0x%03X", nnn);
+                break;
+            }
+
+            switch (opcode & 0x00F0)
+            {
+                case 0xC0:
+                    std::snprintf(text, sizeof(text), "SCD %u", n);
+                    break;
+
+                case 0xD0:
+                    std::snprintf(text, sizeof(text), "SCU %u", n);
+                    break;
+
+                default:
+                {
+                    static constexpr std::array<const char*, 5> SCREEN_NAMES = { "SCR", "SCL", "EXIT", "LOW", "HIGH" };
+                    return SCREEN_NAMES[opcode - 0x00FB];
+                }
+            }
+            break;
+
+        case 0x1000:
+            std::snprintf(text, sizeof(text), "JP 0x%03X", nnn);
+            break;
+
+        case 0x2000:
+            std::snprintf(text, sizeof(text), "CALL 0x%03X", nnn);
+            break;
+
+        case 0x3000:
+            std::snprintf(text, sizeof(text), "SE %s, 0x%02X", vx.c_str(), nn);
+            break;
+
+        case 0x4000:
+            std::snprintf(text, sizeof(text), "SNE %s, 0x%02X", vx.c_str(), nn);
+            break;
+
+        case 0x5000:
+            if (model == ar::chip8::machine_model::xo_chip && n == 0x2)
+            {
+                std::snprintf(text, sizeof(text), "SAVE %s - %s", vx.c_str(), vy.c_str());
+            }
+            else if (model == ar::chip8::machine_model::xo_chip && n == 0x3)
+            {
+                std::snprintf(text, sizeof(text), "LOAD %s - %s", vx.c_str(), vy.c_str());
+            }
+            else
+            {
+                std::snprintf(text, sizeof(text), "SE %s, %s", vx.c_str(), vy.c_str());
+            }
+            break;
+
+        case 0x6000:
+            std::snprintf(text, sizeof(text), "LD %s, 0x%02X", vx.c_str(), nn);
+            break;
+
+        case 0x7000:
+            std::snprintf(text, sizeof(text), "ADD %s, 0x%02X", vx.c_str(), nn);
+            break;
+
+        case 0x8000:
+        {
+            static constexpr std::array<const char*, 16> ALU_NAMES =
+                    {
+                            "LD", "OR", "AND", "XOR", "ADD", "SUB", "SHR", "SUBN",
+                            "", "", "", "", "", "", "SHL", ""
+                    };
+
+            std::snprintf(text, sizeof(text), "%s %s, %s", ALU_NAMES[n], vx.c_str(), vy.c_str());
+            break;
+        }
+
+        case 0x9000:
+            std::snprintf(text, sizeof(text), "SNE %s, %s", vx.c_str(), vy.c_str());
+            break;
+
+        case 0xA000:
+            std::snprintf(text, sizeof(text), "LD I, 0x%03X", nnn);
+            break;
+
+        case 0xB000:
+            std::snprintf(text, sizeof(text), "JP V0, 0x%03X", nnn);
+            break;
+
+        case 0xC000:
+            std::snprintf(text, sizeof(text), "RND %s, 0x%02X", vx.c_str(), nn);
+            break;
+
+        case 0xD000:
+            std::snprintf(text, sizeof(text), "DRW %s, %s, %u", vx.c_str(), vy.c_str(), n);
+            break;
+
+        case 0xE000:
+            std::snprintf(text, sizeof(text), "%s %s", nn == 0x9E ? "SKP" : "SKNP", vx.c_str());
+            break;
+
+        case 0xF000:
+            switch (nn)
+            {
+                case 0x00:
+                    std::snprintf(text, sizeof(text), "LD I, 0x%04X", long_address);
+                    break;
+
+                case 0x01:
+                    std::snprintf(text, sizeof(text), "PLANE %u", (opcode & 0x0F00u) >> 8);
+                    break;
+
+                case 0x02:
+                    return "AUDIO";
+
+                case 0x07:
+                    return "LD " + vx + ", DT";
+
+                case 0x0A:
+                    return "LD " + vx + ", K";
+
+                case 0x15:
+                    return "LD DT, " + vx;
+
+                case 0x18:
+                    return "LD ST, " + vx;
+
+                case 0x1E:
+                    return "ADD I, " + vx;
+
+                case 0x29:
+                    return "LD F, " + vx;
+
+                case 0x30:
+                    return "LD HF, " + vx;
+
+                case 0x33:
+                    return "LD B, " + vx;
+
+                case 0x3A:
+                    return "PITCH " + vx;
+
+                case 0x55:
+                    return "LD [I], " + vx;
+
+                case 0x65:
+                    return "LD " + vx + ", [I]";
+
+                case 0x75:
+                    return "LD R, " + vx;
+
+                case 0x85:
+                    return "LD " + vx + ", R";
+
+                default:
+                    break;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return text;
+}
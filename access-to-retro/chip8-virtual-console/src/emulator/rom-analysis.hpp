@@ -0,0 +1,177 @@
+/**
+ * @file emulator/rom-analysis.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_ROM_ANALYSIS_HPP
+#define ACCESS_TO_RETRO_ROM_ANALYSIS_HPP
+
+#include <access-to-retro-dev/access-to-retro-dev.h>
+#include <string>
+#include <vector>
+#include "machine-model.hpp"
+#include "ram-memory.hpp"
+
+namespace ar::chip8
+{
+    /// @brief Instruction decoded ahead of time by 'rom_analysis'
+    struct decoded_instruction
+    {
+        /// @brief Address of the instruction
+        uint16_t address;
+
+        /// @brief Encoded instruction (opcode)
+        uint16_t opcode;
+
+        /// @brief Address NNNN following XO-CHIP's 0xF000, 0 for other instructions
+        uint16_t long_address;
+
+        /// @brief Number of bytes (2, or 4 for 0xF000 NNNN)
+        uint8_t length;
+
+        /// @brief 'AR_CODE_*' flags of the instruction
+        uint8_t flags;
+
+        /// @brief Index of the basic block the instruction belongs to
+        uint32_t block;
+    };
+
+    /// @brief Straight-line run of instructions, only entered at the start and only left at the end
+    struct basic_block
+    {
+        /// @brief Address of the first instruction
+        uint16_t start;
+
+        /// @brief Address right after the last instruction
+        uint16_t end;
+
+        /// @brief Index of the first instruction in 'rom_analysis::get_instructions'
+        uint32_t first_instruction;
+
+        /// @brief Number of instructions
+        uint32_t instruction_count;
+    };
+
+    /// @brief Instruction that writes to memory that may hold code
+    struct code_write
+    {
+        /// @brief Address of the writing instruction
+        uint16_t instruction;
+
+        /// @brief First written address, only valid if the target is known
+        uint16_t target;
+
+        /// @brief Number of written bytes
+        uint16_t length;
+
+        /// @brief Whether I is known at the instruction (set in the same block), unknown targets may be anywhere
+        bool target_known;
+    };
+
+    /**
+     * @brief Static analysis of a loaded game: code, data and basic blocks found by walking control flow from 0x200
+     * @details Uses the developer library's control flow walk with a decoder that follows 'cpu::decode_and_execute'.
+     *          Each reachable instruction is decoded into a flat array that can be looked up by address, so a
+     *          disassembly view (or an interpreter) does not decode the same bytes again. Opcodes the CPU ignores and
+     *          0x0000 end the walk, games never execute them so their bytes are data.
+     *
+     *          Writes to memory (0xFX33, 0xFX55, 0x5XY2) are checked against the code: with I set by 0xANNN (or
+     *          0xF000 NNNN) earlier in the same block the target is known and reported only if it hits code, with
+     *          unknown I the write is reported as a possible self-modification. Jumps through 0xBNNN are flagged with
+     *          'AR_CODE_INDIRECT', code only reached through them is not found.
+     */
+    class rom_analysis
+    {
+    public:
+        /// @brief Default constructor, the code map is allocated by the first analysis and kept for the next ones
+        rom_analysis() = default;
+
+        ~rom_analysis();
+
+        rom_analysis(const rom_analysis&) = delete;
+
+        rom_analysis& operator=(const rom_analysis&) = delete;
+
+        /**
+         * @brief Analyse a loaded game, replaces the previous result
+         * @param ram Memory with the game loaded
+         * @param model Machine the game runs on, decides which opcodes exist and how long they are
+         */
+        void analyze(const ar::chip8::ram_memory& ram, ar::chip8::machine_model model);
+
+        /**
+         * @brief Getter for decoded instructions
+         * @return Reachable instructions sorted by address
+         */
+        [[nodiscard]] const std::vector<ar::chip8::decoded_instruction>& get_instructions() const;
+
+        /**
+         * @brief Getter for basic blocks
+         * @return Basic blocks sorted by address
+         */
+        [[nodiscard]] const std::vector<ar::chip8::basic_block>& get_blocks() const;
+
+        /**
+         * @brief Getter for writes that may modify code
+         * @return Writes sorted by address of the instruction
+         */
+        [[nodiscard]] const std::vector<ar::chip8::code_write>& get_code_writes() const;
+
+        /**
+         * @brief Find decoded instruction at an address
+         * @param address Address of the instruction
+         * @return Instruction, nullptr if no reachable instruction starts there
+         */
+        [[nodiscard]] const ar::chip8::decoded_instruction* find_instruction(uint16_t address) const;
+
+        /**
+         * @brief Get flags of a byte
+         * @param address Address of the byte
+         * @return 'AR_CODE_*' flags, 0 for data
+         */
+        [[nodiscard]] uint8_t get_flags(uint16_t address) const;
+
+        /**
+         * @brief Get size of the analysed memory
+         * @return Size in bytes
+         */
+        [[nodiscard]] std::size_t get_memory_size() const;
+
+    private:
+        /// @brief Index of 'find_instruction' for addresses without an instruction
+        static constexpr uint32_t NO_INSTRUCTION = UINT32_MAX;
+
+        /// @brief Flags of every byte filled by the developer library
+        ar_code_map _code_map {};
+
+        /// @brief Size of the analysed memory
+        std::size_t _memory_size = 0;
+
+        /// @brief Reachable instructions sorted by address
+        std::vector<ar::chip8::decoded_instruction> _instructions;
+
+        /// @brief Index into '_instructions' for every address, 'NO_INSTRUCTION' if none starts there
+        std::vector<uint32_t> _instruction_index;
+
+        /// @brief Basic blocks sorted by address
+        std::vector<ar::chip8::basic_block> _blocks;
+
+        /// @brief Writes that may modify code
+        std::vector<ar::chip8::code_write> _code_writes;
+
+        /// @brief Find writes that may hit code, follows I through each block
+        void find_code_writes();
+    };
+
+    /**
+     * @brief Get assembly of an instruction
+     * @details Mnemonics follow Cowgod's reference (SUPER-CHIP and XO-CHIP ones are named after Octo's), opcodes the
+     *          machine does not have are shown as 'DW'.
+     * @param opcode Encoded instruction
+     * @param long_address Address NNNN following 0xF000 on XO-CHIP
+     * @param model Machine the instruction runs on
+     * @return Assembly, for example 'LD V1, 0x2A'
+     */
+    [[nodiscard]] std::string disassemble(uint16_t opcode, uint16_t long_address, ar::chip8::machine_model model);
+}
+
+#endif //ACCESS_TO_RETRO_ROM_ANALYSIS_HPP
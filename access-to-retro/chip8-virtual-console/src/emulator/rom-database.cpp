@@ -0,0 +1,94 @@
+#include <algorithm>
+#include "rom-database.hpp"
+#include "state-hash.hpp"
+
+/// @brief Built-in entry of the database
+struct rom_database_entry
+{
+    /// @brief Hash of the ROM, see 'ar::chip8::get_rom_hash'
+    uint64_t rom_hash;
+
+    /// @brief Machine the game was written for
+    ar::chip8::machine_model model;
+
+    /// @brief Instructions executed per second
+    uint32_t clock_speed;
+
+    /// @brief Quirks the game expects
+    ar::chip8::cpu_quirks quirks;
+};
+
+/*
+ * Known games. Hash of a ROM is printed by 'access-to-retro-chip8-guest-profile', quirk sets are the usual way to fill
+ * in quirks, single quirks can be set with 'cpu_quirks' designated initializers. Games written for the COSMAC VIP
+ * usually need 'quirk_set::cosmac_vip', SUPER-CHIP games need 'machine_model::super_chip', 'quirk_set::super_chip' and
+ * often 1000+ hz, XO-CHIP games need 'machine_model::xo_chip' and usually run at 1000s of hz.
+ */
+static const rom_database_entry ROM_DATABASE_ENTRIES[] =
+        {
+                // Golden frame test ROMs ('tests/roms'), pinned to the defaults their traces were recorded with
+                { 0x96E7EAFEDB6AB495, ar::chip8::machine_model::chip8, ar::chip8::CLOCK_SPEED, {} },
+                { 0x0B25C942F16699EB, ar::chip8::machine_model::chip8, ar::chip8::CLOCK_SPEED, {} },
+                { 0x35AC321158A914A4, ar::chip8::machine_model::chip8, ar::chip8::CLOCK_SPEED, {} },
+                { 0x70C11CE9EF2B05BD, ar::chip8::machine_model::super_chip, ar::chip8::CLOCK_SPEED,
+                  ar::chip8::get_quirk_set_quirks(ar::chip8::quirk_set::super_chip) },
+                { 0x8B6F0095EEB92A2F, ar::chip8::machine_model::xo_chip, ar::chip8::CLOCK_SPEED, {} },
+        };
+
+uint64_t ar::chip8::get_rom_hash(const ar_byte* bytes, std::size_t size)
+{
+    return ar::chip8::hash_state_bytes(ar::chip8::STATE_HASH_BASIS, bytes, size);
+}
+
+ar::chip8::rom_database::rom_database()
+{
+    _index.reserve(std::size(ROM_DATABASE_ENTRIES));
+
+    for (const rom_database_entry& entry : ROM_DATABASE_ENTRIES)
+    {
+        _index.push_back({ entry.rom_hash, entry.clock_speed, pack_quirks(entry.quirks), entry.model });
+    }
+
+    std::sort(_index.begin(), _index.end(),
+              [](const index_entry& a, const index_entry& b) { return a.rom_hash < b.rom_hash; });
+}
+
+std::optional<ar::chip8::rom_profile> ar::chip8::rom_database::find_profile(uint64_t rom_hash) const
+{
+    auto entry = std::lower_bound(_index.begin(), _index.end(), rom_hash,
+                                  [](const index_entry& a, uint64_t hash) { return a.rom_hash < hash; });
+
+    if (entry == _index.end() || entry->rom_hash != rom_hash)
+    {
+        return std::nullopt;
+    }
+
+    return ar::chip8::rom_profile { entry->model, entry->clock_speed, unpack_quirks(entry->quirk_bits) };
+}
+
+std::size_t ar::chip8::rom_database::get_profile_count() const
+{
+    return _index.size();
+}
+
+uint8_t ar::chip8::rom_database::pack_quirks(const ar::chip8::cpu_quirks& quirks)
+{
+    return static_cast<uint8_t>((quirks.shift_uses_vy ? 1 << 0 : 0) |
+                                (quirks.load_store_increments_i ? 1 << 1 : 0) |
+                                (quirks.jump_uses_vx ? 1 << 2 : 0) |
+                                (quirks.logic_resets_vf ? 1 << 3 : 0) |
+                                (quirks.clip_sprites ? 1 << 4 : 0) |
+                                (quirks.wait_for_vblank ? 1 << 5 : 0));
+}
+
+ar::chip8::cpu_quirks ar::chip8::rom_database::unpack_quirks(uint8_t quirk_bits)
+{
+    return {
+            .shift_uses_vy           = (quirk_bits & 1 << 0) != 0,
+            .load_store_increments_i = (quirk_bits & 1 << 1) != 0,
+            .jump_uses_vx            = (quirk_bits & 1 << 2) != 0,
+            .logic_resets_vf         = (quirk_bits & 1 << 3) != 0,
+            .clip_sprites            = (quirk_bits & 1 << 4) != 0,
+            .wait_for_vblank         = (quirk_bits & 1 << 5) != 0
+    };
+}
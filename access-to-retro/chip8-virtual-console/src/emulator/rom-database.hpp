@@ -0,0 +1,99 @@
+/**
+ * @file emulator/rom-database.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_ROM_DATABASE_HPP
+#define ACCESS_TO_RETRO_ROM_DATABASE_HPP
+
+#include <access-to-retro-dev/access-to-retro-dev.h>
+#include <optional>
+#include <vector>
+#include "cpu-policy.hpp"
+#include "emulator.hpp"
+#include "machine-model.hpp"
+
+namespace ar::chip8
+{
+    /// @brief How a game has to be run, games not in the database run with the defaults
+    struct rom_profile
+    {
+        /// @brief Machine the game was written for
+        ar::chip8::machine_model model = ar::chip8::machine_model::chip8;
+
+        /// @brief Instructions executed per second
+        uint32_t clock_speed = ar::chip8::CLOCK_SPEED;
+
+        /// @brief Quirks the game expects
+        ar::chip8::cpu_quirks quirks {};
+    };
+
+    /**
+     * @brief Hash a ROM, database entries are keyed by it
+     * @details Same 64-bit FNV-1a as state hashes, 'access-to-retro-chip8-guest-profile' prints it for new entries.
+     * @param bytes Bytes of the ROM
+     * @param size Number of bytes
+     * @return Hash of the ROM
+     */
+    [[nodiscard]] uint64_t get_rom_hash(const ar_byte* bytes, std::size_t size);
+
+    /**
+     * @brief Machine model, clock speed and quirks of known games, keyed by hash of the ROM
+     * @details Built-in entries are packed into a sorted index when the database is created, lookups are a binary
+     *          search over 16 bytes per game.
+     */
+    class rom_database
+    {
+    public:
+        /// @brief Default constructor, builds the index of built-in entries
+        rom_database();
+
+        /**
+         * @brief Find profile of a game
+         * @param rom_hash Hash of the ROM, see 'get_rom_hash'
+         * @return Profile of the game, nothing if the game is not in the database
+         */
+        [[nodiscard]] std::optional<ar::chip8::rom_profile> find_profile(uint64_t rom_hash) const;
+
+        /**
+         * @brief Get number of games in the database
+         * @return Game count
+         */
+        [[nodiscard]] std::size_t get_profile_count() const;
+
+    private:
+        /// @brief Packed profile of a single game
+        struct index_entry
+        {
+            /// @brief Hash of the ROM, index is sorted by it
+            uint64_t rom_hash;
+
+            /// @brief Instructions executed per second
+            uint32_t clock_speed;
+
+            /// @brief Quirks, one bit per 'cpu_quirks' member
+            uint8_t quirk_bits;
+
+            /// @brief Machine the game was written for
+            ar::chip8::machine_model model;
+        };
+
+        /// @brief Profiles sorted by ROM hash
+        std::vector<index_entry> _index;
+
+        /**
+         * @brief Pack quirks into bits of an index entry
+         * @param quirks Quirks
+         * @return Quirk bits
+         */
+        static uint8_t pack_quirks(const ar::chip8::cpu_quirks& quirks);
+
+        /**
+         * @brief Unpack quirks from bits of an index entry
+         * @param quirk_bits Quirk bits
+         * @return Quirks
+         */
+        static ar::chip8::cpu_quirks unpack_quirks(uint8_t quirk_bits);
+    };
+}
+
+#endif //ACCESS_TO_RETRO_ROM_DATABASE_HPP
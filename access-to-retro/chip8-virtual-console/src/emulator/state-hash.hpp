@@ -0,0 +1,41 @@
+/**
+ * @file emulator/state-hash.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_STATE_HASH_HPP
+#define ACCESS_TO_RETRO_STATE_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ar::chip8
+{
+    /// @brief Starting value of state hashes (FNV-1a 64-bit offset basis)
+    constexpr uint64_t STATE_HASH_BASIS = 14695981039346656037ULL;
+
+    /// @brief FNV-1a 64-bit prime
+    constexpr uint64_t STATE_HASH_PRIME = 1099511628211ULL;
+
+    /**
+     * @brief Continue FNV-1a hash with bytes of an object
+     * @details Used to compare emulator's state between runs (golden tests), components hash their own state one after
+     *          another so the result does not depend on how they store it.
+     * @param hash Hash so far, 'STATE_HASH_BASIS' for a new one
+     * @param data Bytes to hash
+     * @param size Number of bytes
+     * @return Updated hash
+     */
+    inline uint64_t hash_state_bytes(uint64_t hash, const void* data, std::size_t size)
+    {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+
+        for (std::size_t i = 0; i < size; i++)
+        {
+            hash = (hash ^ bytes[i]) * ar::chip8::STATE_HASH_PRIME;
+        }
+
+        return hash;
+    }
+}
+
+#endif //ACCESS_TO_RETRO_STATE_HASH_HPP
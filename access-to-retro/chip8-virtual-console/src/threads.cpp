@@ -2,7 +2,6 @@
  * @file threads.cpp
  */
 
-#include <cmath>
 #include <access-to-retro-dev/access-to-retro-dev.h>
 #include "emulator/emulator.hpp"
 
@@ -18,26 +17,17 @@
  */
 AR_DEFINE_REQUIRED_FN(AR_THREAD_MAIN_FN)
 {
-    ar::chip8::cpu& cpu = ar::chip8::emulator::get_global_emulator()->access_cpu();
+    std::shared_ptr<ar::chip8::emulator> emulator = ar::chip8::emulator::get_global_emulator();
 
-    /*
-     * To calculate how many instructions need to be executed per frame it can be calculated using
-     * formula: CLOCK_SPEED / FRAME_RATE
-     *
-     * Clock speed is how many instructions are executed per second
-     * Frame rate is how many frames are shown per second (how many times this function gets called too)
-     *
-     * So, for framerate of 60 this function gets called 60 times per second and for clock speed of 600hz
-     * 600 instructions needs to be executed per second therefore 600 / 60 = 10;
-     */
-    for (auto i = 0; i < std::floor(ar::chip8::CLOCK_SPEED / ar::chip8::FRAME_RATE); i++)
+    // Clock speed set by the frontend applies from the next frame on, timers keep their 60hz
+    unsigned clock_speed = ar_get_vc_clock_speed();
+    if (clock_speed != 0 && clock_speed != emulator->get_clock_speed())
     {
-        // Execute one instruction (one cpu tick)
-        cpu.tick();
+        emulator->set_clock_speed(clock_speed);
     }
 
-    // Timers should tick at constant 60hz and not 600hz that cpu runs on so tick timers here and not in the loop
-    cpu.tick_timers();
+    // Executes clock speed / 60 instructions (fractions carry over), ticks the timers and presents the frame
+    emulator->run_frame();
 }
 
 /**
@@ -52,16 +42,7 @@ AR_DEFINE_REQUIRED_FN(AR_THREAD_MAIN_FN)
  */
 AR_DEFINE_REQUIRED_FN(AR_THREAD_RENDER_FN)
 {
-    ar::chip8::gpu& gpu = ar::chip8::emulator::get_global_emulator()->access_gpu();
-
-    if (gpu.get_draw_flag())
-    {
-        // If draw flag is set then draw to the screen
-        gpu.render();
-
-        // Let emulator know rendering happened (clear CPU's draw flag)
-        gpu.set_draw_flag(false);
-    }
+    // Nothing to do, frames are presented from the main thread right after they are drawn (frame buffer method)
 }
 
 /**
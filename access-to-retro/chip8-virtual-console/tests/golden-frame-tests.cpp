@@ -0,0 +1,717 @@
+/**
+ * @file golden-frame-tests.cpp
+ * @details Runs a ROM for a fixed number of frames with scripted inputs and compares every instruction and every frame
+ *          against a committed golden trace, then measures how many instructions per second the emulator executes.
+ *
+ *          Usage: ar_chip8_golden_test <rom> <inputs> <golden trace> <frame count> [--update]
+ *
+ *          Inputs file has one "<frame> <key (hex digit)> <press|release>" line per change, applied before the frame
+ *          runs. Golden trace has one line per frame: "<frame> <presented frame hash> <state hash> <instruction
+ *          hashes>", instruction hashes are the lower 32 bits of the state hash after each instruction of the frame.
+ *          '--update' writes the golden trace from the current emulator instead of comparing.
+ *
+ *          Run is then repeated with the instruction trace recording, the decoded trace has to list exactly the
+ *          instructions of the golden run. Emulation speed is measured both without and with tracing.
+ */
+
+#include <access-to-retro-dev/access-to-retro-dev.h>
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "emulator/emulator.hpp"
+#include "emulator/instruction-trace.hpp"
+#include "emulator/rom-database.hpp"
+
+AR_API AR_DEFINE_FN;
+
+AR_API AR_STARTUP_FN;
+
+AR_API AR_QUIT_FN;
+
+/// @brief Seed of the random number generator, golden traces are only valid for this seed
+static constexpr uint32_t RANDOM_SEED = 0xC8C8C8C8;
+
+/// @brief Timing runs are repeated until they took at least this long, a single run is too short to measure
+static constexpr std::chrono::milliseconds MIN_TIMING_DURATION { 200 };
+
+/// @brief Scripted change of a key's status
+struct input_event
+{
+    /// @brief Frame before which the change is applied
+    uint32_t frame;
+
+    /// @brief Changed key
+    ar::chip8::key key;
+
+    /// @brief Whether the key gets pressed or released
+    bool pressed;
+};
+
+/// @brief Single executed instruction
+struct instruction_record
+{
+    /// @brief Address of the instruction
+    uint16_t address = 0;
+
+    /// @brief Encoded instruction (opcode)
+    uint16_t opcode = 0;
+
+    /// @brief Lower 32 bits of the state hash after the instruction
+    uint32_t state_hash = 0;
+};
+
+/// @brief Single emulated frame
+struct frame_record
+{
+    /// @brief Hash of library's frame buffer after the frame (last presented frame)
+    uint64_t frame_hash = 0;
+
+    /// @brief Hash of the state after the frame (timers ticked)
+    uint64_t state_hash = 0;
+
+    /// @brief Instructions executed during the frame
+    std::vector<instruction_record> instructions;
+};
+
+/****************************************************************************************************
+ Helpers
+****************************************************************************************************/
+
+/**
+ * @brief Read whole file
+ * @param path Path of the file
+ * @param bytes Bytes of the file
+ * @return Whether the file could be read
+ */
+static bool read_file(const std::string& path, std::vector<ar_byte>& bytes)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    return true;
+}
+
+/**
+ * @brief Read scripted inputs, empty lines and lines starting with '#' are skipped
+ * @param path Path of the inputs file
+ * @param inputs Inputs sorted by frame
+ * @return Whether the file could be read and parsed
+ */
+static bool read_inputs(const std::string& path, std::vector<input_event>& inputs)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        std::istringstream stream(line);
+
+        uint32_t frame = 0;
+        unsigned key   = 0;
+        std::string action;
+
+        if (!(stream >> frame >> std::hex >> key >> action) || key >= ar::chip8::KEY_COUNT ||
+            (action != "press" && action != "release"))
+        {
+            std::cerr << "Invalid input line: " << line << std::endl;
+            return false;
+        }
+
+        inputs.push_back({ frame, static_cast<ar::chip8::key>(key), action == "press" });
+    }
+
+    std::stable_sort(inputs.begin(), inputs.end(),
+                     [](const input_event& a, const input_event& b) { return a.frame < b.frame; });
+
+    return true;
+}
+
+/**
+ * @brief Read golden trace
+ * @param path Path of the trace
+ * @param frames Recorded frames, instructions only have their state hash
+ * @return Whether the file could be read and parsed
+ */
+static bool read_golden_trace(const std::string& path, std::vector<frame_record>& frames)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        std::istringstream stream(line);
+
+        std::size_t index = 0;
+        frame_record frame;
+        std::string instruction_hashes;
+
+        if (!(stream >> index >> std::hex >> frame.frame_hash >> frame.state_hash >> instruction_hashes) ||
+            index != frames.size())
+        {
+            std::cerr << "Invalid golden trace line: " << line << std::endl;
+            return false;
+        }
+
+        std::istringstream hashes(instruction_hashes);
+        std::string hash;
+
+        while (std::getline(hashes, hash, ','))
+        {
+            instruction_record instruction;
+            instruction.state_hash = static_cast<uint32_t>(std::stoul(hash, nullptr, 16));
+
+            frame.instructions.push_back(instruction);
+        }
+
+        frames.push_back(frame);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Write golden trace
+ * @param path Path of the trace
+ * @param rom_path Path of the ROM, written into the header
+ * @param frames Recorded frames
+ * @return Whether the file could be written
+ */
+static bool write_golden_trace(const std::string& path, const std::string& rom_path,
+                               const std::vector<frame_record>& frames)
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    file << "# Golden trace of " << rom_path.substr(rom_path.find_last_of("/\\") + 1) << ", random seed 0x"
+         << std::hex << RANDOM_SEED << "\n";
+    file << "# <frame> <presented frame hash> <state hash> <state hashes after each instruction>\n";
+
+    for (std::size_t i = 0; i < frames.size(); i++)
+    {
+        file << std::dec << i << std::hex << std::setfill('0') << " " << std::setw(16) << frames[i].frame_hash << " "
+             << std::setw(16) << frames[i].state_hash << " ";
+
+        for (std::size_t j = 0; j < frames[i].instructions.size(); j++)
+        {
+            file << (j == 0 ? "" : ",") << std::setw(8) << frames[i].instructions[j].state_hash;
+        }
+
+        file << "\n";
+    }
+
+    return file.good();
+}
+
+/**
+ * @brief Format a value as hexadecimal number
+ * @param value Value to format
+ * @param digits Number of digits
+ * @return Formatted value with '0x' prefix
+ */
+static std::string to_hex(uint64_t value, int digits)
+{
+    std::ostringstream stream;
+    stream << "0x" << std::hex << std::setw(digits) << std::setfill('0') << value;
+
+    return stream.str();
+}
+
+/**
+ * @brief Start the virtual console the same way the frontend does, with fixed random seed
+ * @param rom ROM to run, has to outlive the run
+ */
+static void start_virtual_console(const std::vector<ar_byte>& rom)
+{
+    _ar_vc_define();
+
+    ar_create_executable(rom.data(), rom.size());
+
+    _ar_vc_startup();
+
+    ar::chip8::emulator::get_global_emulator()->access_cpu().set_random_seed(RANDOM_SEED);
+}
+
+/**
+ * @brief Find profile of a ROM the same way the virtual console does
+ * @param rom ROM
+ * @return Profile of the ROM, defaults for unknown ROMs
+ */
+static ar::chip8::rom_profile find_rom_profile(const std::vector<ar_byte>& rom)
+{
+    return ar::chip8::rom_database().find_profile(ar::chip8::get_rom_hash(rom.data(), rom.size())).value_or(
+            ar::chip8::rom_profile {});
+}
+
+/**
+ * @brief Record instructions of the running virtual console into a trace, with the game's quirks kept
+ * @param rom Running ROM
+ * @param trace Trace to record into
+ */
+static void enable_tracing(const std::vector<ar_byte>& rom, ar::chip8::instruction_trace& trace)
+{
+    std::shared_ptr<ar::chip8::emulator> emulator = ar::chip8::emulator::get_global_emulator();
+
+    emulator->access_cpu().set_trace_callback(&ar::chip8::instruction_trace::record_instruction_callback, &trace);
+    emulator->set_cpu_configuration(ar::chip8::cpu_configuration { .quirks = find_rom_profile(rom).quirks,
+                                                                   .tracing = true });
+}
+
+/**
+ * @brief Run a frame with the CPU policy of a machine model and the game's quirks, inspecting the state after each
+ *        instruction
+ * @param emulator Emulator to run
+ * @param quirks Quirks of the game
+ * @param on_instruction Called after each executed instruction
+ * @tparam model Machine model of the game
+ */
+template<ar::chip8::machine_model model, typename instruction_callback>
+static void run_inspected_frame_of_model(ar::chip8::emulator& emulator, const ar::chip8::cpu_quirks& quirks,
+                                         instruction_callback&& on_instruction)
+{
+    switch (ar::chip8::find_quirk_set(quirks))
+    {
+        case ar::chip8::quirk_set::chip8:
+            emulator.run_frame<ar::chip8::cpu_policy<model, ar::chip8::quirk_set::chip8, false, false>>(on_instruction);
+            break;
+
+        case ar::chip8::quirk_set::cosmac_vip:
+            emulator.run_frame<ar::chip8::cpu_policy<model, ar::chip8::quirk_set::cosmac_vip, false, false>>(
+                    on_instruction);
+            break;
+
+        case ar::chip8::quirk_set::super_chip:
+            emulator.run_frame<ar::chip8::cpu_policy<model, ar::chip8::quirk_set::super_chip, false, false>>(
+                    on_instruction);
+            break;
+
+        case ar::chip8::quirk_set::custom:
+        default:
+            emulator.run_frame<ar::chip8::cpu_policy<model, ar::chip8::quirk_set::custom, false, false>>(
+                    on_instruction);
+            break;
+    }
+}
+
+/**
+ * @brief Run a frame with the CPU policy of the game's machine model and quirks, inspecting the state after each
+ *        instruction
+ * @details Frame loop with a callback is a template, the policy 'set_cpu_configuration' selected for the virtual
+ *          console is not used by it.
+ * @param emulator Emulator to run
+ * @param quirks Quirks of the game
+ * @param on_instruction Called after each executed instruction
+ */
+template<typename instruction_callback>
+static void run_inspected_frame(ar::chip8::emulator& emulator, const ar::chip8::cpu_quirks& quirks,
+                                instruction_callback&& on_instruction)
+{
+    switch (emulator.access_cpu().get_machine_model())
+    {
+        case ar::chip8::machine_model::super_chip:
+            run_inspected_frame_of_model<ar::chip8::machine_model::super_chip>(emulator, quirks, on_instruction);
+            break;
+
+        case ar::chip8::machine_model::xo_chip:
+            run_inspected_frame_of_model<ar::chip8::machine_model::xo_chip>(emulator, quirks, on_instruction);
+            break;
+
+        case ar::chip8::machine_model::chip8:
+        default:
+            run_inspected_frame_of_model<ar::chip8::machine_model::chip8>(emulator, quirks, on_instruction);
+            break;
+    }
+}
+
+/**
+ * @brief Apply scripted inputs for a frame
+ * @param inputs Scripted inputs sorted by frame
+ * @param frame Frame that is about to run
+ * @param next_input Index of the first input that was not applied yet, advanced past applied inputs
+ */
+static void apply_inputs(const std::vector<input_event>& inputs, uint32_t frame, std::size_t& next_input)
+{
+    ar::chip8::controller& controller = ar::chip8::emulator::get_global_emulator()->access_controller();
+
+    for (; next_input < inputs.size() && inputs[next_input].frame <= frame; next_input++)
+    {
+        controller.set_key_status(inputs[next_input].key,
+                                  inputs[next_input].pressed ? ar_key_status_pressed : ar_key_status_released);
+    }
+}
+
+/**
+ * @brief Hash the last presented frame
+ * @return Hash of library's frame buffer (back buffer holds a copy of the presented frame)
+ */
+static uint64_t get_presented_frame_hash()
+{
+    const ar_frame_buffer* frame_buffer = ar_graphics_get_frame_buffer();
+
+    return ar::chip8::hash_state_bytes(ar::chip8::STATE_HASH_BASIS, frame_buffer->data,
+                                       static_cast<std::size_t>(frame_buffer->pitch) * frame_buffer->height);
+}
+
+/**
+ * @brief Run the ROM and record state after each instruction and each frame
+ * @param rom ROM to run
+ * @param inputs Scripted inputs
+ * @param frame_count Number of frames to run
+ * @return Recorded frames
+ */
+static std::vector<frame_record> record_run(const std::vector<ar_byte>& rom, const std::vector<input_event>& inputs,
+                                            uint32_t frame_count)
+{
+    start_virtual_console(rom);
+
+    std::shared_ptr<ar::chip8::emulator> emulator = ar::chip8::emulator::get_global_emulator();
+    ar::chip8::cpu& cpu = emulator->access_cpu();
+
+    ar::chip8::cpu_quirks quirks = find_rom_profile(rom).quirks;
+
+    std::vector<frame_record> frames(frame_count);
+    std::size_t next_input = 0;
+
+    for (uint32_t i = 0; i < frame_count; i++)
+    {
+        apply_inputs(inputs, i, next_input);
+
+        frame_record& frame = frames[i];
+
+        // Program counter before the tick is the address of the executed instruction
+        uint16_t address = cpu.get_program_counter();
+
+        run_inspected_frame(*emulator, quirks, [&]
+                            {
+                                frame.instructions.push_back({ address, cpu.get_encoded_instruction(),
+                                                               static_cast<uint32_t>(emulator->get_state_hash()) });
+
+                                address = cpu.get_program_counter();
+                            });
+
+        frame.frame_hash = get_presented_frame_hash();
+        frame.state_hash = emulator->get_state_hash();
+    }
+
+    _ar_vc_quit();
+
+    return frames;
+}
+
+/**
+ * @brief Run the ROM with the instruction trace recording, write the trace and decode it
+ * @param rom ROM to run
+ * @param inputs Scripted inputs
+ * @param frame_count Number of frames to run
+ * @param trace_path Path the trace is written to, removed after it is read back
+ * @param entries Decoded instructions
+ * @return Whether the trace was written and decoded
+ */
+static bool record_instruction_trace(const std::vector<ar_byte>& rom, const std::vector<input_event>& inputs,
+                                     uint32_t frame_count, const std::string& trace_path,
+                                     std::vector<ar::chip8::trace_entry>& entries)
+{
+    start_virtual_console(rom);
+
+    std::shared_ptr<ar::chip8::emulator> emulator = ar::chip8::emulator::get_global_emulator();
+
+    ar::chip8::instruction_trace trace(*emulator);
+    enable_tracing(rom, trace);
+
+    std::size_t next_input = 0;
+    for (uint32_t i = 0; i < frame_count; i++)
+    {
+        apply_inputs(inputs, i, next_input);
+
+        emulator->run_frame();
+    }
+
+    // Trace goes through a file the same way a crash dump does
+    std::vector<ar_byte> bytes;
+    int file = ar::chip8::instruction_trace::open_file(trace_path.c_str());
+
+    bool written = file >= 0 && trace.write(file, emulator->access_cpu().get_machine_model());
+    if (file >= 0)
+    {
+        written = ar::chip8::instruction_trace::close_file(file) && written && read_file(trace_path, bytes);
+        std::remove(trace_path.c_str());
+    }
+
+    emulator->access_cpu().set_trace_callback(nullptr, nullptr);
+    _ar_vc_quit();
+
+    ar::chip8::machine_model model = ar::chip8::machine_model::chip8;
+    return written && ar::chip8::instruction_trace::decode(bytes.data(), bytes.size(), entries, model);
+}
+
+/**
+ * @brief Measure emulation speed, without any state inspection
+ * @param rom ROM to run
+ * @param inputs Scripted inputs
+ * @param frame_count Number of frames of a single run
+ * @param tracing Whether the instruction trace records every instruction
+ * @return Number of executed instructions per second
+ */
+static double measure_instructions_per_second(const std::vector<ar_byte>& rom, const std::vector<input_event>& inputs,
+                                              uint32_t frame_count, bool tracing)
+{
+    std::chrono::steady_clock::duration elapsed { 0 };
+    uint64_t instruction_count = 0;
+
+    while (elapsed < MIN_TIMING_DURATION)
+    {
+        start_virtual_console(rom);
+
+        std::shared_ptr<ar::chip8::emulator> emulator = ar::chip8::emulator::get_global_emulator();
+        std::size_t next_input = 0;
+
+        // Trace is allocated before the clock starts, recording is what is measured
+        std::unique_ptr<ar::chip8::instruction_trace> trace;
+        if (tracing)
+        {
+            trace = std::make_unique<ar::chip8::instruction_trace>(*emulator);
+            enable_tracing(rom, *trace);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (uint32_t i = 0; i < frame_count; i++)
+        {
+            apply_inputs(inputs, i, next_input);
+
+            emulator->run_frame();
+        }
+
+        elapsed += std::chrono::steady_clock::now() - start;
+        instruction_count += static_cast<uint64_t>(frame_count) * ar::chip8::INSTRUCTIONS_PER_FRAME;
+
+        emulator->access_cpu().set_trace_callback(nullptr, nullptr);
+        _ar_vc_quit();
+    }
+
+    return static_cast<double>(instruction_count) / std::chrono::duration<double>(elapsed).count();
+}
+
+/**
+ * @brief Compare recorded frames with the golden trace and report the first difference
+ * @param expected Frames from the golden trace
+ * @param actual Recorded frames
+ * @return Whether all frames match
+ */
+static bool compare_with_golden_trace(const std::vector<frame_record>& expected, const std::vector<frame_record>& actual)
+{
+    if (expected.size() < actual.size())
+    {
+        std::cerr << "Golden trace only has " << expected.size() << " of " << actual.size()
+                  << " frames, regenerate it with '--update'" << std::endl;
+        return false;
+    }
+
+    for (std::size_t i = 0; i < actual.size(); i++)
+    {
+        const std::vector<instruction_record>& expected_instructions = expected[i].instructions;
+        const std::vector<instruction_record>& actual_instructions   = actual[i].instructions;
+
+        for (std::size_t j = 0; j < actual_instructions.size(); j++)
+        {
+            if (j >= expected_instructions.size() ||
+                expected_instructions[j].state_hash != actual_instructions[j].state_hash)
+            {
+                std::cerr << "First divergence at frame " << i << ", instruction " << j << " (instruction "
+                          << i * ar::chip8::INSTRUCTIONS_PER_FRAME + j << " overall): "
+                          << to_hex(actual_instructions[j].opcode, 4) << " at "
+                          << to_hex(actual_instructions[j].address, 3) << " left state "
+                          << to_hex(actual_instructions[j].state_hash, 8) << ", expected "
+                          << (j < expected_instructions.size() ? to_hex(expected_instructions[j].state_hash, 8)
+                                                               : "no instruction") << std::endl;
+
+                // Previous instruction leads up to the difference, show it when there is one in this frame
+                if (j > 0)
+                {
+                    std::cerr << "Previous instruction: " << to_hex(actual_instructions[j - 1].opcode, 4) << " at "
+                              << to_hex(actual_instructions[j - 1].address, 3) << std::endl;
+                }
+
+                return false;
+            }
+        }
+
+        if (expected[i].state_hash != actual[i].state_hash)
+        {
+            std::cerr << "First divergence at frame " << i << " after its instructions (timers): state "
+                      << to_hex(actual[i].state_hash, 16) << ", expected " << to_hex(expected[i].state_hash, 16)
+                      << std::endl;
+            return false;
+        }
+
+        if (expected[i].frame_hash != actual[i].frame_hash)
+        {
+            std::cerr << "First divergence at frame " << i << " in the presented frame: "
+                      << to_hex(actual[i].frame_hash, 16) << ", expected " << to_hex(expected[i].frame_hash, 16)
+                      << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Compare decoded instruction trace with the recorded instructions
+ * @param frames Recorded frames
+ * @param entries Decoded instructions
+ * @return Whether the trace lists the same instructions in the same order
+ */
+static bool compare_with_instruction_trace(const std::vector<frame_record>& frames,
+                                           const std::vector<ar::chip8::trace_entry>& entries)
+{
+    std::size_t index = 0;
+
+    for (std::size_t i = 0; i < frames.size(); i++)
+    {
+        for (const instruction_record& instruction : frames[i].instructions)
+        {
+            if (index >= entries.size() || entries[index].address != instruction.address ||
+                entries[index].opcode != instruction.opcode || entries[index].cycle != index + 1)
+            {
+                std::cerr << "Instruction trace differs at instruction " << index << " (frame " << i << "): "
+                          << to_hex(instruction.opcode, 4) << " at " << to_hex(instruction.address, 3)
+                          << " was executed, trace has "
+                          << (index < entries.size() ? to_hex(entries[index].opcode, 4) + " at " +
+                                                       to_hex(entries[index].address, 3) : "no instruction")
+                          << std::endl;
+                return false;
+            }
+
+            index++;
+        }
+    }
+
+    if (index != entries.size())
+    {
+        std::cerr << "Instruction trace has " << entries.size() << " instructions, " << index << " were executed"
+                  << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/****************************************************************************************************
+ Entry point
+****************************************************************************************************/
+
+int main(int argc, char** argv)
+{
+    if (argc != 5 && !(argc == 6 && std::string(argv[5]) == "--update"))
+    {
+        std::cerr << "Usage: " << argv[0] << " <rom> <inputs> <golden trace> <frame count> [--update]" << std::endl;
+        return 1;
+    }
+
+    std::string rom_path    = argv[1];
+    std::string inputs_path = argv[2];
+    std::string golden_path = argv[3];
+    auto frame_count        = static_cast<uint32_t>(std::stoul(argv[4]));
+    bool update             = argc == 6;
+
+    std::vector<ar_byte> rom;
+    if (!read_file(rom_path, rom) || rom.empty() || rom.size() > ar::chip8::RAM_SIZE - 0x200)
+    {
+        std::cerr << "Unable to read ROM '" << rom_path << "'" << std::endl;
+        return 1;
+    }
+
+    std::vector<input_event> inputs;
+    if (!read_inputs(inputs_path, inputs))
+    {
+        std::cerr << "Unable to read inputs '" << inputs_path << "'" << std::endl;
+        return 1;
+    }
+
+    std::vector<frame_record> frames = record_run(rom, inputs, frame_count);
+
+    if (update)
+    {
+        if (!write_golden_trace(golden_path, rom_path, frames))
+        {
+            std::cerr << "Unable to write golden trace '" << golden_path << "'" << std::endl;
+            return 1;
+        }
+
+        std::cout << "Golden trace '" << golden_path << "' written (" << frame_count << " frames)" << std::endl;
+        return 0;
+    }
+
+    std::vector<frame_record> golden_frames;
+    if (!read_golden_trace(golden_path, golden_frames))
+    {
+        std::cerr << "Unable to read golden trace '" << golden_path << "'" << std::endl;
+        return 1;
+    }
+
+    if (!compare_with_golden_trace(golden_frames, frames))
+    {
+        return 1;
+    }
+
+    // Each golden test has its own trace file, tests can run in parallel
+    std::string trace_path = (std::filesystem::temp_directory_path() /
+                              std::filesystem::path(golden_path).filename().replace_extension(".ar8t")).string();
+
+    std::vector<ar::chip8::trace_entry> trace_entries;
+    if (!record_instruction_trace(rom, inputs, frame_count, trace_path, trace_entries))
+    {
+        std::cerr << "Unable to write and decode the instruction trace" << std::endl;
+        return 1;
+    }
+
+    if (!compare_with_instruction_trace(frames, trace_entries))
+    {
+        return 1;
+    }
+
+    double instructions_per_second = measure_instructions_per_second(rom, inputs, frame_count, false);
+    double traced_per_second       = measure_instructions_per_second(rom, inputs, frame_count, true);
+
+    std::cout << frame_count << " frames (" << frame_count * ar::chip8::INSTRUCTIONS_PER_FRAME
+              << " instructions) match the golden trace" << std::endl;
+    std::cout << "Instructions per second: " << std::fixed << std::setprecision(0) << instructions_per_second
+              << std::endl;
+    std::cout << "Instructions per second with tracing: " << traced_per_second << " (" << std::setprecision(2)
+              << instructions_per_second / traced_per_second << "x slower)" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,258 @@
+/**
+ * @file chip8-disassemble.cpp
+ * @details Analyses a ROM without running it and prints its disassembly: instructions grouped by basic block, bytes
+ *          never reached from 0x200 as data and writes that may modify code.
+ *
+ *          Usage: access-to-retro-chip8-disassemble <rom> [--model chip8|super-chip|xo-chip]
+ *
+ *          Machine model comes from the ROM database ('emulator/rom-database.cpp') unless '--model' is given, games
+ *          not in the database are disassembled as CHIP8. Code only reached through 0xBNNN jump tables is not found
+ *          and shows up as data, the jumps themselves are marked 'indirect'.
+ */
+
+#include <access-to-retro-dev/access-to-retro-dev.h>
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "emulator/rom-analysis.hpp"
+#include "emulator/rom-database.hpp"
+
+/// @brief Address ROMs are loaded to
+static constexpr uint16_t PROGRAM_START = 0x200;
+
+/// @brief Number of data bytes on one line
+static constexpr uint32_t DATA_BYTES_PER_LINE = 8;
+
+/// @brief Names of machine models for '--model' and the header, in the order of 'machine_model'
+static constexpr std::array<const char*, 3> MODEL_NAMES = { "chip8", "super-chip", "xo-chip" };
+
+/**
+ * @brief Read whole file
+ * @param path Path of the file
+ * @param content Content of the file
+ * @return Whether the file could be read
+ */
+static bool read_file(const std::string& path, std::vector<ar_byte>& content)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    return !file.bad();
+}
+
+/**
+ * @brief Parse name of a machine model
+ * @param name Name as given to '--model'
+ * @return Machine model, none for unknown names
+ */
+static std::optional<ar::chip8::machine_model> parse_model(const std::string& name)
+{
+    for (std::size_t model = 0; model < MODEL_NAMES.size(); model++)
+    {
+        if (name == MODEL_NAMES[model])
+        {
+            return static_cast<ar::chip8::machine_model>(model);
+        }
+    }
+
+    return std::nullopt;
+}
+
+/**
+ * @brief Format an address
+ * @param address Address
+ * @return Address as '0x' and at least 3 hex digits
+ */
+static std::string format_address(uint32_t address)
+{
+    std::ostringstream text;
+    text << "0x" << std::hex << std::uppercase << std::setw(3) << std::setfill('0') << address;
+
+    return text.str();
+}
+
+/**
+ * @brief Write the disassembly
+ * @param output Stream to write to
+ * @param analysis Analysis of the loaded ROM
+ * @param ram Memory with the ROM loaded
+ * @param model Machine model
+ * @param end Address after the last byte worth showing
+ */
+static void write_disassembly(std::ostream& output, const ar::chip8::rom_analysis& analysis,
+                              const ar::chip8::ram_memory& ram, ar::chip8::machine_model model, uint32_t end)
+{
+    const std::vector<ar::chip8::code_write>& code_writes = analysis.get_code_writes();
+
+    uint32_t address = PROGRAM_START;
+    while (address < end)
+    {
+        const ar::chip8::decoded_instruction* instruction = analysis.find_instruction(static_cast<uint16_t>(address));
+
+        if (instruction == nullptr)
+        {
+            // Run of data up to the next instruction, one line per 'DATA_BYTES_PER_LINE' bytes
+            output << "  " << format_address(address) << "  DB";
+
+            for (uint32_t count = 0; count < DATA_BYTES_PER_LINE && address < end; count++, address++)
+            {
+                if ((analysis.get_flags(static_cast<uint16_t>(address)) & AR_CODE_INSTRUCTION) != 0)
+                {
+                    break;
+                }
+
+                output << (count == 0 ? " " : ", ") << "0x" << std::hex << std::uppercase << std::setw(2)
+                       << std::setfill('0') << static_cast<uint32_t>(ram.read(static_cast<uint16_t>(address)))
+                       << std::dec << std::nouppercase << std::setfill(' ');
+            }
+
+            output << "\n";
+            continue;
+        }
+
+        if ((instruction->flags & AR_CODE_BLOCK_START) != 0)
+        {
+            output << "\n" << ((instruction->flags & AR_CODE_CALL_TARGET) != 0 ? "sub_" : "block_")
+                   << format_address(address) << ":\n";
+        }
+
+        std::ostringstream encoded;
+        encoded << std::hex << std::uppercase << std::setfill('0') << std::setw(4) << instruction->opcode;
+        if (instruction->length == 4)
+        {
+            encoded << " " << std::setw(4) << instruction->long_address;
+        }
+
+        // Notes worth a closer look when porting or debugging the game
+        std::string notes;
+        if ((instruction->flags & AR_CODE_INDIRECT) != 0)
+        {
+            notes += " indirect";
+        }
+
+        if ((instruction->flags & AR_CODE_OVERLAP) != 0)
+        {
+            notes += " overlap";
+        }
+
+        auto code_write = std::find_if(code_writes.begin(), code_writes.end(),
+                                       [&](const ar::chip8::code_write& write)
+                                       {
+                                           return write.instruction == address;
+                                       });
+
+        if (code_write != code_writes.end())
+        {
+            notes += code_write->target_known ? " writes code at " + format_address(code_write->target)
+                                              : std::string(" writes unknown I");
+        }
+
+        std::string assembly = ar::chip8::disassemble(instruction->opcode, instruction->long_address, model);
+        if (!notes.empty())
+        {
+            assembly.resize(std::max<std::size_t>(assembly.size(), 20), ' ');
+            assembly += " ;" + notes;
+        }
+
+        output << "  " << format_address(address) << "  " << std::left << std::setw(11) << encoded.str() << std::right
+               << assembly << "\n";
+        address += instruction->length;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string rom_path;
+    std::optional<ar::chip8::machine_model> model;
+    bool valid = true;
+
+    for (int i = 1; i < argc && valid; i++)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "--model" && i + 1 < argc)
+        {
+            model = parse_model(argv[++i]);
+            valid = model.has_value();
+        }
+        else if (!arg.starts_with("-") && rom_path.empty())
+        {
+            rom_path = arg;
+        }
+        else
+        {
+            valid = false;
+        }
+    }
+
+    if (!valid || rom_path.empty())
+    {
+        std::cerr << "Usage: " << argv[0] << " <rom> [--model chip8|super-chip|xo-chip]" << std::endl;
+        return 1;
+    }
+
+    std::vector<ar_byte> rom;
+    if (!read_file(rom_path, rom) || rom.empty() || rom.size() > ar::chip8::XO_CHIP_RAM_SIZE - PROGRAM_START)
+    {
+        std::cerr << "Unable to read ROM '" << rom_path << "'" << std::endl;
+        return 1;
+    }
+
+    uint64_t rom_hash = ar::chip8::get_rom_hash(rom.data(), rom.size());
+    if (!model.has_value())
+    {
+        model = ar::chip8::rom_database().find_profile(rom_hash).value_or(ar::chip8::rom_profile {}).model;
+    }
+
+    // Memory is laid out the same way the virtual console lays it out, fonts included, but nothing runs
+    ar::chip8::ram_memory ram;
+    ram.set_size(*model == ar::chip8::machine_model::xo_chip ? ar::chip8::XO_CHIP_RAM_SIZE : ar::chip8::RAM_SIZE);
+    if (*model != ar::chip8::machine_model::chip8)
+    {
+        ram.load_big_font();
+    }
+
+    ar_executable executable { rom.data(), rom.size() };
+    ram.load_binary(&executable);
+
+    ar::chip8::rom_analysis analysis;
+    analysis.analyze(ram, *model);
+
+    // Code can run past the end of the ROM into zeroed memory only when the game is truncated
+    uint32_t end = static_cast<uint32_t>(std::min<std::size_t>(PROGRAM_START + rom.size(), ram.get_size()));
+    if (!analysis.get_instructions().empty())
+    {
+        const ar::chip8::decoded_instruction& last = analysis.get_instructions().back();
+        end = std::max<uint32_t>(end, last.address + last.length);
+    }
+
+    uint32_t data_bytes = 0;
+    for (uint32_t address = PROGRAM_START; address < end; address++)
+    {
+        data_bytes += (analysis.get_flags(static_cast<uint16_t>(address)) &
+                       (AR_CODE_INSTRUCTION | AR_CODE_OPERAND)) == 0 ? 1 : 0;
+    }
+
+    std::cout << "ROM hash: 0x" << std::hex << std::uppercase << std::setw(16) << std::setfill('0') << rom_hash
+              << std::dec << std::nouppercase << std::setfill(' ')
+              << "\nMachine model: " << MODEL_NAMES[static_cast<std::size_t>(*model)]
+              << "\nInstructions: " << analysis.get_instructions().size()
+              << "\nBasic blocks: " << analysis.get_blocks().size()
+              << "\nData bytes: " << data_bytes
+              << "\nWrites that may modify code: " << analysis.get_code_writes().size() << "\n";
+
+    write_disassembly(std::cout, analysis, ram, *model, end);
+
+    return 0;
+}
@@ -0,0 +1,218 @@
+/**
+ * @file chip8-guest-profile.cpp
+ * @details Runs a ROM without the frontend and reports where the game spends its instructions: the most executed
+ *          addresses, histogram of instruction patterns and instructions per call stack.
+ *
+ *          Usage: access-to-retro-chip8-guest-profile <rom> [--frames N] [--top N] [--folded <file>]
+ *
+ *          Report is written to standard output. '--folded' also writes call stacks in folded format, turn it into a
+ *          flame graph with 'flamegraph.pl <file> > flame.svg' or open it in speedscope. No keys are pressed, games
+ *          waiting for a key show it as a hot 'FX0A' (or 'EX9E'/'EXA1' loop). ROM hash in the report is the key of
+ *          the game's entry in the ROM database ('emulator/rom-database.cpp').
+ */
+
+#include <access-to-retro-dev/access-to-retro-dev.h>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <vector>
+#include "emulator/emulator.hpp"
+#include "emulator/guest-profiler.hpp"
+#include "emulator/rom-database.hpp"
+
+AR_API AR_DEFINE_FN;
+
+AR_API AR_STARTUP_FN;
+
+AR_API AR_QUIT_FN;
+
+/// @brief Number of frames that are run when '--frames' is not given, ten seconds of emulated time
+static constexpr uint64_t DEFAULT_FRAME_COUNT = 600;
+
+/// @brief Number of hot addresses reported when '--top' is not given
+static constexpr std::size_t DEFAULT_TOP_COUNT = 20;
+
+/// @brief Seed of the random number generator, same seed makes profiles of the same ROM comparable
+static constexpr uint32_t RANDOM_SEED = 0xC8C8C8C8;
+
+/// @brief Address ROMs are loaded to
+static constexpr uint16_t PROGRAM_START = 0x200;
+
+/**
+ * @brief Read whole file
+ * @param path Path of the file
+ * @param content Content of the file
+ * @return Whether the file could be read
+ */
+static bool read_file(const std::string& path, std::vector<ar_byte>& content)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    return !file.bad();
+}
+
+/**
+ * @brief Format a share of instructions as percentage
+ * @param count Instructions
+ * @param total All instructions
+ * @return Percentage
+ */
+static double get_percentage(uint64_t count, uint64_t total)
+{
+    return total != 0 ? static_cast<double>(count) * 100.0 / static_cast<double>(total) : 0.0;
+}
+
+/**
+ * @brief Write the report
+ * @param output Stream to write to
+ * @param profiler Profiler the ROM ran with
+ * @param ram Memory of the emulator, shows instructions at the hot addresses
+ * @param top_count Number of hot addresses
+ */
+static void write_report(std::ostream& output, const ar::chip8::guest_profiler& profiler,
+                         const ar::chip8::ram_memory& ram, std::size_t top_count)
+{
+    uint64_t total = profiler.get_instruction_count();
+
+    output << std::fixed << std::setprecision(2);
+    output << "Instructions: " << total << "\n";
+    output << "Unmatched returns: " << profiler.get_unmatched_return_count() << "\n\n";
+
+    output << "Hot addresses:\n";
+    for (const ar::chip8::hot_address& hot : profiler.get_hot_addresses(top_count))
+    {
+        uint16_t opcode = ram.read_instruction(hot.address);
+
+        output << "  0x" << std::hex << std::uppercase << std::setw(3) << std::setfill('0') << hot.address << "  "
+               << std::setw(4) << opcode << std::dec << std::nouppercase << std::setfill(' ') << "  "
+               << std::setw(7) << ar::chip8::guest_profiler::get_instruction_pattern_name(
+                       ar::chip8::guest_profiler::get_instruction_pattern(opcode))
+               << std::setw(12) << hot.count << std::setw(8) << get_percentage(hot.count, total) << "%\n";
+    }
+
+    // Most executed patterns first, these are worth a fast path in the interpreter
+    const auto& histogram = profiler.get_opcode_histogram();
+
+    std::vector<std::size_t> patterns;
+    for (std::size_t pattern = 0; pattern < histogram.size(); pattern++)
+    {
+        if (histogram[pattern] != 0)
+        {
+            patterns.push_back(pattern);
+        }
+    }
+
+    std::stable_sort(patterns.begin(), patterns.end(),
+                     [&](std::size_t a, std::size_t b) { return histogram[a] > histogram[b]; });
+
+    output << "\nInstruction patterns:\n";
+    for (std::size_t pattern : patterns)
+    {
+        output << "  " << std::setw(7) << ar::chip8::guest_profiler::get_instruction_pattern_name(pattern)
+               << std::setw(12) << histogram[pattern] << std::setw(8) << get_percentage(histogram[pattern], total)
+               << "%\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string rom_path;
+    std::string folded_path;
+    uint64_t frame_count  = DEFAULT_FRAME_COUNT;
+    std::size_t top_count = DEFAULT_TOP_COUNT;
+
+    try
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg = argv[i];
+
+            if (arg == "--frames" && i + 1 < argc)
+            {
+                frame_count = std::stoull(argv[++i]);
+            }
+            else if (arg == "--top" && i + 1 < argc)
+            {
+                top_count = std::stoull(argv[++i]);
+            }
+            else if (arg == "--folded" && i + 1 < argc)
+            {
+                folded_path = argv[++i];
+            }
+            else if (!arg.starts_with("-") && rom_path.empty())
+            {
+                rom_path = arg;
+            }
+            else
+            {
+                rom_path.clear();
+                break;
+            }
+        }
+    }
+    catch (const std::logic_error&)
+    {
+        rom_path.clear();
+    }
+
+    if (rom_path.empty())
+    {
+        std::cerr << "Usage: " << argv[0] << " <rom> [--frames N] [--top N] [--folded <file>]" << std::endl;
+        return 1;
+    }
+
+    std::vector<ar_byte> rom;
+    if (!read_file(rom_path, rom) || rom.empty() || rom.size() > ar::chip8::XO_CHIP_RAM_SIZE - PROGRAM_START)
+    {
+        std::cerr << "Unable to read ROM '" << rom_path << "'" << std::endl;
+        return 1;
+    }
+
+    // Start the virtual console the same way the frontend does
+    _ar_vc_define();
+    ar_create_executable(rom.data(), rom.size());
+    _ar_vc_startup();
+
+    std::shared_ptr<ar::chip8::emulator> emulator = ar::chip8::emulator::get_global_emulator();
+    emulator->access_cpu().set_random_seed(RANDOM_SEED);
+
+    ar::chip8::guest_profiler profiler(emulator->access_cpu());
+
+    for (uint64_t frame = 0; frame < frame_count; frame++)
+    {
+        emulator->run_frame([&] { profiler.record_instruction(); });
+    }
+
+    // Hash is the key of the game in the ROM database
+    std::cout << "ROM hash: 0x" << std::hex << std::uppercase << std::setw(16) << std::setfill('0')
+              << ar::chip8::get_rom_hash(rom.data(), rom.size()) << std::dec << std::nouppercase << std::setfill(' ')
+              << "\nClock speed: " << emulator->get_clock_speed() << " hz\n";
+
+    write_report(std::cout, profiler, emulator->access_ram(), top_count);
+
+    int exit_code = 0;
+    if (!folded_path.empty())
+    {
+        std::ofstream folded(folded_path);
+        profiler.write_folded_stacks(folded);
+
+        if (!folded)
+        {
+            std::cerr << "Unable to write call stacks to '" << folded_path << "'" << std::endl;
+            exit_code = 1;
+        }
+    }
+
+    _ar_vc_quit();
+
+    return exit_code;
+}
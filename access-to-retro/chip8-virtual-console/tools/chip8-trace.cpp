@@ -0,0 +1,257 @@
+/**
+ * @file chip8-trace.cpp
+ * @details Records a binary instruction trace of a ROM running without the frontend, or decodes a trace into one line
+ *          per instruction: cycle, address, opcode, assembly and the registers the instruction changed.
+ *
+ *          Usage: access-to-retro-chip8-trace <rom> --output <trace> [--frames N]
+ *                 access-to-retro-chip8-trace --decode <trace> [--last N]
+ *
+ *          Virtual console run by the frontend writes the same trace when 'AR_CHIP8_TRACE' environment variable is
+ *          set to the path of the trace, when the game is closed or the emulator crashes. Only the last
+ *          'DEFAULT_TRACE_CHUNK_COUNT' chunks are kept, '--last' shows just the instructions that led up to the end.
+ */
+
+#include <access-to-retro-dev/access-to-retro-dev.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "emulator/emulator.hpp"
+#include "emulator/instruction-trace.hpp"
+#include "emulator/rom-analysis.hpp"
+#include "emulator/rom-database.hpp"
+
+AR_API AR_DEFINE_FN;
+
+AR_API AR_STARTUP_FN;
+
+AR_API AR_QUIT_FN;
+
+/// @brief Number of frames that are run when '--frames' is not given, ten seconds of emulated time
+static constexpr uint64_t DEFAULT_FRAME_COUNT = 600;
+
+/// @brief Seed of the random number generator, same seed makes traces of the same ROM comparable
+static constexpr uint32_t RANDOM_SEED = 0xC8C8C8C8;
+
+/// @brief Address ROMs are loaded to
+static constexpr uint16_t PROGRAM_START = 0x200;
+
+/**
+ * @brief Read whole file
+ * @param path Path of the file
+ * @param content Content of the file
+ * @return Whether the file could be read
+ */
+static bool read_file(const std::string& path, std::vector<ar_byte>& content)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    return !file.bad();
+}
+
+/**
+ * @brief Run a ROM with tracing and write the trace
+ * @param rom_path Path of the ROM
+ * @param output_path Path of the trace
+ * @param frame_count Number of frames to run
+ * @return Exit code
+ */
+static int record_trace(const std::string& rom_path, const std::string& output_path, uint64_t frame_count)
+{
+    std::vector<ar_byte> rom;
+    if (!read_file(rom_path, rom) || rom.empty() || rom.size() > ar::chip8::XO_CHIP_RAM_SIZE - PROGRAM_START)
+    {
+        std::cerr << "Unable to read ROM '" << rom_path << "'" << std::endl;
+        return 1;
+    }
+
+    // Start the virtual console the same way the frontend does
+    _ar_vc_define();
+    ar_create_executable(rom.data(), rom.size());
+    _ar_vc_startup();
+
+    std::shared_ptr<ar::chip8::emulator> emulator = ar::chip8::emulator::get_global_emulator();
+    emulator->access_cpu().set_random_seed(RANDOM_SEED);
+
+    // Game keeps its quirks, tracing policy only adds the trace callback
+    ar::chip8::rom_profile profile = ar::chip8::rom_database().find_profile(
+            ar::chip8::get_rom_hash(rom.data(), rom.size())).value_or(ar::chip8::rom_profile {});
+
+    ar::chip8::instruction_trace trace(*emulator);
+    emulator->access_cpu().set_trace_callback(&ar::chip8::instruction_trace::record_instruction_callback, &trace);
+    emulator->set_cpu_configuration(ar::chip8::cpu_configuration { .quirks = profile.quirks, .tracing = true });
+
+    for (uint64_t frame = 0; frame < frame_count; frame++)
+    {
+        emulator->run_frame();
+    }
+
+    int exit_code = 0;
+
+    // Written the same way the virtual console writes it when it crashes
+    int file = ar::chip8::instruction_trace::open_file(output_path.c_str());
+    bool written = file >= 0 && trace.write(file, emulator->access_cpu().get_machine_model());
+
+    if (file >= 0 && !ar::chip8::instruction_trace::close_file(file))
+    {
+        written = false;
+    }
+
+    if (!written)
+    {
+        std::cerr << "Unable to write trace to '" << output_path << "'" << std::endl;
+        exit_code = 1;
+    }
+    else
+    {
+        std::cout << "Instructions: " << trace.get_instruction_count() << "\nTrace size: "
+                  << std::filesystem::file_size(output_path) << " bytes" << std::endl;
+    }
+
+    emulator->access_cpu().set_trace_callback(nullptr, nullptr);
+    _ar_vc_quit();
+
+    return exit_code;
+}
+
+/**
+ * @brief Print a decoded trace
+ * @param trace_path Path of the trace
+ * @param last_count Number of instructions to print from the end, all of them if 0
+ * @return Exit code
+ */
+static int decode_trace(const std::string& trace_path, std::size_t last_count)
+{
+    std::vector<ar_byte> bytes;
+    if (!read_file(trace_path, bytes))
+    {
+        std::cerr << "Unable to read trace '" << trace_path << "'" << std::endl;
+        return 1;
+    }
+
+    std::vector<ar::chip8::trace_entry> entries;
+    ar::chip8::machine_model model = ar::chip8::machine_model::chip8;
+
+    // Whatever decoded before an error is still worth showing, a crash may have cut the trace short
+    bool valid = ar::chip8::instruction_trace::decode(bytes.data(), bytes.size(), entries, model);
+
+    std::size_t first = last_count != 0 && entries.size() > last_count ? entries.size() - last_count : 0;
+
+    for (std::size_t i = first; i < entries.size(); i++)
+    {
+        const ar::chip8::trace_entry& entry = entries[i];
+
+        // Second word of XO-CHIP's 0xF000 NNNN is not in the trace, next instruction's I shows where it pointed
+        std::string assembly = entry.opcode == 0xF000 && model == ar::chip8::machine_model::xo_chip
+                               ? std::string("LD I, NNNN") : ar::chip8::disassemble(entry.opcode, 0, model);
+
+        std::ostringstream changes;
+        changes << std::hex << std::uppercase << std::setfill('0');
+
+        for (uint32_t index = 0; index < ar::chip8::GENERAL_REGISTER_COUNT; index++)
+        {
+            if ((entry.changed_registers & (1u << index)) != 0)
+            {
+                changes << " V" << index << "=" << std::setw(2) << static_cast<uint32_t>(entry.registers[index]);
+            }
+        }
+
+        if (entry.address_register_changed)
+        {
+            changes << " I=" << std::setw(3) << entry.address_register;
+        }
+
+        // Assembly is only padded when changes follow it, lines don't end with spaces
+        if (!changes.str().empty())
+        {
+            assembly.resize(std::max<std::size_t>(assembly.size(), 20), ' ');
+        }
+
+        std::cout << std::setw(12) << entry.cycle << "  0x" << std::hex << std::uppercase << std::setfill('0')
+                  << std::setw(3) << entry.address << "  " << std::setw(4) << entry.opcode << "  " << assembly
+                  << changes.str();
+
+        std::cout << std::dec << std::nouppercase << std::setfill(' ') << "\n";
+    }
+
+    if (!valid)
+    {
+        std::cerr << "Trace '" << trace_path << "' is damaged, " << entries.size() << " instructions decoded"
+                  << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    std::string rom_path;
+    std::string output_path;
+    std::string trace_path;
+    uint64_t frame_count   = DEFAULT_FRAME_COUNT;
+    std::size_t last_count = 0;
+    bool valid             = true;
+
+    try
+    {
+        for (int i = 1; i < argc && valid; i++)
+        {
+            std::string arg = argv[i];
+
+            if (arg == "--output" && i + 1 < argc)
+            {
+                output_path = argv[++i];
+            }
+            else if (arg == "--frames" && i + 1 < argc)
+            {
+                frame_count = std::stoull(argv[++i]);
+            }
+            else if (arg == "--decode" && i + 1 < argc)
+            {
+                trace_path = argv[++i];
+            }
+            else if (arg == "--last" && i + 1 < argc)
+            {
+                last_count = std::stoull(argv[++i]);
+            }
+            else if (!arg.starts_with("-") && rom_path.empty())
+            {
+                rom_path = arg;
+            }
+            else
+            {
+                valid = false;
+            }
+        }
+    }
+    catch (const std::logic_error&)
+    {
+        valid = false;
+    }
+
+    if (valid && !trace_path.empty() && rom_path.empty() && output_path.empty())
+    {
+        return decode_trace(trace_path, last_count);
+    }
+
+    if (valid && trace_path.empty() && !rom_path.empty() && !output_path.empty())
+    {
+        return record_trace(rom_path, output_path, frame_count);
+    }
+
+    std::cerr << "Usage: " << argv[0] << " <rom> --output <trace> [--frames N]\n"
+              << "       " << argv[0] << " --decode <trace> [--last N]" << std::endl;
+    return 1;
+}
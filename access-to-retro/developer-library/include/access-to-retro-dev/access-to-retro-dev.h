@@ -11,10 +11,13 @@
 #define ACCESS_TO_RETRO_ACCESS_TO_RETRO_DEV_H
 
 #include "graphics.h"
+#include "audio.h"
 #include "basics.h"
 #include "input.h"
 #include "game.h"
 #include "data.h"
+#include "profiling.h"
+#include "analysis.h"
 #include "c-cpp-required-definitions-helper.h"
 
 #endif //ACCESS_TO_RETRO_ACCESS_TO_RETRO_DEV_H
@@ -0,0 +1,153 @@
+/**
+ * @file analysis.h
+ */
+
+/** @defgroup group_analysis Analysis
+ *  Static analysis of guest code: walks control flow of a ROM to tell code from data
+ *  @{
+ */
+
+#ifndef ACCESS_TO_RETRO_ANALYSIS_H
+#define ACCESS_TO_RETRO_ANALYSIS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "basics.h"
+
+/************************************* Code Map *************************************/
+
+/// @brief Byte is the first byte of a reachable instruction
+#define AR_CODE_INSTRUCTION 0x01
+
+/// @brief Byte belongs to a reachable instruction but is not its first byte
+#define AR_CODE_OPERAND 0x02
+
+/// @brief Instruction starts a basic block (entry point, target of a jump, branch or call, or a join of two paths)
+#define AR_CODE_BLOCK_START 0x04
+
+/// @brief Instruction is called as a function
+#define AR_CODE_CALL_TARGET 0x08
+
+/// @brief Instruction continues at an address only known at runtime (jump table, computed jump)
+#define AR_CODE_INDIRECT 0x10
+
+/// @brief Instruction writes memory, together with the code bytes this tells where self-modifying code can be
+#define AR_CODE_WRITES_MEMORY 0x20
+
+/**
+ * @brief Byte is reached both as start of an instruction and as part of another one
+ * @details Happens with data decoded as code or code that is modified before it runs, both worth a closer look.
+ */
+#define AR_CODE_OVERLAP 0x40
+
+/// @brief How an instruction continues, reported by the decoder of the emulated CPU
+enum ar_code_flow_kind
+{
+    /// @brief Continues with the next instruction
+    ar_code_flow_next,
+
+    /// @brief Always continues at the target
+    ar_code_flow_jump,
+
+    /// @brief Continues either with the next instruction or at the target (conditional jumps and skips)
+    ar_code_flow_branch,
+
+    /// @brief Calls the target, continues with the next instruction once it returns
+    ar_code_flow_call,
+
+    /// @brief Returns to the caller
+    ar_code_flow_return,
+
+    /// @brief Continues at an address computed at runtime
+    ar_code_flow_indirect,
+
+    /// @brief Nothing follows (halts, exits or leaves the emulated CPU)
+    ar_code_flow_stop
+};
+
+/// @brief Instruction as seen by the control flow walk
+struct ar_code_flow
+{
+    /// @brief Number of bytes of the instruction, 0 if the bytes are not a valid instruction
+    uint32_t length;
+
+    /// @brief How the instruction continues
+    enum ar_code_flow_kind kind;
+
+    /// @brief Target of a jump, branch or call
+    uint32_t target;
+
+    /// @brief Whether the instruction writes memory
+    bool writes_memory;
+};
+
+/**
+ * @brief Decoder of the emulated CPU, called once for every reachable instruction
+ * @param memory Memory being analysed
+ * @param size Size of the memory
+ * @param address Address of the instruction, smaller than the size
+ * @param user_data Pointer given to 'ar_code_map_analyze'
+ * @return Instruction's control flow
+ */
+typedef struct ar_code_flow (* ar_code_flow_decoder)(const uint8_t* memory, size_t size, uint32_t address,
+                                                      void* user_data);
+
+/**
+ * @brief Result of control flow analysis, flags of every byte of the analysed memory
+ * @details Bytes without 'AR_CODE_INSTRUCTION' or 'AR_CODE_OPERAND' were never reached and are data (or code only
+ *          reached through indirect jumps). The map is allocated once and can analyse the same size of memory any
+ *          number of times without allocating again.
+ */
+struct ar_code_map
+{
+    /// @brief 'AR_CODE_*' flags of each byte
+    uint8_t* flags;
+
+    /// @brief Number of bytes in the map
+    size_t size;
+
+    /// @brief Number of reachable instructions
+    uint32_t instruction_count;
+
+    /// @brief Number of basic blocks
+    uint32_t block_count;
+
+    /// @brief Addresses waiting to be walked, internal to the analysis
+    uint32_t* worklist;
+};
+
+/**
+ * @brief Create a code map for memory of given size
+ * @param map Map to create
+ * @param size Size of the memory that will be analysed
+ * @return Error codes:
+ *  - 0: No error
+ *  - 1: Unable to allocate the map
+ */
+AR_API ar_err_code ar_code_map_create(struct ar_code_map* map, size_t size);
+
+/**
+ * @brief Free a code map
+ * @param map Map created by 'ar_code_map_create', can be destroyed more than once
+ */
+AR_API void ar_code_map_destroy(struct ar_code_map* map);
+
+/**
+ * @brief Walk control flow of the memory from entry points and fill the map
+ * @details Each reachable instruction is decoded once. Targets of jumps, branches and calls are walked too, indirect
+ *          jumps are only flagged. Walk stops at invalid instructions and at the end of the memory. Everything in the
+ *          map is cleared first.
+ * @param map Map created for the size of the memory
+ * @param memory Memory to analyse
+ * @param entries Addresses where execution starts (usually just the reset address)
+ * @param entry_count Number of entry points
+ * @param decoder Decoder of the emulated CPU
+ * @param user_data Pointer passed to the decoder
+ */
+AR_API void ar_code_map_analyze(struct ar_code_map* map, const uint8_t* memory, const uint32_t* entries,
+                                size_t entry_count, ar_code_flow_decoder decoder, void* user_data);
+
+#endif //ACCESS_TO_RETRO_ANALYSIS_H
+
+/** @} */ // end of group
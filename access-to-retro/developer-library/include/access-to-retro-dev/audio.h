@@ -0,0 +1,145 @@
+/**
+ * @file audio.h
+ */
+
+/** @defgroup group_audio Audio
+ *  Deals with audio output
+ *  @{
+ */
+
+#ifndef ACCESS_TO_RETRO_AUDIO_H
+#define ACCESS_TO_RETRO_AUDIO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "basics.h"
+
+/// @brief Default number of frames that the audio device requests at once, at 48000hz it's ~5.3ms of audio
+#define AR_AUDIO_DEFAULT_BUFFER_SIZE 256
+
+/**
+ * @brief Time (in milliseconds) of audio that the sample queue can hold
+ * @details Virtual consoles usually push a whole video frame of audio at once (16.6ms at 60 FPS), the queue has to
+ *          fit at least 2 of them on top of the audio device's own buffer.
+ */
+#define AR_AUDIO_QUEUE_LENGTH_MS 50
+
+/// @brief Contains all supported sample formats, samples of all channels are interleaved (L R L R ...)
+enum ar_audio_format
+{
+    /// @brief Signed 16-bit integer samples in native byte order
+    ar_audio_format_s16,
+
+    /// @brief 32-bit floating point samples in range -1.0 to 1.0
+    ar_audio_format_f32,
+};
+
+/**
+ * @brief Configure audio output of this virtual console
+ * @details Allocates the sample queue between the virtual console and the frontend, audio output is disabled until
+ *          this function succeeds.
+ * @remark It is recommended to call this function in AR_STARTUP_FN, audio device is opened by the frontend after the
+ *         startup function has returned
+ * @param sample_rate Number of frames per second, for example: 48000
+ * @param channels Number of interleaved channels (1 - mono, 2 - stereo)
+ * @param format Format of a single sample
+ * @return Error codes:
+ *  - 0: No error
+ *  - 1: Invalid sample rate (0 or too high for the queue), channel count or format
+ *  - 2: Unable to allocate the sample queue
+ */
+AR_API ar_err_code ar_audio_configure(uint32_t sample_rate, uint8_t channels, enum ar_audio_format format);
+
+/**
+ * @brief Set number of frames that the audio device should request at once
+ * @details Smaller buffer means lower latency but higher risk of underruns, the default buffer size
+ *          ('AR_AUDIO_DEFAULT_BUFFER_SIZE') keeps the latency under 10ms for sample rates of 32000hz and above.
+ * @warning Must be called before the frontend opens the audio device (AR_STARTUP_FN), later changes are ignored
+ * @param frames Number of frames, rounded up to a power of 2 by the frontend
+ */
+AR_API void ar_audio_set_buffer_size(uint32_t frames);
+
+/**
+ * @brief Push samples to the audio output
+ * @details Samples are copied into a lock-free queue and consumed by the frontend's audio device, this function never
+ *          blocks. If the queue is full the frames that do not fit are dropped and counted as an overrun.
+ * @warning Should only be called from a single thread, for example the main thread.
+ * @param samples Interleaved samples in the configured format
+ * @param frame_count Number of frames (samples per channel) to push
+ * @return Number of frames that were queued
+ */
+AR_API uint32_t ar_audio_push_samples(const void* samples, uint32_t frame_count);
+
+/**
+ * @brief Pull samples from the audio output
+ * @details If there are not enough queued frames the rest of 'out' is filled with silence and counted as an underrun.
+ * @remarks Used by the frontend application (audio device callback), shouldn't be used by virtual console developers
+ * @param out Buffer to copy interleaved samples to, must fit 'frame_count' frames
+ * @param frame_count Number of frames requested
+ * @return Number of frames that were copied from the queue (not counting silence)
+ */
+AR_API uint32_t ar_audio_pull_samples(void* out, uint32_t frame_count);
+
+/**
+ * @brief Free the sample queue and reset the configuration
+ * @remarks Called automatically in 'ar_quit', no need for developer to call it himself
+ */
+AR_API void ar_audio_free(void);
+
+/**
+ * @brief Check whether audio output was configured
+ * @return Whether 'ar_audio_configure' has succeeded
+ */
+AR_API bool ar_audio_is_configured(void);
+
+/**
+ * @brief Get the configured sample rate
+ * @return Number of frames per second or 0 if audio was not configured
+ */
+AR_API uint32_t ar_audio_get_sample_rate(void);
+
+/**
+ * @brief Get the configured number of channels
+ * @return Number of channels or 0 if audio was not configured
+ */
+AR_API uint8_t ar_audio_get_channels(void);
+
+/**
+ * @brief Get the configured sample format
+ * @return Format of a single sample
+ */
+AR_API enum ar_audio_format ar_audio_get_format(void);
+
+/**
+ * @brief Get number of frames that the audio device should request at once
+ * @return Buffer size in frames
+ */
+AR_API uint32_t ar_audio_get_buffer_size(void);
+
+/**
+ * @brief Get number of frames that are waiting in the queue
+ * @return Number of queued frames
+ */
+AR_API uint32_t ar_audio_get_queued_frames(void);
+
+/**
+ * @brief Get number of frames that the queue can hold
+ * @return Capacity of the queue in frames or 0 if audio was not configured
+ */
+AR_API uint32_t ar_audio_get_queue_capacity(void);
+
+/**
+ * @brief Get number of times the audio device requested more frames than were queued
+ * @return Underrun count since 'ar_audio_configure'
+ */
+AR_API uint64_t ar_audio_get_underrun_count(void);
+
+/**
+ * @brief Get number of times pushed frames did not fit into the queue
+ * @return Overrun count since 'ar_audio_configure'
+ */
+AR_API uint64_t ar_audio_get_overrun_count(void);
+
+#endif //ACCESS_TO_RETRO_AUDIO_H
+
+/** @} */ // end of group
@@ -140,6 +140,20 @@ AR_API unsigned ar_get_vc_default_window_res_x(void);
  */
 AR_API unsigned ar_get_vc_default_window_res_y(void);
 
+/**
+ * @brief Set the virtual console's clock speed
+ * @details Virtual console sets its clock speed when it starts, then the frontend can change it while the game is
+ *          running. Virtual console reads it back with 'ar_get_vc_clock_speed' every frame.
+ * @param clock_speed Clock speed in hz, 0 if the virtual console's clock speed can't be changed
+ */
+AR_API void ar_set_vc_clock_speed(unsigned clock_speed);
+
+/**
+ * @brief Get the virtual console's clock speed
+ * @return Virtual console's clock speed in hz, 0 if it can't be changed
+ */
+AR_API unsigned ar_get_vc_clock_speed(void);
+
 #endif
 
 /** @} */ // end of group
@@ -71,27 +71,93 @@ struct ar_pixel
     uint8_t a;
 };
 
-/// @brief Represents a frame buffer (array of pixels) that is used for 'ar_graphics_method_framebuffer' graphics method
+/**
+ * @brief Formats in which the frame buffer can store pixels
+ * @details Virtual consoles should use their native format, the frontend converts it when showing the frame. Smaller
+ *          formats mean less memory copied on every present.
+ */
+enum ar_pixel_format
+{
+    /// @brief 'struct ar_pixel' per pixel (R, G, B, A bytes), 4 bytes per pixel
+    ar_pixel_format_rgba8888,
+
+    /// @brief 1 bit per pixel, most significant bit is the leftmost pixel, colours are palette entries 0 and 1
+    ar_pixel_format_1bpp,
+
+    /// @brief 2 bits per pixel, most significant bits are the leftmost pixel, colours are palette entries 0 - 3
+    ar_pixel_format_2bpp_indexed,
+
+    /// @brief 1 byte per pixel, colours are palette entries 0 - 255
+    ar_pixel_format_8bpp_indexed,
+
+    /// @brief 'uint16_t' per pixel, 5 bits red (most significant), 6 bits green and 5 bits blue
+    ar_pixel_format_rgb565,
+
+    /// @brief 'uint32_t' per pixel as 0xXXRRGGBB, the top byte is ignored
+    ar_pixel_format_xrgb8888,
+};
+
+/// @brief Number of colours in frame buffer's palette, indexed formats use the first 2, 4 or all of them
+#define AR_PALETTE_SIZE 256
+
+/**
+ * @brief Represents a frame buffer (array of pixels) that is used for 'ar_graphics_method_framebuffer' graphics method
+ * @details The frame buffer is double-buffered, virtual console draws into 'pixels' (back buffer) while the frontend
+ *          shows the previously presented frame. 'ar_graphics_present' hands the back buffer over to the frontend and
+ *          replaces 'pixels' with a new back buffer, so 'pixels' must NOT be cached across presents.
+ */
 struct ar_frame_buffer
 {
-    /// @brief Array of individual pixels (size = .width x .height)
-    struct ar_pixel* pixels;
+    union
+    {
+        /// @brief Array of individual pixels (size = .width x .height), this is the back buffer
+        struct ar_pixel* pixels;
+
+        /// @brief Same back buffer for formats other than 'ar_pixel_format_rgba8888' (size = .pitch x .height)
+        void* data;
+    };
 
     /// @brief Width of the frame
     uint32_t width;
 
     /// @brief Height of the frame
     uint32_t height;
+
+    /// @brief Format of the pixels
+    enum ar_pixel_format format;
+
+    /// @brief Number of bytes between the starts of two rows, rows of packed formats start on a new byte
+    uint32_t pitch;
+
+    /// @brief Colours of indexed formats, presented together with the pixels so it can change every frame
+    struct ar_pixel palette[AR_PALETTE_SIZE];
 };
 
 /**
- * @brief Create a frame buffer graphical object
+ * @brief Create a frame buffer graphical object with 'ar_pixel_format_rgba8888' pixels
  * @details This NEEDS to be called if graphics method is set to 'ar_graphics_method_frame_buffer' otherwise getter will
  *          return nullptr.
+ * @remark Calling it again replaces the previous frame buffer, pointers to it and its pixels become invalid
+ * @param width Width of the frame
+ * @param height Height of the frame
+ * @return Error codes:
+ *  - 0: No error
+ *  - 1: Invalid size (width or height is 0, or the frame doesn't fit into memory)
+ *  - 2: Unable to allocate the frame buffer, there is no frame buffer afterwards
+ */
+AR_API ar_err_code ar_graphics_create_frame_buffer(uint32_t width, uint32_t height);
+
+/**
+ * @brief Create a frame buffer graphical object storing pixels in given format
+ * @details Same as 'ar_graphics_create_frame_buffer', palette starts as a grayscale ramp from black to white over the
+ *          colours that the format can index.
  * @param width Width of the frame
  * @param height Height of the frame
+ * @param format Format of the pixels
+ * @return Error codes, same as 'ar_graphics_create_frame_buffer'
  */
-AR_API void ar_graphics_create_frame_buffer(uint32_t width, uint32_t height);
+AR_API ar_err_code ar_graphics_create_frame_buffer_with_format(uint32_t width, uint32_t height,
+                                                               enum ar_pixel_format format);
 
 /**
  * @brief Getter for frame buffer graphical object
@@ -100,10 +166,52 @@ AR_API void ar_graphics_create_frame_buffer(uint32_t width, uint32_t height);
  */
 AR_API struct ar_frame_buffer* ar_graphics_get_frame_buffer(void);
 
+/**
+ * @brief Present the frame drawn into the frame buffer
+ * @details Atomically flips the back buffer with the frontend, this never blocks and never touches any graphics API so
+ *          it can be called from any virtual console thread (but always the same one). After the flip the new back
+ *          buffer contains a copy of the presented frame, so it is fine to only draw what has changed.
+ * @remark Presenting faster than the frontend shows frames is fine, frames that were not shown are skipped
+ */
+AR_API void ar_graphics_present(void);
+
+/**
+ * @brief Acquire the most recently presented frame
+ * @details The returned frame is owned by the frontend until the next call to this function, the virtual console
+ *          never writes to it in the meantime.
+ * @remarks Used by the frontend application, shouldn't be used by virtual console developers
+ * @return Pixels of the presented frame in frame buffer's format (size = pitch x height) or NULL if nothing new was
+ *         presented since the last call
+ */
+AR_API const void* ar_graphics_acquire_frame(void);
+
+/**
+ * @brief Get palette that was presented together with the acquired frame
+ * @remarks Used by the frontend application, shouldn't be used by virtual console developers
+ * @return 'AR_PALETTE_SIZE' colours, only valid until the next 'ar_graphics_acquire_frame'
+ */
+AR_API const struct ar_pixel* ar_graphics_get_acquired_palette(void);
+
+/// @brief Function called after a frame was presented, 'user_data' is the value passed when setting the callback
+typedef void (* ar_graphics_present_callback)(void* user_data);
+
+/**
+ * @brief Set function that gets called each time a frame is presented
+ * @details Lets the frontend wake up its present thread instead of polling for new frames. Once this returns the
+ *          previous callback is neither running nor called again, its user data can be freed. Must not be called
+ *          from within the callback and only from one thread at a time.
+ * @remarks Used by the frontend application, shouldn't be used by virtual console developers
+ * @param callback Function to call from within 'ar_graphics_present' (on virtual console's thread) or NULL
+ * @param user_data Value passed to the callback
+ */
+AR_API void ar_graphics_set_present_callback(ar_graphics_present_callback callback, void* user_data);
+
 /************************************* SDL2 *************************************/
 
 /**
  * @brief Connect access to retro library with access to retro frontend SDL objects
+ * @warning SDL renderer is not thread-safe, rendering from virtual console's threads while the frontend uses SDL can
+ *          crash. Prefer 'ar_graphics_method_frame_buffer' where the frontend does all rendering itself.
  * @remarks Used by the frontend application, shouldn't be used by virtual console developers
  * @param window Frontend's SDL Window object
  * @param renderer Frontend's SDL Renderer object
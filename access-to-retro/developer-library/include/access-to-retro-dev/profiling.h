@@ -0,0 +1,91 @@
+/**
+ * @file profiling.h
+ */
+
+/** @defgroup group_profiling Profiling
+ *  Measures how long named zones of code take and exports them as a trace
+ *  @{
+ */
+
+#ifndef ACCESS_TO_RETRO_PROFILING_H
+#define ACCESS_TO_RETRO_PROFILING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "basics.h"
+
+/**
+ * @brief Number of events (zone begins and ends) that a single thread can record
+ * @details Every thread gets its own buffer the first time it records while profiling is enabled, 16 bytes per event
+ *          so 1MB per thread. Events that do not fit are dropped and counted.
+ */
+#define AR_PROFILE_THREAD_EVENT_CAPACITY 65536
+
+/**
+ * @brief Enable or disable recording of profiling zones
+ * @details Profiling is disabled by default, a disabled 'ar_profile_begin'/'ar_profile_end' is a single branch.
+ *          Enabling does not clear events recorded earlier, 'ar_profile_clear' does.
+ * @param enabled Whether zones should be recorded
+ */
+AR_API void ar_profile_set_enabled(bool enabled);
+
+/**
+ * @brief Check whether zones are being recorded
+ * @return Whether profiling is enabled
+ */
+AR_API bool ar_profile_is_enabled(void);
+
+/**
+ * @brief Begin a zone on the calling thread, every begin has to be followed by 'ar_profile_end' on the same thread
+ * @details Zones nest, the end closes the zone that began last. Recording only writes to the calling thread's own
+ *          buffer, there are no locks.
+ * @warning Only the pointer is stored, name has to stay valid until the trace is written (use string literals)
+ * @param name Name of the zone shown in the trace
+ */
+AR_API void ar_profile_begin(const char* name);
+
+/// @brief End the zone that began last on the calling thread
+AR_API void ar_profile_end(void);
+
+/**
+ * @brief Name the calling thread in the trace, threads without a name are shown by their number
+ * @warning Only the pointer is stored, name has to stay valid until the trace is written (use string literals)
+ * @param name Name of the thread
+ */
+AR_API void ar_profile_set_thread_name(const char* name);
+
+/**
+ * @brief Write recorded zones of all threads as Chrome trace (JSON), opened by 'chrome://tracing' and Perfetto
+ * @details Can be called while other threads are recording, events recorded during the writing may be missing.
+ * @param path Path of the trace file
+ * @return Error codes:
+ *  - 0: No error
+ *  - 1: Unable to open the file
+ *  - 2: Unable to write the file
+ */
+AR_API ar_err_code ar_profile_write_trace(const char* path);
+
+/**
+ * @brief Get number of events that did not fit into their thread's buffer
+ * @return Dropped event count since the last clear
+ */
+AR_API uint64_t ar_profile_get_dropped_count(void);
+
+/**
+ * @brief Disable profiling and drop all recorded events
+ * @details Can be called while other threads are recording, thread buffers are kept and reused. Events a thread was
+ *          recording while this function ran may be dropped.
+ */
+AR_API void ar_profile_clear(void);
+
+/**
+ * @brief Disable profiling and free buffers of all threads
+ * @remarks Called automatically in 'ar_quit', no need for developer to call it himself
+ * @warning No thread may be inside 'ar_profile_begin'/'ar_profile_end' while this function runs, virtual console's
+ *          threads have to be joined first
+ */
+AR_API void ar_profile_free(void);
+
+#endif //ACCESS_TO_RETRO_PROFILING_H
+
+/** @} */ // end of group
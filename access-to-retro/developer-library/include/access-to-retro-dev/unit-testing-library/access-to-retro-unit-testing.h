@@ -12,6 +12,8 @@
 
 #include "definitions.h"
 #include "asserts.h"
+#include "benchmarks.h"
+#include "test-runner.h"
 
 #endif //ACCESS_TO_RETRO_AR_UNIT_TESTING_H
 
@@ -0,0 +1,335 @@
+/**
+ * @file benchmarks.h
+ */
+
+/** @defgroup group_unit_testing_benchmarks Benchmarks
+ *  Contains microbenchmark definitions, measured with the same drivers as unit tests
+ *  @{
+ */
+
+#ifndef ACCESS_TO_RETRO_BENCHMARKS_H
+#define ACCESS_TO_RETRO_BENCHMARKS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "definitions.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <intrin.h>
+#else
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#endif
+
+/// @brief Wall clock time spent running the benchmark before it is measured (also used to calibrate iterations)
+#define AR_BENCHMARK_WARM_UP_NS 100000000ULL
+
+/// @brief Wall clock time each sample should take, iteration count is calibrated to reach it
+#define AR_BENCHMARK_SAMPLE_NS 10000000ULL
+
+/// @brief Number of samples a benchmark is measured with, median and 99th percentile are taken over them
+#define AR_BENCHMARK_SAMPLE_COUNT 51
+
+/// @brief Environment variable with path of a file that benchmark results are appended to (one JSON object per line)
+#define AR_BENCHMARK_OUTPUT_ENV "AR_BENCHMARK_OUTPUT"
+
+/// @brief State of a running benchmark, passed to the benchmark function
+struct ar_benchmark_state
+{
+    /// @brief Number of iterations the current sample runs
+    uint64_t iterations;
+
+    /// @brief Iterations left in the current sample
+    uint64_t remaining;
+
+    /// @brief Monotonic time when the current sample's loop started (nanoseconds)
+    uint64_t start_ns;
+
+    /// @brief Time stamp counter when the current sample's loop started, 0 if there is no TSC
+    uint64_t start_cycles;
+
+    /// @brief Duration of the last sample (nanoseconds)
+    uint64_t elapsed_ns;
+
+    /// @brief Time stamp counter ticks of the last sample
+    uint64_t elapsed_cycles;
+};
+
+/// @brief Result of a measured benchmark, all values are per single iteration
+struct ar_benchmark_result
+{
+    /// @brief Number of iterations in each sample
+    uint64_t iterations;
+
+    /// @brief Number of samples
+    uint32_t samples;
+
+    /// @brief Fastest sample (nanoseconds)
+    double min_ns;
+
+    /// @brief Median sample (nanoseconds)
+    double median_ns;
+
+    /// @brief 99th percentile sample (nanoseconds)
+    double p99_ns;
+
+    /// @brief Average of all samples (nanoseconds)
+    double mean_ns;
+
+    /// @brief Median sample in time stamp counter ticks, 0 if there is no TSC
+    double median_cycles;
+};
+
+/// @brief Benchmark function, defined with 'DEFINE_BENCHMARK'
+typedef void (* ar_benchmark_fn)(struct ar_benchmark_state* state);
+
+/**
+ * @brief Define a benchmark
+ * @details Setup goes before 'BENCHMARK_LOOP', only the loop's body is measured
+ * @param FN_NAME name of the benchmark function
+ */
+#define DEFINE_BENCHMARK(FN_NAME) void FN_NAME(struct ar_benchmark_state* ar_benchmark)
+
+/// @brief Loop measured by the benchmark, its body is a single iteration
+#define BENCHMARK_LOOP for (ar_benchmark_start(ar_benchmark); ar_benchmark_keep_running(ar_benchmark);)
+
+/**
+ * @brief Keep the compiler from optimizing away a value computed by the benchmark
+ * @param VALUE Value that has to be computed
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define BENCHMARK_KEEP(VALUE) __asm__ volatile("" : : "g"(VALUE) : "memory")
+#else
+#define BENCHMARK_KEEP(VALUE) (ar_benchmark_sink = (uint64_t) (VALUE), _ReadWriteBarrier())
+#endif
+
+/**
+ * @brief Connect benchmark function with a name used in CMakeLists.txt, prints and records its result
+ * @param BENCHMARK_FN_NAME Benchmark function
+ */
+#define DEFINE_BENCHMARK_FN(BENCHMARK_FN_NAME) \
+if (strcmp(argv[1], #BENCHMARK_FN_NAME) == 0) \
+{ \
+    struct ar_benchmark_result ar_benchmark_result; \
+    ar_benchmark_measure(BENCHMARK_FN_NAME, &ar_benchmark_result); \
+    return ar_benchmark_report(#BENCHMARK_FN_NAME, &ar_benchmark_result); \
+} \
+
+/**
+ * @brief Assert that median iteration of a benchmark takes less than given time
+ * @param BENCHMARK_FN Benchmark function
+ * @param MAX_NS Longest allowed median iteration in nanoseconds
+ * @param FAIL_CODE Error code returned from the test on failure
+ */
+#define ASSERT_FASTER_THAN(BENCHMARK_FN, MAX_NS, FAIL_CODE) \
+{ \
+    struct ar_benchmark_result ar_benchmark_result; \
+    ar_benchmark_measure(BENCHMARK_FN, &ar_benchmark_result); \
+    ar_benchmark_report(#BENCHMARK_FN, &ar_benchmark_result); \
+    if (!(ar_benchmark_result.median_ns < (double) (MAX_NS))) \
+    { \
+        COMPLETE_TEST(ERROR(FAIL_CODE)); \
+    } \
+} \
+
+/**
+ * @brief Assert that median iteration of one benchmark is faster than median iteration of another
+ * @remarks Prefer this over 'ASSERT_FASTER_THAN' where possible, relative comparison does not depend on the machine
+ * @param FAST_BENCHMARK_FN Benchmark expected to be faster
+ * @param SLOW_BENCHMARK_FN Benchmark expected to be slower
+ * @param FAIL_CODE Error code returned from the test on failure
+ */
+#define ASSERT_FASTER_THAN_BENCHMARK(FAST_BENCHMARK_FN, SLOW_BENCHMARK_FN, FAIL_CODE) \
+{ \
+    struct ar_benchmark_result ar_benchmark_fast_result; \
+    struct ar_benchmark_result ar_benchmark_slow_result; \
+    ar_benchmark_measure(FAST_BENCHMARK_FN, &ar_benchmark_fast_result); \
+    ar_benchmark_measure(SLOW_BENCHMARK_FN, &ar_benchmark_slow_result); \
+    ar_benchmark_report(#FAST_BENCHMARK_FN, &ar_benchmark_fast_result); \
+    ar_benchmark_report(#SLOW_BENCHMARK_FN, &ar_benchmark_slow_result); \
+    if (!(ar_benchmark_fast_result.median_ns < ar_benchmark_slow_result.median_ns)) \
+    { \
+        COMPLETE_TEST(ERROR(FAIL_CODE)); \
+    } \
+} \
+
+#if !defined(__GNUC__) && !defined(__clang__)
+/// @brief Target of 'BENCHMARK_KEEP' on compilers without inline assembly
+static volatile uint64_t ar_benchmark_sink;
+#endif
+
+/**
+ * @brief Get monotonic time
+ * @return Nanoseconds from an unspecified point
+ */
+static inline uint64_t ar_benchmark_now_ns(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+
+    return (uint64_t) ((double) counter.QuadPart * 1e9 / (double) frequency.QuadPart);
+#else
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (uint64_t) time.tv_sec * 1000000000ULL + (uint64_t) time.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Read time stamp counter
+ * @return Reference cycles, 0 on architectures without TSC
+ */
+static inline uint64_t ar_benchmark_cycles(void)
+{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    return (uint64_t) __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Start measuring a sample, used by 'BENCHMARK_LOOP'
+ * @param state Benchmark state
+ */
+static inline void ar_benchmark_start(struct ar_benchmark_state* state)
+{
+    state->remaining = state->iterations;
+    state->start_cycles = ar_benchmark_cycles();
+    state->start_ns = ar_benchmark_now_ns();
+}
+
+/**
+ * @brief Count an iteration and stop measuring once all iterations ran, used by 'BENCHMARK_LOOP'
+ * @param state Benchmark state
+ * @return Whether another iteration should run
+ */
+static inline bool ar_benchmark_keep_running(struct ar_benchmark_state* state)
+{
+    if (state->remaining > 0)
+    {
+        state->remaining--;
+        return true;
+    }
+
+    state->elapsed_ns = ar_benchmark_now_ns() - state->start_ns;
+    state->elapsed_cycles = ar_benchmark_cycles() - state->start_cycles;
+
+    return false;
+}
+
+/**
+ * @brief Compare two samples, used to sort them
+ * @param a First sample
+ * @param b Second sample
+ * @return Negative, zero or positive like 'strcmp'
+ */
+static inline int ar_benchmark_compare(const void* a, const void* b)
+{
+    double first = *(const double*) a;
+    double second = *(const double*) b;
+
+    return (first > second) - (first < second);
+}
+
+/**
+ * @brief Warm up, calibrate and measure a benchmark
+ * @details Iterations double during warm-up until a run takes long enough to calibrate against, then every sample
+ *          runs as many iterations as fit into 'AR_BENCHMARK_SAMPLE_NS'
+ * @param benchmark Benchmark function
+ * @param result Measured result
+ */
+static inline void ar_benchmark_measure(ar_benchmark_fn benchmark, struct ar_benchmark_result* result)
+{
+    struct ar_benchmark_state state;
+    memset(&state, 0, sizeof(state));
+    state.iterations = 1;
+
+    // Warm-up caches, branch predictors and clocks while finding out how long an iteration takes
+    uint64_t warm_up_start = ar_benchmark_now_ns();
+    while (true)
+    {
+        benchmark(&state);
+
+        if (ar_benchmark_now_ns() - warm_up_start >= AR_BENCHMARK_WARM_UP_NS &&
+            state.elapsed_ns >= AR_BENCHMARK_SAMPLE_NS / 10)
+        {
+            break;
+        }
+
+        if (state.elapsed_ns < AR_BENCHMARK_SAMPLE_NS)
+        {
+            state.iterations *= 2;
+        }
+    }
+
+    double iteration_ns = (double) state.elapsed_ns / (double) state.iterations;
+    state.iterations = (uint64_t) ((double) AR_BENCHMARK_SAMPLE_NS / iteration_ns) + 1;
+
+    double samples_ns[AR_BENCHMARK_SAMPLE_COUNT];
+    double samples_cycles[AR_BENCHMARK_SAMPLE_COUNT];
+    double total_ns = 0.0;
+
+    for (uint32_t i = 0; i < AR_BENCHMARK_SAMPLE_COUNT; i++)
+    {
+        benchmark(&state);
+
+        samples_ns[i] = (double) state.elapsed_ns / (double) state.iterations;
+        samples_cycles[i] = (double) state.elapsed_cycles / (double) state.iterations;
+        total_ns += samples_ns[i];
+    }
+
+    qsort(samples_ns, AR_BENCHMARK_SAMPLE_COUNT, sizeof(double), ar_benchmark_compare);
+    qsort(samples_cycles, AR_BENCHMARK_SAMPLE_COUNT, sizeof(double), ar_benchmark_compare);
+
+    result->iterations = state.iterations;
+    result->samples = AR_BENCHMARK_SAMPLE_COUNT;
+    result->min_ns = samples_ns[0];
+    result->median_ns = samples_ns[AR_BENCHMARK_SAMPLE_COUNT / 2];
+    result->p99_ns = samples_ns[(AR_BENCHMARK_SAMPLE_COUNT * 99) / 100];
+    result->mean_ns = total_ns / AR_BENCHMARK_SAMPLE_COUNT;
+    result->median_cycles = samples_cycles[AR_BENCHMARK_SAMPLE_COUNT / 2];
+}
+
+/**
+ * @brief Print a result and append it to the file named by 'AR_BENCHMARK_OUTPUT' environment variable
+ * @param name Name of the benchmark
+ * @param result Measured result
+ * @return 0 so it can be returned from the testing entry point
+ */
+static inline int ar_benchmark_report(const char* name, const struct ar_benchmark_result* result)
+{
+    printf("%s: median %.2f ns, p99 %.2f ns, min %.2f ns, mean %.2f ns, %.1f cycles (%llu iterations x %u samples)\n",
+           name, result->median_ns, result->p99_ns, result->min_ns, result->mean_ns, result->median_cycles,
+           (unsigned long long) result->iterations, result->samples);
+
+    const char* output_path = getenv(AR_BENCHMARK_OUTPUT_ENV);
+    if (output_path != NULL && output_path[0] != '\0')
+    {
+        FILE* output = fopen(output_path, "a");
+        if (output != NULL)
+        {
+            fprintf(output, "{\"name\": \"%s\", \"iterations\": %llu, \"samples\": %u, \"min_ns\": %.3f, "
+                            "\"median_ns\": %.3f, \"p99_ns\": %.3f, \"mean_ns\": %.3f, \"median_cycles\": %.3f}\n",
+                    name, (unsigned long long) result->iterations, result->samples, result->min_ns,
+                    result->median_ns, result->p99_ns, result->mean_ns, result->median_cycles);
+            fclose(output);
+        }
+    }
+
+    return 0;
+}
+
+#endif //ACCESS_TO_RETRO_BENCHMARKS_H
+
+/** @} */ // end of group
@@ -0,0 +1,635 @@
+/**
+ * @file test-runner.h
+ */
+
+/** @defgroup group_unit_testing_test_runner TestRunner
+ *  Contains test registration tables and a runner executing them in parallel
+ *  @{
+ */
+
+#ifndef ACCESS_TO_RETRO_TEST_RUNNER_H
+#define ACCESS_TO_RETRO_TEST_RUNNER_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "definitions.h"
+#include "benchmarks.h"
+
+#if defined(__linux__) || defined(__APPLE__)
+#define AR_TEST_RUNNER_ISOLATION 1
+#include <sys/wait.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#else
+#define AR_TEST_RUNNER_ISOLATION 0
+#endif
+
+/// @brief Seconds a test can run before it is killed, when '--timeout' is not given
+#define AR_TEST_DEFAULT_TIMEOUT 30.0
+
+/// @brief Number of slowest tests listed in the timing report
+#define AR_TEST_REPORT_SLOWEST 10
+
+/// @brief Test registered in a test table
+struct ar_test_entry
+{
+    /// @brief Name of the test, same as used in CMakeLists.txt
+    const char* name;
+
+    /// @brief Test function, NULL for benchmarks
+    int (* test_fn)(void);
+
+    /// @brief Benchmark function, NULL for tests
+    ar_benchmark_fn benchmark_fn;
+
+    /// @brief Whether the test runs alone after the parallel ones (for ex: performance assertions)
+    bool serial;
+
+    /// @brief Whether it only runs by name or with '--benchmarks' (benchmarks and absolute speed assertions)
+    bool opt_in;
+};
+
+/**
+ * @brief Define a table of tests, ends with 'END_TEST_TABLE'
+ * @param TABLE_NAME Name of the table
+ */
+#define DEFINE_TEST_TABLE(TABLE_NAME) const struct ar_test_entry TABLE_NAME[] =
+
+/**
+ * @brief Register a test that can run in parallel with others
+ * @param TEST_FN Testing function
+ */
+#define REGISTER_TEST(TEST_FN) { #TEST_FN, TEST_FN, NULL, false, false }
+
+/**
+ * @brief Register a test that runs alone, used for tests that measure time
+ * @remarks Tests that run by default should only compare benchmarks with 'ASSERT_FASTER_THAN_BENCHMARK'
+ * @param TEST_FN Testing function
+ */
+#define REGISTER_SERIAL_TEST(TEST_FN) { #TEST_FN, TEST_FN, NULL, true, false }
+
+/**
+ * @brief Register a test asserting absolute times with 'ASSERT_FASTER_THAN', runs alone and only by name or with
+ *        '--benchmarks' as its bounds depend on the machine
+ * @param TEST_FN Testing function
+ */
+#define REGISTER_SPEED_TEST(TEST_FN) { #TEST_FN, TEST_FN, NULL, true, true }
+
+/**
+ * @brief Register a benchmark, only runs by name or with '--benchmarks'
+ * @param BENCHMARK_FN Benchmark function
+ */
+#define REGISTER_BENCHMARK(BENCHMARK_FN) { #BENCHMARK_FN, NULL, BENCHMARK_FN, true, true }
+
+/// @brief Last entry of a test table
+#define END_TEST_TABLE { NULL, NULL, NULL, false, false }
+
+/**
+ * @brief Used to define entry point running a test table, to be used instead of 'DEFINE_TESTING_ENTRY_POINT'
+ * @details Tests linked into the single test runner (AR_SINGLE_TEST_RUNNER defined) do not get their own entry point
+ * @param TABLE_NAME Name of the table
+ */
+#ifdef AR_SINGLE_TEST_RUNNER
+#define DEFINE_TEST_TABLE_ENTRY_POINT(TABLE_NAME)
+#else
+#define DEFINE_TEST_TABLE_ENTRY_POINT(TABLE_NAME) \
+int main(int argc, char** argv) \
+{ \
+    const struct ar_test_entry* ar_test_tables[] = { TABLE_NAME, NULL }; \
+    return ar_run_test_tables(ar_test_tables, argc, argv); \
+} \
+
+#endif
+
+/// @brief Settings of a test run
+struct ar_test_run_options
+{
+    /// @brief Number of tests running at the same time
+    uint32_t jobs;
+
+    /// @brief Seconds a test can run before it is killed
+    double timeout;
+
+    /// @brief Only tests containing this string run, NULL for all
+    const char* filter;
+
+    /// @brief Whether benchmarks and absolute speed tests run too
+    bool benchmarks;
+
+    /// @brief Whether tests run in the runner's process instead of a forked child
+    bool no_fork;
+};
+
+/// @brief Result of a single test
+struct ar_test_result
+{
+    /// @brief Test that was run
+    const struct ar_test_entry* entry;
+
+    /// @brief "passed", "failed", "crashed" or "timed out"
+    const char* status;
+
+    /// @brief Value returned by the test, signal number if it crashed
+    int code;
+
+    /// @brief Wall clock time of the test in milliseconds
+    double duration_ms;
+
+    /// @brief Everything the test wrote to standard output and error, NULL if it ran in the runner's process
+    char* output;
+};
+
+/// @brief Shared state of the worker threads
+struct ar_test_run
+{
+    /// @brief Tests that run in this phase
+    const struct ar_test_entry** entries;
+
+    /// @brief Results, same order as 'entries'
+    struct ar_test_result* results;
+
+    /// @brief Number of entries
+    size_t count;
+
+    /// @brief Index of the next entry to run
+    atomic_size_t next;
+
+    /// @brief Settings of the run
+    const struct ar_test_run_options* options;
+};
+
+/**
+ * @brief Run a test or benchmark entry in the calling process
+ * @param entry Test to run
+ * @return Value returned by the test
+ */
+static inline int ar_run_test_entry(const struct ar_test_entry* entry)
+{
+    if (entry->benchmark_fn != NULL)
+    {
+        struct ar_benchmark_result result;
+        ar_benchmark_measure(entry->benchmark_fn, &result);
+
+        return ar_benchmark_report(entry->name, &result);
+    }
+
+    return entry->test_fn();
+}
+
+#if AR_TEST_RUNNER_ISOLATION
+/**
+ * @brief Append whatever the child wrote to the pipe, never blocks
+ * @param fd Read end of the pipe
+ * @param output Collected output, reallocated as it grows
+ * @param size Length of the collected output
+ */
+static inline void ar_test_read_output(int fd, char** output, size_t* size)
+{
+    char buffer[4096];
+    ssize_t read_size = 0;
+
+    while ((read_size = read(fd, buffer, sizeof(buffer))) > 0)
+    {
+        char* grown = realloc(*output, *size + (size_t) read_size + 1);
+        if (grown == NULL)
+        {
+            return;
+        }
+
+        memcpy(grown + *size, buffer, (size_t) read_size);
+        *size += (size_t) read_size;
+        grown[*size] = '\0';
+        *output = grown;
+    }
+}
+
+/**
+ * @brief Run a test in a forked child, killing it if it does not finish in time
+ * @details Library state is global, separate processes let tests run at the same time without sharing it and keep
+ *          a crashing test from taking the runner down
+ * @param entry Test to run
+ * @param timeout Seconds the test can run
+ * @param result Result of the test
+ */
+static inline void ar_run_test_isolated(const struct ar_test_entry* entry, double timeout,
+                                        struct ar_test_result* result)
+{
+    int pipe_fds[2];
+    if (pipe(pipe_fds) != 0)
+    {
+        result->status = "failed";
+        result->code = -1;
+        return;
+    }
+
+    fflush(stdout);
+    fflush(stderr);
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        dup2(pipe_fds[1], STDOUT_FILENO);
+        dup2(pipe_fds[1], STDERR_FILENO);
+        close(pipe_fds[0]);
+        close(pipe_fds[1]);
+
+        int code = ar_run_test_entry(entry);
+        if (code != 0)
+        {
+            printf("\n%s returned %d\n", entry->name, code);
+        }
+
+        fflush(stdout);
+        _exit(code == 0 ? 0 : 1);
+    }
+
+    close(pipe_fds[1]);
+
+    if (pid < 0)
+    {
+        close(pipe_fds[0]);
+        result->status = "failed";
+        result->code = -1;
+        return;
+    }
+
+    fcntl(pipe_fds[0], F_SETFL, fcntl(pipe_fds[0], F_GETFL) | O_NONBLOCK);
+
+    size_t output_size = 0;
+    uint64_t deadline = ar_benchmark_now_ns() + (uint64_t) (timeout * 1e9);
+    struct timespec poll_interval = { 0, 100000 };
+
+    while (true)
+    {
+        ar_test_read_output(pipe_fds[0], &result->output, &output_size);
+
+        int status = 0;
+        if (waitpid(pid, &status, WNOHANG) == pid)
+        {
+            ar_test_read_output(pipe_fds[0], &result->output, &output_size);
+
+            if (WIFSIGNALED(status))
+            {
+                result->status = "crashed";
+                result->code = WTERMSIG(status);
+            }
+            else
+            {
+                result->code = WEXITSTATUS(status);
+                result->status = result->code == 0 ? "passed" : "failed";
+            }
+
+            break;
+        }
+
+        if (ar_benchmark_now_ns() >= deadline)
+        {
+            kill(pid, SIGKILL);
+            waitpid(pid, NULL, 0);
+            ar_test_read_output(pipe_fds[0], &result->output, &output_size);
+
+            result->status = "timed out";
+            result->code = -1;
+            break;
+        }
+
+        nanosleep(&poll_interval, NULL);
+    }
+
+    close(pipe_fds[0]);
+}
+#endif
+
+/**
+ * @brief Run a single test and time it
+ * @param entry Test to run
+ * @param options Settings of the run
+ * @param result Result of the test
+ */
+static inline void ar_run_test(const struct ar_test_entry* entry, const struct ar_test_run_options* options,
+                               struct ar_test_result* result)
+{
+    memset(result, 0, sizeof(*result));
+    result->entry = entry;
+
+    uint64_t start = ar_benchmark_now_ns();
+
+#if AR_TEST_RUNNER_ISOLATION
+    if (!options->no_fork)
+    {
+        ar_run_test_isolated(entry, options->timeout, result);
+    }
+    else
+#endif
+    {
+        (void) options;
+
+        result->code = ar_run_test_entry(entry);
+        result->status = result->code == 0 ? "passed" : "failed";
+    }
+
+    result->duration_ms = (double) (ar_benchmark_now_ns() - start) / 1e6;
+}
+
+/**
+ * @brief Worker thread function, runs entries until none are left
+ * @param data Pointer to 'ar_test_run'
+ * @return NULL
+ */
+static inline void* ar_test_worker(void* data)
+{
+    struct ar_test_run* run = data;
+
+    for (size_t i = atomic_fetch_add(&run->next, 1); i < run->count; i = atomic_fetch_add(&run->next, 1))
+    {
+        ar_run_test(run->entries[i], run->options, &run->results[i]);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Run entries on worker threads
+ * @details Without process isolation tests would share library state, they run one after another instead
+ * @param run Entries and their results
+ * @param jobs Number of worker threads
+ */
+static inline void ar_run_test_phase(struct ar_test_run* run, uint32_t jobs)
+{
+    atomic_init(&run->next, 0);
+
+#if AR_TEST_RUNNER_ISOLATION
+    if (!run->options->no_fork && jobs > 1)
+    {
+        pthread_t threads[64];
+        uint32_t thread_count = jobs < 64 ? jobs : 64;
+        uint32_t started = 0;
+
+        for (; started < thread_count; started++)
+        {
+            if (pthread_create(&threads[started], NULL, ar_test_worker, run) != 0)
+            {
+                break;
+            }
+        }
+
+        // Calling thread helps too, this also covers the case when no thread could be started
+        ar_test_worker(run);
+
+        for (uint32_t i = 0; i < started; i++)
+        {
+            pthread_join(threads[i], NULL);
+        }
+
+        return;
+    }
+#else
+    (void) jobs;
+#endif
+
+    ar_test_worker(run);
+}
+
+/**
+ * @brief Compare results by duration, slowest first
+ * @param a First result
+ * @param b Second result
+ * @return Negative, zero or positive like 'strcmp'
+ */
+static inline int ar_test_compare_duration(const void* a, const void* b)
+{
+    double first = (*(const struct ar_test_result* const*) a)->duration_ms;
+    double second = (*(const struct ar_test_result* const*) b)->duration_ms;
+
+    return (first < second) - (first > second);
+}
+
+/**
+ * @brief Print failures and the timing report
+ * @param results Results of all tests
+ * @param count Number of results
+ * @param elapsed_ms Wall clock time of the whole run
+ * @return Number of tests that did not pass
+ */
+static inline size_t ar_test_report(struct ar_test_result* results, size_t count, double elapsed_ms)
+{
+    size_t failed = 0;
+    double total_ms = 0.0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        total_ms += results[i].duration_ms;
+
+        if (strcmp(results[i].status, "passed") == 0)
+        {
+            continue;
+        }
+
+        failed++;
+        printf("[%s] %s (code %d, %.1f ms)\n", results[i].status, results[i].entry->name, results[i].code,
+               results[i].duration_ms);
+
+        if (results[i].output != NULL && results[i].output[0] != '\0')
+        {
+            printf("%s\n", results[i].output);
+        }
+    }
+
+    const struct ar_test_result** sorted = malloc(count * sizeof(const struct ar_test_result*));
+    if (sorted != NULL)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            sorted[i] = &results[i];
+        }
+
+        qsort(sorted, count, sizeof(const struct ar_test_result*), ar_test_compare_duration);
+
+        printf("\nSlowest tests:\n");
+        for (size_t i = 0; i < count && i < AR_TEST_REPORT_SLOWEST; i++)
+        {
+            printf("  %10.2f ms  %-9s  %s\n", sorted[i]->duration_ms, sorted[i]->status, sorted[i]->entry->name);
+        }
+
+        free(sorted);
+    }
+
+    printf("\n%zu tests, %zu passed, %zu failed in %.1f ms (%.1f ms of test time)\n", count, count - failed, failed,
+           elapsed_ms, total_ms);
+
+    return failed;
+}
+
+/**
+ * @brief Parse runner's arguments
+ * @param argc Number of arguments
+ * @param argv Arguments
+ * @param options Parsed settings
+ * @return Whether the arguments are valid
+ */
+static inline bool ar_test_parse_options(int argc, char** argv, struct ar_test_run_options* options)
+{
+    options->jobs = 0;
+    options->timeout = AR_TEST_DEFAULT_TIMEOUT;
+    options->filter = NULL;
+    options->benchmarks = false;
+    options->no_fork = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool has_value = i + 1 < argc;
+
+        if (strcmp(argv[i], "--jobs") == 0 && has_value)
+        {
+            options->jobs = (uint32_t) strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--timeout") == 0 && has_value)
+        {
+            options->timeout = strtod(argv[++i], NULL);
+        }
+        else if (strcmp(argv[i], "--filter") == 0 && has_value)
+        {
+            options->filter = argv[++i];
+        }
+        else if (strcmp(argv[i], "--benchmarks") == 0)
+        {
+            options->benchmarks = true;
+        }
+        else if (strcmp(argv[i], "--no-fork") == 0)
+        {
+            options->no_fork = true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    if (options->jobs == 0)
+    {
+#if AR_TEST_RUNNER_ISOLATION
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+        options->jobs = processors > 0 ? (uint32_t) processors : 1;
+#else
+        options->jobs = 1;
+#endif
+    }
+
+    return true;
+}
+
+/**
+ * @brief Run tests from tables
+ * @details With a test name as the only argument just that test runs in the calling process (one process per test,
+ *          as registered in CMakeLists.txt). Otherwise all matching tests run, parallel ones on '--jobs' threads each
+ *          in its own forked child with '--timeout', then serial ones one by one, and a timing report is printed.
+ * @param tables NULL terminated list of tables
+ * @param argc Number of arguments
+ * @param argv Arguments
+ * @return 0 if all tests passed, result of the test when running a single one
+ */
+static inline int ar_run_test_tables(const struct ar_test_entry* const* tables, int argc, char** argv)
+{
+    // Single test by name
+    if (argc == 2 && strncmp(argv[1], "--", 2) != 0)
+    {
+        for (size_t table = 0; tables[table] != NULL; table++)
+        {
+            for (const struct ar_test_entry* entry = tables[table]; entry->name != NULL; entry++)
+            {
+                if (strcmp(entry->name, argv[1]) == 0)
+                {
+                    return ar_run_test_entry(entry);
+                }
+            }
+        }
+
+        fprintf(stderr, "Test '%s' not found\n", argv[1]);
+        return -1;
+    }
+
+    struct ar_test_run_options options;
+    if (!ar_test_parse_options(argc, argv, &options))
+    {
+        fprintf(stderr, "usage: %s [<test>] [--jobs N] [--timeout S] [--filter TEXT] [--benchmarks] [--no-fork]\n",
+                argv[0]);
+        return -1;
+    }
+
+    size_t count = 0;
+    for (size_t table = 0; tables[table] != NULL; table++)
+    {
+        for (const struct ar_test_entry* entry = tables[table]; entry->name != NULL; entry++)
+        {
+            count++;
+        }
+    }
+
+    const struct ar_test_entry** parallel = malloc((count + 1) * sizeof(const struct ar_test_entry*));
+    const struct ar_test_entry** serial = malloc((count + 1) * sizeof(const struct ar_test_entry*));
+    struct ar_test_result* results = calloc(count + 1, sizeof(struct ar_test_result));
+    if (parallel == NULL || serial == NULL || results == NULL)
+    {
+        free(parallel);
+        free(serial);
+        free(results);
+        return -1;
+    }
+
+    size_t parallel_count = 0;
+    size_t serial_count = 0;
+
+    for (size_t table = 0; tables[table] != NULL; table++)
+    {
+        for (const struct ar_test_entry* entry = tables[table]; entry->name != NULL; entry++)
+        {
+            if ((options.filter != NULL && strstr(entry->name, options.filter) == NULL) ||
+                (entry->opt_in && !options.benchmarks))
+            {
+                continue;
+            }
+
+            if (entry->serial)
+            {
+                serial[serial_count++] = entry;
+            }
+            else
+            {
+                parallel[parallel_count++] = entry;
+            }
+        }
+    }
+
+    uint64_t start = ar_benchmark_now_ns();
+
+    struct ar_test_run parallel_run = { parallel, results, parallel_count, 0, &options };
+    ar_run_test_phase(&parallel_run, options.jobs);
+
+    // Tests measuring time run alone so that other tests do not disturb them
+    struct ar_test_run serial_run = { serial, results + parallel_count, serial_count, 0, &options };
+    ar_run_test_phase(&serial_run, 1);
+
+    size_t failed = ar_test_report(results, parallel_count + serial_count,
+                                   (double) (ar_benchmark_now_ns() - start) / 1e6);
+
+    for (size_t i = 0; i < parallel_count + serial_count; i++)
+    {
+        free(results[i].output);
+    }
+
+    free(parallel);
+    free(serial);
+    free(results);
+
+    return failed == 0 ? 0 : 1;
+}
+
+#endif //ACCESS_TO_RETRO_TEST_RUNNER_H
+
+/** @} */ // end of group
@@ -0,0 +1,178 @@
+#include <access-to-retro-dev/access-to-retro-dev.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief Address is on the worklist (or was walked already), cleared once the analysis finishes
+#define AR_CODE_QUEUED 0x80
+
+/****************************************************************************************************
+ Internal helpers
+****************************************************************************************************/
+
+/**
+ * @brief Mark an address as start of a basic block and queue it to be walked
+ * @details Every address is queued at most once so the worklist never needs more entries than the map has bytes.
+ * @param map Map being filled
+ * @param worklist_count Number of queued addresses
+ * @param address Address of the block
+ * @param flags Extra flags of the block ('AR_CODE_CALL_TARGET')
+ */
+static void ar_code_map_queue(struct ar_code_map* map, size_t* worklist_count, uint32_t address, uint8_t flags)
+{
+    if (address >= map->size)
+    {
+        return;
+    }
+
+    map->flags[address] = (uint8_t) (map->flags[address] | AR_CODE_BLOCK_START | flags);
+
+    if ((map->flags[address] & AR_CODE_QUEUED) == 0)
+    {
+        map->flags[address] = (uint8_t) (map->flags[address] | AR_CODE_QUEUED);
+        map->worklist[(*worklist_count)++] = address;
+    }
+}
+
+/****************************************************************************************************
+ API functions
+****************************************************************************************************/
+
+AR_API ar_err_code ar_code_map_create(struct ar_code_map* map, size_t size)
+{
+    memset(map, 0, sizeof(struct ar_code_map));
+
+    map->flags    = calloc(size, sizeof(uint8_t));
+    map->worklist = malloc(size * sizeof(uint32_t));
+
+    if (map->flags == NULL || map->worklist == NULL)
+    {
+        ar_code_map_destroy(map);
+        return 1;
+    }
+
+    map->size = size;
+
+    return 0;
+}
+
+AR_API void ar_code_map_destroy(struct ar_code_map* map)
+{
+    free(map->flags);
+    free(map->worklist);
+
+    memset(map, 0, sizeof(struct ar_code_map));
+}
+
+AR_API void ar_code_map_analyze(struct ar_code_map* map, const uint8_t* memory, const uint32_t* entries,
+                                size_t entry_count, ar_code_flow_decoder decoder, void* user_data)
+{
+    memset(map->flags, 0, map->size);
+    map->instruction_count = 0;
+    map->block_count       = 0;
+
+    size_t worklist_count = 0;
+    for (size_t i = 0; i < entry_count; i++)
+    {
+        ar_code_map_queue(map, &worklist_count, entries[i], 0);
+    }
+
+    while (worklist_count > 0)
+    {
+        uint32_t address = map->worklist[--worklist_count];
+
+        // Walk straight-line code until something changes the flow or another walk already decoded the rest
+        while (address < map->size)
+        {
+            uint8_t flags = map->flags[address];
+
+            if ((flags & AR_CODE_INSTRUCTION) != 0)
+            {
+                // Two paths join here, the first one to get here did not know that a block starts
+                map->flags[address] = (uint8_t) (flags | AR_CODE_BLOCK_START);
+                break;
+            }
+
+            if ((flags & AR_CODE_OPERAND) != 0)
+            {
+                map->flags[address] = (uint8_t) (flags | AR_CODE_OVERLAP);
+                break;
+            }
+
+            struct ar_code_flow flow = decoder(memory, map->size, address, user_data);
+            if (flow.length == 0 || flow.length > map->size - address)
+            {
+                break;
+            }
+
+            flags = (uint8_t) (flags | AR_CODE_INSTRUCTION | (flow.writes_memory ? AR_CODE_WRITES_MEMORY : 0));
+
+            for (uint32_t i = 1; i < flow.length; i++)
+            {
+                if ((map->flags[address + i] & AR_CODE_INSTRUCTION) != 0)
+                {
+                    flags = (uint8_t) (flags | AR_CODE_OVERLAP);
+                }
+
+                map->flags[address + i] = (uint8_t) (map->flags[address + i] | AR_CODE_OPERAND);
+            }
+
+            map->instruction_count++;
+
+            uint32_t next = address + flow.length;
+
+            if (flow.kind == ar_code_flow_next)
+            {
+                map->flags[address] = flags;
+                address = next;
+                continue;
+            }
+
+            if (flow.kind == ar_code_flow_indirect)
+            {
+                flags = (uint8_t) (flags | AR_CODE_INDIRECT);
+            }
+
+            map->flags[address] = flags;
+
+            // Block ends here, its successors start new ones
+            switch (flow.kind)
+            {
+                case ar_code_flow_jump:
+                    ar_code_map_queue(map, &worklist_count, flow.target, 0);
+                    break;
+
+                case ar_code_flow_branch:
+                    ar_code_map_queue(map, &worklist_count, flow.target, 0);
+                    ar_code_map_queue(map, &worklist_count, next, 0);
+                    break;
+
+                case ar_code_flow_call:
+                    ar_code_map_queue(map, &worklist_count, flow.target, AR_CODE_CALL_TARGET);
+                    ar_code_map_queue(map, &worklist_count, next, 0);
+                    break;
+
+                default:
+                    break;
+            }
+
+            break;
+        }
+    }
+
+    // Targets that never decoded are not blocks, queued marks are not part of the result
+    for (size_t address = 0; address < map->size; address++)
+    {
+        uint8_t flags = (uint8_t) (map->flags[address] & ~AR_CODE_QUEUED);
+
+        if ((flags & AR_CODE_INSTRUCTION) == 0)
+        {
+            flags = (uint8_t) (flags & ~(AR_CODE_BLOCK_START | AR_CODE_CALL_TARGET));
+        }
+        else if ((flags & AR_CODE_BLOCK_START) != 0)
+        {
+            map->block_count++;
+        }
+
+        map->flags[address] = flags;
+    }
+}
@@ -0,0 +1,314 @@
+#include <access-to-retro-dev/access-to-retro-dev.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/****************************************************************************************************
+ API global objects
+****************************************************************************************************/
+
+/**
+ * @brief Single producer single consumer queue of interleaved audio frames
+ * @details Read and write positions only ever grow (wrapping at 2^N), the number of queued frames is their difference.
+ *          Capacity is a power of 2 so a position is turned into an index using a mask. The producer (virtual console)
+ *          only writes 'write_position' and the consumer (frontend's audio device) only writes 'read_position', each
+ *          publishing with release and observing the other with acquire, so no locks are needed.
+ */
+struct ar_audio_queue
+{
+    /// @brief Queued frames, size = capacity * frame_size
+    uint8_t* frames;
+
+    /// @brief Number of frames that the queue can hold, always a power of 2
+    uint32_t capacity;
+
+    /// @brief Size of a single frame (sample size * channels) in bytes
+    uint32_t frame_size;
+
+    /// @brief Position of the next frame to be read, only written by the consumer
+    _Atomic uint32_t read_position;
+
+    /// @brief Position of the next frame to be written, only written by the producer
+    _Atomic uint32_t write_position;
+};
+
+/// @brief Largest queue capacity, positions are 32-bit and their difference has to tell a full queue from an empty one
+#define AR_AUDIO_MAX_QUEUE_CAPACITY (UINT64_C(1) << 31)
+
+/// @brief Queue between virtual console and frontend, 'frames' is NULL if audio was not configured
+static struct ar_audio_queue g_audio_queue = { .frames = NULL };
+
+/// @brief Configured sample rate, 0 if audio was not configured
+static uint32_t g_audio_sample_rate = 0;
+
+/// @brief Configured number of channels, 0 if audio was not configured
+static uint8_t g_audio_channels = 0;
+
+/// @brief Configured format of a single sample
+static enum ar_audio_format g_audio_format = ar_audio_format_s16;
+
+/// @brief Number of frames that the audio device should request at once
+static uint32_t g_audio_buffer_size = AR_AUDIO_DEFAULT_BUFFER_SIZE;
+
+/// @brief Number of pulls that could not be fully satisfied
+static _Atomic uint64_t g_audio_underrun_count;
+
+/// @brief Number of pushes that could not be fully queued
+static _Atomic uint64_t g_audio_overrun_count;
+
+/****************************************************************************************************
+ Internal helpers
+****************************************************************************************************/
+
+/**
+ * @brief Get size of a single sample in bytes
+ * @param format Sample format
+ * @return Size in bytes, 0 for unknown formats
+ */
+static uint32_t ar_audio_sample_size(enum ar_audio_format format)
+{
+    switch (format)
+    {
+        case ar_audio_format_s16:
+            return sizeof(int16_t);
+
+        case ar_audio_format_f32:
+            return sizeof(float);
+
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Round value up to the nearest power of 2
+ * @param value Value to round, at most 'AR_AUDIO_MAX_QUEUE_CAPACITY' so the result cannot overflow
+ * @return Smallest power of 2 that is greater or equal to the value
+ */
+static uint64_t ar_audio_round_up_to_power_of_2(uint64_t value)
+{
+    uint64_t result = 1;
+    while (result < value)
+    {
+        result <<= 1;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Get number of frames that fit between queue position and the end of the queue memory
+ * @param position Queue position of the first frame
+ * @param frame_count Number of frames to be copied
+ * @return Number of frames that can be copied before wrapping to the start of the queue memory
+ */
+static uint32_t ar_audio_queue_first_part(uint32_t position, uint32_t frame_count)
+{
+    uint32_t frames_until_end = g_audio_queue.capacity - (position & (g_audio_queue.capacity - 1));
+
+    return frame_count < frames_until_end ? frame_count : frames_until_end;
+}
+
+/**
+ * @brief Copy frames into the queue, handling the wrap around the end of the queue memory
+ * @param position Queue position of the first frame
+ * @param source Linear buffer to copy from
+ * @param frame_count Number of frames to copy
+ */
+static void ar_audio_queue_write(uint32_t position, const uint8_t* source, uint32_t frame_count)
+{
+    size_t first_part  = (size_t) ar_audio_queue_first_part(position, frame_count) * g_audio_queue.frame_size;
+    size_t second_part = (size_t) frame_count * g_audio_queue.frame_size - first_part;
+    size_t offset      = (size_t) (position & (g_audio_queue.capacity - 1)) * g_audio_queue.frame_size;
+
+    memcpy(g_audio_queue.frames + offset, source, first_part);
+    memcpy(g_audio_queue.frames, source + first_part, second_part);
+}
+
+/**
+ * @brief Copy frames out of the queue, handling the wrap around the end of the queue memory
+ * @param position Queue position of the first frame
+ * @param destination Linear buffer to copy to
+ * @param frame_count Number of frames to copy
+ */
+static void ar_audio_queue_read(uint32_t position, uint8_t* destination, uint32_t frame_count)
+{
+    size_t first_part  = (size_t) ar_audio_queue_first_part(position, frame_count) * g_audio_queue.frame_size;
+    size_t second_part = (size_t) frame_count * g_audio_queue.frame_size - first_part;
+    size_t offset      = (size_t) (position & (g_audio_queue.capacity - 1)) * g_audio_queue.frame_size;
+
+    memcpy(destination, g_audio_queue.frames + offset, first_part);
+    memcpy(destination + first_part, g_audio_queue.frames, second_part);
+}
+
+/****************************************************************************************************
+ API Implementation
+****************************************************************************************************/
+
+AR_API ar_err_code ar_audio_configure(uint32_t sample_rate, uint8_t channels, enum ar_audio_format format)
+{
+    uint32_t sample_size = ar_audio_sample_size(format);
+    if (sample_rate == 0 || channels == 0 || sample_size == 0)
+    {
+        return 1;
+    }
+
+    // 64-bit so high sample rates cannot overflow, queue positions limit the capacity
+    uint64_t capacity = ar_audio_round_up_to_power_of_2((uint64_t) sample_rate * AR_AUDIO_QUEUE_LENGTH_MS / 1000);
+    if (capacity > AR_AUDIO_MAX_QUEUE_CAPACITY)
+    {
+        return 1;
+    }
+
+    // Reconfiguring replaces the previous queue
+    ar_audio_free();
+
+    uint64_t queue_size = capacity * sample_size * channels;
+    if (queue_size > SIZE_MAX)
+    {
+        return 2;
+    }
+
+    g_audio_queue.frames = malloc((size_t) queue_size);
+    if (g_audio_queue.frames == NULL)
+    {
+        return 2;
+    }
+
+    g_audio_queue.capacity   = (uint32_t) capacity;
+    g_audio_queue.frame_size = sample_size * channels;
+
+    atomic_store(&g_audio_queue.read_position, 0);
+    atomic_store(&g_audio_queue.write_position, 0);
+
+    atomic_store(&g_audio_underrun_count, 0);
+    atomic_store(&g_audio_overrun_count, 0);
+
+    g_audio_sample_rate = sample_rate;
+    g_audio_channels    = channels;
+    g_audio_format      = format;
+
+    return 0;
+}
+
+AR_API void ar_audio_set_buffer_size(uint32_t frames)
+{
+    g_audio_buffer_size = frames != 0 ? frames : AR_AUDIO_DEFAULT_BUFFER_SIZE;
+}
+
+AR_API uint32_t ar_audio_push_samples(const void* samples, uint32_t frame_count)
+{
+    if (g_audio_queue.frames == NULL)
+    {
+        return 0;
+    }
+
+    // Producer owns the write position so relaxed load is enough, read position is published by the consumer
+    uint32_t write_position = atomic_load_explicit(&g_audio_queue.write_position, memory_order_relaxed);
+    uint32_t read_position  = atomic_load_explicit(&g_audio_queue.read_position, memory_order_acquire);
+
+    uint32_t free_frames = g_audio_queue.capacity - (write_position - read_position);
+    uint32_t to_write    = frame_count < free_frames ? frame_count : free_frames;
+
+    if (to_write < frame_count)
+    {
+        atomic_fetch_add_explicit(&g_audio_overrun_count, 1, memory_order_relaxed);
+    }
+
+    ar_audio_queue_write(write_position, samples, to_write);
+
+    atomic_store_explicit(&g_audio_queue.write_position, write_position + to_write, memory_order_release);
+
+    return to_write;
+}
+
+AR_API uint32_t ar_audio_pull_samples(void* out, uint32_t frame_count)
+{
+    if (g_audio_queue.frames == NULL)
+    {
+        return 0;
+    }
+
+    // Consumer owns the read position so relaxed load is enough, write position is published by the producer
+    uint32_t read_position  = atomic_load_explicit(&g_audio_queue.read_position, memory_order_relaxed);
+    uint32_t write_position = atomic_load_explicit(&g_audio_queue.write_position, memory_order_acquire);
+
+    uint32_t queued_frames = write_position - read_position;
+    uint32_t to_read       = frame_count < queued_frames ? frame_count : queued_frames;
+
+    ar_audio_queue_read(read_position, out, to_read);
+
+    atomic_store_explicit(&g_audio_queue.read_position, read_position + to_read, memory_order_release);
+
+    if (to_read < frame_count)
+    {
+        atomic_fetch_add_explicit(&g_audio_underrun_count, 1, memory_order_relaxed);
+
+        // Zero is silence for both of the supported formats
+        memset((uint8_t*) out + (size_t) to_read * g_audio_queue.frame_size, 0,
+               (size_t) (frame_count - to_read) * g_audio_queue.frame_size);
+    }
+
+    return to_read;
+}
+
+AR_API void ar_audio_free(void)
+{
+    free(g_audio_queue.frames);
+
+    g_audio_queue.frames     = NULL;
+    g_audio_queue.capacity   = 0;
+    g_audio_queue.frame_size = 0;
+
+    g_audio_sample_rate = 0;
+    g_audio_channels    = 0;
+}
+
+AR_API bool ar_audio_is_configured(void)
+{
+    return g_audio_queue.frames != NULL;
+}
+
+AR_API uint32_t ar_audio_get_sample_rate(void)
+{
+    return g_audio_sample_rate;
+}
+
+AR_API uint8_t ar_audio_get_channels(void)
+{
+    return g_audio_channels;
+}
+
+AR_API enum ar_audio_format ar_audio_get_format(void)
+{
+    return g_audio_format;
+}
+
+AR_API uint32_t ar_audio_get_buffer_size(void)
+{
+    return g_audio_buffer_size;
+}
+
+AR_API uint32_t ar_audio_get_queued_frames(void)
+{
+    uint32_t write_position = atomic_load_explicit(&g_audio_queue.write_position, memory_order_acquire);
+    uint32_t read_position  = atomic_load_explicit(&g_audio_queue.read_position, memory_order_acquire);
+
+    return write_position - read_position;
+}
+
+AR_API uint32_t ar_audio_get_queue_capacity(void)
+{
+    return g_audio_queue.capacity;
+}
+
+AR_API uint64_t ar_audio_get_underrun_count(void)
+{
+    return atomic_load_explicit(&g_audio_underrun_count, memory_order_relaxed);
+}
+
+AR_API uint64_t ar_audio_get_overrun_count(void)
+{
+    return atomic_load_explicit(&g_audio_overrun_count, memory_order_relaxed);
+}
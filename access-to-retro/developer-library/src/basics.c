@@ -1,4 +1,5 @@
 #include <access-to-retro-dev/access-to-retro-dev.h>
+#include <stdatomic.h>
 
 /****************************************************************************************************
  API global objects
@@ -31,6 +32,9 @@ static unsigned g_vc_default_window_x;
 /// @brief Default window height for this virtual console
 static unsigned g_vc_default_window_y;
 
+/// @brief Clock speed the virtual console runs at, changed by the frontend while the main thread reads it
+static atomic_uint g_vc_clock_speed;
+
 /****************************************************************************************************
  API Implementation
 ****************************************************************************************************/
@@ -64,6 +68,15 @@ AR_API void ar_quit(void)
 
     // Free executable object
     ar_free_executable();
+
+    // Free audio sample queue
+    ar_audio_free();
+
+    // Free profiling buffers, virtual console's threads were already joined
+    ar_profile_free();
+
+    // Next virtual console sets its own clock speed
+    atomic_store(&g_vc_clock_speed, 0);
 }
 
 AR_API struct ar_version ar_get_version(void)
@@ -105,3 +118,13 @@ AR_API unsigned ar_get_vc_default_window_res_y(void)
 {
     return g_vc_default_window_y;
 }
+
+AR_API void ar_set_vc_clock_speed(unsigned clock_speed)
+{
+    atomic_store_explicit(&g_vc_clock_speed, clock_speed, memory_order_relaxed);
+}
+
+AR_API unsigned ar_get_vc_clock_speed(void)
+{
+    return atomic_load_explicit(&g_vc_clock_speed, memory_order_relaxed);
+}
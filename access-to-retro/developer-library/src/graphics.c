@@ -1,5 +1,14 @@
 #include <access-to-retro-dev/access-to-retro-dev.h>
+#include <stdatomic.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sched.h>
+#endif
 
 /****************************************************************************************************
  API global objects
@@ -11,6 +20,61 @@ static enum ar_graphics_method g_graphics_method = ar_graphics_method_none;
 /// @brief Graphical object for 'ar_graphics_method_frame_buffer', nullptr if different mode is selected
 static struct ar_frame_buffer* g_graphics_object_frame_buffer = NULL;
 
+/**
+ * @brief Number of pixel arrays behind the frame buffer
+ * @details Virtual console and frontend each own one array (back and front buffer), the third one holds the latest
+ *          presented frame that was not acquired yet. Flipping is then a single atomic exchange and neither side ever
+ *          waits for the other one.
+ */
+#define AR_FRAME_BUFFER_SLOT_COUNT 3
+
+/// @brief Flag set in 'g_frame_buffer_ready_slot' when it holds a frame that the frontend has not acquired yet
+#define AR_FRAME_BUFFER_SLOT_NEW 0x4u
+
+/// @brief Mask extracting slot index from 'g_frame_buffer_ready_slot'
+#define AR_FRAME_BUFFER_SLOT_INDEX_MASK 0x3u
+
+/// @brief Pixel arrays behind the frame buffer, see 'AR_FRAME_BUFFER_SLOT_COUNT'
+static uint8_t* g_frame_buffer_slots[AR_FRAME_BUFFER_SLOT_COUNT] = { NULL };
+
+/// @brief Palette presented together with each slot's pixels
+static struct ar_pixel g_frame_buffer_slot_palettes[AR_FRAME_BUFFER_SLOT_COUNT][AR_PALETTE_SIZE];
+
+/// @brief Slot that the virtual console draws into, only accessed by the virtual console
+static uint32_t g_frame_buffer_back_slot = 0;
+
+/// @brief Slot holding the latest presented frame, combined with 'AR_FRAME_BUFFER_SLOT_NEW' flag
+static _Atomic uint32_t g_frame_buffer_ready_slot = 1;
+
+/// @brief Slot that the frontend reads from, only accessed by the frontend
+static uint32_t g_frame_buffer_front_slot = 2;
+
+/// @brief Function called after each present together with the value passed to it
+struct ar_present_callback_registration
+{
+    /// @brief Function called after each present
+    ar_graphics_present_callback callback;
+
+    /// @brief Value passed to 'callback'
+    void* user_data;
+};
+
+/**
+ * @brief Storage of present callbacks, a new callback is written into the one that is not published
+ * @details Callback and its user data are published together as a single pointer, so the virtual console's thread
+ *          never calls one callback with the user data of another.
+ */
+static struct ar_present_callback_registration g_present_callback_registrations[2];
+
+/// @brief Callback called after each present, set by the frontend, NULL if there is none
+static _Atomic(struct ar_present_callback_registration*) g_present_callback = NULL;
+
+/// @brief Number of presents calling the callback right now, replacing the callback waits until it drops to 0
+static _Atomic uint32_t g_present_callback_calls = 0;
+
+/// @brief How many times replacing the callback checks for running presents before it starts yielding its time slice
+#define AR_PRESENT_CALLBACK_SPIN_COUNT 64
+
 /// @brief Graphical object for 'ar_graphics_method_sdl', nullptr if different mode is selected
 static SDL_Window* g_graphics_object_window = NULL;
 
@@ -20,6 +84,88 @@ static SDL_Renderer* g_graphics_object_renderer = NULL;
 /// @brief Graphical object for 'ar_graphics_method_open_gl_context', nullptr if different mode is selected
 static open_gl_context g_graphics_object_gl_context = NULL;
 
+/****************************************************************************************************
+ Internal helpers
+****************************************************************************************************/
+
+/**
+ * @brief Get number of bytes in a single row of pixels
+ * @param format Format of the pixels
+ * @param width Number of pixels in the row
+ * @return Size of the row in bytes, packed formats are rounded up to a whole byte
+ */
+static uint32_t ar_graphics_get_pitch(enum ar_pixel_format format, uint32_t width)
+{
+    switch (format)
+    {
+        case ar_pixel_format_1bpp:
+            return (width + 7) / 8;
+
+        case ar_pixel_format_2bpp_indexed:
+            return (width + 3) / 4;
+
+        case ar_pixel_format_8bpp_indexed:
+            return width;
+
+        case ar_pixel_format_rgb565:
+            return width * (uint32_t) sizeof(uint16_t);
+
+        case ar_pixel_format_xrgb8888:
+            return width * (uint32_t) sizeof(uint32_t);
+
+        case ar_pixel_format_rgba8888:
+        default:
+            return width * (uint32_t) sizeof(struct ar_pixel);
+    }
+}
+
+/**
+ * @brief Get number of colours that pixels in given format can index
+ * @param format Format of the pixels
+ * @return Number of used palette entries, 0 for formats that store colours directly
+ */
+static uint32_t ar_graphics_get_palette_colour_count(enum ar_pixel_format format)
+{
+    switch (format)
+    {
+        case ar_pixel_format_1bpp:
+            return 2;
+
+        case ar_pixel_format_2bpp_indexed:
+            return 4;
+
+        case ar_pixel_format_8bpp_indexed:
+            return AR_PALETTE_SIZE;
+
+        default:
+            return 0;
+    }
+}
+
+/// @brief Free the frame buffer and its pixel slots, does nothing if there is no frame buffer
+static void ar_graphics_free_frame_buffer(void)
+{
+    // Delete pixels first, 'data' always points to one of the slots
+    for (uint32_t i = 0; i < AR_FRAME_BUFFER_SLOT_COUNT; i++)
+    {
+        free(g_frame_buffer_slots[i]);
+        g_frame_buffer_slots[i] = NULL;
+    }
+
+    free(g_graphics_object_frame_buffer);
+    g_graphics_object_frame_buffer = NULL;
+}
+
+/// @brief Let other threads run on this core, used while waiting for another thread without a lock
+static void ar_graphics_yield(void)
+{
+#if defined(_WIN32)
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
 /****************************************************************************************************
  API Implementation
 ****************************************************************************************************/
@@ -39,9 +185,7 @@ AR_API void ar_graphics_free_object(void)
     switch (g_graphics_method)
     {
         case ar_graphics_method_frame_buffer:
-            // Delete pixels first
-            free(g_graphics_object_frame_buffer->pixels);
-            free(g_graphics_object_frame_buffer);
+            ar_graphics_free_frame_buffer();
 
             // TODO: Other (SDL not needed, does opengl need it?)
 
@@ -51,24 +195,83 @@ AR_API void ar_graphics_free_object(void)
 
 /************************************* Frame Buffer *************************************/
 
-AR_API void ar_graphics_create_frame_buffer(uint32_t width, uint32_t height)
+AR_API ar_err_code ar_graphics_create_frame_buffer(uint32_t width, uint32_t height)
+{
+    return ar_graphics_create_frame_buffer_with_format(width, height, ar_pixel_format_rgba8888);
+}
+
+AR_API ar_err_code ar_graphics_create_frame_buffer_with_format(uint32_t width, uint32_t height,
+                                                               enum ar_pixel_format format)
 {
-    //g_graphics_object_frame_buffer = new ar_frame_buffer;
+    if (width == 0 || height == 0)
+    {
+        return 1;
+    }
+
+    // Creating the frame buffer again replaces the previous one
+    ar_graphics_free_frame_buffer();
+
+    uint32_t pitch = ar_graphics_get_pitch(format, width);
+    if (pitch == 0 || height > SIZE_MAX / pitch)
+    {
+        return 1;
+    }
+
+    size_t frame_size = (size_t) pitch * height;
+
     g_graphics_object_frame_buffer = malloc(sizeof(struct ar_frame_buffer));
+    if (g_graphics_object_frame_buffer == NULL)
+    {
+        return 2;
+    }
 
     g_graphics_object_frame_buffer->width  = width;
     g_graphics_object_frame_buffer->height = height;
+    g_graphics_object_frame_buffer->format = format;
+    g_graphics_object_frame_buffer->pitch  = pitch;
 
-    g_graphics_object_frame_buffer->pixels = malloc(sizeof(struct ar_pixel) * width * height);
+    // Grayscale ramp over the used colours, rest of the palette is black
+    uint32_t colour_count = ar_graphics_get_palette_colour_count(format);
+    for (uint32_t i = 0; i < AR_PALETTE_SIZE; i++)
+    {
+        uint8_t value = (uint8_t) (i < colour_count ? i * 255 / (colour_count - 1) : 0);
 
-    // Fill the pixels with default value (black pixel with full opacity)
-    for (uint32_t i = 0; i < width * height; i++)
+        g_graphics_object_frame_buffer->palette[i] = (struct ar_pixel) { value, value, value, 255 };
+    }
+
+    for (uint32_t slot = 0; slot < AR_FRAME_BUFFER_SLOT_COUNT; slot++)
     {
-        g_graphics_object_frame_buffer->pixels[i].r = 0;
-        g_graphics_object_frame_buffer->pixels[i].g = 0;
-        g_graphics_object_frame_buffer->pixels[i].b = 0;
-        g_graphics_object_frame_buffer->pixels[i].a = 255;
+        // Zero is black (or palette entry 0) in every format, only RGBA needs the opacity set
+        g_frame_buffer_slots[slot] = calloc(frame_size, 1);
+        if (g_frame_buffer_slots[slot] == NULL)
+        {
+            // Half created frame buffer is not left behind, getter returns NULL like before the first call
+            ar_graphics_free_frame_buffer();
+            return 2;
+        }
+
+        if (format == ar_pixel_format_rgba8888)
+        {
+            struct ar_pixel* pixels = (struct ar_pixel*) g_frame_buffer_slots[slot];
+
+            // Fill the pixels with default value (black pixel with full opacity)
+            for (size_t i = 0; i < (size_t) width * height; i++)
+            {
+                pixels[i].a = 255;
+            }
+        }
+
+        memcpy(g_frame_buffer_slot_palettes[slot], g_graphics_object_frame_buffer->palette,
+               sizeof(g_frame_buffer_slot_palettes[slot]));
     }
+
+    g_frame_buffer_back_slot  = 0;
+    g_frame_buffer_front_slot = 2;
+    atomic_store(&g_frame_buffer_ready_slot, 1);
+
+    g_graphics_object_frame_buffer->data = g_frame_buffer_slots[g_frame_buffer_back_slot];
+
+    return 0;
 }
 
 AR_API struct ar_frame_buffer* ar_graphics_get_frame_buffer(void)
@@ -76,6 +279,106 @@ AR_API struct ar_frame_buffer* ar_graphics_get_frame_buffer(void)
     return g_graphics_object_frame_buffer;
 }
 
+AR_API void ar_graphics_present(void)
+{
+    if (g_graphics_object_frame_buffer == NULL)
+    {
+        return;
+    }
+
+    uint32_t presented_slot = g_frame_buffer_back_slot;
+
+    // Palette is published together with the pixels
+    if (ar_graphics_get_palette_colour_count(g_graphics_object_frame_buffer->format) != 0)
+    {
+        memcpy(g_frame_buffer_slot_palettes[presented_slot], g_graphics_object_frame_buffer->palette,
+               sizeof(g_frame_buffer_slot_palettes[presented_slot]));
+    }
+
+    // Publish the back buffer and take whichever slot was holding the previous frame (acquired or skipped)
+    uint32_t previous = atomic_exchange_explicit(&g_frame_buffer_ready_slot, presented_slot | AR_FRAME_BUFFER_SLOT_NEW,
+                                                 memory_order_acq_rel);
+
+    g_frame_buffer_back_slot = previous & AR_FRAME_BUFFER_SLOT_INDEX_MASK;
+
+    // Keep the presented frame in the new back buffer so that virtual console can continue drawing on top of it
+    memcpy(g_frame_buffer_slots[g_frame_buffer_back_slot], g_frame_buffer_slots[presented_slot],
+           (size_t) g_graphics_object_frame_buffer->pitch * g_graphics_object_frame_buffer->height);
+
+    g_graphics_object_frame_buffer->data = g_frame_buffer_slots[g_frame_buffer_back_slot];
+
+    // Counted before the callback is read, see 'ar_graphics_set_present_callback'
+    atomic_fetch_add_explicit(&g_present_callback_calls, 1, memory_order_seq_cst);
+
+    struct ar_present_callback_registration* registration = atomic_load_explicit(&g_present_callback,
+                                                                                 memory_order_seq_cst);
+    if (registration != NULL)
+    {
+        registration->callback(registration->user_data);
+    }
+
+    atomic_fetch_sub_explicit(&g_present_callback_calls, 1, memory_order_release);
+}
+
+AR_API const void* ar_graphics_acquire_frame(void)
+{
+    if (g_graphics_object_frame_buffer == NULL)
+    {
+        return NULL;
+    }
+
+    // Nothing new was presented, keep the current front buffer
+    if ((atomic_load_explicit(&g_frame_buffer_ready_slot, memory_order_acquire) & AR_FRAME_BUFFER_SLOT_NEW) == 0)
+    {
+        return NULL;
+    }
+
+    // Give the current front buffer back and take the presented frame
+    uint32_t ready = atomic_exchange_explicit(&g_frame_buffer_ready_slot, g_frame_buffer_front_slot,
+                                              memory_order_acq_rel);
+
+    g_frame_buffer_front_slot = ready & AR_FRAME_BUFFER_SLOT_INDEX_MASK;
+
+    return g_frame_buffer_slots[g_frame_buffer_front_slot];
+}
+
+AR_API const struct ar_pixel* ar_graphics_get_acquired_palette(void)
+{
+    return g_frame_buffer_slot_palettes[g_frame_buffer_front_slot];
+}
+
+AR_API void ar_graphics_set_present_callback(ar_graphics_present_callback callback, void* user_data)
+{
+    struct ar_present_callback_registration* registration = NULL;
+
+    // Published registration may still be in use, the other one is not (previous call waited for its presents)
+    if (callback != NULL)
+    {
+        registration = atomic_load_explicit(&g_present_callback, memory_order_relaxed) ==
+                       &g_present_callback_registrations[0] ? &g_present_callback_registrations[1]
+                                                            : &g_present_callback_registrations[0];
+
+        registration->callback  = callback;
+        registration->user_data = user_data;
+    }
+
+    atomic_store_explicit(&g_present_callback, registration, memory_order_seq_cst);
+
+    /*
+     * Presents counted after the store see the new callback, so once the count drops to 0 no present is calling the
+     * previous one anymore and its user data can be freed. Callbacks can do real work (frontend copies the whole frame
+     * when capturing), so after a short spin the waiting thread yields instead of burning the core the present may
+     * need.
+     */
+    for (uint32_t spins = 0; atomic_load_explicit(&g_present_callback_calls, memory_order_acquire) != 0; spins++)
+    {
+        if (spins >= AR_PRESENT_CALLBACK_SPIN_COUNT)
+        {
+            ar_graphics_yield();
+        }
+    }
+}
+
 /************************************* SDL2 *************************************/
 
 AR_API void ar_graphics_set_sdl_objects(SDL_Window* window, SDL_Renderer* renderer)
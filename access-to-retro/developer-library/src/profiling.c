@@ -0,0 +1,389 @@
+#include <access-to-retro-dev/access-to-retro-dev.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#if defined(_MSC_VER)
+#define AR_PROFILE_THREAD_LOCAL __declspec(thread)
+#else
+#define AR_PROFILE_THREAD_LOCAL _Thread_local
+#endif
+
+/****************************************************************************************************
+ API global objects
+****************************************************************************************************/
+
+/// @brief Single recorded event, begin of a zone or (without a name) end of the last zone
+struct ar_profile_event
+{
+    /// @brief Name of the zone, NULL for the end of a zone
+    const char* name;
+
+    /// @brief Time of the event in nanoseconds, see 'ar_profile_now_ns'
+    uint64_t timestamp;
+};
+
+/**
+ * @brief Events of a single thread
+ * @details Only the owning thread writes events, it publishes them by storing 'count' with release. The trace writer
+ *          observes 'count' with acquire and only reads events below it, so neither side takes a lock.
+ *
+ *          Buffers are never freed while threads may record, a clear only starts a new generation. Owning thread
+ *          resets its buffer when it records in the new generation for the first time, until then the trace writer
+ *          skips the buffer as its events belong to an older generation.
+ */
+struct ar_profile_thread_buffer
+{
+    /// @brief Recorded events
+    struct ar_profile_event events[AR_PROFILE_THREAD_EVENT_CAPACITY];
+
+    /// @brief Number of recorded events, only written by the owning thread
+    _Atomic uint32_t count;
+
+    /// @brief Generation the events were recorded in, only written by the owning thread
+    _Atomic uint32_t generation;
+
+    /// @brief Number of the thread shown in the trace
+    uint32_t thread_id;
+
+    /// @brief Name of the thread shown in the trace, NULL if not named
+    _Atomic(const char*) thread_name;
+
+    /// @brief Next buffer in 'g_profile_buffers'
+    struct ar_profile_thread_buffer* next;
+};
+
+/// @brief Whether zones are recorded, the only thing checked by disabled zones
+static _Atomic bool g_profile_enabled = false;
+
+/// @brief Buffers of all threads that recorded since the last free, new buffers are pushed to the front
+static _Atomic(struct ar_profile_thread_buffer*) g_profile_buffers = NULL;
+
+/// @brief Increased by every clear, events of older generations are not part of the trace anymore
+static _Atomic uint32_t g_profile_generation = 1;
+
+/// @brief Increased by every free, buffers created before it were freed
+static _Atomic uint32_t g_profile_allocation = 1;
+
+/// @brief Number given to the next thread that records
+static _Atomic uint32_t g_profile_next_thread_id = 1;
+
+/// @brief Number of events that did not fit into their thread's buffer
+static _Atomic uint64_t g_profile_dropped_count = 0;
+
+/// @brief Time profiling was first enabled since the last clear, trace times are relative to it
+static _Atomic uint64_t g_profile_epoch = 0;
+
+/// @brief Buffer of the calling thread, NULL until it records
+static AR_PROFILE_THREAD_LOCAL struct ar_profile_thread_buffer* t_profile_buffer = NULL;
+
+/// @brief Generation of 't_profile_buffer', buffer is reset when it differs from 'g_profile_generation'
+static AR_PROFILE_THREAD_LOCAL uint32_t t_profile_generation = 0;
+
+/// @brief Allocation of 't_profile_buffer', buffer was freed when it differs from 'g_profile_allocation'
+static AR_PROFILE_THREAD_LOCAL uint32_t t_profile_allocation = 0;
+
+/// @brief Name of the calling thread, kept for buffers created after the name was set
+static AR_PROFILE_THREAD_LOCAL const char* t_profile_thread_name = NULL;
+
+/****************************************************************************************************
+ Internal helpers
+****************************************************************************************************/
+
+/**
+ * @brief Get monotonic time
+ * @return Nanoseconds from an unspecified point
+ */
+static uint64_t ar_profile_now_ns(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+
+    return (uint64_t) ((double) counter.QuadPart * 1e9 / (double) frequency.QuadPart);
+#else
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (uint64_t) time.tv_sec * 1000000000ULL + (uint64_t) time.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Check whether the calling thread's buffer was not freed
+ * @return Whether 't_profile_buffer' can be used
+ */
+static bool ar_profile_has_thread_buffer(void)
+{
+    return t_profile_buffer != NULL &&
+           t_profile_allocation == atomic_load_explicit(&g_profile_allocation, memory_order_acquire);
+}
+
+/**
+ * @brief Get buffer of the calling thread, creating it on the first use (or the first use after a free)
+ * @return Buffer of the thread, NULL if it could not be allocated
+ */
+static struct ar_profile_thread_buffer* ar_profile_get_thread_buffer(void)
+{
+    uint32_t generation = atomic_load_explicit(&g_profile_generation, memory_order_acquire);
+    if (ar_profile_has_thread_buffer())
+    {
+        // Cleared since the last event, events are dropped before the buffer joins the new generation
+        if (t_profile_generation != generation)
+        {
+            atomic_store_explicit(&t_profile_buffer->count, 0, memory_order_relaxed);
+            atomic_store_explicit(&t_profile_buffer->generation, generation, memory_order_release);
+            t_profile_generation = generation;
+        }
+
+        return t_profile_buffer;
+    }
+
+    struct ar_profile_thread_buffer* buffer = malloc(sizeof(struct ar_profile_thread_buffer));
+    if (buffer == NULL)
+    {
+        return NULL;
+    }
+
+    atomic_init(&buffer->count, 0);
+    atomic_init(&buffer->generation, generation);
+    atomic_init(&buffer->thread_name, t_profile_thread_name);
+    buffer->thread_id = atomic_fetch_add_explicit(&g_profile_next_thread_id, 1, memory_order_relaxed);
+
+    // Other threads may push their buffers at the same time, retry until this one gets in front
+    buffer->next = atomic_load_explicit(&g_profile_buffers, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak_explicit(&g_profile_buffers, &buffer->next, buffer, memory_order_release,
+                                                  memory_order_relaxed))
+    {
+    }
+
+    t_profile_buffer     = buffer;
+    t_profile_generation = generation;
+    t_profile_allocation = atomic_load_explicit(&g_profile_allocation, memory_order_relaxed);
+
+    return buffer;
+}
+
+/**
+ * @brief Record an event in the calling thread's buffer
+ * @param name Name of the zone, NULL for the end of a zone
+ */
+static void ar_profile_record(const char* name)
+{
+    struct ar_profile_thread_buffer* buffer = ar_profile_get_thread_buffer();
+    if (buffer == NULL)
+    {
+        atomic_fetch_add_explicit(&g_profile_dropped_count, 1, memory_order_relaxed);
+        return;
+    }
+
+    // Only this thread writes the count
+    uint32_t count = atomic_load_explicit(&buffer->count, memory_order_relaxed);
+    if (count >= AR_PROFILE_THREAD_EVENT_CAPACITY)
+    {
+        atomic_fetch_add_explicit(&g_profile_dropped_count, 1, memory_order_relaxed);
+        return;
+    }
+
+    buffer->events[count].name      = name;
+    buffer->events[count].timestamp = ar_profile_now_ns();
+
+    atomic_store_explicit(&buffer->count, count + 1, memory_order_release);
+}
+
+/**
+ * @brief Write a string as JSON string
+ * @param file File to write to
+ * @param value String to write
+ */
+static void ar_profile_write_json_string(FILE* file, const char* value)
+{
+    fputc('"', file);
+
+    for (; *value != '\0'; value++)
+    {
+        if (*value == '"' || *value == '\\')
+        {
+            fputc('\\', file);
+            fputc(*value, file);
+        }
+        else if ((unsigned char) *value < 0x20)
+        {
+            fprintf(file, "\\u%04x", (unsigned) (unsigned char) *value);
+        }
+        else
+        {
+            fputc(*value, file);
+        }
+    }
+
+    fputc('"', file);
+}
+
+/****************************************************************************************************
+ API functions
+****************************************************************************************************/
+
+AR_API void ar_profile_set_enabled(bool enabled)
+{
+    if (enabled)
+    {
+        uint64_t no_epoch = 0;
+        atomic_compare_exchange_strong(&g_profile_epoch, &no_epoch, ar_profile_now_ns());
+    }
+
+    atomic_store_explicit(&g_profile_enabled, enabled, memory_order_release);
+}
+
+AR_API bool ar_profile_is_enabled(void)
+{
+    return atomic_load_explicit(&g_profile_enabled, memory_order_relaxed);
+}
+
+AR_API void ar_profile_begin(const char* name)
+{
+    if (!atomic_load_explicit(&g_profile_enabled, memory_order_relaxed))
+    {
+        return;
+    }
+
+    // NULL marks the end of a zone
+    ar_profile_record(name != NULL ? name : "unnamed");
+}
+
+AR_API void ar_profile_end(void)
+{
+    if (!atomic_load_explicit(&g_profile_enabled, memory_order_relaxed))
+    {
+        return;
+    }
+
+    ar_profile_record(NULL);
+}
+
+AR_API void ar_profile_set_thread_name(const char* name)
+{
+    t_profile_thread_name = name;
+
+    // Buffers of older allocations were already freed, the next one takes the name when it is created
+    if (ar_profile_has_thread_buffer())
+    {
+        atomic_store_explicit(&t_profile_buffer->thread_name, name, memory_order_release);
+    }
+}
+
+AR_API ar_err_code ar_profile_write_trace(const char* path)
+{
+    FILE* file = fopen(path, "w");
+    if (file == NULL)
+    {
+        return 1;
+    }
+
+    uint64_t epoch = atomic_load_explicit(&g_profile_epoch, memory_order_relaxed);
+
+    fprintf(file, "{\"displayTimeUnit\": \"ns\", \"otherData\": {\"dropped_events\": %" PRIu64 "}, "
+                  "\"traceEvents\": [\n", ar_profile_get_dropped_count());
+
+    const char* separator = "";
+    uint32_t generation   = atomic_load_explicit(&g_profile_generation, memory_order_acquire);
+
+    struct ar_profile_thread_buffer* buffer = atomic_load_explicit(&g_profile_buffers, memory_order_acquire);
+    for (; buffer != NULL; buffer = buffer->next)
+    {
+        // Thread has not recorded since the last clear, its events are from before it
+        if (atomic_load_explicit(&buffer->generation, memory_order_acquire) != generation)
+        {
+            continue;
+        }
+
+        const char* thread_name = atomic_load_explicit(&buffer->thread_name, memory_order_acquire);
+        if (thread_name != NULL)
+        {
+            fprintf(file, "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %" PRIu32
+                          ", \"args\": {\"name\": ", separator, buffer->thread_id);
+            ar_profile_write_json_string(file, thread_name);
+            fprintf(file, "}}");
+
+            separator = ",\n";
+        }
+
+        // Events below the count were written before it was published
+        uint32_t count = atomic_load_explicit(&buffer->count, memory_order_acquire);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const struct ar_profile_event* event = &buffer->events[i];
+
+            // Trace times are in microseconds
+            double timestamp = event->timestamp > epoch ? (double) (event->timestamp - epoch) / 1000.0 : 0.0;
+
+            fprintf(file, "%s{", separator);
+            if (event->name != NULL)
+            {
+                fprintf(file, "\"name\": ");
+                ar_profile_write_json_string(file, event->name);
+                fprintf(file, ", \"ph\": \"B\"");
+            }
+            else
+            {
+                fprintf(file, "\"ph\": \"E\"");
+            }
+
+            fprintf(file, ", \"ts\": %.3f, \"pid\": 1, \"tid\": %" PRIu32 "}", timestamp, buffer->thread_id);
+
+            separator = ",\n";
+        }
+    }
+
+    fprintf(file, "\n]}\n");
+
+    ar_err_code result = ferror(file) ? 2 : 0;
+    if (fclose(file) != 0)
+    {
+        result = 2;
+    }
+
+    return result;
+}
+
+AR_API uint64_t ar_profile_get_dropped_count(void)
+{
+    return atomic_load_explicit(&g_profile_dropped_count, memory_order_relaxed);
+}
+
+AR_API void ar_profile_clear(void)
+{
+    atomic_store_explicit(&g_profile_enabled, false, memory_order_release);
+
+    // Buffers are kept, threads may still be writing into them, each one is reset by its thread when it records next
+    atomic_fetch_add_explicit(&g_profile_generation, 1, memory_order_release);
+
+    atomic_store_explicit(&g_profile_dropped_count, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_profile_epoch, 0, memory_order_relaxed);
+}
+
+AR_API void ar_profile_free(void)
+{
+    ar_profile_clear();
+
+    // Threads notice the new allocation and create new buffers instead of using the freed ones
+    struct ar_profile_thread_buffer* buffer = atomic_exchange_explicit(&g_profile_buffers, NULL,
+                                                                       memory_order_acquire);
+    atomic_fetch_add_explicit(&g_profile_allocation, 1, memory_order_release);
+
+    while (buffer != NULL)
+    {
+        struct ar_profile_thread_buffer* next = buffer->next;
+        free(buffer);
+        buffer = next;
+    }
+}
@@ -0,0 +1,198 @@
+#include <string.h>
+#include "../include/access-to-retro-dev/access-to-retro-dev.h"
+#include "../include/access-to-retro-dev/unit-testing-library/access-to-retro-unit-testing.h"
+
+/*
+ * Tests decode a made up CPU: every instruction is 3 bytes, kind followed by a big endian 16-bit target
+ *  - 0x00: no operation, 0x01: jump, 0x02: branch, 0x03: call, 0x04: return, 0x05: indirect jump, 0x06: memory write
+ *  - anything else is not an instruction
+ */
+
+/// @brief Size of memory of the benchmark, same as CHIP8's
+#define BENCHMARK_MEMORY_SIZE 4096
+
+/// @brief Address where code of the benchmark starts
+#define BENCHMARK_CODE_START 0x200
+
+/// @brief Decoder of the made up CPU
+static struct ar_code_flow decode_test_instruction(const uint8_t* memory, size_t size, uint32_t address,
+                                                   void* user_data)
+{
+    (void) user_data;
+
+    struct ar_code_flow flow = { .length = 3, .kind = ar_code_flow_next, .target = 0, .writes_memory = false };
+    if (memory[address] > 0x06 || size - address < 3)
+    {
+        flow.length = 0;
+        return flow;
+    }
+
+    flow.target = (uint32_t) memory[address + 1] << 8 | memory[address + 2];
+
+    switch (memory[address])
+    {
+        case 0x01:
+            flow.kind = ar_code_flow_jump;
+            break;
+
+        case 0x02:
+            flow.kind = ar_code_flow_branch;
+            break;
+
+        case 0x03:
+            flow.kind = ar_code_flow_call;
+            break;
+
+        case 0x04:
+            flow.kind = ar_code_flow_return;
+            break;
+
+        case 0x05:
+            flow.kind = ar_code_flow_indirect;
+            break;
+
+        case 0x06:
+            flow.writes_memory = true;
+            break;
+
+        default:
+            break;
+    }
+
+    return flow;
+}
+
+DEFINE_TEST(ar_code_map_flow_test)
+{
+    static const uint8_t memory[64] = {
+            0x03, 0x00, 0x18, // 0x00: call 0x18
+            0x02, 0x00, 0x0C, // 0x03: branch 0x0C
+            0x00, 0x00, 0x00, // 0x06: no operation
+            0x01, 0x00, 0x0F, // 0x09: jump 0x0F
+            0x05, 0x00, 0x00, // 0x0C: indirect jump
+            0x06, 0x00, 0x30, // 0x0F: memory write
+            0x04, 0x00, 0x00, // 0x12: return
+            0xAA, 0xAA, 0xAA, // 0x15: data
+            0x00, 0x00, 0x00, // 0x18: no operation
+            0x04, 0x00, 0x00, // 0x1B: return
+            0x01, 0x00, 0x00, // 0x1E: never reached
+    };
+
+    struct ar_code_map map;
+    ASSERT_EQ(ar_code_map_create(&map, sizeof(memory)), 0, ERROR(1));
+
+    uint32_t entry = 0x00;
+    ar_code_map_analyze(&map, memory, &entry, 1, decode_test_instruction, NULL);
+
+    ASSERT_EQ(map.instruction_count, 9, ERROR(2));
+
+    // Entry, call target, after the call, both ways of the branch and the jump target
+    ASSERT_EQ(map.block_count, 6, ERROR(3));
+    ASSERT_EQ(map.flags[0x00], (AR_CODE_INSTRUCTION | AR_CODE_BLOCK_START), ERROR(4));
+    ASSERT_EQ(map.flags[0x18], (AR_CODE_INSTRUCTION | AR_CODE_BLOCK_START | AR_CODE_CALL_TARGET), ERROR(5));
+    ASSERT_EQ(map.flags[0x03], (AR_CODE_INSTRUCTION | AR_CODE_BLOCK_START), ERROR(6));
+    ASSERT_EQ(map.flags[0x06], (AR_CODE_INSTRUCTION | AR_CODE_BLOCK_START), ERROR(7));
+    ASSERT_EQ(map.flags[0x0C], (AR_CODE_INSTRUCTION | AR_CODE_BLOCK_START | AR_CODE_INDIRECT), ERROR(8));
+    ASSERT_EQ(map.flags[0x0F], (AR_CODE_INSTRUCTION | AR_CODE_BLOCK_START | AR_CODE_WRITES_MEMORY), ERROR(9));
+    ASSERT_EQ(map.flags[0x12], (AR_CODE_INSTRUCTION), ERROR(10));
+    ASSERT_EQ(map.flags[0x10], (AR_CODE_OPERAND), ERROR(11));
+
+    // Data and unreachable code
+    ASSERT_EQ(map.flags[0x15], 0, ERROR(12));
+    ASSERT_EQ(map.flags[0x1E], 0, ERROR(13));
+
+    // Analysing again starts over
+    entry = 0x18;
+    ar_code_map_analyze(&map, memory, &entry, 1, decode_test_instruction, NULL);
+
+    ASSERT_EQ(map.instruction_count, 2, ERROR(14));
+    ASSERT_EQ(map.block_count, 1, ERROR(15));
+    ASSERT_EQ(map.flags[0x00], 0, ERROR(16));
+
+    ar_code_map_destroy(&map);
+    ar_code_map_destroy(&map);
+
+    COMPLETE_TEST(SUCCESS)
+}
+
+DEFINE_TEST(ar_code_map_overlap_test)
+{
+    static const uint8_t memory[16] = {
+            0x02, 0x00, 0x04, // 0x00: branch 0x04, into the middle of the next instruction
+            0x06, 0x00, 0x04, // 0x03: memory write
+            0x04, 0x00, 0x00, // 0x06: return
+            0xFF,             // 0x09: past the end of the last instruction
+    };
+
+    struct ar_code_map map;
+    ASSERT_EQ(ar_code_map_create(&map, sizeof(memory)), 0, ERROR(1));
+
+    uint32_t entries[] = { 0x00, 0x09, 0x40 };
+    ar_code_map_analyze(&map, memory, entries, 3, decode_test_instruction, NULL);
+
+    ASSERT_EQ(map.instruction_count, 3, ERROR(2));
+    ASSERT_EQ(map.block_count, 2, ERROR(3));
+    ASSERT_EQ(map.flags[0x04], (AR_CODE_OPERAND | AR_CODE_OVERLAP), ERROR(4));
+
+    // Invalid instruction is data, not a block
+    ASSERT_EQ(map.flags[0x09], 0, ERROR(5));
+
+    ar_code_map_destroy(&map);
+
+    COMPLETE_TEST(SUCCESS)
+}
+
+DEFINE_BENCHMARK(ar_code_map_analyze_benchmark)
+{
+    static uint8_t memory[BENCHMARK_MEMORY_SIZE];
+    memset(memory, 0, sizeof(memory));
+
+    // 3.5kb of code, a branch over the next 4 instructions after every 4 instructions
+    for (uint32_t address = BENCHMARK_CODE_START; address + 24 <= BENCHMARK_MEMORY_SIZE; address += 24)
+    {
+        uint32_t target = address + 24;
+
+        memory[address + 12] = 0x02;
+        memory[address + 13] = (uint8_t) (target >> 8);
+        memory[address + 14] = (uint8_t) target;
+    }
+
+    struct ar_code_map map;
+    if (ar_code_map_create(&map, sizeof(memory)) != 0)
+    {
+        return;
+    }
+
+    uint32_t entry = BENCHMARK_CODE_START;
+
+    BENCHMARK_LOOP
+    {
+        ar_code_map_analyze(&map, memory, &entry, 1, decode_test_instruction, NULL);
+        BENCHMARK_KEEP(map.instruction_count);
+    }
+
+    ar_code_map_destroy(&map);
+}
+
+DEFINE_TEST(ar_code_map_speed_test)
+{
+    // Virtual consoles analyse the ROM when it loads, a 3.5kb one takes tens of microseconds. Bound is 10 times that so
+    // loaded machines and debug builds pass, analysis going quadratic would still take milliseconds
+    ASSERT_FASTER_THAN(ar_code_map_analyze_benchmark, 500000.0, ERROR(1))
+
+    COMPLETE_TEST(SUCCESS)
+}
+
+DEFINE_TEST_TABLE(ar_analysis_tests)
+{
+    REGISTER_TEST(ar_code_map_flow_test),
+    REGISTER_TEST(ar_code_map_overlap_test),
+    REGISTER_SPEED_TEST(ar_code_map_speed_test),
+
+    // Benchmarks
+    REGISTER_BENCHMARK(ar_code_map_analyze_benchmark),
+
+    END_TEST_TABLE
+};
+
+DEFINE_TEST_TABLE_ENTRY_POINT(ar_analysis_tests)
@@ -0,0 +1,108 @@
+#include "../include/access-to-retro-dev/access-to-retro-dev.h"
+#include "../include/access-to-retro-dev/unit-testing-library/access-to-retro-unit-testing.h"
+
+DEFINE_TEST(ar_audio_configure_test)
+{
+    // Invalid configuration is rejected and leaves audio disabled
+    ASSERT_EQ(ar_audio_configure(0, 1, ar_audio_format_s16), 1, ERROR(1));
+    ASSERT_FALSE(ar_audio_is_configured(), ERROR(2));
+
+    ASSERT_EQ(ar_audio_configure(48000, 2, ar_audio_format_f32), 0, ERROR(3));
+    ASSERT_TRUE(ar_audio_is_configured(), ERROR(4));
+    ASSERT_EQ(ar_audio_get_sample_rate(), 48000, ERROR(5));
+    ASSERT_EQ(ar_audio_get_channels(), 2, ERROR(6));
+
+    // 50ms at 48000hz is 2400 frames, rounded up to a power of 2
+    ASSERT_EQ(ar_audio_get_queue_capacity(), 4096, ERROR(7));
+
+    ar_audio_free();
+    ASSERT_FALSE(ar_audio_is_configured(), ERROR(8));
+
+    // Highest sample rate neither overflows the queue length nor hangs rounding it, the huge queue may not allocate
+    ar_err_code result = ar_audio_configure(UINT32_MAX, 1, ar_audio_format_s16);
+    ASSERT_TRUE((result == 0 || result == 2), ERROR(9));
+    ASSERT_TRUE((result != 0 || ar_audio_get_queue_capacity() == (1u << 28)), ERROR(10));
+
+    ar_audio_free();
+
+    COMPLETE_TEST(SUCCESS)
+}
+
+DEFINE_TEST(ar_audio_push_pull_test)
+{
+    int16_t samples[300];
+    int16_t pulled[300];
+
+    // Capacity is 1024 frames at 20000hz
+    ASSERT_EQ(ar_audio_configure(20000, 1, ar_audio_format_s16), 0, ERROR(1));
+
+    // Push and pull more than the capacity in total so that the positions wrap around the queue memory
+    int16_t next_pushed = 0;
+    int16_t next_pulled = 0;
+    for (int round = 0; round < 10; round++)
+    {
+        for (int i = 0; i < 300; i++)
+        {
+            samples[i] = next_pushed++;
+        }
+
+        ASSERT_EQ(ar_audio_push_samples(samples, 300), 300, ERROR(2));
+        ASSERT_EQ(ar_audio_pull_samples(pulled, 300), 300, ERROR(3));
+
+        for (int i = 0; i < 300; i++)
+        {
+            ASSERT_EQ(pulled[i], next_pulled, ERROR(4));
+            next_pulled++;
+        }
+    }
+
+    ASSERT_EQ(ar_audio_get_queued_frames(), 0, ERROR(5));
+    ASSERT_EQ(ar_audio_get_underrun_count(), 0, ERROR(6));
+    ASSERT_EQ(ar_audio_get_overrun_count(), 0, ERROR(7));
+
+    ar_audio_free();
+
+    COMPLETE_TEST(SUCCESS)
+}
+
+DEFINE_TEST(ar_audio_underrun_overrun_test)
+{
+    int16_t samples[300] = { 0 };
+
+    // Capacity is 1024 frames at 20000hz
+    ASSERT_EQ(ar_audio_configure(20000, 1, ar_audio_format_s16), 0, ERROR(1));
+
+    // Only 1024 out of 1200 frames fit
+    for (int i = 0; i < 4; i++)
+    {
+        ar_audio_push_samples(samples, 300);
+    }
+
+    ASSERT_EQ(ar_audio_get_queued_frames(), 1024, ERROR(2));
+    ASSERT_EQ(ar_audio_get_overrun_count(), 1, ERROR(3));
+
+    // Drain the queue, last pull gets only 124 frames and the rest is silence
+    for (int i = 0; i < 4; i++)
+    {
+        samples[299] = 1;
+        ar_audio_pull_samples(samples, 300);
+    }
+
+    ASSERT_EQ(samples[299], 0, ERROR(4));
+    ASSERT_EQ(ar_audio_get_underrun_count(), 1, ERROR(5));
+
+    ar_audio_free();
+
+    COMPLETE_TEST(SUCCESS)
+}
+
+DEFINE_TEST_TABLE(ar_audio_tests)
+{
+    REGISTER_TEST(ar_audio_configure_test),
+    REGISTER_TEST(ar_audio_push_pull_test),
+    REGISTER_TEST(ar_audio_underrun_overrun_test),
+
+    END_TEST_TABLE
+};
+
+DEFINE_TEST_TABLE_ENTRY_POINT(ar_audio_tests)
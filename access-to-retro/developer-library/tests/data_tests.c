@@ -86,19 +86,44 @@ DEFINE_TEST(ar_combine_n_bytes_test)
     COMPLETE_TEST(SUCCESS)
 }
 
-DEFINE_TESTING_ENTRY_POINT
+DEFINE_BENCHMARK(ar_combine_n_bytes_benchmark)
 {
-    START_TESTING
+    ar_byte bytes[8] = { 0xAB, 0xCD, 0xEF, 0xFF, 0xFF, 0xEF, 0xCD, 0xAB };
+
+    BENCHMARK_LOOP
+    {
+        // Keep the compiler from treating bytes as constants
+        BENCHMARK_KEEP(bytes);
+
+        BENCHMARK_KEEP(ar_combine_n_bytes(bytes, 8));
+    }
+}
 
+DEFINE_TEST(ar_combine_n_bytes_speed_test)
+{
+    // Loop over 8 bytes, anything close to this limit means it stopped being inlined/unrolled friendly
+    ASSERT_FASTER_THAN(ar_combine_n_bytes_benchmark, 100.0, ERROR(1))
+
+    COMPLETE_TEST(SUCCESS)
+}
+
+DEFINE_TEST_TABLE(ar_data_tests)
+{
     // Bit manipulation
-    DEFINE_TEST_FN(ar_set_bit_test)
-    DEFINE_TEST_FN(ar_clear_bit_test)
-    DEFINE_TEST_FN(ar_set_bit_to_test)
-    DEFINE_TEST_FN(ar_toggle_bit_test)
-    DEFINE_TEST_FN(ar_is_bit_set_test)
+    REGISTER_TEST(ar_set_bit_test),
+    REGISTER_TEST(ar_clear_bit_test),
+    REGISTER_TEST(ar_set_bit_to_test),
+    REGISTER_TEST(ar_toggle_bit_test),
+    REGISTER_TEST(ar_is_bit_set_test),
 
     // Byte manipulation
-    DEFINE_TEST_FN(ar_combine_n_bytes_test)
+    REGISTER_TEST(ar_combine_n_bytes_test),
+    REGISTER_SPEED_TEST(ar_combine_n_bytes_speed_test),
 
-    END_TESTING
-}
+    // Benchmarks
+    REGISTER_BENCHMARK(ar_combine_n_bytes_benchmark),
+
+    END_TEST_TABLE
+};
+
+DEFINE_TEST_TABLE_ENTRY_POINT(ar_data_tests)
@@ -0,0 +1,220 @@
+#include "../include/access-to-retro-dev/access-to-retro-dev.h"
+#include "../include/access-to-retro-dev/unit-testing-library/access-to-retro-unit-testing.h"
+
+/// @brief Number of times 'count_presents' was called
+static int g_present_count = 0;
+
+/// @brief Present callback counting the presents
+static void count_presents(void* user_data)
+{
+    (void) user_data;
+    g_present_count++;
+}
+
+/// @brief Present callback counting the presents in the integer its user data points to
+static void count_presents_in_user_data(void* user_data)
+{
+    (*(int*) user_data)++;
+}
+
+DEFINE_TEST(ar_graphics_present_acquire_test)
+{
+    ar_graphics_set_method(ar_graphics_method_frame_buffer);
+    ar_graphics_create_frame_buffer(4, 2);
+
+    struct ar_frame_buffer* frame_buffer = ar_graphics_get_frame_buffer();
+
+    // Nothing was presented yet
+    ASSERT_NULL(ar_graphics_acquire_frame(), ERROR(1));
+
+    frame_buffer->pixels[0].r = 10;
+    ar_graphics_present();
+
+    // Back buffer is replaced but keeps the presented content
+    ASSERT_EQ(frame_buffer->pixels[0].r, 10, ERROR(2));
+
+    const struct ar_pixel* frame = ar_graphics_acquire_frame();
+    ASSERT_NOT_NULL(frame, ERROR(3));
+    ASSERT_EQ(frame[0].r, 10, ERROR(4));
+
+    // Drawing into the back buffer does not change the acquired frame
+    frame_buffer->pixels[0].r = 20;
+    ASSERT_EQ(frame[0].r, 10, ERROR(5));
+
+    // Frame can only be acquired once
+    ASSERT_NULL(ar_graphics_acquire_frame(), ERROR(6));
+
+    ar_graphics_free_object();
+
+    COMPLETE_TEST(SUCCESS)
+}
+
+DEFINE_TEST(ar_graphics_present_skips_frames_test)
+{
+    ar_graphics_set_method(ar_graphics_method_frame_buffer);
+    ar_graphics_create_frame_buffer(4, 2);
+    ar_graphics_set_present_callback(count_presents, NULL);
+
+    struct ar_frame_buffer* frame_buffer = ar_graphics_get_frame_buffer();
+
+    // Present 3 frames without acquiring any of them
+    for (uint8_t i = 1; i <= 3; i++)
+    {
+        frame_buffer->pixels[0].g = i;
+        ar_graphics_present();
+    }
+
+    ASSERT_EQ(g_present_count, 3, ERROR(1));
+
+    // Only the latest frame is acquired
+    const struct ar_pixel* frame = ar_graphics_acquire_frame();
+    ASSERT_NOT_NULL(frame, ERROR(2));
+    ASSERT_EQ(frame[0].g, 3, ERROR(3));
+
+    ar_graphics_set_present_callback(NULL, NULL);
+    ar_graphics_free_object();
+
+    COMPLETE_TEST(SUCCESS)
+}
+
+DEFINE_TEST(ar_graphics_present_callback_test)
+{
+    ar_graphics_set_method(ar_graphics_method_frame_buffer);
+    ar_graphics_create_frame_buffer(4, 2);
+
+    int first_count  = 0;
+    int second_count = 0;
+
+    ar_graphics_set_present_callback(count_presents_in_user_data, &first_count);
+    ar_graphics_present();
+
+    // Replaced callback is always called with its own user data, never with the previous one
+    ar_graphics_set_present_callback(count_presents_in_user_data, &second_count);
+    ar_graphics_present();
+    ar_graphics_present();
+
+    ASSERT_EQ(first_count, 1, ERROR(1));
+    ASSERT_EQ(second_count, 2, ERROR(2));
+
+    // Cleared callback is not called anymore
+    ar_graphics_set_present_callback(NULL, NULL);
+    ar_graphics_present();
+
+    ASSERT_EQ(first_count, 1, ERROR(3));
+    ASSERT_EQ(second_count, 2, ERROR(4));
+
+    ar_graphics_free_object();
+
+    COMPLETE_TEST(SUCCESS)
+}
+
+DEFINE_TEST(ar_graphics_pixel_format_test)
+{
+    ar_graphics_set_method(ar_graphics_method_frame_buffer);
+    ar_graphics_create_frame_buffer_with_format(12, 2, ar_pixel_format_1bpp);
+
+    struct ar_frame_buffer* frame_buffer = ar_graphics_get_frame_buffer();
+
+    // Packed rows are rounded up to a whole byte
+    ASSERT_EQ(frame_buffer->pitch, 2, ERROR(1));
+
+    // Default palette of 1bpp is black and white
+    ASSERT_EQ(frame_buffer->palette[0].r, 0, ERROR(2));
+    ASSERT_EQ(frame_buffer->palette[1].r, 255, ERROR(3));
+
+    uint8_t* data = frame_buffer->data;
+    data[2] = 0x80;
+    frame_buffer->palette[1].g = 100;
+
+    ar_graphics_present();
+
+    // Palette changes after present do not affect the presented frame
+    frame_buffer->palette[1].g = 200;
+
+    const uint8_t* frame = ar_graphics_acquire_frame();
+    ASSERT_NOT_NULL(frame, ERROR(4));
+    ASSERT_EQ(frame[2], 0x80, ERROR(5));
+    ASSERT_EQ(ar_graphics_get_acquired_palette()[1].g, 100, ERROR(6));
+
+    ar_graphics_free_object();
+
+    COMPLETE_TEST(SUCCESS)
+}
+
+DEFINE_TEST(ar_graphics_create_frame_buffer_test)
+{
+    ar_graphics_set_method(ar_graphics_method_frame_buffer);
+
+    // Empty frame is rejected and no frame buffer is created
+    ASSERT_EQ(ar_graphics_create_frame_buffer(0, 2), 1, ERROR(1));
+    ASSERT_NULL(ar_graphics_get_frame_buffer(), ERROR(2));
+
+    ASSERT_EQ(ar_graphics_create_frame_buffer(4, 2), 0, ERROR(3));
+    ar_graphics_present();
+
+    // Creating it again replaces the previous frame buffer together with its slots and presented frames
+    ASSERT_EQ(ar_graphics_create_frame_buffer_with_format(12, 3, ar_pixel_format_1bpp), 0, ERROR(4));
+
+    struct ar_frame_buffer* frame_buffer = ar_graphics_get_frame_buffer();
+    ASSERT_NOT_NULL(frame_buffer, ERROR(5));
+    ASSERT_EQ(frame_buffer->height, 3, ERROR(6));
+    ASSERT_EQ(frame_buffer->pitch, 2, ERROR(7));
+    ASSERT_NULL(ar_graphics_acquire_frame(), ERROR(8));
+
+    ar_graphics_free_object();
+    ASSERT_NULL(ar_graphics_get_frame_buffer(), ERROR(9));
+
+    COMPLETE_TEST(SUCCESS)
+}
+
+DEFINE_BENCHMARK(ar_graphics_present_rgba8888_benchmark)
+{
+    ar_graphics_set_method(ar_graphics_method_frame_buffer);
+    ar_graphics_create_frame_buffer_with_format(256, 240, ar_pixel_format_rgba8888);
+
+    BENCHMARK_LOOP
+    {
+        ar_graphics_present();
+    }
+
+    ar_graphics_free_object();
+}
+
+DEFINE_BENCHMARK(ar_graphics_present_1bpp_benchmark)
+{
+    ar_graphics_set_method(ar_graphics_method_frame_buffer);
+    ar_graphics_create_frame_buffer_with_format(256, 240, ar_pixel_format_1bpp);
+
+    BENCHMARK_LOOP
+    {
+        ar_graphics_present();
+    }
+
+    ar_graphics_free_object();
+}
+
+DEFINE_TEST(ar_graphics_present_native_format_speed_test)
+{
+    // Presenting copies the frame, native formats exist so that small frames are cheaper to present
+    ASSERT_FASTER_THAN_BENCHMARK(ar_graphics_present_1bpp_benchmark, ar_graphics_present_rgba8888_benchmark, ERROR(1))
+
+    COMPLETE_TEST(SUCCESS)
+}
+
+DEFINE_TEST_TABLE(ar_graphics_tests)
+{
+    REGISTER_TEST(ar_graphics_present_acquire_test),
+    REGISTER_TEST(ar_graphics_present_skips_frames_test),
+    REGISTER_TEST(ar_graphics_present_callback_test),
+    REGISTER_TEST(ar_graphics_pixel_format_test),
+    REGISTER_TEST(ar_graphics_create_frame_buffer_test),
+    REGISTER_SERIAL_TEST(ar_graphics_present_native_format_speed_test),
+
+    // Benchmarks
+    REGISTER_BENCHMARK(ar_graphics_present_rgba8888_benchmark),
+    REGISTER_BENCHMARK(ar_graphics_present_1bpp_benchmark),
+
+    END_TEST_TABLE
+};
+
+DEFINE_TEST_TABLE_ENTRY_POINT(ar_graphics_tests)
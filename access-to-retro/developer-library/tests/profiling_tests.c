@@ -0,0 +1,220 @@
+#include "../include/access-to-retro-dev/access-to-retro-dev.h"
+#include "../include/access-to-retro-dev/unit-testing-library/access-to-retro-unit-testing.h"
+
+/**
+ * @brief Read whole trace written by a test
+ * @param path Path of the trace, each test writes its own so that tests can run in parallel
+ * @param buffer Buffer for the trace, null terminated
+ * @param size Size of the buffer
+ * @return Whether the trace could be read and fits into the buffer
+ */
+static bool read_trace(const char* path, char* buffer, size_t size)
+{
+    FILE* file = fopen(path, "r");
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    size_t length = fread(buffer, 1, size - 1, file);
+    bool fits = feof(file) != 0 || fgetc(file) == EOF;
+    fclose(file);
+
+    buffer[length] = '\0';
+
+    return fits;
+}
+
+/**
+ * @brief Count occurrences of a string in a trace
+ * @param trace Trace
+ * @param value String to count
+ * @return Number of occurrences
+ */
+static int count_occurrences(const char* trace, const char* value)
+{
+    int count = 0;
+    for (const char* found = strstr(trace, value); found != NULL; found = strstr(found + 1, value))
+    {
+        count++;
+    }
+
+    return count;
+}
+
+DEFINE_TEST(ar_profile_disabled_test)
+{
+    static char trace[4096];
+
+    // Nothing is recorded until profiling is enabled
+    ar_profile_clear();
+    ASSERT_FALSE(ar_profile_is_enabled(), ERROR(1));
+
+    ar_profile_begin("disabled_zone");
+    ar_profile_end();
+
+    ASSERT_EQ(ar_profile_write_trace("ar_profile_disabled_test.json"), 0, ERROR(2));
+    ASSERT_TRUE(read_trace("ar_profile_disabled_test.json", trace, sizeof(trace)), ERROR(3));
+    ASSERT_EQ(count_occurrences(trace, "disabled_zone"), 0, ERROR(4));
+    ASSERT_EQ(count_occurrences(trace, "\"ph\""), 0, ERROR(5));
+
+    remove("ar_profile_disabled_test.json");
+
+    COMPLETE_TEST(SUCCESS)
+}
+
+DEFINE_TEST(ar_profile_trace_test)
+{
+    static char trace[4096];
+
+    ar_profile_clear();
+    ar_profile_set_thread_name("test \"thread\"");
+    ar_profile_set_enabled(true);
+
+    ar_profile_begin("outer");
+    ar_profile_begin("inner");
+    ar_profile_end();
+    ar_profile_end();
+
+    // Zones after disabling are not recorded
+    ar_profile_set_enabled(false);
+    ar_profile_begin("after");
+    ar_profile_end();
+
+    ASSERT_EQ(ar_profile_write_trace("ar_profile_trace_test.json"), 0, ERROR(1));
+    ASSERT_TRUE(read_trace("ar_profile_trace_test.json", trace, sizeof(trace)), ERROR(2));
+
+    ASSERT_EQ(count_occurrences(trace, "\"traceEvents\""), 1, ERROR(3));
+    ASSERT_EQ(count_occurrences(trace, "\"name\": \"outer\", \"ph\": \"B\""), 1, ERROR(4));
+    ASSERT_EQ(count_occurrences(trace, "\"name\": \"inner\", \"ph\": \"B\""), 1, ERROR(5));
+    ASSERT_EQ(count_occurrences(trace, "\"ph\": \"E\""), 2, ERROR(6));
+    ASSERT_EQ(count_occurrences(trace, "after"), 0, ERROR(7));
+
+    // Thread name is escaped
+    ASSERT_EQ(count_occurrences(trace, "\"args\": {\"name\": \"test \\\"thread\\\"\"}"), 1, ERROR(8));
+
+    // Clearing drops the events, next trace is empty
+    ar_profile_clear();
+
+    ASSERT_EQ(ar_profile_write_trace("ar_profile_trace_test.json"), 0, ERROR(9));
+    ASSERT_TRUE(read_trace("ar_profile_trace_test.json", trace, sizeof(trace)), ERROR(10));
+    ASSERT_EQ(count_occurrences(trace, "outer"), 0, ERROR(11));
+
+    // Thread keeps its buffer and name after a clear, only events recorded after it are in the trace
+    ar_profile_set_enabled(true);
+    ar_profile_begin("after_clear");
+    ar_profile_end();
+
+    ASSERT_EQ(ar_profile_write_trace("ar_profile_trace_test.json"), 0, ERROR(12));
+    ASSERT_TRUE(read_trace("ar_profile_trace_test.json", trace, sizeof(trace)), ERROR(13));
+    ASSERT_EQ(count_occurrences(trace, "\"name\": \"after_clear\", \"ph\": \"B\""), 1, ERROR(14));
+    ASSERT_EQ(count_occurrences(trace, "\"ph\": \"E\""), 1, ERROR(15));
+    ASSERT_EQ(count_occurrences(trace, "outer"), 0, ERROR(16));
+    ASSERT_EQ(count_occurrences(trace, "test \\\"thread\\\""), 1, ERROR(17));
+
+    // Freed buffers are not used anymore, thread gets a new one
+    ar_profile_free();
+    ar_profile_set_enabled(true);
+    ar_profile_begin("after_free");
+    ar_profile_end();
+
+    ASSERT_EQ(ar_profile_write_trace("ar_profile_trace_test.json"), 0, ERROR(18));
+    ASSERT_TRUE(read_trace("ar_profile_trace_test.json", trace, sizeof(trace)), ERROR(19));
+    ASSERT_EQ(count_occurrences(trace, "\"name\": \"after_free\", \"ph\": \"B\""), 1, ERROR(20));
+    ASSERT_EQ(count_occurrences(trace, "after_clear"), 0, ERROR(21));
+
+    ar_profile_free();
+    remove("ar_profile_trace_test.json");
+
+    COMPLETE_TEST(SUCCESS)
+}
+
+DEFINE_TEST(ar_profile_overflow_test)
+{
+    ar_profile_clear();
+    ar_profile_set_enabled(true);
+
+    // Each zone is 2 events, the last 10 zones do not fit
+    for (int i = 0; i < AR_PROFILE_THREAD_EVENT_CAPACITY / 2 + 10; i++)
+    {
+        ar_profile_begin("zone");
+        ar_profile_end();
+    }
+
+    ASSERT_EQ(ar_profile_get_dropped_count(), 20, ERROR(1));
+
+    ar_profile_clear();
+    ASSERT_EQ(ar_profile_get_dropped_count(), 0, ERROR(2));
+    ASSERT_FALSE(ar_profile_is_enabled(), ERROR(3));
+
+    COMPLETE_TEST(SUCCESS)
+}
+
+DEFINE_BENCHMARK(ar_profile_zone_disabled_benchmark)
+{
+    ar_profile_clear();
+
+    BENCHMARK_LOOP
+    {
+        ar_profile_begin("zone");
+        ar_profile_end();
+    }
+}
+
+DEFINE_BENCHMARK(ar_profile_zone_enabled_benchmark)
+{
+    uint32_t zones = 0;
+
+    ar_profile_clear();
+    ar_profile_set_enabled(true);
+
+    BENCHMARK_LOOP
+    {
+        // Start over before the buffer fills up, dropped events are cheaper than recorded ones
+        if (++zones == AR_PROFILE_THREAD_EVENT_CAPACITY / 2)
+        {
+            ar_profile_clear();
+            ar_profile_set_enabled(true);
+            zones = 0;
+        }
+
+        ar_profile_begin("zone");
+        ar_profile_end();
+    }
+
+    ar_profile_clear();
+}
+
+DEFINE_TEST(ar_profile_zone_disabled_speed_test)
+{
+    // Disabled zones skip the clock and the event buffer, recording ones have to cost more on any machine
+    ASSERT_FASTER_THAN_BENCHMARK(ar_profile_zone_disabled_benchmark, ar_profile_zone_enabled_benchmark, ERROR(1))
+
+    COMPLETE_TEST(SUCCESS)
+}
+
+DEFINE_TEST(ar_profile_zone_speed_test)
+{
+    // Zones are left in release builds, disabled ones have to cost next to nothing and enabled ones tens of ns
+    ASSERT_FASTER_THAN(ar_profile_zone_disabled_benchmark, 10.0, ERROR(1))
+    ASSERT_FASTER_THAN(ar_profile_zone_enabled_benchmark, 200.0, ERROR(2))
+
+    COMPLETE_TEST(SUCCESS)
+}
+
+DEFINE_TEST_TABLE(ar_profiling_tests)
+{
+    REGISTER_TEST(ar_profile_disabled_test),
+    REGISTER_TEST(ar_profile_trace_test),
+    REGISTER_TEST(ar_profile_overflow_test),
+    REGISTER_SERIAL_TEST(ar_profile_zone_disabled_speed_test),
+    REGISTER_SPEED_TEST(ar_profile_zone_speed_test),
+
+    // Benchmarks
+    REGISTER_BENCHMARK(ar_profile_zone_disabled_benchmark),
+    REGISTER_BENCHMARK(ar_profile_zone_enabled_benchmark),
+
+    END_TEST_TABLE
+};
+
+DEFINE_TEST_TABLE_ENTRY_POINT(ar_profiling_tests)
@@ -0,0 +1,21 @@
+#include "../include/access-to-retro-dev/access-to-retro-dev.h"
+#include "../include/access-to-retro-dev/unit-testing-library/access-to-retro-unit-testing.h"
+
+/*
+ * Test tables of all test files, linked into a single executable with 'AR_SINGLE_TEST_RUNNER' defined so that the
+ * files do not define their own entry points
+ *
+ */
+extern const struct ar_test_entry ar_data_tests[];
+extern const struct ar_test_entry ar_audio_tests[];
+extern const struct ar_test_entry ar_graphics_tests[];
+extern const struct ar_test_entry ar_profiling_tests[];
+extern const struct ar_test_entry ar_analysis_tests[];
+
+int main(int argc, char** argv)
+{
+    const struct ar_test_entry* tables[] = { ar_data_tests, ar_audio_tests, ar_graphics_tests, ar_profiling_tests,
+                                             ar_analysis_tests, NULL };
+
+    return ar_run_test_tables(tables, argc, argv);
+}
@@ -0,0 +1,92 @@
+/**
+ * @file benchmarks/audio-resampler-benchmark.cpp
+ * @brief Measures number of output samples per second per channel that the audio resampler can produce
+ * @details Runs every instruction set supported by the CPU for a few typical rate conversions, using the same block
+ *          size as the audio device's default buffer.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <cmath>
+#include "core/audio-resampler.hpp"
+
+/// @brief Number of output frames per block, matches 'AR_AUDIO_DEFAULT_BUFFER_SIZE'
+static constexpr std::size_t BLOCK_FRAMES = 256;
+
+/// @brief Number of blocks per measured configuration
+static constexpr std::size_t BLOCK_COUNT = 20000;
+
+/// @brief Number of interleaved channels
+static constexpr uint32_t CHANNELS = 2;
+
+/// @brief Conversions to measure, input rate -> output rate
+static const std::vector<std::pair<double, double>> g_conversions = {
+        { 48000.0, 48000.0 },
+        { 44100.0, 48000.0 },
+        { 32040.0, 48000.0 },
+        { 48000.0, 44100.0 },
+        { 48000.0 * 1.005, 48000.0 },
+};
+
+/**
+ * @brief Resample 'BLOCK_COUNT' blocks and print the result
+ * @param simd Instruction set to use
+ * @param input_rate Input sample rate
+ * @param output_rate Output sample rate
+ */
+static void measure(ar::core::audio_resampler::simd_level simd, double input_rate, double output_rate)
+{
+    std::size_t max_input_frames = static_cast<std::size_t>(std::ceil(BLOCK_FRAMES * input_rate / output_rate)) +
+                                   ar::core::audio_resampler::TAPS + 1;
+
+    ar::core::audio_resampler resampler(CHANNELS, max_input_frames, simd);
+    resampler.set_rates(input_rate, output_rate);
+
+    // Input content does not matter for the speed, use a sine wave so the output is not trivially zero
+    std::vector<float> input(max_input_frames * CHANNELS);
+    for (std::size_t i = 0; i < input.size(); i++)
+    {
+        input[i] = static_cast<float>(std::sin(static_cast<double>(i / CHANNELS) * 0.05));
+    }
+
+    std::vector<float> output(BLOCK_FRAMES * CHANNELS);
+    float checksum = 0.0f;
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t block = 0; block < BLOCK_COUNT; block++)
+    {
+        resampler.push_input(input.data(), resampler.get_required_input_frames(BLOCK_FRAMES));
+        resampler.read_output(output.data(), BLOCK_FRAMES);
+
+        checksum += output[0];
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << ar::core::audio_resampler::get_simd_level_name(simd) << " " << input_rate << "hz -> "
+              << output_rate << "hz: " << static_cast<double>(BLOCK_FRAMES * BLOCK_COUNT) / seconds
+              << " samples/s per channel (checksum " << checksum << ")" << std::endl;
+}
+
+int main()
+{
+    using simd_level = ar::core::audio_resampler::simd_level;
+
+    simd_level best = ar::core::audio_resampler::get_best_simd_level();
+
+    for (simd_level simd : { simd_level::none, simd_level::sse, simd_level::avx })
+    {
+        if (simd > best)
+        {
+            continue;
+        }
+
+        for (const auto& [input_rate, output_rate] : g_conversions)
+        {
+            measure(simd, input_rate, output_rate);
+        }
+    }
+
+    return 0;
+}
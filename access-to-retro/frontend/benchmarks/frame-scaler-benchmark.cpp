@@ -0,0 +1,114 @@
+/**
+ * @file benchmarks/frame-scaler-benchmark.cpp
+ * @brief Measures per-frame scaling cost of every filter at 1080p and 4K output sizes
+ * @details Frames are scaled to the size the presenter would upload for the given output (filter factor replicated by
+ *          the largest integer factor that fits), so the results include the final replication. Presenter only scales
+ *          when a new frame arrives or the output is resized, this is the upper bound of the per-frame cost.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include "core/frame-scaler.hpp"
+
+/// @brief Number of scaled frames per measured configuration
+static constexpr std::size_t FRAME_COUNT = 200;
+
+/// @brief Frame resolutions to measure, width x height
+static const std::vector<std::pair<uint32_t, uint32_t>> g_frame_resolutions = {
+        { 64,  32 },
+        { 160, 144 },
+        { 320, 240 },
+};
+
+/// @brief Output resolutions to measure, width x height
+static const std::vector<std::pair<uint32_t, uint32_t>> g_output_resolutions = {
+        { 1920, 1080 },
+        { 3840, 2160 },
+};
+
+/// @brief Filters to measure
+static const std::vector<ar::core::frame_scaler::filter> g_filters = {
+        ar::core::frame_scaler::filter::nearest,
+        ar::core::frame_scaler::filter::scale2x,
+        ar::core::frame_scaler::filter::scale3x,
+        ar::core::frame_scaler::filter::xbr,
+};
+
+/**
+ * @brief Scale 'FRAME_COUNT' frames and print the result
+ * @param simd Instruction set to use
+ * @param scaling_filter Filter to use
+ * @param width Width of the frame
+ * @param height Height of the frame
+ * @param output_width Width of the output
+ * @param output_height Height of the output
+ */
+static void measure(ar::core::frame_scaler::simd_level simd, ar::core::frame_scaler::filter scaling_filter,
+                    uint32_t width, uint32_t height, uint32_t output_width, uint32_t output_height)
+{
+    ar::core::frame_scaler scaler(scaling_filter, simd);
+
+    // Few colours with diagonal runs so that the pixel art filters find edges
+    const uint32_t colours[] = { 0xFF000000, 0xFFFFFFFF, 0xFF3060C0, 0xFF20C040 };
+
+    std::vector<uint32_t> frame(static_cast<std::size_t>(width) * height);
+    for (uint32_t y = 0; y < height; y++)
+    {
+        for (uint32_t x = 0; x < width; x++)
+        {
+            frame[static_cast<std::size_t>(y) * width + x] = colours[((x + y) / 3 + (x * y) % 5) % 4];
+        }
+    }
+
+    uint32_t scaled_width  = 0;
+    uint32_t scaled_height = 0;
+    scaler.get_scaled_size(width, height, output_width, output_height, scaled_width, scaled_height);
+
+    std::vector<uint32_t> destination(static_cast<std::size_t>(scaled_width) * scaled_height);
+    uint32_t checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < FRAME_COUNT; i++)
+    {
+        scaler.scale(frame.data(), width, height, output_width, output_height, destination.data(),
+                     scaled_width * sizeof(uint32_t));
+
+        checksum += destination[(i * 7919) % destination.size()];
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double microseconds = std::chrono::duration<double, std::micro>(end - start).count() / FRAME_COUNT;
+    std::cout << (simd == ar::core::frame_scaler::simd_level::sse2 ? "SSE2" : "None") << " "
+              << ar::core::frame_scaler::get_filter_name(scaling_filter) << " " << width << "x" << height << " -> "
+              << scaled_width << "x" << scaled_height << " (output " << output_width << "x" << output_height
+              << "): " << microseconds << " us/frame (checksum " << checksum << ")" << std::endl;
+}
+
+int main()
+{
+    using simd_level = ar::core::frame_scaler::simd_level;
+
+    simd_level best = ar::core::frame_scaler::get_best_simd_level();
+
+    for (simd_level simd : { simd_level::none, simd_level::sse2 })
+    {
+        if (simd > best)
+        {
+            continue;
+        }
+
+        for (const auto& [output_width, output_height] : g_output_resolutions)
+        {
+            for (const auto& [width, height] : g_frame_resolutions)
+            {
+                for (ar::core::frame_scaler::filter scaling_filter : g_filters)
+                {
+                    measure(simd, scaling_filter, width, height, output_width, output_height);
+                }
+            }
+        }
+    }
+
+    return 0;
+}
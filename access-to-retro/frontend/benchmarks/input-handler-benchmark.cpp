@@ -0,0 +1,156 @@
+/**
+ * @file benchmarks/input-handler-benchmark.cpp
+ * @brief Measures number of key events per second that can be translated into Unified Controller keys
+ * @details Compares the key translation table against previous approach which converted every key event into its
+ *          name using 'QKeySequence' and looked it up inside a hash map.
+ *
+ *          Usage: ar_input_handler_benchmark [<virtual console>]
+ *
+ *          When a virtual console is given the whole input path is measured as well: 'input_handler' presses and
+ *          releases keys bound in the user's settings (the same ones the frontend uses), so every event also goes
+ *          through its profile zone and sets the key status inside the virtual console's library.
+ */
+
+#include <QGuiApplication>
+#include <QKeySequence>
+#include <unordered_map>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include "core/input-handler.hpp"
+#include "core/key-translation-table.hpp"
+#include "core/virtual-console.hpp"
+#include "util/logger.hpp"
+#include "util/settings-manager.hpp"
+
+/// @brief Number of translated key events per measured approach
+static constexpr std::size_t EVENT_COUNT = 1000000;
+
+/// @brief Keys mapped in both approaches, typical gamepad-like layout
+static const std::vector<std::pair<Qt::Key, ar_unified_controller_key>> g_mapped_keys = {
+        { Qt::Key_Up,    ar_unified_controller_dpad_up    },
+        { Qt::Key_Down,  ar_unified_controller_dpad_down  },
+        { Qt::Key_Left,  ar_unified_controller_dpad_left  },
+        { Qt::Key_Right, ar_unified_controller_dpad_right },
+        { Qt::Key_Z,     ar_unified_controller_a          },
+        { Qt::Key_X,     ar_unified_controller_b          },
+        { Qt::Key_Enter, ar_unified_controller_start      },
+};
+
+/// @brief Stream of key events, contains both mapped and unmapped keys
+static const std::vector<int> g_event_keys = {
+        Qt::Key_Up, Qt::Key_A, Qt::Key_Z, Qt::Key_Left, Qt::Key_Space, Qt::Key_X, Qt::Key_F1, Qt::Key_Enter
+};
+
+/// @brief Input settings read for the input handler, the frontend's default bindings are stored under these
+static const std::vector<std::string> g_input_settings = {
+        "input_dpad_up", "input_dpad_down", "input_dpad_left", "input_dpad_right", "input_a", "input_b", "input_start"
+};
+
+/// @brief Key that is never bound, events of it are translated but don't set any key status
+static constexpr int UNBOUND_KEY = Qt::Key_F35;
+
+/**
+ * @brief Run translation function for 'EVENT_COUNT' events and print the result
+ * @param name Name of the measured approach
+ * @param translate Function translating key code, returns whether the key was mapped
+ * @param event_keys Stream of key events, repeated until 'EVENT_COUNT' events are translated
+ */
+template<typename Fn>
+static void measure(const std::string& name, Fn translate, const std::vector<int>& event_keys = g_event_keys)
+{
+    std::size_t mapped = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < EVENT_COUNT; i++)
+    {
+        mapped += translate(event_keys[i % event_keys.size()]) ? 1 : 0;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << name << ": " << static_cast<double>(EVENT_COUNT) / seconds << " events/s"
+              << " (" << mapped << " mapped)" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    // 'QKeySequence' requires application instance for key names
+    QGuiApplication app(argc, argv);
+
+    // Previous approach - key name lookup
+    std::unordered_map<std::string, ar_unified_controller_key> string_map;
+    for (const auto& [key, unified_key] : g_mapped_keys)
+    {
+        string_map.insert({ QKeySequence(key).toString().toStdString(), unified_key });
+    }
+
+    measure("string map", [&string_map](int key)
+    {
+        return string_map.contains(QKeySequence(key).toString().toStdString());
+    });
+
+    // Current approach - flat table lookup
+    ar::core::key_translation_table table;
+    for (const auto& [key, unified_key] : g_mapped_keys)
+    {
+        table.map(key, unified_key);
+    }
+
+    measure("translation table", [&table](int key)
+    {
+        return table.translate(key) != std::nullopt;
+    });
+
+    if (argc < 2)
+    {
+        return 0;
+    }
+
+    // Whole input path - same settings and library the frontend would use
+    ar::util::logger::configure_based_on_args({});
+    ar::util::settings_manager::configure();
+
+    std::vector<int> handler_event_keys;
+    for (const std::string& setting : g_input_settings)
+    {
+        std::optional<std::string> key_name = ar::util::settings_manager::get_global_manager()->get_setting(setting);
+        std::optional<ar::core::key_id> key = key_name != std::nullopt ?
+                                              ar::core::key_translation_table::key_id_from_string(key_name.value()) :
+                                              std::nullopt;
+
+        if (key != std::nullopt)
+        {
+            handler_event_keys.push_back(key.value());
+            handler_event_keys.push_back(UNBOUND_KEY);
+        }
+    }
+
+    if (handler_event_keys.empty())
+    {
+        std::cerr << "No input bindings found in settings, input handler is not measured" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        auto virtual_console = std::make_unique<ar::core::virtual_console>(argv[1]);
+        ar::core::input_handler handler(virtual_console);
+
+        // Every event is a press followed by a release, just like holding a key down for a moment
+        measure("input handler (press + release)", [&handler](int key)
+        {
+            handler.key_press(key);
+            handler.key_release(key);
+
+            return key != UNBOUND_KEY;
+        }, handler_event_keys);
+    }
+    catch (const ar::base_exception& ex)
+    {
+        std::cerr << ex.get_logger_formatted_error() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file benchmarks/pixel-converter-benchmark.cpp
+ * @brief Measures bytes moved per frame and conversion time per frame for every frame buffer pixel format
+ * @details Bytes per frame is what the virtual console copies on every present (and what the frontend reads), the
+ *          converted frame is always 4 bytes per pixel. Every instruction set supported by the CPU is measured at a
+ *          few typical virtual console resolutions.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include "core/pixel-converter.hpp"
+
+/// @brief Number of converted frames per measured configuration
+static constexpr std::size_t FRAME_COUNT = 20000;
+
+/// @brief Resolutions to measure, width x height
+static const std::vector<std::pair<uint32_t, uint32_t>> g_resolutions = {
+        { 64,  32 },
+        { 160, 144 },
+        { 320, 240 },
+};
+
+/// @brief Formats to measure
+static const std::vector<ar_pixel_format> g_formats = {
+        ar_pixel_format_1bpp,
+        ar_pixel_format_2bpp_indexed,
+        ar_pixel_format_8bpp_indexed,
+        ar_pixel_format_rgb565,
+        ar_pixel_format_xrgb8888,
+        ar_pixel_format_rgba8888,
+};
+
+/**
+ * @brief Convert 'FRAME_COUNT' frames and print the result
+ * @param simd Instruction set to use
+ * @param format Format of the source frame
+ * @param width Width of the frame
+ * @param height Height of the frame
+ */
+static void measure(ar::core::pixel_converter::simd_level simd, ar_pixel_format format, uint32_t width,
+                    uint32_t height)
+{
+    ar::core::pixel_converter converter(simd);
+
+    std::size_t frame_size   = ar::core::pixel_converter::get_frame_size(format, width, height);
+    std::size_t source_pitch = frame_size / height;
+
+    // Content does not matter for the speed, use a pattern so that every palette entry and bit gets hit
+    std::vector<uint8_t> source(frame_size);
+    for (std::size_t i = 0; i < source.size(); i++)
+    {
+        source[i] = static_cast<uint8_t>(i * 37);
+    }
+
+    std::vector<ar_pixel> palette(AR_PALETTE_SIZE);
+    for (std::size_t i = 0; i < palette.size(); i++)
+    {
+        auto value = static_cast<uint8_t>(i);
+        palette[i] = { value, value, value, 255 };
+    }
+
+    std::vector<ar_pixel> destination(static_cast<std::size_t>(width) * height);
+    uint32_t checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t frame = 0; frame < FRAME_COUNT; frame++)
+    {
+        converter.convert(format, source.data(), source_pitch, palette.data(), width, height, destination.data(),
+                          width * sizeof(ar_pixel));
+
+        checksum += destination[frame % destination.size()].r;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count() / FRAME_COUNT;
+    std::cout << ar::core::pixel_converter::get_simd_level_name(simd) << " " << width << "x" << height << " "
+              << ar::core::pixel_converter::get_pixel_format_name(format) << ": " << frame_size
+              << " bytes/frame (" << destination.size() * sizeof(ar_pixel) << " converted), " << nanoseconds
+              << " ns/frame (checksum " << checksum << ")" << std::endl;
+}
+
+int main()
+{
+    using simd_level = ar::core::pixel_converter::simd_level;
+
+    simd_level best = ar::core::pixel_converter::get_best_simd_level();
+
+    for (simd_level simd : { simd_level::none, simd_level::sse2, simd_level::avx2 })
+    {
+        if (simd > best)
+        {
+            continue;
+        }
+
+        for (const auto& [width, height] : g_resolutions)
+        {
+            for (ar_pixel_format format : g_formats)
+            {
+                measure(simd, format, width, height);
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file benchmarks/render-backend-benchmark.cpp
+ * @brief Measures cost of presenting a frame with each render backend
+ * @details Every present uploads a new frame and shows it scaled to the window, the same work the frame presenter
+ *          does. Vertical sync is disabled so only the backend's own cost is measured. Backends that cannot be
+ *          created (for example accelerated renderer without a GPU) are reported as unavailable. Can be run without
+ *          a display using 'SDL_VIDEODRIVER=dummy' or 'SDL_VIDEODRIVER=offscreen', OpenGL backend additionally needs
+ *          'SDL_VIDEODRIVER=offscreen' with 'LIBGL_ALWAYS_SOFTWARE=1' to run on Mesa's llvmpipe. OpenGL backend scales
+ *          in its shader while SDL renderers stretch the texture, both receive the frame in its own size.
+ */
+
+#define SDL_MAIN_HANDLED
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <cstring>
+#include "core/render-backend.hpp"
+#include "error/os-error.hpp"
+
+/// @brief Number of presents per measured configuration
+static constexpr std::size_t PRESENT_COUNT = 500;
+
+/// @brief Frame sizes to measure, width x height
+static const std::vector<std::pair<uint32_t, uint32_t>> g_frame_sizes = {
+        { 64,  32 },
+        { 320, 240 },
+};
+
+/// @brief Window sizes to measure, width x height
+static const std::vector<std::pair<int, int>> g_window_sizes = {
+        { 640,  320 },
+        { 1920, 1080 },
+};
+
+/**
+ * @brief Present 'PRESENT_COUNT' frames and print the result
+ * @param type Backend to measure
+ * @param frame_width Width of the frame
+ * @param frame_height Height of the frame
+ * @param window_width Width of the window
+ * @param window_height Height of the window
+ */
+static void measure(ar::core::render_backend_type type, uint32_t frame_width, uint32_t frame_height,
+                    int window_width, int window_height)
+{
+    std::string configuration = ar::core::render_backend::get_type_name(type) + " " + std::to_string(frame_width) +
+                                "x" + std::to_string(frame_height) + " -> " + std::to_string(window_width) + "x" +
+                                std::to_string(window_height);
+
+    // OpenGL backend creates its own context, the window has to support it
+    Uint32 window_flags = SDL_WINDOW_HIDDEN;
+    if (type == ar::core::render_backend_type::opengl)
+    {
+        window_flags |= SDL_WINDOW_OPENGL;
+    }
+
+    SDL_Window* window = SDL_CreateWindow("render-backend-benchmark", SDL_WINDOWPOS_UNDEFINED,
+                                          SDL_WINDOWPOS_UNDEFINED, window_width, window_height, window_flags);
+    if (window == nullptr)
+    {
+        std::cout << configuration << ": unable to create window (" << SDL_GetError() << ")" << std::endl;
+        return;
+    }
+
+    try
+    {
+        std::unique_ptr<ar::core::render_backend> backend = ar::core::render_backend::create(type, window, false);
+
+        // Two alternating frames so that nothing can be cached between presents
+        std::vector<std::vector<uint32_t>> frames(2, std::vector<uint32_t>(frame_width * frame_height));
+        for (std::size_t i = 0; i < frames[0].size(); i++)
+        {
+            frames[0][i] = static_cast<uint32_t>(i * 2654435761u) | 0xFF000000;
+            frames[1][i] = ~frames[0][i] | 0xFF000000;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t present = 0; present < PRESENT_COUNT; present++)
+        {
+            const std::vector<uint32_t>& frame = frames[present % 2];
+
+            std::size_t pitch = 0;
+            auto* pixels      = static_cast<uint8_t*>(backend->lock_frame(frame_width, frame_height, pitch));
+            if (pixels != nullptr)
+            {
+                for (uint32_t y = 0; y < frame_height; y++)
+                {
+                    std::memcpy(pixels + y * pitch, frame.data() + y * frame_width, frame_width * sizeof(uint32_t));
+                }
+
+                backend->unlock_frame();
+            }
+
+            backend->present();
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        double microseconds = std::chrono::duration<double, std::micro>(end - start).count() / PRESENT_COUNT;
+        std::cout << configuration << ": " << microseconds << " us/present" << std::endl;
+    }
+    catch (const ar::error::os_error& ex)
+    {
+        std::cout << configuration << ": unavailable (" << ex.get_error() << ")" << std::endl;
+    }
+
+    SDL_DestroyWindow(window);
+}
+
+int main()
+{
+    if (SDL_Init(SDL_INIT_VIDEO) != 0)
+    {
+        std::cout << "Unable to initialise SDL video: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+
+    for (ar::core::render_backend_type type : { ar::core::render_backend_type::accelerated,
+                                                ar::core::render_backend_type::software,
+                                                ar::core::render_backend_type::cpu_blitter,
+                                                ar::core::render_backend_type::opengl })
+    {
+        for (const auto& [frame_width, frame_height] : g_frame_sizes)
+        {
+            for (const auto& [window_width, window_height] : g_window_sizes)
+            {
+                measure(type, frame_width, frame_height, window_width, window_height);
+            }
+        }
+    }
+
+    SDL_Quit();
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <cstring>
+#include "util/logger.hpp"
+#include "audio-output.hpp"
+
+ar::core::audio_output::audio_output(ar::core::dynamic_library& library)
+{
+    _pull_samples_fn       = library.get_symbol<pull_samples_fn>("ar_audio_pull_samples");
+    _get_underrun_count_fn = library.get_symbol<get_counter_fn>("ar_audio_get_underrun_count");
+    _get_overrun_count_fn  = library.get_symbol<get_counter_fn>("ar_audio_get_overrun_count");
+    _get_queued_frames_fn  = library.get_symbol<get_queued_frames_fn>("ar_audio_get_queued_frames");
+
+    auto get_sample_rate_fn = library.get_symbol<uint32_t(*)()>("ar_audio_get_sample_rate");
+    auto get_channels_fn    = library.get_symbol<uint8_t(*)()>("ar_audio_get_channels");
+    auto get_format_fn      = library.get_symbol<ar_audio_format(*)()>("ar_audio_get_format");
+    auto get_buffer_size_fn = library.get_symbol<uint32_t(*)()>("ar_audio_get_buffer_size");
+
+    _sample_rate = get_sample_rate_fn();
+    _format      = get_format_fn();
+    _channels    = get_channels_fn();
+
+    SDL_AudioSpec desired_spec {};
+    desired_spec.freq     = static_cast<int>(_sample_rate);
+    desired_spec.format   = AUDIO_F32SYS;
+    desired_spec.channels = static_cast<Uint8>(_channels);
+    desired_spec.callback = audio_callback;
+    desired_spec.userdata = this;
+
+    // SDL requires the number of frames to be a power of 2
+    uint32_t buffer_size = 1;
+    while (buffer_size < get_buffer_size_fn() && buffer_size < UINT16_MAX / 2 + 1)
+    {
+        buffer_size <<= 1;
+    }
+
+    desired_spec.samples = static_cast<Uint16>(buffer_size);
+
+    // Only sample rate can change, it's handled by the resampler. SDL converts the format if it's not supported natively
+    _device = SDL_OpenAudioDevice(nullptr, 0, &desired_spec, &_device_spec, SDL_AUDIO_ALLOW_FREQUENCY_CHANGE);
+    if (_device == 0)
+    {
+        throw ar::error::os_error("Unable to open audio device. Error: " + std::string(SDL_GetError()));
+    }
+
+    // Largest block of input frames that a single device buffer can require (+ filter window and rounding margin)
+    std::size_t max_input_frames = get_device_buffer_frames() + ar::core::audio_resampler::TAPS + 1;
+
+    _resampler = std::make_unique<ar::core::audio_resampler>(_channels, max_input_frames);
+    _resampler->set_rates(_sample_rate, _device_spec.freq);
+
+    std::size_t sample_size = _format == ar_audio_format_f32 ? sizeof(float) : sizeof(int16_t);
+
+    _pull_buffer.resize(max_input_frames * _channels * sample_size);
+    _float_buffer.resize(max_input_frames * _channels);
+
+    LOG_DEBUG("core.audio_output", "Audio device opened (" + std::to_string(_device_spec.freq) + "hz, " +
+                                   std::to_string(_device_spec.channels) + " channels, " +
+                                   std::to_string(_device_spec.samples) + " frames buffer), virtual console " +
+                                   "audio is resampled from " + std::to_string(_sample_rate) + "hz using " +
+                                   ar::core::audio_resampler::get_simd_level_name(_resampler->get_simd_level()));
+}
+
+ar::core::audio_output::~audio_output()
+{
+    SDL_CloseAudioDevice(_device);
+
+    LOG_DEBUG("core.audio_output", "Audio device closed (" + std::to_string(_get_underrun_count_fn()) +
+                                   " underruns, " + std::to_string(_get_overrun_count_fn()) + " overruns)");
+}
+
+void ar::core::audio_output::start()
+{
+    SDL_PauseAudioDevice(_device, 0);
+}
+
+void ar::core::audio_output::pause()
+{
+    SDL_PauseAudioDevice(_device, 1);
+}
+
+double ar::core::audio_output::get_device_latency() const
+{
+    return 1000.0 * _device_spec.samples / _device_spec.freq;
+}
+
+uint32_t ar::core::audio_output::get_queued_frames() const
+{
+    return _get_queued_frames_fn();
+}
+
+uint32_t ar::core::audio_output::get_device_buffer_frames() const
+{
+    // Device buffer is in device's sample rate, convert it to virtual console's sample rate (rounding up)
+    uint64_t frames = static_cast<uint64_t>(_device_spec.samples) * _sample_rate;
+    uint64_t freq   = static_cast<uint64_t>(_device_spec.freq);
+
+    return static_cast<uint32_t>((frames + freq - 1) / freq);
+}
+
+uint32_t ar::core::audio_output::get_sample_rate() const
+{
+    return _sample_rate;
+}
+
+void ar::core::audio_output::pull_into_resampler(std::size_t frame_count)
+{
+    std::size_t max_frames = _float_buffer.size() / _channels;
+
+    while (frame_count > 0)
+    {
+        auto frames = static_cast<uint32_t>(std::min(frame_count, max_frames));
+
+        // Library fills whatever was not queued with silence
+        _pull_samples_fn(_pull_buffer.data(), frames);
+
+        std::size_t sample_count = static_cast<std::size_t>(frames) * _channels;
+        if (_format == ar_audio_format_f32)
+        {
+            std::memcpy(_float_buffer.data(), _pull_buffer.data(), sample_count * sizeof(float));
+        }
+        else
+        {
+            const auto* samples = reinterpret_cast<const int16_t*>(_pull_buffer.data());
+            for (std::size_t i = 0; i < sample_count; i++)
+            {
+                _float_buffer[i] = static_cast<float>(samples[i]) * (1.0f / 32768.0f);
+            }
+        }
+
+        _resampler->push_input(_float_buffer.data(), frames);
+
+        frame_count -= frames;
+    }
+}
+
+void ar::core::audio_output::audio_callback(void* user_data, Uint8* stream, int length)
+{
+    auto* output = static_cast<ar::core::audio_output*>(user_data);
+
+    std::size_t frame_count = static_cast<std::size_t>(length) / (sizeof(float) * output->_channels);
+
+    output->pull_into_resampler(output->_resampler->get_required_input_frames(frame_count));
+    output->_resampler->read_output(reinterpret_cast<float*>(stream), frame_count);
+}
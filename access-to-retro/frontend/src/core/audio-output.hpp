@@ -0,0 +1,133 @@
+/**
+ * @file core/audio-output.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_FRONTEND_AUDIO_OUTPUT_HPP
+#define ACCESS_TO_RETRO_FRONTEND_AUDIO_OUTPUT_HPP
+
+#include <access-to-retro-dev/access-to-retro-dev.h>
+#include <SDL.h>
+#include <memory>
+#include <vector>
+#include "dynamic-library.hpp"
+#include "audio-resampler.hpp"
+
+namespace ar::core
+{
+    /**
+     * @brief Plays audio pushed by a virtual console using SDL's audio device
+     * @details Virtual console pushes samples into the library's lock-free queue ('ar_audio_push_samples'), SDL's audio
+     *          callback (running on SDL's audio thread) pulls them out of it. The device always plays float samples at
+     *          its preferred sample rate, pulled samples are converted and resampled from virtual console's rate.
+     */
+    class audio_output
+    {
+    public:
+        /**
+         * @brief Default constructor, opens the audio device in paused state
+         * @warning Virtual console has to configure audio ('ar_audio_configure') before this object is created
+         * @param library Virtual console's library that the samples will be pulled from
+         * @throws Exceptions:
+         *  - ar::error::os_error: When the symbols were not found or the audio device could not be opened
+         */
+        explicit audio_output(ar::core::dynamic_library& library);
+
+        /// @brief Closes the audio device and logs the underrun/overrun counters
+        ~audio_output();
+
+        audio_output(const audio_output&) = delete;
+        audio_output& operator=(const audio_output&) = delete;
+
+        /// @brief Start playing audio
+        void start();
+
+        /// @brief Pause playing audio, the audio device will stop pulling samples
+        void pause();
+
+        /**
+         * @brief Get latency of the audio device's buffer
+         * @return Time (in milliseconds) that a single device buffer takes to play
+         */
+        [[nodiscard]] double get_device_latency() const;
+
+        /**
+         * @brief Get number of frames waiting in the virtual console's audio queue
+         * @return Number of queued frames (at virtual console's sample rate)
+         */
+        [[nodiscard]] uint32_t get_queued_frames() const;
+
+        /**
+         * @brief Get number of frames that the audio device consumes at once
+         * @return Number of frames (at virtual console's sample rate) consumed per device buffer
+         */
+        [[nodiscard]] uint32_t get_device_buffer_frames() const;
+
+        /**
+         * @brief Get virtual console's sample rate
+         * @return Number of frames per second pushed by the virtual console
+         */
+        [[nodiscard]] uint32_t get_sample_rate() const;
+
+    private:
+        /// @brief Access to Retro library function used to pull samples from the queue
+        typedef uint32_t(* pull_samples_fn)(void*, uint32_t);
+
+        /// @brief Access to Retro library function used to get underrun/overrun counters
+        typedef uint64_t(* get_counter_fn)();
+
+        /// @brief Access to Retro library function used to get number of queued frames
+        typedef uint32_t(* get_queued_frames_fn)();
+
+        /// @brief Function used to pull samples, called from SDL's audio thread
+        pull_samples_fn _pull_samples_fn = nullptr;
+
+        /// @brief Function used to get number of underruns
+        get_counter_fn _get_underrun_count_fn = nullptr;
+
+        /// @brief Function used to get number of overruns
+        get_counter_fn _get_overrun_count_fn = nullptr;
+
+        /// @brief Function used to get number of queued frames
+        get_queued_frames_fn _get_queued_frames_fn = nullptr;
+
+        /// @brief Virtual console's sample rate
+        uint32_t _sample_rate = 0;
+
+        /// @brief Virtual console's sample format
+        ar_audio_format _format = ar_audio_format_s16;
+
+        /// @brief Opened SDL audio device
+        SDL_AudioDeviceID _device = 0;
+
+        /// @brief Specification of the opened audio device
+        SDL_AudioSpec _device_spec {};
+
+        /// @brief Number of interleaved channels, same for virtual console and the device
+        uint32_t _channels = 0;
+
+        /// @brief Converts virtual console's sample rate to device's sample rate
+        std::unique_ptr<ar::core::audio_resampler> _resampler = nullptr;
+
+        /// @brief Frames pulled from the queue in virtual console's format, allocated upfront
+        std::vector<uint8_t> _pull_buffer;
+
+        /// @brief Frames pulled from the queue converted to float, allocated upfront
+        std::vector<float> _float_buffer;
+
+        /**
+         * @brief Pull frames from the queue and pass them to the resampler
+         * @param frame_count Number of frames to pull
+         */
+        void pull_into_resampler(std::size_t frame_count);
+
+        /**
+         * @brief SDL's audio callback, fills device's buffer with samples from the queue
+         * @param user_data Pointer to 'audio_output' object
+         * @param stream Device's buffer
+         * @param length Length of the device's buffer in bytes
+         */
+        static void audio_callback(void* user_data, Uint8* stream, int length);
+    };
+}
+
+#endif //ACCESS_TO_RETRO_FRONTEND_AUDIO_OUTPUT_HPP
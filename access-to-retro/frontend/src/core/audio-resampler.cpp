@@ -0,0 +1,308 @@
+#include <algorithm>
+#include <numbers>
+#include <cmath>
+#include "audio-resampler.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+
+/// @brief SSE is part of every x86-64 CPU
+#define AR_RESAMPLER_SSE
+
+#if defined(__GNUC__) || defined(__clang__)
+/// @brief AVX kernel is compiled for AVX only, it's selected at runtime if the CPU supports it
+#define AR_RESAMPLER_AVX
+#define AR_RESAMPLER_AVX_TARGET __attribute__((target("avx")))
+#elif defined(__AVX__)
+#define AR_RESAMPLER_AVX
+#define AR_RESAMPLER_AVX_TARGET
+#endif
+
+#endif
+
+/// @brief Filter's cutoff relative to the lower of the two Nyquist frequencies, leaves room for the transition band
+static constexpr double ROLLOFF = 0.9;
+
+/****************************************************************************************************
+ Dot product kernels
+****************************************************************************************************/
+
+/**
+ * @brief Dot product of 'TAPS' samples and coefficients, plain C++
+ * @param samples Input samples
+ * @param coefficients Filter coefficients
+ * @return Filtered sample
+ */
+static float dot_product_scalar(const float* samples, const float* coefficients)
+{
+    // Independent accumulators so that the additions do not wait on each other
+    float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+    for (std::size_t i = 0; i < ar::core::audio_resampler::TAPS; i += 4)
+    {
+        sum[0] += samples[i + 0] * coefficients[i + 0];
+        sum[1] += samples[i + 1] * coefficients[i + 1];
+        sum[2] += samples[i + 2] * coefficients[i + 2];
+        sum[3] += samples[i + 3] * coefficients[i + 3];
+    }
+
+    return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+#ifdef AR_RESAMPLER_SSE
+
+/**
+ * @brief Dot product of 'TAPS' samples and coefficients, SSE
+ * @param samples Input samples
+ * @param coefficients Filter coefficients
+ * @return Filtered sample
+ */
+static float dot_product_sse(const float* samples, const float* coefficients)
+{
+    __m128 sum_a = _mm_setzero_ps();
+    __m128 sum_b = _mm_setzero_ps();
+
+    for (std::size_t i = 0; i < ar::core::audio_resampler::TAPS; i += 8)
+    {
+        sum_a = _mm_add_ps(sum_a, _mm_mul_ps(_mm_loadu_ps(samples + i), _mm_loadu_ps(coefficients + i)));
+        sum_b = _mm_add_ps(sum_b, _mm_mul_ps(_mm_loadu_ps(samples + i + 4), _mm_loadu_ps(coefficients + i + 4)));
+    }
+
+    // Horizontal sum of the 4 lanes
+    __m128 sum = _mm_add_ps(sum_a, sum_b);
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 0x55));
+
+    return _mm_cvtss_f32(sum);
+}
+
+#endif
+
+#ifdef AR_RESAMPLER_AVX
+
+/**
+ * @brief Dot product of 'TAPS' samples and coefficients, AVX
+ * @param samples Input samples
+ * @param coefficients Filter coefficients
+ * @return Filtered sample
+ */
+AR_RESAMPLER_AVX_TARGET static float dot_product_avx(const float* samples, const float* coefficients)
+{
+    __m256 sum_a = _mm256_setzero_ps();
+    __m256 sum_b = _mm256_setzero_ps();
+
+    for (std::size_t i = 0; i < ar::core::audio_resampler::TAPS; i += 16)
+    {
+        sum_a = _mm256_add_ps(sum_a, _mm256_mul_ps(_mm256_loadu_ps(samples + i), _mm256_loadu_ps(coefficients + i)));
+        sum_b = _mm256_add_ps(sum_b, _mm256_mul_ps(_mm256_loadu_ps(samples + i + 8),
+                                                   _mm256_loadu_ps(coefficients + i + 8)));
+    }
+
+    // Fold 8 lanes into 4 and finish like SSE
+    __m256 sum_256 = _mm256_add_ps(sum_a, sum_b);
+    __m128 sum     = _mm_add_ps(_mm256_castps256_ps128(sum_256), _mm256_extractf128_ps(sum_256, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 0x55));
+
+    return _mm_cvtss_f32(sum);
+}
+
+#endif
+
+/****************************************************************************************************
+ audio_resampler
+****************************************************************************************************/
+
+ar::core::audio_resampler::audio_resampler(uint32_t channels, std::size_t max_input_frames,
+                                           ar::core::audio_resampler::simd_level simd) :
+        _channels(channels),
+        _simd(std::min(simd, get_best_simd_level())),
+        _dot_product_fn(dot_product_scalar),
+        _input(channels)
+{
+#ifdef AR_RESAMPLER_SSE
+    if (_simd == simd_level::sse)
+    {
+        _dot_product_fn = dot_product_sse;
+    }
+#endif
+
+#ifdef AR_RESAMPLER_AVX
+    if (_simd == simd_level::avx)
+    {
+        _dot_product_fn = dot_product_avx;
+    }
+#endif
+
+    // Frames kept between blocks are at most one filter window
+    for (auto& channel_input : _input)
+    {
+        channel_input.reserve(max_input_frames + TAPS);
+    }
+
+    build_filter(ROLLOFF);
+}
+
+void ar::core::audio_resampler::set_rates(double input_rate, double output_rate)
+{
+    _step = static_cast<uint64_t>(std::llround(input_rate / output_rate *
+                                               static_cast<double>(uint64_t { 1 } << FRACTION_BITS)));
+
+    // When downsampling the cutoff has to be below output's Nyquist frequency to avoid aliasing
+    double cutoff = std::min(1.0, output_rate / input_rate) * ROLLOFF;
+
+    // Rate control only changes the ratio by fractions of a percent, do not rebuild the filter for that
+    if (std::abs(cutoff - _cutoff) > 0.01 * _cutoff)
+    {
+        build_filter(cutoff);
+    }
+}
+
+std::size_t ar::core::audio_resampler::get_required_input_frames(std::size_t output_frames) const
+{
+    if (output_frames == 0)
+    {
+        return 0;
+    }
+
+    // Filter window of the last output frame starts at its integer position
+    uint64_t last_position = _position + (output_frames - 1) * _step;
+    std::size_t needed     = static_cast<std::size_t>(last_position >> FRACTION_BITS) + TAPS;
+    std::size_t buffered   = _input[0].size();
+
+    return needed > buffered ? needed - buffered : 0;
+}
+
+void ar::core::audio_resampler::push_input(const float* frames, std::size_t frame_count)
+{
+    // Deinterleave so that each channel's filter window is contiguous
+    for (uint32_t channel = 0; channel < _channels; channel++)
+    {
+        std::vector<float>& channel_input = _input[channel];
+
+        for (std::size_t i = 0; i < frame_count; i++)
+        {
+            channel_input.push_back(frames[i * _channels + channel]);
+        }
+    }
+}
+
+void ar::core::audio_resampler::read_output(float* out, std::size_t frame_count)
+{
+    constexpr uint32_t PHASE_SHIFT         = FRACTION_BITS - PHASE_BITS;
+    constexpr uint64_t PHASE_FRACTION_MASK = (uint64_t { 1 } << PHASE_SHIFT) - 1;
+    constexpr float PHASE_FRACTION_SCALE   = 1.0f / static_cast<float>(uint64_t { 1 } << PHASE_SHIFT);
+
+    for (std::size_t i = 0; i < frame_count; i++)
+    {
+        auto index    = static_cast<std::size_t>(_position >> FRACTION_BITS);
+        auto fraction = static_cast<uint32_t>(_position);
+
+        // Output is interpolated between the two closest precomputed phases
+        std::size_t phase    = fraction >> PHASE_SHIFT;
+        float phase_fraction = static_cast<float>(fraction & PHASE_FRACTION_MASK) * PHASE_FRACTION_SCALE;
+
+        const float* coefficients      = _coefficients.data() + phase * TAPS;
+        const float* next_coefficients = coefficients + TAPS;
+
+        for (uint32_t channel = 0; channel < _channels; channel++)
+        {
+            const float* window = _input[channel].data() + index;
+
+            float current = _dot_product_fn(window, coefficients);
+            float next    = _dot_product_fn(window, next_coefficients);
+
+            out[i * _channels + channel] = current + (next - current) * phase_fraction;
+        }
+
+        _position += _step;
+    }
+
+    /*
+     * Drop input frames that will not be needed anymore. When downsampling by more than 'TAPS' times the position can
+     * point past the buffered frames, the rest is skipped from the frames pushed for the next block.
+     */
+    std::size_t consumed_frames = std::min(static_cast<std::size_t>(_position >> FRACTION_BITS), _input[0].size());
+
+    for (auto& channel_input : _input)
+    {
+        channel_input.erase(channel_input.begin(),
+                            channel_input.begin() + static_cast<std::ptrdiff_t>(consumed_frames));
+    }
+
+    _position -= static_cast<uint64_t>(consumed_frames) << FRACTION_BITS;
+}
+
+ar::core::audio_resampler::simd_level ar::core::audio_resampler::get_simd_level() const
+{
+    return _simd;
+}
+
+ar::core::audio_resampler::simd_level ar::core::audio_resampler::get_best_simd_level()
+{
+#if defined(AR_RESAMPLER_AVX) && (defined(__GNUC__) || defined(__clang__))
+    if (__builtin_cpu_supports("avx"))
+    {
+        return simd_level::avx;
+    }
+#elif defined(AR_RESAMPLER_AVX)
+    return simd_level::avx;
+#endif
+
+#ifdef AR_RESAMPLER_SSE
+    return simd_level::sse;
+#else
+    return simd_level::none;
+#endif
+}
+
+std::string ar::core::audio_resampler::get_simd_level_name(ar::core::audio_resampler::simd_level simd)
+{
+    switch (simd)
+    {
+        case simd_level::sse:
+            return "SSE";
+
+        case simd_level::avx:
+            return "AVX";
+
+        default:
+            return "None";
+    }
+}
+
+void ar::core::audio_resampler::build_filter(double cutoff)
+{
+    _cutoff = cutoff;
+    _coefficients.assign((PHASES + 1) * TAPS, 0.0f);
+
+    constexpr double HALF_WIDTH = TAPS / 2;
+
+    for (std::size_t phase = 0; phase <= PHASES; phase++)
+    {
+        double fraction = static_cast<double>(phase) / PHASES;
+        double sum      = 0.0;
+
+        std::vector<double> row(TAPS);
+        for (std::size_t tap = 0; tap < TAPS; tap++)
+        {
+            // Distance of the tap from the output position, which lies between the two middle taps
+            double x = static_cast<double>(tap) - (HALF_WIDTH - 1) - fraction;
+
+            double sinc = x == 0.0 ? 1.0 : std::sin(std::numbers::pi * cutoff * x) / (std::numbers::pi * cutoff * x);
+
+            // Blackman window, goes to 0 at both ends of the filter
+            double u      = x / HALF_WIDTH;
+            double window = 0.42 + 0.5 * std::cos(std::numbers::pi * u) + 0.08 * std::cos(2.0 * std::numbers::pi * u);
+
+            row[tap] = cutoff * sinc * window;
+            sum += row[tap];
+        }
+
+        // Normalise so that each phase passes constant signal unchanged
+        for (std::size_t tap = 0; tap < TAPS; tap++)
+        {
+            _coefficients[phase * TAPS + tap] = static_cast<float>(row[tap] / sum);
+        }
+    }
+}
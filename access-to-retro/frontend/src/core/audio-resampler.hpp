@@ -0,0 +1,151 @@
+/**
+ * @file core/audio-resampler.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_FRONTEND_AUDIO_RESAMPLER_HPP
+#define ACCESS_TO_RETRO_FRONTEND_AUDIO_RESAMPLER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ar::core
+{
+    /**
+     * @brief Converts interleaved float audio from virtual console's sample rate to audio device's sample rate
+     * @details Works on a pull basis: caller asks how many input frames are needed for the requested number of output
+     *          frames, pushes them and then reads the output. Unused input frames are kept for the next block so the
+     *          output is continuous across blocks.
+     *
+     *          Each output frame is a dot product of 'TAPS' input frames with a windowed-sinc filter. The filter is
+     *          precomputed for 'PHASES' fractional positions between two input frames (polyphase filter bank), output
+     *          at any position is interpolated between the two closest phases so the ratio can be any fraction.
+     *          Position in the input is tracked using 32.32 fixed point so that the number of required input frames is
+     *          always computed exactly the same way as they are later consumed.
+     */
+    class audio_resampler
+    {
+    public:
+        /// @brief Instruction sets that the filter's dot product can use
+        enum class simd_level
+        {
+            /// @brief Plain C++
+            none,
+
+            /// @brief SSE, 4 taps at once
+            sse,
+
+            /// @brief AVX, 8 taps at once
+            avx
+        };
+
+        /// @brief Number of input frames used for each output frame, multiple of 8 so that AVX needs no remainder loop
+        static constexpr std::size_t TAPS = 32;
+
+        /// @brief Number of precomputed fractional positions between two input frames
+        static constexpr std::size_t PHASES = 256;
+
+        /**
+         * @brief Default constructor
+         * @param channels Number of interleaved channels
+         * @param max_input_frames Maximum number of input frames that will be pushed per block, memory is allocated
+         *                         upfront so that the resampler never allocates in the audio callback
+         * @param simd Instruction set used by the filter, best supported one is used if it's not supported
+         */
+        audio_resampler(uint32_t channels, std::size_t max_input_frames,
+                        simd_level simd = simd_level::avx);
+
+        /**
+         * @brief Set conversion ratio
+         * @remark Can be changed between any two blocks without glitches, the filter is only rebuilt when its cutoff
+         *         has to change noticeably (large ratio changes while downsampling)
+         * @param input_rate Sample rate of the input (virtual console)
+         * @param output_rate Sample rate of the output (audio device)
+         */
+        void set_rates(double input_rate, double output_rate);
+
+        /**
+         * @brief Get number of input frames that have to be pushed before reading given number of output frames
+         * @param output_frames Number of output frames that will be read
+         * @return Number of input frames to push, can be 0
+         */
+        [[nodiscard]] std::size_t get_required_input_frames(std::size_t output_frames) const;
+
+        /**
+         * @brief Push input frames
+         * @param frames Interleaved input frames
+         * @param frame_count Number of frames
+         */
+        void push_input(const float* frames, std::size_t frame_count);
+
+        /**
+         * @brief Read resampled output frames
+         * @warning 'get_required_input_frames' worth of frames must be pushed before reading
+         * @param out Buffer for interleaved output frames
+         * @param frame_count Number of output frames to read
+         */
+        void read_output(float* out, std::size_t frame_count);
+
+        /**
+         * @brief Get instruction set used by the filter
+         * @return Instruction set that is actually used
+         */
+        [[nodiscard]] simd_level get_simd_level() const;
+
+        /**
+         * @brief Get best instruction set supported by this CPU and build
+         * @return Best supported instruction set
+         */
+        [[nodiscard]] static simd_level get_best_simd_level();
+
+        /**
+         * @brief Get name of the instruction set, for logging
+         * @param simd Instruction set
+         * @return Name of the instruction set
+         */
+        [[nodiscard]] static std::string get_simd_level_name(simd_level simd);
+
+    private:
+        /// @brief Function computing dot product of 'TAPS' input samples and 'TAPS' filter coefficients
+        typedef float(* dot_product_fn)(const float*, const float*);
+
+        /// @brief Number of fractional bits of the fixed point position
+        static constexpr uint32_t FRACTION_BITS = 32;
+
+        /// @brief Number of fractional bits used to select the phase
+        static constexpr uint32_t PHASE_BITS = 8;
+
+        /// @brief Number of interleaved channels
+        uint32_t _channels;
+
+        /// @brief Instruction set used by '_dot_product_fn'
+        simd_level _simd;
+
+        /// @brief Dot product implementation for '_simd'
+        dot_product_fn _dot_product_fn;
+
+        /// @brief Input frames advanced per output frame (input rate / output rate) in fixed point
+        uint64_t _step = uint64_t { 1 } << FRACTION_BITS;
+
+        /// @brief Position of the first input frame of the next output frame's filter window in fixed point
+        uint64_t _position = 0;
+
+        /// @brief Cutoff frequency of the current filter, relative to input's Nyquist frequency
+        double _cutoff = 0.0;
+
+        /// @brief Filter coefficients, 'PHASES' + 1 rows of 'TAPS' coefficients (last row is the next frame's phase 0)
+        std::vector<float> _coefficients;
+
+        /// @brief Buffered input frames, one vector per channel so that the filter window is contiguous
+        std::vector<std::vector<float>> _input;
+
+        /**
+         * @brief Precompute the filter bank
+         * @param cutoff Cutoff frequency relative to input's Nyquist frequency
+         */
+        void build_filter(double cutoff);
+    };
+}
+
+#endif //ACCESS_TO_RETRO_FRONTEND_AUDIO_RESAMPLER_HPP
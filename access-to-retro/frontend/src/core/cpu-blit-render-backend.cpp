@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <cstring>
+#include "error/os-error.hpp"
+#include "frame-scaler.hpp"
+#include "cpu-blit-render-backend.hpp"
+
+/****************************************************************************************************
+ Helpers
+****************************************************************************************************/
+
+/**
+ * @brief Check whether the blitter can write into surface's pixel format
+ * @param format SDL pixel format of the surface
+ * @param swap Set to whether red and blue channels have to be swapped
+ * @return Whether the format is a 32-bit format that the blitter supports
+ */
+static bool get_red_blue_swap(Uint32 format, bool& swap)
+{
+    // Packed formats are stored in memory in reverse order on little endian
+    if (SDL_BYTEORDER != SDL_LIL_ENDIAN)
+    {
+        return false;
+    }
+
+    switch (format)
+    {
+        case SDL_PIXELFORMAT_RGB888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            swap = true;
+            return true;
+
+        case SDL_PIXELFORMAT_BGR888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            swap = false;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/****************************************************************************************************
+ cpu_blit_render_backend
+****************************************************************************************************/
+
+ar::core::cpu_blit_render_backend::cpu_blit_render_backend(SDL_Window* window) :
+        _window(window)
+{
+    if (SDL_GetWindowSurface(_window) == nullptr)
+    {
+        throw ar::error::os_error("Unable to get window surface for " + get_name() + ". Error: " +
+                                  std::string(SDL_GetError()));
+    }
+}
+
+void* ar::core::cpu_blit_render_backend::lock_frame(uint32_t width, uint32_t height, std::size_t& pitch)
+{
+    if (_frame_width != width || _frame_height != height)
+    {
+        _frame.assign(static_cast<std::size_t>(width) * height, 0);
+
+        _frame_width  = width;
+        _frame_height = height;
+    }
+
+    pitch = width * sizeof(uint32_t);
+
+    return _frame.data();
+}
+
+void ar::core::cpu_blit_render_backend::unlock_frame()
+{
+    // Frame is only read in 'present'
+}
+
+void ar::core::cpu_blit_render_backend::present()
+{
+    // Surface gets recreated by SDL when the window is resized
+    SDL_Surface* surface = SDL_GetWindowSurface(_window);
+    if (surface == nullptr || _frame.empty())
+    {
+        return;
+    }
+
+    // Borders never change between presents, only clear them when the surface changes
+    if (surface != _cleared_surface || surface->w != _cleared_surface_width || surface->h != _cleared_surface_height)
+    {
+        SDL_FillRect(surface, nullptr, 0);
+
+        _cleared_surface        = surface;
+        _cleared_surface_width  = surface->w;
+        _cleared_surface_height = surface->h;
+    }
+
+    uint32_t scale = std::min(static_cast<uint32_t>(surface->w) / _frame_width,
+                              static_cast<uint32_t>(surface->h) / _frame_height);
+
+    bool swap = false;
+    if (scale == 0 || !get_red_blue_swap(surface->format->format, swap))
+    {
+        present_using_sdl_blit(surface);
+        SDL_UpdateWindowSurface(_window);
+
+        return;
+    }
+
+    if (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) != 0)
+    {
+        return;
+    }
+
+    uint32_t scaled_width = _frame_width * scale;
+    std::size_t row_size  = scaled_width * sizeof(uint32_t);
+
+    _scaled_row.resize(scaled_width + ar::core::frame_scaler::ROW_PADDING);
+
+    // Center the frame, the rest of the surface is the cleared border
+    std::size_t offset_x = (static_cast<uint32_t>(surface->w) - scaled_width) / 2;
+    std::size_t offset_y = (static_cast<uint32_t>(surface->h) - _frame_height * scale) / 2;
+
+    auto* surface_pixels = static_cast<uint8_t*>(surface->pixels);
+    auto surface_pitch   = static_cast<std::size_t>(surface->pitch);
+
+    for (uint32_t y = 0; y < _frame_height; y++)
+    {
+        // Scale the row once and copy it 'scale' times vertically
+        ar::core::frame_scaler::replicate_row(_frame.data() + static_cast<std::size_t>(y) * _frame_width,
+                                              _scaled_row.data(), _frame_width, scale, swap);
+
+        for (uint32_t repeat = 0; repeat < scale; repeat++)
+        {
+            std::size_t output_y = offset_y + static_cast<std::size_t>(y) * scale + repeat;
+
+            std::memcpy(surface_pixels + output_y * surface_pitch + offset_x * sizeof(uint32_t), _scaled_row.data(),
+                        row_size);
+        }
+    }
+
+    if (SDL_MUSTLOCK(surface))
+    {
+        SDL_UnlockSurface(surface);
+    }
+
+    SDL_UpdateWindowSurface(_window);
+}
+
+std::string ar::core::cpu_blit_render_backend::get_name() const
+{
+    return ar::core::render_backend::get_type_name(render_backend_type::cpu_blitter);
+}
+
+void ar::core::cpu_blit_render_backend::get_output_size(uint32_t& width, uint32_t& height)
+{
+    SDL_Surface* surface = SDL_GetWindowSurface(_window);
+
+    width  = surface != nullptr ? static_cast<uint32_t>(surface->w) : 0;
+    height = surface != nullptr ? static_cast<uint32_t>(surface->h) : 0;
+}
+
+void ar::core::cpu_blit_render_backend::present_using_sdl_blit(SDL_Surface* surface)
+{
+    SDL_Surface* frame_surface = SDL_CreateRGBSurfaceWithFormatFrom(_frame.data(), static_cast<int>(_frame_width),
+                                                                    static_cast<int>(_frame_height), 32,
+                                                                    static_cast<int>(_frame_width * sizeof(uint32_t)),
+                                                                    SDL_PIXELFORMAT_RGBA32);
+    if (frame_surface == nullptr)
+    {
+        return;
+    }
+
+    SDL_Rect destination = get_letterbox(_frame_width, _frame_height, static_cast<uint32_t>(surface->w),
+                                         static_cast<uint32_t>(surface->h));
+
+    SDL_BlitScaled(frame_surface, nullptr, surface, &destination);
+    SDL_FreeSurface(frame_surface);
+}
@@ -0,0 +1,74 @@
+/**
+ * @file core/cpu-blit-render-backend.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_FRONTEND_CPU_BLIT_RENDER_BACKEND_HPP
+#define ACCESS_TO_RETRO_FRONTEND_CPU_BLIT_RENDER_BACKEND_HPP
+
+#include <vector>
+#include "render-backend.hpp"
+
+namespace ar::core
+{
+    /**
+     * @brief Render backend that scales frames on the CPU straight into the window surface
+     * @details Meant for machines without a usable GPU where SDL's accelerated renderer falls back to slow paths. Frame
+     *          is scaled by the largest integer factor that fits the window ('frame_scaler::replicate_row'), centered and
+     *          written directly in window surface's pixel format, so presenting is a single pass over the output.
+     *          Window surfaces in other formats or smaller than the frame go through SDL's scaled blit instead.
+     */
+    class cpu_blit_render_backend : public render_backend
+    {
+    public:
+        /**
+         * @brief Default constructor
+         * @param window Window that the frames will be shown in
+         * @throws Exceptions:
+         *  - ar::error::os_error: When window's surface could not be obtained
+         */
+        explicit cpu_blit_render_backend(SDL_Window* window);
+
+        void* lock_frame(uint32_t width, uint32_t height, std::size_t& pitch) override;
+
+        void unlock_frame() override;
+
+        void present() override;
+
+        [[nodiscard]] std::string get_name() const override;
+
+        void get_output_size(uint32_t& width, uint32_t& height) override;
+
+    private:
+        /// @brief Window that the frames are shown in
+        SDL_Window* _window;
+
+        /// @brief Last frame as packed 'ar_pixel' values
+        std::vector<uint32_t> _frame;
+
+        /// @brief Width of '_frame'
+        uint32_t _frame_width = 0;
+
+        /// @brief Height of '_frame'
+        uint32_t _frame_height = 0;
+
+        /// @brief Single scaled row, copied into the surface once per output row
+        std::vector<uint32_t> _scaled_row;
+
+        /// @brief Window surface that was cleared last, surface changes when the window is resized
+        SDL_Surface* _cleared_surface = nullptr;
+
+        /// @brief Width of '_cleared_surface'
+        int _cleared_surface_width = 0;
+
+        /// @brief Height of '_cleared_surface'
+        int _cleared_surface_height = 0;
+
+        /**
+         * @brief Show the frame using SDL's scaled blit, used for surfaces that the blitter does not handle
+         * @param surface Window surface
+         */
+        void present_using_sdl_blit(SDL_Surface* surface);
+    };
+}
+
+#endif //ACCESS_TO_RETRO_FRONTEND_CPU_BLIT_RENDER_BACKEND_HPP
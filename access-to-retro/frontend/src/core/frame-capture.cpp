@@ -0,0 +1,436 @@
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include "error/io-error.hpp"
+#include "util/logger.hpp"
+#include "frame-capture.hpp"
+
+/****************************************************************************************************
+ Helpers
+****************************************************************************************************/
+
+/// @brief Largest payload of a single stored deflate block
+static constexpr std::size_t PNG_STORED_BLOCK_SIZE = 65535;
+
+/// @brief FNV-1a 64-bit offset basis
+static constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+
+/// @brief FNV-1a 64-bit prime
+static constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+/**
+ * @brief Append a 32-bit value in big endian byte order
+ * @param data Data to append to
+ * @param value Value to append
+ */
+static void append_big_endian(std::vector<uint8_t>& data, uint32_t value)
+{
+    data.push_back(static_cast<uint8_t>(value >> 24));
+    data.push_back(static_cast<uint8_t>(value >> 16));
+    data.push_back(static_cast<uint8_t>(value >> 8));
+    data.push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * @brief Get CRC-32 of PNG chunk data (polynomial 0xEDB88320)
+ * @param data Data to checksum
+ * @param size Number of bytes
+ * @return CRC-32 of the data
+ */
+static uint32_t get_crc32(const uint8_t* data, std::size_t size)
+{
+    static const std::array<uint32_t, 256> table = []
+    {
+        std::array<uint32_t, 256> values {};
+
+        for (uint32_t i = 0; i < values.size(); i++)
+        {
+            uint32_t value = i;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                value = (value & 1) != 0 ? 0xEDB88320 ^ (value >> 1) : value >> 1;
+            }
+
+            values[i] = value;
+        }
+
+        return values;
+    }();
+
+    uint32_t crc = 0xFFFFFFFF;
+    for (std::size_t i = 0; i < size; i++)
+    {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+
+    return crc ^ 0xFFFFFFFF;
+}
+
+/**
+ * @brief Get Adler-32 checksum of zlib stream's uncompressed data
+ * @param data Data to checksum
+ * @param size Number of bytes
+ * @return Adler-32 of the data
+ */
+static uint32_t get_adler32(const uint8_t* data, std::size_t size)
+{
+    constexpr uint32_t MODULO = 65521;
+
+    uint32_t a = 1;
+    uint32_t b = 0;
+
+    for (std::size_t i = 0; i < size; i++)
+    {
+        a = (a + data[i]) % MODULO;
+        b = (b + a) % MODULO;
+    }
+
+    return (b << 16) | a;
+}
+
+/**
+ * @brief Write a PNG chunk
+ * @param stream Stream to write into
+ * @param type 4 character chunk type
+ * @param data Chunk data
+ */
+static void write_png_chunk(std::ofstream& stream, const char* type, const std::vector<uint8_t>& data)
+{
+    // CRC covers the type and the data
+    std::vector<uint8_t> chunk(type, type + 4);
+    chunk.insert(chunk.end(), data.begin(), data.end());
+
+    std::vector<uint8_t> length;
+    append_big_endian(length, static_cast<uint32_t>(data.size()));
+
+    std::vector<uint8_t> crc;
+    append_big_endian(crc, get_crc32(chunk.data(), chunk.size()));
+
+    stream.write(reinterpret_cast<const char*>(length.data()), static_cast<std::streamsize>(length.size()));
+    stream.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+    stream.write(reinterpret_cast<const char*>(crc.data()), static_cast<std::streamsize>(crc.size()));
+}
+
+/****************************************************************************************************
+ frame_capture
+****************************************************************************************************/
+
+ar::core::frame_capture::frame_capture(const std::filesystem::path& directory, ar::core::capture_format format,
+                                       double frame_rate) :
+        _directory(directory),
+        _format(format),
+        _frame_rate(frame_rate)
+{
+    std::error_code error;
+    std::filesystem::create_directories(_directory, error);
+    if (error)
+    {
+        throw ar::error::io_error(_directory.string(), "Unable to create capture directory: " + error.message());
+    }
+
+    _hash_log.open(_directory / "frames.hash", std::ios::out | std::ios::trunc);
+    if (!_hash_log.is_open())
+    {
+        throw ar::error::io_error((_directory / "frames.hash").string(), "Unable to create frame hash log");
+    }
+
+    _hash_log << "# <frame index> <FNV-1a 64-bit hash of R, G, B, A bytes>\n";
+
+    // Whole pool is allocated up front, 'capture' only resizes the pixels when the frame size changes
+    for (std::size_t i = 0; i < POOL_SIZE; i++)
+    {
+        _free_frames.push_back(std::make_unique<captured_frame>());
+    }
+
+    _writer_thread = std::make_unique<std::thread>([this] { write_loop(); });
+
+    LOG_INFO("Capturing frames (" + get_format_name(_format) + ") into '" + _directory.string() + "'");
+}
+
+ar::core::frame_capture::~frame_capture()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+
+    _queued_condition.notify_one();
+    _writer_thread->join();
+
+    LOG_INFO("Frame capture finished: " + std::to_string(_written_frames) + " of " +
+             std::to_string(_presented_frames) + " presented frames written, " + std::to_string(_dropped_frames) +
+             " dropped");
+}
+
+void ar::core::frame_capture::capture(const ar_frame_buffer* frame_buffer)
+{
+    uint64_t index = _presented_frames++;
+
+    std::unique_ptr<captured_frame> frame;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_free_frames.empty())
+        {
+            _dropped_frames++;
+            return;
+        }
+
+        frame = std::move(_free_frames.back());
+        _free_frames.pop_back();
+    }
+
+    // Copy happens outside of the lock, writer can keep taking other frames meanwhile
+    frame->index  = index;
+    frame->format = frame_buffer->format;
+    frame->width  = frame_buffer->width;
+    frame->height = frame_buffer->height;
+    frame->pitch  = frame_buffer->pitch;
+
+    std::size_t frame_size = frame->pitch * frame->height;
+    frame->pixels.resize(frame_size);
+
+    std::memcpy(frame->pixels.data(), frame_buffer->data, frame_size);
+    std::copy(std::begin(frame_buffer->palette), std::end(frame_buffer->palette), frame->palette.begin());
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queued_frames.push_back(std::move(frame));
+    }
+
+    _queued_condition.notify_one();
+}
+
+uint64_t ar::core::frame_capture::get_presented_frame_count() const
+{
+    return _presented_frames;
+}
+
+uint64_t ar::core::frame_capture::get_dropped_frame_count() const
+{
+    return _dropped_frames;
+}
+
+uint64_t ar::core::frame_capture::get_written_frame_count() const
+{
+    return _written_frames;
+}
+
+uint64_t ar::core::frame_capture::get_frame_hash(const ar_pixel* pixels, std::size_t pixel_count)
+{
+    const auto* bytes = reinterpret_cast<const uint8_t*>(pixels);
+    uint64_t hash     = FNV_OFFSET_BASIS;
+
+    for (std::size_t i = 0; i < pixel_count * sizeof(ar_pixel); i++)
+    {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+
+    return hash;
+}
+
+std::string ar::core::frame_capture::get_format_name(ar::core::capture_format format)
+{
+    switch (format)
+    {
+        case capture_format::hashes:
+            return "hashes only";
+
+        case capture_format::ppm:
+            return "PPM sequence";
+
+        case capture_format::y4m:
+            return "Y4M stream";
+
+        case capture_format::png:
+            return "PNG sequence";
+
+        case capture_format::disabled:
+        default:
+            return "disabled";
+    }
+}
+
+void ar::core::frame_capture::write_loop()
+{
+    while (true)
+    {
+        std::unique_ptr<captured_frame> frame;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _queued_condition.wait(lock, [this] { return _stop || !_queued_frames.empty(); });
+
+            // Queue is drained before stopping so that nothing that was captured gets lost
+            if (_queued_frames.empty())
+            {
+                return;
+            }
+
+            frame = std::move(_queued_frames.front());
+            _queued_frames.pop_front();
+        }
+
+        write_frame(*frame);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _free_frames.push_back(std::move(frame));
+        }
+
+        _written_frames++;
+    }
+}
+
+void ar::core::frame_capture::write_frame(const captured_frame& frame)
+{
+    _converted_frame.resize(static_cast<std::size_t>(frame.width) * frame.height);
+
+    _pixel_converter.convert(frame.format, frame.pixels.data(), frame.pitch, frame.palette.data(), frame.width,
+                             frame.height, _converted_frame.data(), frame.width * sizeof(ar_pixel));
+
+    _hash_log << frame.index << " " << std::hex << std::setw(16) << std::setfill('0')
+              << get_frame_hash(_converted_frame.data(), _converted_frame.size()) << std::dec << "\n";
+
+    switch (_format)
+    {
+        case capture_format::ppm:
+            write_ppm(get_frame_path(frame.index, ".ppm"), frame.width, frame.height);
+            break;
+
+        case capture_format::y4m:
+            write_y4m(frame.index, frame.width, frame.height);
+            break;
+
+        case capture_format::png:
+            write_png(get_frame_path(frame.index, ".png"), frame.width, frame.height);
+            break;
+
+        default:
+            break;
+    }
+}
+
+void ar::core::frame_capture::write_ppm(const std::filesystem::path& path, uint32_t width, uint32_t height)
+{
+    std::ofstream stream(path, std::ios::out | std::ios::binary);
+
+    stream << "P6\n" << width << " " << height << "\n255\n";
+
+    std::vector<uint8_t> row(static_cast<std::size_t>(width) * 3);
+    for (uint32_t y = 0; y < height; y++)
+    {
+        const ar_pixel* pixels = _converted_frame.data() + static_cast<std::size_t>(y) * width;
+
+        for (uint32_t x = 0; x < width; x++)
+        {
+            row[x * 3]     = pixels[x].r;
+            row[x * 3 + 1] = pixels[x].g;
+            row[x * 3 + 2] = pixels[x].b;
+        }
+
+        stream.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(row.size()));
+    }
+}
+
+void ar::core::frame_capture::write_y4m(uint64_t index, uint32_t width, uint32_t height)
+{
+    if (!_y4m_stream.is_open() || _y4m_width != width || _y4m_height != height)
+    {
+        _y4m_stream.close();
+        _y4m_stream.open(get_frame_path(index, ".y4m"), std::ios::out | std::ios::binary);
+
+        _y4m_width  = width;
+        _y4m_height = height;
+
+        // Frame rate is written as a fraction with millisecond precision
+        auto frame_rate = static_cast<uint64_t>(_frame_rate * 1000.0);
+
+        _y4m_stream << "YUV4MPEG2 W" << width << " H" << height << " F" << frame_rate << ":1000 Ip A1:1 C444"
+                    << " XCOLORRANGE=FULL\n";
+    }
+
+    std::size_t plane_size = static_cast<std::size_t>(width) * height;
+    std::vector<uint8_t> planes(plane_size * 3);
+
+    // Full range BT.601 (JFIF), coefficients scaled by 2^16
+    for (std::size_t i = 0; i < plane_size; i++)
+    {
+        auto r = static_cast<int32_t>(_converted_frame[i].r);
+        auto g = static_cast<int32_t>(_converted_frame[i].g);
+        auto b = static_cast<int32_t>(_converted_frame[i].b);
+
+        int32_t y  = (19595 * r + 38470 * g + 7471 * b + 32768) >> 16;
+        int32_t cb = ((-11059 * r - 21709 * g + 32768 * b + 32768) >> 16) + 128;
+        int32_t cr = ((32768 * r - 27439 * g - 5329 * b + 32768) >> 16) + 128;
+
+        planes[i]                  = static_cast<uint8_t>(std::clamp(y, 0, 255));
+        planes[plane_size + i]     = static_cast<uint8_t>(std::clamp(cb, 0, 255));
+        planes[plane_size * 2 + i] = static_cast<uint8_t>(std::clamp(cr, 0, 255));
+    }
+
+    _y4m_stream << "FRAME\n";
+    _y4m_stream.write(reinterpret_cast<const char*>(planes.data()), static_cast<std::streamsize>(planes.size()));
+}
+
+void ar::core::frame_capture::write_png(const std::filesystem::path& path, uint32_t width, uint32_t height)
+{
+    std::ofstream stream(path, std::ios::out | std::ios::binary);
+
+    const uint8_t signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    stream.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+    // 8 bits per channel RGBA, no interlacing
+    std::vector<uint8_t> header;
+    append_big_endian(header, width);
+    append_big_endian(header, height);
+    header.insert(header.end(), { 8, 6, 0, 0, 0 });
+
+    write_png_chunk(stream, "IHDR", header);
+
+    // Each row starts with filter type 0 (none)
+    std::size_t row_size = static_cast<std::size_t>(width) * sizeof(ar_pixel);
+    std::vector<uint8_t> raw((row_size + 1) * height);
+
+    for (uint32_t y = 0; y < height; y++)
+    {
+        raw[y * (row_size + 1)] = 0;
+        std::memcpy(raw.data() + y * (row_size + 1) + 1, _converted_frame.data() + static_cast<std::size_t>(y) * width,
+                    row_size);
+    }
+
+    // zlib stream made of stored deflate blocks, fast to write and readable by anything
+    std::vector<uint8_t> image_data = { 0x78, 0x01 };
+
+    for (std::size_t offset = 0; offset < raw.size() || offset == 0; offset += PNG_STORED_BLOCK_SIZE)
+    {
+        auto block_size = static_cast<uint16_t>(std::min(PNG_STORED_BLOCK_SIZE, raw.size() - offset));
+        bool last_block = offset + block_size >= raw.size();
+
+        image_data.push_back(last_block ? 1 : 0);
+        image_data.push_back(static_cast<uint8_t>(block_size));
+        image_data.push_back(static_cast<uint8_t>(block_size >> 8));
+        image_data.push_back(static_cast<uint8_t>(~block_size));
+        image_data.push_back(static_cast<uint8_t>(~block_size >> 8));
+        image_data.insert(image_data.end(), raw.begin() + static_cast<std::ptrdiff_t>(offset),
+                          raw.begin() + static_cast<std::ptrdiff_t>(offset + block_size));
+
+        if (last_block)
+        {
+            break;
+        }
+    }
+
+    append_big_endian(image_data, get_adler32(raw.data(), raw.size()));
+
+    write_png_chunk(stream, "IDAT", image_data);
+    write_png_chunk(stream, "IEND", {});
+}
+
+std::filesystem::path ar::core::frame_capture::get_frame_path(uint64_t index, const std::string& extension) const
+{
+    std::ostringstream name;
+    name << "frame-" << std::setw(8) << std::setfill('0') << index << extension;
+
+    return _directory / name.str();
+}
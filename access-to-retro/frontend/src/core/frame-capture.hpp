@@ -0,0 +1,234 @@
+/**
+ * @file core/frame-capture.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_FRONTEND_FRAME_CAPTURE_HPP
+#define ACCESS_TO_RETRO_FRONTEND_FRAME_CAPTURE_HPP
+
+#include <access-to-retro-dev/access-to-retro-dev.h>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <vector>
+#include <array>
+#include <string>
+#include "pixel-converter.hpp"
+
+namespace ar::core
+{
+    /// @brief What gets written for captured frames, value is the index stored in "frame_capture" setting
+    enum class capture_format
+    {
+        /// @brief Nothing is captured
+        disabled = 0,
+
+        /// @brief Only the hash log
+        hashes = 1,
+
+        /// @brief Binary PPM file per frame
+        ppm = 2,
+
+        /// @brief Single YUV4MPEG2 stream (4:4:4, full range), new file whenever the frame size changes
+        y4m = 3,
+
+        /// @brief Uncompressed PNG file per frame
+        png = 4
+    };
+
+    /**
+     * @brief Records presented frames to disk without blocking the virtual console
+     * @details 'capture' runs on virtual console's thread, it copies the frame into a buffer from a fixed pool and
+     *          queues it. Writer thread converts queued frames to 'ar_pixel', hashes them and writes them out. If the
+     *          writer falls behind and the pool runs out the frame is dropped and counted, the hash log then has a gap
+     *          in frame indices. Every format also writes the hash log ('frames.hash', "<frame index> <hash>" lines).
+     */
+    class frame_capture
+    {
+    public:
+        /**
+         * @brief Default constructor, creates the output directory and starts the writer thread
+         * @param directory Directory that the files will be written into, created if it does not exist
+         * @param format What to write for each frame, cannot be 'capture_format::disabled'
+         * @param frame_rate Frame rate written into Y4M headers
+         * @throws Exceptions:
+         *  - ar::error::io_error: When the directory or the hash log could not be created
+         */
+        frame_capture(const std::filesystem::path& directory, capture_format format, double frame_rate);
+
+        /// @brief Writes out queued frames, stops the writer thread and logs the counters
+        ~frame_capture();
+
+        frame_capture(const frame_capture&) = delete;
+        frame_capture& operator=(const frame_capture&) = delete;
+
+        /**
+         * @brief Queue a presented frame, never waits for the writer
+         * @param frame_buffer Frame buffer right after 'ar_graphics_present', its pixels are the presented frame
+         */
+        void capture(const ar_frame_buffer* frame_buffer);
+
+        /**
+         * @brief Get number of frames passed to 'capture'
+         * @return Number of presented frames
+         */
+        [[nodiscard]] uint64_t get_presented_frame_count() const;
+
+        /**
+         * @brief Get number of frames dropped because the writer fell behind
+         * @return Number of dropped frames
+         */
+        [[nodiscard]] uint64_t get_dropped_frame_count() const;
+
+        /**
+         * @brief Get number of frames written so far
+         * @return Number of written frames
+         */
+        [[nodiscard]] uint64_t get_written_frame_count() const;
+
+        /**
+         * @brief Hash a converted frame, same value as written into the hash log
+         * @param pixels Frame pixels, rows are tightly packed
+         * @param pixel_count Number of pixels
+         * @return 64-bit FNV-1a hash of the pixels
+         */
+        [[nodiscard]] static uint64_t get_frame_hash(const ar_pixel* pixels, std::size_t pixel_count);
+
+        /**
+         * @brief Get name of the format, for logging
+         * @param format Capture format
+         * @return Name of the format
+         */
+        [[nodiscard]] static std::string get_format_name(capture_format format);
+
+    private:
+        /// @brief Copy of a presented frame in virtual console's pixel format
+        struct captured_frame
+        {
+            /// @brief Index of the frame among presented frames
+            uint64_t index = 0;
+
+            /// @brief Format of 'pixels'
+            ar_pixel_format format = ar_pixel_format_rgba8888;
+
+            /// @brief Width of the frame
+            uint32_t width = 0;
+
+            /// @brief Height of the frame
+            uint32_t height = 0;
+
+            /// @brief Number of bytes between the starts of two rows
+            std::size_t pitch = 0;
+
+            /// @brief Frame pixels
+            std::vector<uint8_t> pixels;
+
+            /// @brief Palette presented with the frame
+            std::array<ar_pixel, AR_PALETTE_SIZE> palette {};
+        };
+
+        /// @brief Number of frames that can wait for the writer, a second at 60 frames per second
+        static constexpr std::size_t POOL_SIZE = 60;
+
+        /// @brief Directory that the files are written into
+        std::filesystem::path _directory;
+
+        /// @brief What gets written for each frame
+        capture_format _format;
+
+        /// @brief Frame rate written into Y4M headers
+        double _frame_rate;
+
+        /// @brief Hash log
+        std::ofstream _hash_log;
+
+        /// @brief Current Y4M stream
+        std::ofstream _y4m_stream;
+
+        /// @brief Width of frames in '_y4m_stream'
+        uint32_t _y4m_width = 0;
+
+        /// @brief Height of frames in '_y4m_stream'
+        uint32_t _y4m_height = 0;
+
+        /// @brief Converts captured frames to 'ar_pixel', only used by the writer thread
+        ar::core::pixel_converter _pixel_converter;
+
+        /// @brief Last converted frame
+        std::vector<ar_pixel> _converted_frame;
+
+        /// @brief Buffers that are not queued
+        std::vector<std::unique_ptr<captured_frame>> _free_frames;
+
+        /// @brief Frames waiting for the writer, oldest first
+        std::deque<std::unique_ptr<captured_frame>> _queued_frames;
+
+        /// @brief Protects '_free_frames', '_queued_frames' and '_stop', never held during I/O
+        std::mutex _mutex;
+
+        /// @brief Wakes up the writer thread
+        std::condition_variable _queued_condition;
+
+        /// @brief Whether the writer thread should stop once the queue is empty
+        bool _stop = false;
+
+        /// @brief Writer thread object
+        std::unique_ptr<std::thread> _writer_thread = nullptr;
+
+        /// @brief Number of frames passed to 'capture'
+        std::atomic_uint64_t _presented_frames = 0;
+
+        /// @brief Number of dropped frames
+        std::atomic_uint64_t _dropped_frames = 0;
+
+        /// @brief Number of written frames
+        std::atomic_uint64_t _written_frames = 0;
+
+        /// @brief Writer thread function, writes queued frames until stopped
+        void write_loop();
+
+        /**
+         * @brief Convert, hash and write a single frame
+         * @param frame Frame to write
+         */
+        void write_frame(const captured_frame& frame);
+
+        /**
+         * @brief Write '_converted_frame' as binary PPM file
+         * @param path Path of the file
+         * @param width Width of the frame
+         * @param height Height of the frame
+         */
+        void write_ppm(const std::filesystem::path& path, uint32_t width, uint32_t height);
+
+        /**
+         * @brief Append '_converted_frame' to the Y4M stream, opens a new stream if the size changed
+         * @param index Index of the frame, used to name new streams
+         * @param width Width of the frame
+         * @param height Height of the frame
+         */
+        void write_y4m(uint64_t index, uint32_t width, uint32_t height);
+
+        /**
+         * @brief Write '_converted_frame' as PNG file with stored (uncompressed) deflate blocks
+         * @param path Path of the file
+         * @param width Width of the frame
+         * @param height Height of the frame
+         */
+        void write_png(const std::filesystem::path& path, uint32_t width, uint32_t height);
+
+        /**
+         * @brief Get path of a file written for a single frame
+         * @param index Index of the frame
+         * @param extension File extension including the dot
+         * @return Path of the file
+         */
+        [[nodiscard]] std::filesystem::path get_frame_path(uint64_t index, const std::string& extension) const;
+    };
+}
+
+#endif //ACCESS_TO_RETRO_FRONTEND_FRAME_CAPTURE_HPP
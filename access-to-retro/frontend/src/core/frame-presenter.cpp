@@ -0,0 +1,227 @@
+#include "error/os-error.hpp"
+#include "util/logger.hpp"
+#include "frame-presenter.hpp"
+
+ar::core::frame_presenter::frame_presenter(std::unique_ptr<ar::core::virtual_console>& virtual_console,
+                                           SDL_Window* window, ar::core::render_backend_type backend_type,
+                                           ar::core::frame_scaler::filter scaling_filter) :
+        _window(window),
+        _backend_type(backend_type),
+        _profiler(virtual_console->access_profiler()),
+        _frame_scaler(scaling_filter)
+{
+    _acquire_frame_fn        = virtual_console->get_symbol_from_library<acquire_frame_fn>("ar_graphics_acquire_frame");
+    _get_acquired_palette_fn = virtual_console->get_symbol_from_library<get_acquired_palette_fn>
+            ("ar_graphics_get_acquired_palette");
+    _get_frame_buffer_fn     = virtual_console->get_symbol_from_library<get_frame_buffer_fn>
+            ("ar_graphics_get_frame_buffer");
+    _set_present_callback_fn = virtual_console->get_symbol_from_library<set_present_callback_fn>
+            ("ar_graphics_set_present_callback");
+}
+
+ar::core::frame_presenter::~frame_presenter()
+{
+    stop();
+}
+
+void ar::core::frame_presenter::start()
+{
+    _running = true;
+
+    _set_present_callback_fn(on_frame_presented, this);
+
+    _present_thread = std::make_unique<std::thread>([this] { present_loop(); });
+
+    LOG_DEBUG("core.frame_presenter", "Present thread started");
+}
+
+void ar::core::frame_presenter::stop()
+{
+    if (_present_thread == nullptr)
+    {
+        return;
+    }
+
+    _set_present_callback_fn(nullptr, nullptr);
+
+    _running = false;
+    wake_up();
+
+    _present_thread->join();
+    _present_thread = nullptr;
+
+    LOG_DEBUG("core.frame_presenter", "Present thread stopped");
+}
+
+void ar::core::frame_presenter::request_redraw()
+{
+    _redraw_requested = true;
+    wake_up();
+}
+
+void ar::core::frame_presenter::set_frame_capture(std::unique_ptr<ar::core::frame_capture> frame_capture)
+{
+    _frame_capture = std::move(frame_capture);
+}
+
+void ar::core::frame_presenter::wake_up()
+{
+    {
+        std::lock_guard<std::mutex> lock(_wake_up_mutex);
+        _wake_up = true;
+    }
+
+    _wake_up_condition.notify_one();
+}
+
+std::unique_ptr<ar::core::render_backend> ar::core::frame_presenter::create_render_backend()
+{
+    try
+    {
+        return ar::core::render_backend::create(_backend_type, _window, true);
+    }
+    catch (const ar::error::os_error& ex)
+    {
+        LOG_WARNING(ex.get_error());
+    }
+
+    // Software renderer works everywhere, use it if the selected backend is not available
+    if (_backend_type != ar::core::render_backend_type::software)
+    {
+        try
+        {
+            LOG_WARNING("Falling back to " +
+                        ar::core::render_backend::get_type_name(ar::core::render_backend_type::software) +
+                        " render backend");
+
+            return ar::core::render_backend::create(ar::core::render_backend_type::software, _window, true);
+        }
+        catch (const ar::error::os_error& ex)
+        {
+            LOG_WARNING(ex.get_error());
+        }
+    }
+
+    return nullptr;
+}
+
+void ar::core::frame_presenter::present_loop()
+{
+    _profiler.set_thread_name("present");
+
+    // Backend is created on this thread so that it's only ever used from one thread
+    std::unique_ptr<ar::core::render_backend> backend = create_render_backend();
+    if (backend == nullptr)
+    {
+        LOG_ERROR("Unable to create any render backend, frames will not be shown");
+        return;
+    }
+
+    LOG_DEBUG("core.frame_presenter", "Using " + backend->get_name() + " render backend with " +
+                                      ar::core::frame_scaler::get_filter_name(_frame_scaler.get_filter()) +
+                                      " scaling");
+
+    uint32_t frame_width   = 0;
+    uint32_t frame_height  = 0;
+    uint32_t output_width  = 0;
+    uint32_t output_height = 0;
+    bool has_frame         = false;
+
+    while (_running)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_wake_up_mutex);
+            _wake_up_condition.wait_for(lock, IDLE_WAIT_TIME, [this] { return _wake_up; });
+            _wake_up = false;
+        }
+
+        // Waiting is left out, the zone only shows the work done for each wake up
+        ar::core::profile_zone zone(_profiler, "present thread tick");
+
+        const void* frame = _acquire_frame_fn();
+        if (frame != nullptr)
+        {
+            const ar_frame_buffer* frame_buffer = _get_frame_buffer_fn();
+
+            // Frame buffer size is only known once virtual console has created it
+            if (frame_width != frame_buffer->width || frame_height != frame_buffer->height)
+            {
+                frame_width  = frame_buffer->width;
+                frame_height = frame_buffer->height;
+
+                _converted_frame.assign(static_cast<std::size_t>(frame_width) * frame_height, 0);
+
+                std::size_t frame_size = ar::core::pixel_converter::get_frame_size(frame_buffer->format,
+                                                                                   frame_width, frame_height);
+
+                LOG_DEBUG("core.frame_presenter",
+                          "Presenting " + std::to_string(frame_width) + "x" + std::to_string(frame_height) + " " +
+                          ar::core::pixel_converter::get_pixel_format_name(frame_buffer->format) + " frames (" +
+                          std::to_string(frame_size) + " bytes) converted using " +
+                          ar::core::pixel_converter::get_simd_level_name(_pixel_converter.get_simd_level()));
+            }
+
+            ar::core::profile_zone convert_zone(_profiler, "convert frame");
+            _pixel_converter.convert(frame_buffer->format, frame, frame_buffer->pitch, _get_acquired_palette_fn(),
+                                     frame_width, frame_height, _converted_frame.data(),
+                                     frame_width * sizeof(uint32_t));
+        }
+
+        // Window is resized by the GUI thread, only its new output size is picked up here
+        uint32_t current_output_width  = 0;
+        uint32_t current_output_height = 0;
+        backend->get_output_size(current_output_width, current_output_height);
+
+        bool output_resized = current_output_width != output_width || current_output_height != output_height;
+
+        output_width  = current_output_width;
+        output_height = current_output_height;
+
+        // Scaled frame stays in backend's memory, it only has to be produced again if something changed
+        if (!_converted_frame.empty() && (frame != nullptr || output_resized))
+        {
+            // Backends scaling in a shader only get filter's own factor, replication would just slow the upload
+            uint32_t scale_width  = backend->scales_frames() ? frame_width : output_width;
+            uint32_t scale_height = backend->scales_frames() ? frame_height : output_height;
+
+            uint32_t scaled_width  = 0;
+            uint32_t scaled_height = 0;
+            _frame_scaler.get_scaled_size(frame_width, frame_height, scale_width, scale_height, scaled_width,
+                                          scaled_height);
+
+            std::size_t pitch = 0;
+
+            // Scaler writes straight into backend's memory, rows can be padded on both sides
+            void* pixels = backend->lock_frame(scaled_width, scaled_height, pitch);
+            if (pixels != nullptr)
+            {
+                ar::core::profile_zone scale_zone(_profiler, "scale frame");
+                _frame_scaler.scale(_converted_frame.data(), frame_width, frame_height, scale_width, scale_height,
+                                    pixels, pitch);
+
+                backend->unlock_frame();
+
+                has_frame = true;
+            }
+        }
+
+        if (has_frame && (frame != nullptr || output_resized || _redraw_requested.exchange(false)))
+        {
+            ar::core::profile_zone backend_zone(_profiler, "backend present");
+            backend->present();
+        }
+    }
+}
+
+void ar::core::frame_presenter::on_frame_presented(void* user_data)
+{
+    auto* presenter = static_cast<ar::core::frame_presenter*>(user_data);
+
+    // Frame buffer's back buffer still holds a copy of the frame that was just presented
+    if (presenter->_frame_capture != nullptr)
+    {
+        presenter->_frame_capture->capture(presenter->_get_frame_buffer_fn());
+    }
+
+    presenter->wake_up();
+}
@@ -0,0 +1,164 @@
+/**
+ * @file core/frame-presenter.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_FRONTEND_FRAME_PRESENTER_HPP
+#define ACCESS_TO_RETRO_FRONTEND_FRAME_PRESENTER_HPP
+
+#include <access-to-retro-dev/access-to-retro-dev.h>
+#include <condition_variable>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <SDL.h>
+#include "virtual-console.hpp"
+#include "pixel-converter.hpp"
+#include "frame-scaler.hpp"
+#include "render-backend.hpp"
+#include "frame-capture.hpp"
+
+namespace ar::core
+{
+    /**
+     * @brief Shows frames presented by virtual consoles using 'ar_graphics_method_frame_buffer'
+     * @details Runs its own present thread which owns the render backend, virtual console never touches SDL. Each time
+     *          the virtual console calls 'ar_graphics_present' the present thread is woken up, acquires the frame and
+     *          converts it from virtual console's pixel format. Converted frame is kept and scaled into backend's
+     *          memory, scaling only runs again when a new frame arrives or the output size changes.
+     */
+    class frame_presenter
+    {
+    public:
+        /**
+         * @brief Default constructor
+         * @param virtual_console Virtual console that presents the frames
+         * @param window SDL window to present to, render backend for it is created by the present thread
+         * @param backend_type Render backend to use, SDL's software renderer is used if it cannot be created
+         * @param scaling_filter Filter used to upscale the frames
+         * @throws Exceptions:
+         *  - ar::error::os_error: When the library does not export frame buffer functions
+         */
+        frame_presenter(std::unique_ptr<ar::core::virtual_console>& virtual_console, SDL_Window* window,
+                        ar::core::render_backend_type backend_type, ar::core::frame_scaler::filter scaling_filter);
+
+        /// @brief Stops the present thread
+        ~frame_presenter();
+
+        frame_presenter(const frame_presenter&) = delete;
+        frame_presenter& operator=(const frame_presenter&) = delete;
+
+        /// @brief Start the present thread
+        void start();
+
+        /**
+         * @brief Stop the present thread
+         * @warning Must be called before the virtual console frees its frame buffer ('quit_and_cleanup')
+         */
+        void stop();
+
+        /**
+         * @brief Show the last frame again even if nothing new was presented
+         * @details Present thread queries the output size on each wake up, after the window was resized this also
+         *          scales the last frame again for the new size.
+         */
+        void request_redraw();
+
+        /**
+         * @brief Record every presented frame
+         * @details Frames are copied on virtual console's thread right after they are presented, so the capture sees
+         *          every frame even when the present thread skips some of them.
+         * @param frame_capture Capture that the frames will be passed to, must be set before 'start'
+         */
+        void set_frame_capture(std::unique_ptr<ar::core::frame_capture> frame_capture);
+
+    private:
+        /// @brief Access to Retro library function used to acquire presented frame
+        typedef const void*(* acquire_frame_fn)();
+
+        /// @brief Access to Retro library function used to get palette of the acquired frame
+        typedef const ar_pixel*(* get_acquired_palette_fn)();
+
+        /// @brief Access to Retro library function used to get the frame buffer object
+        typedef ar_frame_buffer*(* get_frame_buffer_fn)();
+
+        /// @brief Access to Retro library function used to set present callback
+        typedef void(* set_present_callback_fn)(ar_graphics_present_callback, void*);
+
+        /// @brief How long the present thread sleeps if nothing was presented, only matters for stopping the thread
+        static constexpr std::chrono::milliseconds IDLE_WAIT_TIME { 100 };
+
+        /// @brief SDL window to present to
+        SDL_Window* _window;
+
+        /// @brief Render backend selected by the user
+        ar::core::render_backend_type _backend_type;
+
+        /// @brief Profiler of the virtual console, present thread records its ticks with it
+        ar::core::profiler& _profiler;
+
+        /// @brief Function used to acquire presented frame
+        acquire_frame_fn _acquire_frame_fn = nullptr;
+
+        /// @brief Function used to get palette of the acquired frame
+        get_acquired_palette_fn _get_acquired_palette_fn = nullptr;
+
+        /// @brief Function used to get the frame buffer object (for its size and format)
+        get_frame_buffer_fn _get_frame_buffer_fn = nullptr;
+
+        /// @brief Function used to set present callback
+        set_present_callback_fn _set_present_callback_fn = nullptr;
+
+        /// @brief Converts frames into texture's format, only used by the present thread
+        ar::core::pixel_converter _pixel_converter;
+
+        /// @brief Upscales converted frames, only used by the present thread
+        ar::core::frame_scaler _frame_scaler;
+
+        /// @brief Last frame converted to packed 'ar_pixel' values, kept so that it can be scaled again after resize
+        std::vector<uint32_t> _converted_frame;
+
+        /// @brief Records presented frames, nullptr if capturing is disabled
+        std::unique_ptr<ar::core::frame_capture> _frame_capture = nullptr;
+
+        /// @brief Present thread object
+        std::unique_ptr<std::thread> _present_thread = nullptr;
+
+        /// @brief Whether the present thread should keep running
+        std::atomic_bool _running = false;
+
+        /// @brief Protects '_wake_up'
+        std::mutex _wake_up_mutex;
+
+        /// @brief Used to wake up the present thread
+        std::condition_variable _wake_up_condition;
+
+        /// @brief Whether the present thread has something to do (new frame, redraw request or stop)
+        bool _wake_up = false;
+
+        /// @brief Whether the last frame should be shown again
+        std::atomic_bool _redraw_requested = false;
+
+        /// @brief Wakes up the present thread
+        void wake_up();
+
+        /**
+         * @brief Create selected render backend or the fallback one
+         * @return Created backend or nullptr if none could be created
+         */
+        std::unique_ptr<ar::core::render_backend> create_render_backend();
+
+        /// @brief Present thread function, creates render backend and shows frames until stopped
+        void present_loop();
+
+        /**
+         * @brief Present callback set in the library, runs on virtual console's thread
+         * @param user_data Pointer to 'frame_presenter' object
+         */
+        static void on_frame_presented(void* user_data);
+    };
+}
+
+#endif //ACCESS_TO_RETRO_FRONTEND_FRAME_PRESENTER_HPP
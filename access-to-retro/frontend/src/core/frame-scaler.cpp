@@ -0,0 +1,709 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include "frame-scaler.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+
+/// @brief SSE2 is part of every x86-64 CPU
+#define AR_SCALER_SSE2
+#endif
+
+/****************************************************************************************************
+ Helpers
+****************************************************************************************************/
+
+/**
+ * @brief Swap red and blue channels of a packed pixel (R, G, B, A bytes <-> B, G, R, A bytes)
+ * @param pixel Packed pixel
+ * @return Pixel with swapped channels
+ */
+static uint32_t swap_red_blue(uint32_t pixel)
+{
+    return (pixel & 0xFF00FF00) | ((pixel >> 16) & 0xFF) | ((pixel & 0xFF) << 16);
+}
+
+/**
+ * @brief Get distance of two colours, sum of absolute differences of red, green and blue
+ * @param a First packed pixel
+ * @param b Second packed pixel
+ * @return Distance of the colours (0 - 765)
+ */
+static uint32_t get_distance(uint32_t a, uint32_t b)
+{
+    uint32_t distance = 0;
+
+    for (uint32_t shift = 0; shift < 24; shift += 8)
+    {
+        auto channel_a = static_cast<int32_t>((a >> shift) & 0xFF);
+        auto channel_b = static_cast<int32_t>((b >> shift) & 0xFF);
+
+        distance += static_cast<uint32_t>(std::abs(channel_a - channel_b));
+    }
+
+    return distance;
+}
+
+/**
+ * @brief Average two packed pixels per channel, rounding up like '_mm_avg_epu8'
+ * @param a First packed pixel
+ * @param b Second packed pixel
+ * @return Averaged pixel
+ */
+static uint32_t blend_pixels(uint32_t a, uint32_t b)
+{
+    return (a | b) - (((a ^ b) >> 1) & 0x7F7F7F7F);
+}
+
+/****************************************************************************************************
+ Scalar kernels
+****************************************************************************************************/
+
+/**
+ * @brief Scale2x a single pixel
+ * @param source Pixel in the padded frame
+ * @param stride Number of pixels between the starts of two padded rows
+ * @param top Output row for the top half
+ * @param bottom Output row for the bottom half
+ */
+static void scale2x_pixel(const uint32_t* source, std::ptrdiff_t stride, uint32_t* top, uint32_t* bottom)
+{
+    uint32_t b = source[-stride];
+    uint32_t d = source[-1];
+    uint32_t e = source[0];
+    uint32_t f = source[1];
+    uint32_t h = source[stride];
+
+    top[0]    = (d == b && b != f && d != h) ? d : e;
+    top[1]    = (b == f && b != d && f != h) ? f : e;
+    bottom[0] = (d == h && d != b && h != f) ? d : e;
+    bottom[1] = (h == f && d != h && b != f) ? f : e;
+}
+
+/**
+ * @brief Scale3x a single pixel
+ * @param source Pixel in the padded frame
+ * @param stride Number of pixels between the starts of two padded rows
+ * @param rows 3 output rows
+ */
+static void scale3x_pixel(const uint32_t* source, std::ptrdiff_t stride, uint32_t* const* rows)
+{
+    uint32_t a = source[-stride - 1];
+    uint32_t b = source[-stride];
+    uint32_t c = source[-stride + 1];
+    uint32_t d = source[-1];
+    uint32_t e = source[0];
+    uint32_t f = source[1];
+    uint32_t g = source[stride - 1];
+    uint32_t h = source[stride];
+    uint32_t i = source[stride + 1];
+
+    // Edge through each corner of the block, same conditions as Scale2x
+    bool top_left     = d == b && b != f && d != h;
+    bool top_right    = b == f && b != d && f != h;
+    bool bottom_left  = d == h && d != b && h != f;
+    bool bottom_right = h == f && d != h && b != f;
+
+    rows[0][0] = top_left ? d : e;
+    rows[0][1] = ((top_left && e != c) || (top_right && e != a)) ? b : e;
+    rows[0][2] = top_right ? f : e;
+    rows[1][0] = ((top_left && e != g) || (bottom_left && e != a)) ? d : e;
+    rows[1][1] = e;
+    rows[1][2] = ((top_right && e != i) || (bottom_right && e != c)) ? f : e;
+    rows[2][0] = bottom_left ? d : e;
+    rows[2][1] = ((bottom_left && e != i) || (bottom_right && e != g)) ? h : e;
+    rows[2][2] = bottom_right ? f : e;
+}
+
+/**
+ * @brief Compute one corner of the xBR-style 2x block
+ * @details Rules of xBR level 1 for the bottom right corner, other corners mirror the neighbourhood. Edge runs along
+ *          H-F if the pixels across it (E-I direction) differ more than the pixels along it, the corner is then blended
+ *          with the closer of H and F.
+ * @param source Pixel in the padded frame
+ * @param dx Step towards the corner horizontally (1 or -1)
+ * @param dy Step towards the corner vertically (stride or -stride)
+ * @return Corner pixel
+ */
+static uint32_t xbr_corner(const uint32_t* source, std::ptrdiff_t dx, std::ptrdiff_t dy)
+{
+    uint32_t e = source[0];
+    uint32_t b = source[-dy];
+    uint32_t c = source[dx - dy];
+    uint32_t d = source[-dx];
+    uint32_t f = source[dx];
+    uint32_t g = source[dy - dx];
+    uint32_t h = source[dy];
+    uint32_t i = source[dy + dx];
+
+    uint32_t f4 = source[2 * dx];
+    uint32_t h5 = source[2 * dy];
+    uint32_t i4 = source[dy + 2 * dx];
+    uint32_t i5 = source[2 * dy + dx];
+
+    uint32_t along  = get_distance(e, c) + get_distance(e, g) + get_distance(i, f4) + get_distance(i, h5) +
+                      4 * get_distance(h, f);
+    uint32_t across = get_distance(h, d) + get_distance(h, i5) + get_distance(f, i4) + get_distance(f, b) +
+                      4 * get_distance(e, i);
+
+    if (along >= across)
+    {
+        return e;
+    }
+
+    uint32_t closer = get_distance(e, f) <= get_distance(e, h) ? f : h;
+
+    return blend_pixels(e, closer);
+}
+
+/**
+ * @brief xBR-style 2x a single pixel
+ * @param source Pixel in the padded frame
+ * @param stride Number of pixels between the starts of two padded rows
+ * @param top Output row for the top half
+ * @param bottom Output row for the bottom half
+ */
+static void xbr_pixel(const uint32_t* source, std::ptrdiff_t stride, uint32_t* top, uint32_t* bottom)
+{
+    top[0]    = xbr_corner(source, -1, -stride);
+    top[1]    = xbr_corner(source, 1, -stride);
+    bottom[0] = xbr_corner(source, -1, stride);
+    bottom[1] = xbr_corner(source, 1, stride);
+}
+
+/****************************************************************************************************
+ SSE2 kernels
+****************************************************************************************************/
+
+#ifdef AR_SCALER_SSE2
+
+/**
+ * @brief Load 4 pixels
+ * @param source First pixel
+ * @return Loaded pixels
+ */
+static __m128i load_pixels(const uint32_t* source)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+}
+
+/**
+ * @brief Store 4 pixels
+ * @param destination First pixel
+ * @param pixels Pixels to store
+ */
+static void store_pixels(uint32_t* destination, __m128i pixels)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), pixels);
+}
+
+/**
+ * @brief Select pixels by a mask
+ * @param mask All bits set in lanes that take 'a'
+ * @param a Pixels selected by set lanes
+ * @param b Pixels selected by clear lanes
+ * @return Selected pixels
+ */
+static __m128i select_pixels(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/**
+ * @brief Swap red and blue channels of 4 packed pixels
+ * @param pixels Packed pixels
+ * @return Pixels with swapped channels
+ */
+static __m128i swap_red_blue(__m128i pixels)
+{
+    const __m128i mask_ga   = _mm_set1_epi32(static_cast<int>(0xFF00FF00));
+    const __m128i mask_byte = _mm_set1_epi32(0xFF);
+
+    return _mm_or_si128(_mm_and_si128(pixels, mask_ga),
+                        _mm_or_si128(_mm_and_si128(_mm_srli_epi32(pixels, 16), mask_byte),
+                                     _mm_slli_epi32(_mm_and_si128(pixels, mask_byte), 16)));
+}
+
+/**
+ * @brief Write the same pixel 'count' times
+ * @warning Writes in blocks of 4, up to 3 pixels past 'count' get overwritten
+ * @param destination Destination pixels
+ * @param pixel Pixel in all 4 lanes
+ * @param count Number of pixels to write
+ */
+static void replicate_pixel(uint32_t* destination, __m128i pixel, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i += 4)
+    {
+        store_pixels(destination + i, pixel);
+    }
+}
+
+/**
+ * @brief Get colour distances of 4 pixel pairs, same as 'get_distance'
+ * @param a First pixels
+ * @param b Second pixels
+ * @return Distances as 32-bit integers
+ */
+static __m128i get_distance(__m128i a, __m128i b)
+{
+    const __m128i mask_byte = _mm_set1_epi32(0xFF);
+
+    // Saturating subtraction in both directions gives the absolute difference of each byte
+    __m128i difference = _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a));
+
+    return _mm_add_epi32(_mm_add_epi32(_mm_and_si128(difference, mask_byte),
+                                       _mm_and_si128(_mm_srli_epi32(difference, 8), mask_byte)),
+                         _mm_and_si128(_mm_srli_epi32(difference, 16), mask_byte));
+}
+
+/**
+ * @brief Interleave 3 vectors (a0 b0 c0 a1 b1 c1 ...) and store the 12 pixels
+ * @param destination First pixel
+ * @param a Pixels going to every third position starting at 0
+ * @param b Pixels going to every third position starting at 1
+ * @param c Pixels going to every third position starting at 2
+ */
+static void store_interleaved_3(uint32_t* destination, __m128i a, __m128i b, __m128i c)
+{
+    __m128 ab_low  = _mm_castsi128_ps(_mm_unpacklo_epi32(a, b));
+    __m128 ab_high = _mm_castsi128_ps(_mm_unpackhi_epi32(a, b));
+    __m128 bc_low  = _mm_castsi128_ps(_mm_unpacklo_epi32(b, c));
+    __m128 bc_high = _mm_castsi128_ps(_mm_unpackhi_epi32(b, c));
+    __m128 ca_low  = _mm_castsi128_ps(_mm_unpacklo_epi32(c, a));
+    __m128 ca_high = _mm_castsi128_ps(_mm_unpackhi_epi32(c, a));
+
+    // a0 b0 c0 a1 | b1 c1 a2 b2 | c2 a3 b3 c3
+    store_pixels(destination, _mm_castps_si128(_mm_shuffle_ps(ab_low, ca_low, _MM_SHUFFLE(3, 0, 1, 0))));
+    store_pixels(destination + 4, _mm_castps_si128(_mm_shuffle_ps(bc_low, ab_high, _MM_SHUFFLE(1, 0, 3, 2))));
+    store_pixels(destination + 8, _mm_castps_si128(_mm_shuffle_ps(ca_high, bc_high, _MM_SHUFFLE(3, 2, 3, 0))));
+}
+
+/**
+ * @brief Scale2x 4 pixels
+ * @param source First pixel in the padded frame
+ * @param stride Number of pixels between the starts of two padded rows
+ * @param top Output row for the top half, 8 pixels
+ * @param bottom Output row for the bottom half, 8 pixels
+ */
+static void scale2x_pixels_sse2(const uint32_t* source, std::ptrdiff_t stride, uint32_t* top, uint32_t* bottom)
+{
+    __m128i b = load_pixels(source - stride);
+    __m128i d = load_pixels(source - 1);
+    __m128i e = load_pixels(source);
+    __m128i f = load_pixels(source + 1);
+    __m128i h = load_pixels(source + stride);
+
+    __m128i d_b = _mm_cmpeq_epi32(d, b);
+    __m128i b_f = _mm_cmpeq_epi32(b, f);
+    __m128i d_h = _mm_cmpeq_epi32(d, h);
+    __m128i h_f = _mm_cmpeq_epi32(h, f);
+
+    // andnot(x, y) is y & ~x, so each condition reads "equal pair, and not either of the other two pairs"
+    __m128i top_left     = _mm_andnot_si128(_mm_or_si128(b_f, d_h), d_b);
+    __m128i top_right    = _mm_andnot_si128(_mm_or_si128(d_b, h_f), b_f);
+    __m128i bottom_left  = _mm_andnot_si128(_mm_or_si128(d_b, h_f), d_h);
+    __m128i bottom_right = _mm_andnot_si128(_mm_or_si128(d_h, b_f), h_f);
+
+    __m128i e0 = select_pixels(top_left, d, e);
+    __m128i e1 = select_pixels(top_right, f, e);
+    __m128i e2 = select_pixels(bottom_left, d, e);
+    __m128i e3 = select_pixels(bottom_right, f, e);
+
+    store_pixels(top, _mm_unpacklo_epi32(e0, e1));
+    store_pixels(top + 4, _mm_unpackhi_epi32(e0, e1));
+    store_pixels(bottom, _mm_unpacklo_epi32(e2, e3));
+    store_pixels(bottom + 4, _mm_unpackhi_epi32(e2, e3));
+}
+
+/**
+ * @brief Scale3x 4 pixels
+ * @param source First pixel in the padded frame
+ * @param stride Number of pixels between the starts of two padded rows
+ * @param rows 3 output rows, 12 pixels each
+ */
+static void scale3x_pixels_sse2(const uint32_t* source, std::ptrdiff_t stride, uint32_t* const* rows)
+{
+    __m128i a = load_pixels(source - stride - 1);
+    __m128i b = load_pixels(source - stride);
+    __m128i c = load_pixels(source - stride + 1);
+    __m128i d = load_pixels(source - 1);
+    __m128i e = load_pixels(source);
+    __m128i f = load_pixels(source + 1);
+    __m128i g = load_pixels(source + stride - 1);
+    __m128i h = load_pixels(source + stride);
+    __m128i i = load_pixels(source + stride + 1);
+
+    __m128i d_b = _mm_cmpeq_epi32(d, b);
+    __m128i b_f = _mm_cmpeq_epi32(b, f);
+    __m128i d_h = _mm_cmpeq_epi32(d, h);
+    __m128i h_f = _mm_cmpeq_epi32(h, f);
+
+    __m128i top_left     = _mm_andnot_si128(_mm_or_si128(b_f, d_h), d_b);
+    __m128i top_right    = _mm_andnot_si128(_mm_or_si128(d_b, h_f), b_f);
+    __m128i bottom_left  = _mm_andnot_si128(_mm_or_si128(d_b, h_f), d_h);
+    __m128i bottom_right = _mm_andnot_si128(_mm_or_si128(d_h, b_f), h_f);
+
+    __m128i e_a = _mm_cmpeq_epi32(e, a);
+    __m128i e_c = _mm_cmpeq_epi32(e, c);
+    __m128i e_g = _mm_cmpeq_epi32(e, g);
+    __m128i e_i = _mm_cmpeq_epi32(e, i);
+
+    __m128i e1 = _mm_or_si128(_mm_andnot_si128(e_c, top_left), _mm_andnot_si128(e_a, top_right));
+    __m128i e3 = _mm_or_si128(_mm_andnot_si128(e_g, top_left), _mm_andnot_si128(e_a, bottom_left));
+    __m128i e5 = _mm_or_si128(_mm_andnot_si128(e_i, top_right), _mm_andnot_si128(e_c, bottom_right));
+    __m128i e7 = _mm_or_si128(_mm_andnot_si128(e_i, bottom_left), _mm_andnot_si128(e_g, bottom_right));
+
+    store_interleaved_3(rows[0], select_pixels(top_left, d, e), select_pixels(e1, b, e),
+                        select_pixels(top_right, f, e));
+    store_interleaved_3(rows[1], select_pixels(e3, d, e), e, select_pixels(e5, f, e));
+    store_interleaved_3(rows[2], select_pixels(bottom_left, d, e), select_pixels(e7, h, e),
+                        select_pixels(bottom_right, f, e));
+}
+
+/**
+ * @brief Compute one corner of the xBR-style 2x block for 4 pixels, same as 'xbr_corner'
+ * @param source First pixel in the padded frame
+ * @param dx Step towards the corner horizontally (1 or -1)
+ * @param dy Step towards the corner vertically (stride or -stride)
+ * @return Corner pixels
+ */
+static __m128i xbr_corner_sse2(const uint32_t* source, std::ptrdiff_t dx, std::ptrdiff_t dy)
+{
+    __m128i e = load_pixels(source);
+    __m128i b = load_pixels(source - dy);
+    __m128i c = load_pixels(source + dx - dy);
+    __m128i d = load_pixels(source - dx);
+    __m128i f = load_pixels(source + dx);
+    __m128i g = load_pixels(source + dy - dx);
+    __m128i h = load_pixels(source + dy);
+    __m128i i = load_pixels(source + dy + dx);
+
+    __m128i f4 = load_pixels(source + 2 * dx);
+    __m128i h5 = load_pixels(source + 2 * dy);
+    __m128i i4 = load_pixels(source + dy + 2 * dx);
+    __m128i i5 = load_pixels(source + 2 * dy + dx);
+
+    __m128i along  = _mm_add_epi32(_mm_add_epi32(get_distance(e, c), get_distance(e, g)),
+                                   _mm_add_epi32(get_distance(i, f4), get_distance(i, h5)));
+    __m128i across = _mm_add_epi32(_mm_add_epi32(get_distance(h, d), get_distance(h, i5)),
+                                   _mm_add_epi32(get_distance(f, i4), get_distance(f, b)));
+
+    along  = _mm_add_epi32(along, _mm_slli_epi32(get_distance(h, f), 2));
+    across = _mm_add_epi32(across, _mm_slli_epi32(get_distance(e, i), 2));
+
+    // Distances are at most 765 * 8 so signed comparisons are fine
+    __m128i edge     = _mm_cmplt_epi32(along, across);
+    __m128i prefer_h = _mm_cmpgt_epi32(get_distance(e, f), get_distance(e, h));
+    __m128i closer   = select_pixels(prefer_h, h, f);
+
+    return select_pixels(edge, _mm_avg_epu8(e, closer), e);
+}
+
+/**
+ * @brief xBR-style 2x 4 pixels
+ * @param source First pixel in the padded frame
+ * @param stride Number of pixels between the starts of two padded rows
+ * @param top Output row for the top half, 8 pixels
+ * @param bottom Output row for the bottom half, 8 pixels
+ */
+static void xbr_pixels_sse2(const uint32_t* source, std::ptrdiff_t stride, uint32_t* top, uint32_t* bottom)
+{
+    __m128i e0 = xbr_corner_sse2(source, -1, -stride);
+    __m128i e1 = xbr_corner_sse2(source, 1, -stride);
+    __m128i e2 = xbr_corner_sse2(source, -1, stride);
+    __m128i e3 = xbr_corner_sse2(source, 1, stride);
+
+    store_pixels(top, _mm_unpacklo_epi32(e0, e1));
+    store_pixels(top + 4, _mm_unpackhi_epi32(e0, e1));
+    store_pixels(bottom, _mm_unpacklo_epi32(e2, e3));
+    store_pixels(bottom + 4, _mm_unpackhi_epi32(e2, e3));
+}
+
+#endif
+
+/****************************************************************************************************
+ frame_scaler
+****************************************************************************************************/
+
+ar::core::frame_scaler::frame_scaler(ar::core::frame_scaler::filter scaling_filter,
+                                     ar::core::frame_scaler::simd_level simd) :
+        _filter(scaling_filter),
+        _simd(std::min(simd, get_best_simd_level()))
+{
+}
+
+void ar::core::frame_scaler::get_scaled_size(uint32_t frame_width, uint32_t frame_height, uint32_t output_width,
+                                             uint32_t output_height, uint32_t& scaled_width,
+                                             uint32_t& scaled_height) const
+{
+    uint32_t filter_factor = get_filter_factor();
+
+    // Largest integer factor that fits, the filter's own factor is always applied even if the output is smaller
+    uint32_t output_factor = 1;
+    if (frame_width != 0 && frame_height != 0)
+    {
+        output_factor = std::max(1U, std::min(output_width / frame_width, output_height / frame_height));
+    }
+
+    uint32_t factor = filter_factor * std::max(1U, output_factor / filter_factor);
+
+    scaled_width  = frame_width * factor;
+    scaled_height = frame_height * factor;
+}
+
+void ar::core::frame_scaler::scale(const uint32_t* frame, uint32_t frame_width, uint32_t frame_height,
+                                   uint32_t output_width, uint32_t output_height, void* destination,
+                                   std::size_t destination_pitch)
+{
+    uint32_t scaled_width  = 0;
+    uint32_t scaled_height = 0;
+    get_scaled_size(frame_width, frame_height, output_width, output_height, scaled_width, scaled_height);
+
+    if (scaled_width == 0 || scaled_height == 0)
+    {
+        return;
+    }
+
+    auto* output           = static_cast<uint8_t*>(destination);
+    uint32_t filter_factor = get_filter_factor();
+    uint32_t replication   = scaled_width / (frame_width * filter_factor);
+
+    if (_filter == filter::nearest)
+    {
+        replicate_frame(frame, frame_width, frame_height, replication, output, destination_pitch);
+        return;
+    }
+
+    pad_frame(frame, frame_width, frame_height);
+
+    if (replication == 1)
+    {
+        run_filter(frame_width, frame_height, output, destination_pitch);
+        return;
+    }
+
+    // Filter output is replicated further to get as close to the output size as possible
+    uint32_t filtered_width  = frame_width * filter_factor;
+    uint32_t filtered_height = frame_height * filter_factor;
+
+    _filtered_frame.resize(static_cast<std::size_t>(filtered_width) * filtered_height);
+
+    run_filter(frame_width, frame_height, reinterpret_cast<uint8_t*>(_filtered_frame.data()),
+               filtered_width * sizeof(uint32_t));
+    replicate_frame(_filtered_frame.data(), filtered_width, filtered_height, replication, output, destination_pitch);
+}
+
+ar::core::frame_scaler::filter ar::core::frame_scaler::get_filter() const
+{
+    return _filter;
+}
+
+ar::core::frame_scaler::simd_level ar::core::frame_scaler::get_simd_level() const
+{
+    return _simd;
+}
+
+void ar::core::frame_scaler::replicate_row(const uint32_t* source, uint32_t* destination, uint32_t width,
+                                           uint32_t factor, bool swap_channels)
+{
+    uint32_t x = 0;
+
+#ifdef AR_SCALER_SSE2
+    for (; x + 4 <= width; x += 4)
+    {
+        __m128i pixels = load_pixels(source + x);
+        if (swap_channels)
+        {
+            pixels = swap_red_blue(pixels);
+        }
+
+        uint32_t* row = destination + x * factor;
+
+        switch (factor)
+        {
+            case 1:
+                store_pixels(row, pixels);
+                break;
+
+            case 2:
+                // Interleaving the vector with itself doubles every pixel
+                store_pixels(row, _mm_unpacklo_epi32(pixels, pixels));
+                store_pixels(row + 4, _mm_unpackhi_epi32(pixels, pixels));
+                break;
+
+            default:
+                // Each lane is broadcast and written 'factor' times, later lanes overwrite the overlap
+                replicate_pixel(row, _mm_shuffle_epi32(pixels, 0x00), factor);
+                replicate_pixel(row + factor, _mm_shuffle_epi32(pixels, 0x55), factor);
+                replicate_pixel(row + factor * 2, _mm_shuffle_epi32(pixels, 0xAA), factor);
+                replicate_pixel(row + factor * 3, _mm_shuffle_epi32(pixels, 0xFF), factor);
+                break;
+        }
+    }
+#endif
+
+    for (; x < width; x++)
+    {
+        uint32_t pixel = swap_channels ? swap_red_blue(source[x]) : source[x];
+
+        std::fill_n(destination + x * factor, factor, pixel);
+    }
+}
+
+ar::core::frame_scaler::simd_level ar::core::frame_scaler::get_best_simd_level()
+{
+#ifdef AR_SCALER_SSE2
+    return simd_level::sse2;
+#else
+    return simd_level::none;
+#endif
+}
+
+std::string ar::core::frame_scaler::get_filter_name(ar::core::frame_scaler::filter scaling_filter)
+{
+    switch (scaling_filter)
+    {
+        case filter::scale2x:
+            return "Scale2x";
+
+        case filter::scale3x:
+            return "Scale3x";
+
+        case filter::xbr:
+            return "xBR 2x";
+
+        case filter::nearest:
+        default:
+            return "Nearest";
+    }
+}
+
+uint32_t ar::core::frame_scaler::get_filter_factor() const
+{
+    switch (_filter)
+    {
+        case filter::scale2x:
+        case filter::xbr:
+            return 2;
+
+        case filter::scale3x:
+            return 3;
+
+        case filter::nearest:
+        default:
+            return 1;
+    }
+}
+
+void ar::core::frame_scaler::pad_frame(const uint32_t* frame, uint32_t width, uint32_t height)
+{
+    std::size_t stride = width + BORDER * 2;
+
+    _padded_frame.resize(stride * (height + BORDER * 2));
+
+    for (uint32_t y = 0; y < height + BORDER * 2; y++)
+    {
+        // Rows above and below the frame repeat its first and last row
+        uint32_t source_y = y < BORDER ? 0 : std::min(y - BORDER, height - 1);
+
+        const uint32_t* source = frame + static_cast<std::size_t>(source_y) * width;
+        uint32_t* row          = _padded_frame.data() + y * stride;
+
+        std::fill_n(row, BORDER, source[0]);
+        std::memcpy(row + BORDER, source, width * sizeof(uint32_t));
+        std::fill_n(row + BORDER + width, BORDER, source[width - 1]);
+    }
+}
+
+void ar::core::frame_scaler::run_filter(uint32_t width, uint32_t height, uint8_t* destination,
+                                        std::size_t destination_pitch) const
+{
+    auto stride = static_cast<std::ptrdiff_t>(width + BORDER * 2);
+
+    for (uint32_t y = 0; y < height; y++)
+    {
+        const uint32_t* source = _padded_frame.data() + (y + BORDER) * static_cast<std::size_t>(stride) + BORDER;
+        uint32_t x             = 0;
+
+        if (_filter == filter::scale3x)
+        {
+            uint32_t* rows[3];
+            for (std::size_t row = 0; row < 3; row++)
+            {
+                rows[row] = reinterpret_cast<uint32_t*>(destination + (y * 3 + row) * destination_pitch);
+            }
+
+#ifdef AR_SCALER_SSE2
+            for (; _simd == simd_level::sse2 && x + 4 <= width; x += 4)
+            {
+                uint32_t* block[3] = { rows[0] + x * 3, rows[1] + x * 3, rows[2] + x * 3 };
+                scale3x_pixels_sse2(source + x, stride, block);
+            }
+#endif
+
+            for (; x < width; x++)
+            {
+                uint32_t* block[3] = { rows[0] + x * 3, rows[1] + x * 3, rows[2] + x * 3 };
+                scale3x_pixel(source + x, stride, block);
+            }
+
+            continue;
+        }
+
+        auto* top    = reinterpret_cast<uint32_t*>(destination + y * 2 * destination_pitch);
+        auto* bottom = reinterpret_cast<uint32_t*>(destination + (y * 2 + 1) * destination_pitch);
+
+        if (_filter == filter::xbr)
+        {
+#ifdef AR_SCALER_SSE2
+            for (; _simd == simd_level::sse2 && x + 4 <= width; x += 4)
+            {
+                xbr_pixels_sse2(source + x, stride, top + x * 2, bottom + x * 2);
+            }
+#endif
+
+            for (; x < width; x++)
+            {
+                xbr_pixel(source + x, stride, top + x * 2, bottom + x * 2);
+            }
+
+            continue;
+        }
+
+#ifdef AR_SCALER_SSE2
+        for (; _simd == simd_level::sse2 && x + 4 <= width; x += 4)
+        {
+            scale2x_pixels_sse2(source + x, stride, top + x * 2, bottom + x * 2);
+        }
+#endif
+
+        for (; x < width; x++)
+        {
+            scale2x_pixel(source + x, stride, top + x * 2, bottom + x * 2);
+        }
+    }
+}
+
+void ar::core::frame_scaler::replicate_frame(const uint32_t* frame, uint32_t width, uint32_t height, uint32_t factor,
+                                             uint8_t* destination, std::size_t destination_pitch)
+{
+    uint32_t replicated_width = width * factor;
+    std::size_t row_size      = replicated_width * sizeof(uint32_t);
+
+    _replicated_row.resize(replicated_width + ROW_PADDING);
+
+    for (uint32_t y = 0; y < height; y++)
+    {
+        // Replicate the row once and copy it 'factor' times vertically
+        replicate_row(frame + static_cast<std::size_t>(y) * width, _replicated_row.data(), width, factor, false);
+
+        for (uint32_t repeat = 0; repeat < factor; repeat++)
+        {
+            std::size_t output_y = static_cast<std::size_t>(y) * factor + repeat;
+
+            std::memcpy(destination + output_y * destination_pitch, _replicated_row.data(), row_size);
+        }
+    }
+}
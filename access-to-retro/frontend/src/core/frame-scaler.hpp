@@ -0,0 +1,182 @@
+/**
+ * @file core/frame-scaler.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_FRONTEND_FRAME_SCALER_HPP
+#define ACCESS_TO_RETRO_FRONTEND_FRAME_SCALER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ar::core
+{
+    /**
+     * @brief Upscales converted frames (packed 'ar_pixel' values) on the CPU before they are uploaded
+     * @details Pixel art filters produce a fixed factor (2x or 3x) which is then replicated by the largest integer
+     *          factor that still fits the output, so the uploaded frame is as close to the output size as possible and
+     *          the renderer only has to stretch it by a small fraction (letterboxed to keep the aspect ratio).
+     *
+     *          Filters read a copy of the frame with a 2 pixel border of replicated edge pixels so that no kernel has
+     *          to handle the edges. SSE2 kernels work on 4 source pixels at once, the remainder of each row uses the
+     *          scalar kernel.
+     */
+    class frame_scaler
+    {
+    public:
+        /// @brief Available filters, value is the index stored in "scaling_filter" setting
+        enum class filter
+        {
+            /// @brief Nearest neighbour by the largest integer factor that fits the output
+            nearest = 0,
+
+            /// @brief Scale2x (EPX), rounds diagonal edges without adding colours
+            scale2x = 1,
+
+            /// @brief Scale3x, same rules as Scale2x with a 3x3 output block
+            scale3x = 2,
+
+            /// @brief 2x filter in the style of xBR, detects edges using colour distances and blends along them
+            xbr = 3
+        };
+
+        /// @brief Instruction sets that the filters can use
+        enum class simd_level
+        {
+            /// @brief Plain C++
+            none,
+
+            /// @brief SSE2, 4 source pixels at once
+            sse2
+        };
+
+        /// @brief Number of pixels that 'replicate_row' can write past the end of the row
+        static constexpr std::size_t ROW_PADDING = 3;
+
+        /**
+         * @brief Default constructor
+         * @param scaling_filter Filter to use
+         * @param simd Instruction set used by the filters, best supported one is used if it's not supported
+         */
+        explicit frame_scaler(filter scaling_filter, simd_level simd = simd_level::sse2);
+
+        /**
+         * @brief Get size of the scaled frame
+         * @param frame_width Width of the frame
+         * @param frame_height Height of the frame
+         * @param output_width Width of the area that the frame will be shown in
+         * @param output_height Height of the area that the frame will be shown in
+         * @param scaled_width Set to the width of the scaled frame
+         * @param scaled_height Set to the height of the scaled frame
+         */
+        void get_scaled_size(uint32_t frame_width, uint32_t frame_height, uint32_t output_width,
+                             uint32_t output_height, uint32_t& scaled_width, uint32_t& scaled_height) const;
+
+        /**
+         * @brief Scale a frame
+         * @param frame Frame pixels, rows are 'frame_width' pixels apart
+         * @param frame_width Width of the frame
+         * @param frame_height Height of the frame
+         * @param output_width Width of the area that the frame will be shown in
+         * @param output_height Height of the area that the frame will be shown in
+         * @param destination Scaled frame, size is given by 'get_scaled_size'
+         * @param destination_pitch Number of bytes between the starts of two destination rows
+         */
+        void scale(const uint32_t* frame, uint32_t frame_width, uint32_t frame_height, uint32_t output_width,
+                   uint32_t output_height, void* destination, std::size_t destination_pitch);
+
+        /**
+         * @brief Get filter in use
+         * @return Filter in use
+         */
+        [[nodiscard]] filter get_filter() const;
+
+        /**
+         * @brief Get instruction set used by the filters
+         * @return Instruction set that is actually used
+         */
+        [[nodiscard]] simd_level get_simd_level() const;
+
+        /**
+         * @brief Scale a row horizontally by an integer factor (nearest neighbour)
+         * @warning Destination must have 'ROW_PADDING' extra pixels
+         * @param source Source row
+         * @param destination Destination row, 'width' * 'factor' pixels
+         * @param width Width of the source row
+         * @param factor Integer scale factor
+         * @param swap_channels Whether to also swap red and blue channels (for BGR window surfaces)
+         */
+        static void replicate_row(const uint32_t* source, uint32_t* destination, uint32_t width, uint32_t factor,
+                                  bool swap_channels);
+
+        /**
+         * @brief Get best instruction set supported by this CPU and build
+         * @return Best supported instruction set
+         */
+        [[nodiscard]] static simd_level get_best_simd_level();
+
+        /**
+         * @brief Get name of the filter, for logging
+         * @param scaling_filter Filter
+         * @return Name of the filter
+         */
+        [[nodiscard]] static std::string get_filter_name(filter scaling_filter);
+
+    private:
+        /// @brief Number of replicated edge pixels around the padded frame, enough for xBR's 5x5 neighbourhood
+        static constexpr uint32_t BORDER = 2;
+
+        /// @brief Filter in use
+        filter _filter;
+
+        /// @brief Instruction set used by the filters
+        simd_level _simd;
+
+        /// @brief Frame with 'BORDER' pixels of replicated edges on every side
+        std::vector<uint32_t> _padded_frame;
+
+        /// @brief Output of the filter when it's replicated further
+        std::vector<uint32_t> _filtered_frame;
+
+        /// @brief Single replicated row, copied into the destination once per output row
+        std::vector<uint32_t> _replicated_row;
+
+        /**
+         * @brief Get fixed factor produced by the filter
+         * @return 1 for nearest neighbour, 2 or 3 for the pixel art filters
+         */
+        [[nodiscard]] uint32_t get_filter_factor() const;
+
+        /**
+         * @brief Copy the frame into '_padded_frame'
+         * @param frame Frame pixels
+         * @param width Width of the frame
+         * @param height Height of the frame
+         */
+        void pad_frame(const uint32_t* frame, uint32_t width, uint32_t height);
+
+        /**
+         * @brief Run the pixel art filter on '_padded_frame'
+         * @param width Width of the frame
+         * @param height Height of the frame
+         * @param destination Filtered frame
+         * @param destination_pitch Number of bytes between the starts of two destination rows
+         */
+        void run_filter(uint32_t width, uint32_t height, uint8_t* destination, std::size_t destination_pitch) const;
+
+        /**
+         * @brief Replicate every pixel of a frame by an integer factor
+         * @param frame Frame pixels, rows are 'width' pixels apart
+         * @param width Width of the frame
+         * @param height Height of the frame
+         * @param factor Integer scale factor
+         * @param destination Replicated frame
+         * @param destination_pitch Number of bytes between the starts of two destination rows
+         */
+        void replicate_frame(const uint32_t* frame, uint32_t width, uint32_t height, uint32_t factor,
+                             uint8_t* destination, std::size_t destination_pitch);
+    };
+}
+
+#endif //ACCESS_TO_RETRO_FRONTEND_FRAME_SCALER_HPP
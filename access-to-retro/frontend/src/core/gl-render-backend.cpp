@@ -0,0 +1,470 @@
+// Only used to declare prototypes for 'decltype', every function is loaded through SDL and the frontend does not
+// link against OpenGL
+#define GL_GLEXT_PROTOTYPES
+
+#include <algorithm>
+#include <cstring>
+#include "error/os-error.hpp"
+#include "gl-render-backend.hpp"
+
+/// @brief Calls 'X' for every OpenGL function used by the backend
+#define AR_GL_FUNCTIONS(X)                                                                                            \
+        X(glGetString) X(glGetStringi) X(glGetIntegerv) X(glGetError) X(glViewport) X(glClearColor) X(glClear)        \
+        X(glGenTextures) X(glDeleteTextures) X(glBindTexture) X(glActiveTexture) X(glTexParameteri) X(glTexImage2D)   \
+        X(glTexSubImage2D) X(glPixelStorei) X(glGenBuffers) X(glDeleteBuffers) X(glBindBuffer) X(glBufferData)        \
+        X(glMapBufferRange) X(glUnmapBuffer) X(glFenceSync) X(glClientWaitSync) X(glDeleteSync) X(glCreateShader)     \
+        X(glShaderSource) X(glCompileShader) X(glGetShaderiv) X(glGetShaderInfoLog) X(glDeleteShader)                 \
+        X(glCreateProgram) X(glAttachShader) X(glLinkProgram) X(glGetProgramiv) X(glGetProgramInfoLog)                \
+        X(glDeleteProgram) X(glUseProgram) X(glGetUniformLocation) X(glUniform1i) X(glUniform2f)                      \
+        X(glGenVertexArrays) X(glDeleteVertexArrays) X(glBindVertexArray) X(glDrawArrays)
+
+/// @brief Declares pointer to an OpenGL function with the type of its prototype
+#define AR_GL_DECLARE_FUNCTION(name) decltype(&::name) name = nullptr;
+
+/// @brief OpenGL functions used by the backend
+struct ar::core::gl_render_backend::gl_functions
+{
+    AR_GL_FUNCTIONS(AR_GL_DECLARE_FUNCTION)
+
+    /// @brief Only exists in OpenGL 4.4 or with ARB_buffer_storage, nullptr otherwise
+    decltype(&::glBufferStorage) glBufferStorage = nullptr;
+};
+
+/// @brief Generates a full-window quad (triangle strip) from vertex IDs, row 0 of the frame is at the top
+static const char* const VERTEX_SHADER = R"(#version 330 core
+out vec2 texture_coordinate;
+
+void main()
+{
+    vec2 position      = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    texture_coordinate = vec2(position.x, 1.0 - position.y);
+    gl_Position        = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+/// @brief Sharp bilinear scaling, samples the nearest source pixel except within a single output pixel of its edges
+static const char* const FRAGMENT_SHADER = R"(#version 330 core
+in vec2 texture_coordinate;
+out vec4 colour;
+
+uniform sampler2D frame;
+uniform vec2 source_size;
+uniform vec2 output_size;
+
+void main()
+{
+    vec2 scale  = max(floor(output_size / source_size), vec2(1.0));
+    vec2 texel  = texture_coordinate * source_size;
+    vec2 region = 0.5 - 0.5 / scale;
+
+    // Distance from the source pixel's center, flattened everywhere except near the edges
+    vec2 center_distance = fract(texel) - 0.5;
+    vec2 offset          = (center_distance - clamp(center_distance, -region, region)) * scale + 0.5;
+
+    colour = texture(frame, (floor(texel) + offset) / source_size);
+}
+)";
+
+ar::core::gl_render_backend::gl_render_backend(SDL_Window* window, bool vsync) :
+        _window(window),
+        _gl(std::make_unique<gl_functions>())
+{
+    if ((SDL_GetWindowFlags(_window) & SDL_WINDOW_OPENGL) == 0)
+    {
+        throw ar::error::os_error("Unable to create " + get_name() + " backend, window was not created for OpenGL");
+    }
+
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+#if defined(__APPLE__)
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS, SDL_GL_CONTEXT_FORWARD_COMPATIBLE_FLAG);
+#endif
+
+    _context = SDL_GL_CreateContext(_window);
+    if (_context == nullptr)
+    {
+        throw ar::error::os_error("Unable to create OpenGL 3.3 context. Error: " + std::string(SDL_GetError()));
+    }
+
+    try
+    {
+        load_functions();
+        create_program();
+    }
+    catch (const ar::error::os_error&)
+    {
+        destroy();
+        throw;
+    }
+
+    // Adaptive sync is preferred, it does not wait if a frame was late
+    if (vsync && SDL_GL_SetSwapInterval(-1) != 0)
+    {
+        SDL_GL_SetSwapInterval(1);
+    }
+    else if (!vsync)
+    {
+        SDL_GL_SetSwapInterval(0);
+    }
+
+    _gl->glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+ar::core::gl_render_backend::~gl_render_backend()
+{
+    destroy();
+}
+
+void* ar::core::gl_render_backend::lock_frame(uint32_t width, uint32_t height, std::size_t& pitch)
+{
+    if (_frame_width != width || _frame_height != height)
+    {
+        destroy_frame_objects();
+
+        if (!create_frame_objects(width, height))
+        {
+            destroy_frame_objects();
+            return nullptr;
+        }
+    }
+
+    // Next buffer is the one used the longest time ago, its upload has most likely finished already
+    _pixel_buffer_index = (_pixel_buffer_index + 1) % PIXEL_BUFFER_COUNT;
+    wait_for_pixel_buffer(_pixel_buffer_index);
+
+    pitch = width * sizeof(uint32_t);
+
+    if (_persistent_mapping)
+    {
+        return _mapped_pixel_buffers[_pixel_buffer_index];
+    }
+
+    // Fence already guarantees that the GPU is done with the buffer, the driver does not have to synchronize again
+    _gl->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pixel_buffers[_pixel_buffer_index]);
+    void* pixels = _gl->glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(pitch * height),
+                                         GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    _gl->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    return pixels;
+}
+
+void ar::core::gl_render_backend::unlock_frame()
+{
+    _gl->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pixel_buffers[_pixel_buffer_index]);
+
+    if (!_persistent_mapping)
+    {
+        _gl->glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    }
+
+    // With a pixel buffer bound the upload only gets queued, the pointer is an offset into the buffer
+    _gl->glBindTexture(GL_TEXTURE_2D, _texture);
+    _gl->glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, static_cast<GLsizei>(_frame_width),
+                         static_cast<GLsizei>(_frame_height), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    _gl->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    _fences[_pixel_buffer_index] = _gl->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    _has_frame = true;
+}
+
+void ar::core::gl_render_backend::present()
+{
+    uint32_t output_width  = 0;
+    uint32_t output_height = 0;
+    get_output_size(output_width, output_height);
+
+    _gl->glViewport(0, 0, static_cast<GLsizei>(output_width), static_cast<GLsizei>(output_height));
+    _gl->glClear(GL_COLOR_BUFFER_BIT);
+
+    if (_has_frame)
+    {
+        SDL_Rect letterbox = get_letterbox(_frame_width, _frame_height, output_width, output_height);
+
+        // OpenGL's origin is the bottom left corner
+        _gl->glViewport(letterbox.x, static_cast<GLint>(output_height) - letterbox.y - letterbox.h, letterbox.w,
+                        letterbox.h);
+
+        _gl->glUseProgram(_program);
+        _gl->glUniform2f(_source_size_location, static_cast<GLfloat>(_frame_width),
+                         static_cast<GLfloat>(_frame_height));
+        _gl->glUniform2f(_output_size_location, static_cast<GLfloat>(letterbox.w), static_cast<GLfloat>(letterbox.h));
+
+        _gl->glActiveTexture(GL_TEXTURE0);
+        _gl->glBindTexture(GL_TEXTURE_2D, _texture);
+        _gl->glBindVertexArray(_vertex_array);
+        _gl->glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    }
+
+    SDL_GL_SwapWindow(_window);
+}
+
+std::string ar::core::gl_render_backend::get_name() const
+{
+    return ar::core::render_backend::get_type_name(render_backend_type::opengl);
+}
+
+void ar::core::gl_render_backend::get_output_size(uint32_t& width, uint32_t& height)
+{
+    int output_width  = 0;
+    int output_height = 0;
+    SDL_GL_GetDrawableSize(_window, &output_width, &output_height);
+
+    width  = static_cast<uint32_t>(std::max(output_width, 0));
+    height = static_cast<uint32_t>(std::max(output_height, 0));
+}
+
+bool ar::core::gl_render_backend::scales_frames() const
+{
+    return true;
+}
+
+void ar::core::gl_render_backend::load_functions()
+{
+    std::string missing;
+
+#define AR_GL_LOAD_FUNCTION(name)                                                                                     \
+    _gl->name = reinterpret_cast<decltype(_gl->name)>(SDL_GL_GetProcAddress(#name));                                  \
+    if (_gl->name == nullptr)                                                                                         \
+    {                                                                                                                 \
+        missing += std::string(missing.empty() ? "" : ", ") + #name;                                                  \
+    }
+
+    AR_GL_FUNCTIONS(AR_GL_LOAD_FUNCTION)
+
+#undef AR_GL_LOAD_FUNCTION
+
+    if (!missing.empty())
+    {
+        // 'destroy' only deletes objects if the functions are loaded
+        *_gl = gl_functions {};
+
+        throw ar::error::os_error("OpenGL driver does not provide: " + missing);
+    }
+
+    GLint major = 0;
+    GLint minor = 0;
+    _gl->glGetIntegerv(GL_MAJOR_VERSION, &major);
+    _gl->glGetIntegerv(GL_MINOR_VERSION, &minor);
+
+    if (major < 3 || (major == 3 && minor < 3))
+    {
+        throw ar::error::os_error("OpenGL 3.3 is required, context provides " + std::to_string(major) + "." +
+                                  std::to_string(minor));
+    }
+
+    bool has_buffer_storage = major > 4 || (major == 4 && minor >= 4);
+
+    GLint extension_count = 0;
+    _gl->glGetIntegerv(GL_NUM_EXTENSIONS, &extension_count);
+
+    for (GLint i = 0; i < extension_count && !has_buffer_storage; i++)
+    {
+        const auto* extension = reinterpret_cast<const char*>(_gl->glGetStringi(GL_EXTENSIONS,
+                                                                                static_cast<GLuint>(i)));
+
+        has_buffer_storage = extension != nullptr && std::strcmp(extension, "GL_ARB_buffer_storage") == 0;
+    }
+
+    if (has_buffer_storage)
+    {
+        _gl->glBufferStorage = reinterpret_cast<decltype(_gl->glBufferStorage)>
+                (SDL_GL_GetProcAddress("glBufferStorage"));
+    }
+
+    _persistent_mapping = _gl->glBufferStorage != nullptr;
+}
+
+void ar::core::gl_render_backend::create_program()
+{
+    GLuint vertex_shader   = compile_shader(GL_VERTEX_SHADER, VERTEX_SHADER);
+    GLuint fragment_shader = 0;
+
+    try
+    {
+        fragment_shader = compile_shader(GL_FRAGMENT_SHADER, FRAGMENT_SHADER);
+    }
+    catch (const ar::error::os_error&)
+    {
+        _gl->glDeleteShader(vertex_shader);
+        throw;
+    }
+
+    _program = _gl->glCreateProgram();
+    _gl->glAttachShader(_program, vertex_shader);
+    _gl->glAttachShader(_program, fragment_shader);
+    _gl->glLinkProgram(_program);
+
+    // Program keeps the shaders alive as long as it needs them
+    _gl->glDeleteShader(vertex_shader);
+    _gl->glDeleteShader(fragment_shader);
+
+    GLint linked = GL_FALSE;
+    _gl->glGetProgramiv(_program, GL_LINK_STATUS, &linked);
+
+    if (linked != GL_TRUE)
+    {
+        char log[1024] {};
+        _gl->glGetProgramInfoLog(_program, sizeof(log), nullptr, log);
+
+        throw ar::error::os_error("Unable to link scaling shader. Error: " + std::string(log));
+    }
+
+    _source_size_location = _gl->glGetUniformLocation(_program, "source_size");
+    _output_size_location = _gl->glGetUniformLocation(_program, "output_size");
+
+    _gl->glUseProgram(_program);
+    _gl->glUniform1i(_gl->glGetUniformLocation(_program, "frame"), 0);
+
+    _gl->glGenVertexArrays(1, &_vertex_array);
+}
+
+GLuint ar::core::gl_render_backend::compile_shader(GLenum type, const char* source)
+{
+    GLuint shader = _gl->glCreateShader(type);
+    _gl->glShaderSource(shader, 1, &source, nullptr);
+    _gl->glCompileShader(shader);
+
+    GLint compiled = GL_FALSE;
+    _gl->glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+
+    if (compiled != GL_TRUE)
+    {
+        char log[1024] {};
+        _gl->glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        _gl->glDeleteShader(shader);
+
+        throw ar::error::os_error("Unable to compile scaling shader. Error: " + std::string(log));
+    }
+
+    return shader;
+}
+
+bool ar::core::gl_render_backend::create_frame_objects(uint32_t width, uint32_t height)
+{
+    auto frame_size = static_cast<GLsizeiptr>(static_cast<std::size_t>(width) * height * sizeof(uint32_t));
+
+    // Flush errors of earlier calls so that only errors of this function are checked at the end
+    while (_gl->glGetError() != GL_NO_ERROR)
+    {
+    }
+
+    _gl->glGenTextures(1, &_texture);
+    _gl->glBindTexture(GL_TEXTURE_2D, _texture);
+    _gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    _gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    _gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    _gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    _gl->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, static_cast<GLsizei>(width), static_cast<GLsizei>(height), 0,
+                      GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    // Rows are tightly packed 4-byte pixels
+    _gl->glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    _gl->glGenBuffers(static_cast<GLsizei>(_pixel_buffers.size()), _pixel_buffers.data());
+
+    for (std::size_t i = 0; i < PIXEL_BUFFER_COUNT; i++)
+    {
+        _gl->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pixel_buffers[i]);
+
+        if (_persistent_mapping)
+        {
+            // Coherent mapping makes CPU writes visible to the upload without explicit flushes
+            GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+            _gl->glBufferStorage(GL_PIXEL_UNPACK_BUFFER, frame_size, nullptr, flags);
+            _mapped_pixel_buffers[i] = _gl->glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, frame_size, flags);
+
+            if (_mapped_pixel_buffers[i] == nullptr)
+            {
+                _gl->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                return false;
+            }
+        }
+        else
+        {
+            _gl->glBufferData(GL_PIXEL_UNPACK_BUFFER, frame_size, nullptr, GL_STREAM_DRAW);
+        }
+    }
+
+    _gl->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    _frame_width  = width;
+    _frame_height = height;
+
+    return _gl->glGetError() == GL_NO_ERROR;
+}
+
+void ar::core::gl_render_backend::destroy_frame_objects()
+{
+    for (std::size_t i = 0; i < PIXEL_BUFFER_COUNT; i++)
+    {
+        wait_for_pixel_buffer(i);
+
+        if (_mapped_pixel_buffers[i] != nullptr)
+        {
+            _gl->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pixel_buffers[i]);
+            _gl->glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            _mapped_pixel_buffers[i] = nullptr;
+        }
+    }
+
+    _gl->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (_pixel_buffers[0] != 0)
+    {
+        _gl->glDeleteBuffers(static_cast<GLsizei>(_pixel_buffers.size()), _pixel_buffers.data());
+        _pixel_buffers.fill(0);
+    }
+
+    if (_texture != 0)
+    {
+        _gl->glDeleteTextures(1, &_texture);
+        _texture = 0;
+    }
+
+    _frame_width  = 0;
+    _frame_height = 0;
+    _has_frame    = false;
+}
+
+void ar::core::gl_render_backend::wait_for_pixel_buffer(std::size_t index)
+{
+    if (_fences[index] == nullptr)
+    {
+        return;
+    }
+
+    _gl->glClientWaitSync(_fences[index], GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT_NS);
+    _gl->glDeleteSync(_fences[index]);
+
+    _fences[index] = nullptr;
+}
+
+void ar::core::gl_render_backend::destroy()
+{
+    // Functions are only missing if loading failed, nothing was created then
+    if (_gl->glDeleteProgram != nullptr)
+    {
+        destroy_frame_objects();
+
+        if (_vertex_array != 0)
+        {
+            _gl->glDeleteVertexArrays(1, &_vertex_array);
+            _vertex_array = 0;
+        }
+
+        if (_program != 0)
+        {
+            _gl->glDeleteProgram(_program);
+            _program = 0;
+        }
+    }
+
+    if (_context != nullptr)
+    {
+        SDL_GL_DeleteContext(_context);
+        _context = nullptr;
+    }
+}
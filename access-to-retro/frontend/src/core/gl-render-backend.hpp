@@ -0,0 +1,161 @@
+/**
+ * @file core/gl-render-backend.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_FRONTEND_GL_RENDER_BACKEND_HPP
+#define ACCESS_TO_RETRO_FRONTEND_GL_RENDER_BACKEND_HPP
+
+#include <SDL_opengl.h>
+#include <array>
+#include <memory>
+#include "render-backend.hpp"
+
+namespace ar::core
+{
+    /**
+     * @brief Render backend using OpenGL 3.3 core, frames are streamed through pixel buffer objects
+     * @details Frame is written into one of 'PIXEL_BUFFER_COUNT' pixel buffers used round-robin, the texture upload
+     *          from it is queued on the GPU and a fence is placed behind it. Writing into a buffer only waits for its
+     *          own fence, so the upload of the previous frames overlaps with the next ones instead of stalling. With
+     *          OpenGL 4.4 or ARB_buffer_storage the buffers stay mapped for the whole lifetime of the backend,
+     *          otherwise they are mapped unsynchronized on every frame (the fence already did the synchronization).
+     *
+     *          Scaling happens in the fragment shader (sharp bilinear: nearest inside source pixels, linear only across
+     *          their edges) drawn into the letterbox, so the frame is uploaded in its own size. Works with Mesa's
+     *          llvmpipe ('LIBGL_ALWAYS_SOFTWARE=1').
+     */
+    class gl_render_backend : public render_backend
+    {
+    public:
+        /**
+         * @brief Default constructor, creates OpenGL context for the window and makes it current on this thread
+         * @param window Window that the frames will be shown in, has to be created with 'SDL_WINDOW_OPENGL'
+         * @param vsync Whether presenting should wait for vertical sync
+         * @throws Exceptions:
+         *  - ar::error::os_error: When the context, shaders or buffers could not be created
+         */
+        gl_render_backend(SDL_Window* window, bool vsync);
+
+        /// @brief Destroys OpenGL objects and the context
+        ~gl_render_backend() override;
+
+        gl_render_backend(const gl_render_backend&) = delete;
+        gl_render_backend& operator=(const gl_render_backend&) = delete;
+
+        void* lock_frame(uint32_t width, uint32_t height, std::size_t& pitch) override;
+
+        void unlock_frame() override;
+
+        void present() override;
+
+        [[nodiscard]] std::string get_name() const override;
+
+        void get_output_size(uint32_t& width, uint32_t& height) override;
+
+        [[nodiscard]] bool scales_frames() const override;
+
+    private:
+        /// @brief OpenGL functions loaded through 'SDL_GL_GetProcAddress', defined in the source file
+        struct gl_functions;
+
+        /// @brief Number of pixel buffers used round-robin, one being written, one uploading and one spare
+        static constexpr std::size_t PIXEL_BUFFER_COUNT = 3;
+
+        /// @brief Longest wait for a pixel buffer's upload to finish, only reached if the driver hangs
+        static constexpr GLuint64 FENCE_TIMEOUT_NS = 1'000'000'000;
+
+        /// @brief Window that the frames are shown in
+        SDL_Window* _window;
+
+        /// @brief OpenGL context owned by this backend
+        SDL_GLContext _context = nullptr;
+
+        /// @brief Loaded OpenGL functions
+        std::unique_ptr<gl_functions> _gl;
+
+        /// @brief Whether pixel buffers are persistently mapped (OpenGL 4.4 or ARB_buffer_storage)
+        bool _persistent_mapping = false;
+
+        /// @brief Shader program scaling the frame
+        GLuint _program = 0;
+
+        /// @brief Empty vertex array, core profile needs one bound to draw (vertices are generated in the shader)
+        GLuint _vertex_array = 0;
+
+        /// @brief Location of 'source_size' uniform
+        GLint _source_size_location = -1;
+
+        /// @brief Location of 'output_size' uniform
+        GLint _output_size_location = -1;
+
+        /// @brief Texture holding the last frame
+        GLuint _texture = 0;
+
+        /// @brief Pixel buffers the frames are written into
+        std::array<GLuint, PIXEL_BUFFER_COUNT> _pixel_buffers {};
+
+        /// @brief Memory of persistently mapped pixel buffers
+        std::array<void*, PIXEL_BUFFER_COUNT> _mapped_pixel_buffers {};
+
+        /// @brief Fence behind the last upload from each pixel buffer, nullptr if the buffer is free
+        std::array<GLsync, PIXEL_BUFFER_COUNT> _fences {};
+
+        /// @brief Pixel buffer used by the current or the last frame
+        std::size_t _pixel_buffer_index = 0;
+
+        /// @brief Width of the frame (and the texture)
+        uint32_t _frame_width = 0;
+
+        /// @brief Height of the frame (and the texture)
+        uint32_t _frame_height = 0;
+
+        /// @brief Whether a frame was uploaded into the texture
+        bool _has_frame = false;
+
+        /**
+         * @brief Load OpenGL functions and check the version
+         * @throws Exceptions:
+         *  - ar::error::os_error: When the context does not provide OpenGL 3.3 or a function is missing
+         */
+        void load_functions();
+
+        /**
+         * @brief Compile and link the scaling shader program
+         * @throws Exceptions:
+         *  - ar::error::os_error: When a shader could not be compiled or linked
+         */
+        void create_program();
+
+        /**
+         * @brief Compile a single shader
+         * @param type Type of the shader
+         * @param source GLSL source of the shader
+         * @return Compiled shader
+         * @throws Exceptions:
+         *  - ar::error::os_error: When the shader could not be compiled
+         */
+        GLuint compile_shader(GLenum type, const char* source);
+
+        /**
+         * @brief (Re)create the texture and pixel buffers for a frame size
+         * @param width Width of the frame
+         * @param height Height of the frame
+         * @return Whether the buffers were created
+         */
+        bool create_frame_objects(uint32_t width, uint32_t height);
+
+        /// @brief Destroy the texture and pixel buffers, waits for pending uploads
+        void destroy_frame_objects();
+
+        /**
+         * @brief Wait until the last upload from a pixel buffer has finished
+         * @param index Index of the pixel buffer
+         */
+        void wait_for_pixel_buffer(std::size_t index);
+
+        /// @brief Destroy all OpenGL objects and the context, used by the destructor and failed construction
+        void destroy();
+    };
+}
+
+#endif //ACCESS_TO_RETRO_FRONTEND_GL_RENDER_BACKEND_HPP
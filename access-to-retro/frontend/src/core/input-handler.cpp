@@ -1,4 +1,3 @@
-#include <QKeyEvent>
 #include "util/logger.hpp"
 #include "input-handler.hpp"
 
@@ -6,32 +5,34 @@ ar::core::input_handler::input_handler(std::unique_ptr<core::virtual_console>& v
         _settings_manager(ar::util::settings_manager::get_global_manager()),
         _virtual_console(virtual_console)
 {
-    fill_input_translation_map_from_settings();
+    fill_input_translation_table_from_settings();
 
     // Get key setting function from the library
-    _set_key_status_fn = _virtual_console->get_symbol_from_library
-            <void(*)(ar_unified_controller_key, ar_unified_controller_key_status)>("ar_set_unified_controller_key_status");
+    _set_key_status_fn = _virtual_console->get_symbol_from_library<set_key_status_fn>
+            ("ar_set_unified_controller_key_status");
 }
 
-void ar::core::input_handler::key_press(const std::string& key)
+void ar::core::input_handler::key_press(ar::core::key_id key)
 {
+    ar::core::profile_zone zone(_virtual_console->access_profiler(), "input key press");
+
     // This key is found inside settings - let virtual console know that Unified Controller button was pressed
-    if (_input_translation_map.contains(key))
+    std::optional<ar_unified_controller_key> unified_key = _input_translation_table.translate(key);
+    if (unified_key != std::nullopt)
     {
-        ar_unified_controller_key unified_key = _input_translation_map[key];
-
-        _set_key_status_fn(unified_key, ar_key_status_pressed);
+        _set_key_status_fn(unified_key.value(), ar_key_status_pressed);
     }
 }
 
-void ar::core::input_handler::key_release(const std::string& key)
+void ar::core::input_handler::key_release(ar::core::key_id key)
 {
+    ar::core::profile_zone zone(_virtual_console->access_profiler(), "input key release");
+
     // This key is found inside settings - let virtual console know that Unified Controller button was released
-    if (_input_translation_map.contains(key))
+    std::optional<ar_unified_controller_key> unified_key = _input_translation_table.translate(key);
+    if (unified_key != std::nullopt)
     {
-        ar_unified_controller_key unified_key = _input_translation_map[key];
-
-        _set_key_status_fn(unified_key, ar_key_status_released);
+        _set_key_status_fn(unified_key.value(), ar_key_status_released);
     }
 }
 
@@ -74,14 +75,21 @@ static std::pair<std::string, ar_unified_controller_key>
                 { "input_right_trigger",      ar_unified_controller_right_trigger },
         };
 
-void ar::core::input_handler::fill_input_translation_map_from_settings()
+void ar::core::input_handler::fill_input_translation_table_from_settings()
 {
     for (const auto& setting_key_pair : key_setting_and_key_enum_list)
     {
         auto setting = _settings_manager->get_setting(setting_key_pair.first);
-        if (setting != std::nullopt)
+        if (setting == std::nullopt)
+        {
+            continue;
+        }
+
+        // Key names are only parsed here, once, so that key events can be translated using raw key codes
+        auto key = ar::core::key_translation_table::key_id_from_string(setting.value());
+        if (key == std::nullopt || !_input_translation_table.map(key.value(), setting_key_pair.second))
         {
-            _input_translation_map.insert({ setting.value(), setting_key_pair.second });
+            LOG_WARNING("Unable to map key '" + setting.value() + "' set for '" + setting_key_pair.first + "'");
         }
     }
 }
@@ -6,16 +6,13 @@
 #define ACCESS_TO_RETRO_INPUT_HANDLER_HPP
 
 #include <access-to-retro-dev/access-to-retro-dev.h>
-#include <unordered_map>
 #include <memory>
+#include "core/key-translation-table.hpp"
 #include "core/virtual-console.hpp"
 #include "util/settings-manager.hpp"
 
 namespace ar::core
 {
-    /// @brief Type representing ID of a Qt key (keyboard/gamepad)
-    typedef int key_id;
-
     /// @brief Handles gamepad/keyboard inputs for the virtual console
     class input_handler
     {
@@ -28,39 +25,41 @@ namespace ar::core
 
         /**
          * @brief Handles key press event
-         * @param key Pressed key name
+         * @param key Pressed key's Qt key code
          */
-        void key_press(const std::string& key);
+        void key_press(ar::core::key_id key);
 
         /**
          * @brief Handles key release event
-         * @param key Released key name
+         * @param key Released key's Qt key code
          */
-        void key_release(const std::string& key);
+        void key_release(ar::core::key_id key);
 
     private:
+        /// @brief Access to Retro library function used to set key status
+        typedef void(* set_key_status_fn)(ar_unified_controller_key, ar_unified_controller_key_status);
+
         /// @brief Global settings manager used to get user's input settings
         std::shared_ptr<ar::util::settings_manager> _settings_manager;
 
         /// @brief Virtual console that the inputs will be directed to
-        std::unique_ptr<ar::core::virtual_console>                                       & _virtual_console;
+        std::unique_ptr<ar::core::virtual_console>& _virtual_console;
 
         /// @brief Access to Retro library function to set key status, fetches from '_virtual_console' in constructor
-        std::function<void(ar_unified_controller_key, ar_unified_controller_key_status)> _set_key_status_fn;
+        set_key_status_fn _set_key_status_fn = nullptr;
 
         /**
-         * @brief Map used for input translation Qt -> Unified Controller
-         * @details Whenever a button is pressed it will be translated from its string value into the enum
-         *          of unified controller:
+         * @brief Table used for input translation Qt -> Unified Controller
+         * @details Whenever a button is pressed its Qt key code will be translated into the enum of unified controller:
          *
-         *          KEY_NAME (is =) CURRENTLY_PRESSED_KEY
-         *          MAP[KEY_NAME] (gives ->) CONTROLLER_KEY
+         *          KEY_CODE (is =) CURRENTLY_PRESSED_KEY
+         *          TABLE[KEY_CODE] (gives ->) CONTROLLER_KEY
          *          CONTROLLER_KEY (is) MARKED AS PRESSED
          */
-        std::unordered_map<std::string, ar_unified_controller_key> _input_translation_map;
+        ar::core::key_translation_table _input_translation_table;
 
-        /// @brief Fill input translation map from settings
-        void fill_input_translation_map_from_settings();
+        /// @brief Fill input translation table from settings
+        void fill_input_translation_table_from_settings();
     };
 }
 
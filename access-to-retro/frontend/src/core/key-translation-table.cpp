@@ -0,0 +1,39 @@
+#include <QKeySequence>
+#include "key-translation-table.hpp"
+
+ar::core::key_translation_table::key_translation_table()
+{
+    clear();
+}
+
+bool ar::core::key_translation_table::map(ar::core::key_id key, ar_unified_controller_key unified_key)
+{
+    std::size_t index = index_of(key);
+
+    // Key is outside of supported ranges, last entry must always stay unmapped
+    if (index == TABLE_SIZE)
+    {
+        return false;
+    }
+
+    _entries[index] = static_cast<int8_t>(unified_key);
+
+    return true;
+}
+
+void ar::core::key_translation_table::clear()
+{
+    _entries.fill(UNMAPPED);
+}
+
+std::optional<ar::core::key_id> ar::core::key_translation_table::key_id_from_string(const std::string& key_name)
+{
+    // Settings store keys using 'QKeySequence::toString' so use the reverse conversion
+    QKeySequence sequence = QKeySequence::fromString(QString::fromStdString(key_name));
+    if (sequence.isEmpty())
+    {
+        return std::nullopt;
+    }
+
+    return static_cast<ar::core::key_id>(sequence[0].key());
+}
@@ -0,0 +1,103 @@
+/**
+ * @file core/key-translation-table.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_KEY_TRANSLATION_TABLE_HPP
+#define ACCESS_TO_RETRO_KEY_TRANSLATION_TABLE_HPP
+
+#include <access-to-retro-dev/access-to-retro-dev.h>
+#include <optional>
+#include <cstdint>
+#include <string>
+#include <array>
+
+namespace ar::core
+{
+    /// @brief Type representing ID of a Qt key (keyboard/gamepad)
+    typedef int key_id;
+
+    /**
+     * @brief Flat lookup table used for input translation Qt -> Unified Controller
+     * @details Qt key codes are split into two ranges that we care about, Latin-1 keys (0x00 - 0xFF) and special
+     *          keys such as arrows or F1 (0x01000000 - 0x010000FF). Both ranges are folded into one small array so that
+     *          translating a key is a single array index with no hashing and no heap allocation.
+     *
+     *          The table is compiled once from settings, key events are then translated by their raw key code.
+     */
+    class key_translation_table
+    {
+    public:
+        /// @brief Represents number of entries in the table, 256 Latin-1 keys + 256 special keys
+        static constexpr std::size_t TABLE_SIZE = 512;
+
+        key_translation_table();
+
+        /**
+         * @brief Map Qt's key to Unified Controller key
+         * @remark Keys that cannot be represented in the table (see class details) are ignored
+         * @param key Qt's key code
+         * @param unified_key Unified Controller key that the Qt's key will be translated to
+         * @return Whether the key was mapped
+         */
+        bool map(key_id key, ar_unified_controller_key unified_key);
+
+        /// @brief Remove all mappings from the table
+        void clear();
+
+        /**
+         * @brief Translate Qt's key to Unified Controller key
+         * @param key Qt's key code
+         * @return Unified Controller key or nothing if the key is not mapped
+         */
+        [[nodiscard]] std::optional<ar_unified_controller_key> translate(key_id key) const
+        {
+            int8_t entry = _entries[index_of(key)];
+
+            if (entry == UNMAPPED)
+            {
+                return std::nullopt;
+            }
+
+            return static_cast<ar_unified_controller_key>(entry);
+        }
+
+        /**
+         * @brief Convert key name (as stored inside the settings file) to Qt's key code
+         * @param key_name Name of the key, for example: 'A' or 'Left'
+         * @return Qt's key code or nothing if the name is not a valid key
+         */
+        [[nodiscard]] static std::optional<key_id> key_id_from_string(const std::string& key_name);
+
+    private:
+        /// @brief Value of an entry that has no Unified Controller key mapped to it
+        static constexpr int8_t UNMAPPED = -1;
+
+        /// @brief First Qt key code of special keys range (Qt::Key_Escape)
+        static constexpr uint32_t SPECIAL_KEYS_START = 0x01000000;
+
+        /**
+         * @brief Translation entries, indexed using 'index_of'
+         * @details Extra last entry is always unmapped, keys outside of supported ranges are redirected to it so that
+         *          'translate' does not need to branch on the range.
+         */
+        std::array<int8_t, TABLE_SIZE + 1> _entries {};
+
+        /**
+         * @brief Fold Qt's key code into table index
+         * @param key Qt's key code
+         * @return Index into '_entries', 'TABLE_SIZE' if the key is outside of supported ranges
+         */
+        static constexpr std::size_t index_of(key_id key)
+        {
+            auto code = static_cast<uint32_t>(key);
+
+            // Latin-1 keys go to the lower half of the table, special keys to the upper one
+            uint32_t offset = code >= SPECIAL_KEYS_START ? code - SPECIAL_KEYS_START : code;
+            uint32_t half   = code >= SPECIAL_KEYS_START ? 256 : 0;
+
+            return offset <= 0xFF ? half + offset : TABLE_SIZE;
+        }
+    };
+}
+
+#endif //ACCESS_TO_RETRO_KEY_TRANSLATION_TABLE_HPP
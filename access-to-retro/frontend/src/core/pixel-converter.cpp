@@ -0,0 +1,614 @@
+#include <algorithm>
+#include <cstring>
+#include "pixel-converter.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+
+/// @brief SSE2 is part of every x86-64 CPU
+#define AR_CONVERTER_SSE2
+
+#if defined(__GNUC__) || defined(__clang__)
+/// @brief AVX2 kernels are compiled for AVX2 only, they're selected at runtime if the CPU supports it
+#define AR_CONVERTER_AVX2
+#define AR_CONVERTER_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(__AVX2__)
+#define AR_CONVERTER_AVX2
+#define AR_CONVERTER_AVX2_TARGET
+#endif
+
+#endif
+
+/// @brief Opacity of formats that do not store it, in the position of 'ar_pixel::a' inside a packed pixel
+static constexpr uint32_t OPAQUE_ALPHA = 0xFF000000;
+
+/****************************************************************************************************
+ Helpers
+****************************************************************************************************/
+
+/**
+ * @brief Pack colour channels into a 32-bit value with the same memory layout as 'ar_pixel'
+ * @param r Value of red colour
+ * @param g Value of green colour
+ * @param b Value of blue colour
+ * @param a Value of opacity
+ * @return Packed pixel
+ */
+static uint32_t pack_pixel(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+{
+    ar_pixel pixel { r, g, b, a };
+
+    uint32_t packed;
+    std::memcpy(&packed, &pixel, sizeof(packed));
+
+    return packed;
+}
+
+/**
+ * @brief Convert a single RGB565 pixel
+ * @param value RGB565 pixel
+ * @return Packed pixel
+ */
+static uint32_t convert_rgb565_pixel(uint16_t value)
+{
+    auto r = static_cast<uint32_t>(value >> 11) & 0x1F;
+    auto g = static_cast<uint32_t>(value >> 5) & 0x3F;
+    auto b = static_cast<uint32_t>(value) & 0x1F;
+
+    // Replicate top bits into the bottom ones so that full intensity maps to 0xFF
+    return pack_pixel(static_cast<uint8_t>((r << 3) | (r >> 2)), static_cast<uint8_t>((g << 2) | (g >> 4)),
+                      static_cast<uint8_t>((b << 3) | (b >> 2)), 0xFF);
+}
+
+/**
+ * @brief Convert a single XRGB8888 pixel
+ * @param value XRGB8888 pixel
+ * @return Packed pixel
+ */
+static uint32_t convert_xrgb8888_pixel(uint32_t value)
+{
+    return pack_pixel(static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value),
+                      0xFF);
+}
+
+/****************************************************************************************************
+ Scalar kernels
+****************************************************************************************************/
+
+/**
+ * @brief Convert part of a 1bpp row, plain C++
+ * @param source Source row
+ * @param destination Destination row
+ * @param first First pixel to convert
+ * @param width Width of the row
+ * @param palette Packed palette
+ */
+static void convert_1bpp_pixels(const uint8_t* source, uint32_t* destination, uint32_t first, uint32_t width,
+                                const uint32_t* palette)
+{
+    for (uint32_t x = first; x < width; x++)
+    {
+        destination[x] = palette[(source[x / 8] >> (7 - x % 8)) & 1];
+    }
+}
+
+static void convert_row_1bpp_scalar(const uint8_t* source, uint32_t* destination, uint32_t width,
+                                    const uint32_t* palette)
+{
+    convert_1bpp_pixels(source, destination, 0, width, palette);
+}
+
+/**
+ * @brief Convert part of a 2bpp row using the expansion table, plain C++
+ * @param source Source row
+ * @param destination Destination row
+ * @param first First pixel to convert, multiple of 4
+ * @param width Width of the row
+ * @param expansion_table All 4 pixels of every possible byte
+ */
+static void convert_2bpp_pixels(const uint8_t* source, uint32_t* destination, uint32_t first, uint32_t width,
+                                const uint32_t* expansion_table)
+{
+    for (uint32_t x = first; x < width; x++)
+    {
+        destination[x] = expansion_table[source[x / 4] * 4 + x % 4];
+    }
+}
+
+static void convert_row_2bpp_scalar(const uint8_t* source, uint32_t* destination, uint32_t width,
+                                    const uint32_t* expansion_table)
+{
+    convert_2bpp_pixels(source, destination, 0, width, expansion_table);
+}
+
+static void convert_row_8bpp_scalar(const uint8_t* source, uint32_t* destination, uint32_t width,
+                                    const uint32_t* palette)
+{
+    for (uint32_t x = 0; x < width; x++)
+    {
+        destination[x] = palette[source[x]];
+    }
+}
+
+/**
+ * @brief Convert part of an RGB565 row, plain C++
+ * @param source Source row
+ * @param destination Destination row
+ * @param first First pixel to convert
+ * @param width Width of the row
+ */
+static void convert_rgb565_pixels(const uint8_t* source, uint32_t* destination, uint32_t first, uint32_t width)
+{
+    for (uint32_t x = first; x < width; x++)
+    {
+        uint16_t value;
+        std::memcpy(&value, source + x * sizeof(value), sizeof(value));
+
+        destination[x] = convert_rgb565_pixel(value);
+    }
+}
+
+static void convert_row_rgb565_scalar(const uint8_t* source, uint32_t* destination, uint32_t width,
+                                      [[maybe_unused]] const uint32_t* palette)
+{
+    convert_rgb565_pixels(source, destination, 0, width);
+}
+
+/**
+ * @brief Convert part of an XRGB8888 row, plain C++
+ * @param source Source row
+ * @param destination Destination row
+ * @param first First pixel to convert
+ * @param width Width of the row
+ */
+static void convert_xrgb8888_pixels(const uint8_t* source, uint32_t* destination, uint32_t first, uint32_t width)
+{
+    for (uint32_t x = first; x < width; x++)
+    {
+        uint32_t value;
+        std::memcpy(&value, source + x * sizeof(value), sizeof(value));
+
+        destination[x] = convert_xrgb8888_pixel(value);
+    }
+}
+
+static void convert_row_xrgb8888_scalar(const uint8_t* source, uint32_t* destination, uint32_t width,
+                                        [[maybe_unused]] const uint32_t* palette)
+{
+    convert_xrgb8888_pixels(source, destination, 0, width);
+}
+
+static void convert_row_rgba8888(const uint8_t* source, uint32_t* destination, uint32_t width,
+                                 [[maybe_unused]] const uint32_t* palette)
+{
+    // Already in the destination format
+    std::memcpy(destination, source, width * sizeof(ar_pixel));
+}
+
+#ifdef AR_CONVERTER_SSE2
+
+/****************************************************************************************************
+ SSE2 kernels
+****************************************************************************************************/
+
+static void convert_row_1bpp_sse2(const uint8_t* source, uint32_t* destination, uint32_t width,
+                                  const uint32_t* palette)
+{
+    // Lane 0 is the leftmost pixel which is the most significant bit
+    const __m128i left_bits  = _mm_set_epi32(0x10, 0x20, 0x40, 0x80);
+    const __m128i right_bits = _mm_set_epi32(0x01, 0x02, 0x04, 0x08);
+    const __m128i colour_0   = _mm_set1_epi32(static_cast<int>(palette[0]));
+    const __m128i colour_1   = _mm_set1_epi32(static_cast<int>(palette[1]));
+
+    uint32_t full_bytes = width / 8;
+
+    for (uint32_t i = 0; i < full_bytes; i++)
+    {
+        __m128i byte = _mm_set1_epi32(source[i]);
+
+        // Lanes whose bit is set become all ones and select colour 1
+        __m128i left_mask  = _mm_cmpeq_epi32(_mm_and_si128(byte, left_bits), left_bits);
+        __m128i right_mask = _mm_cmpeq_epi32(_mm_and_si128(byte, right_bits), right_bits);
+
+        __m128i left  = _mm_or_si128(_mm_and_si128(left_mask, colour_1), _mm_andnot_si128(left_mask, colour_0));
+        __m128i right = _mm_or_si128(_mm_and_si128(right_mask, colour_1), _mm_andnot_si128(right_mask, colour_0));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 8), left);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 8 + 4), right);
+    }
+
+    convert_1bpp_pixels(source, destination, full_bytes * 8, width, palette);
+}
+
+static void convert_row_2bpp_sse2(const uint8_t* source, uint32_t* destination, uint32_t width,
+                                  const uint32_t* expansion_table)
+{
+    uint32_t full_bytes = width / 4;
+
+    // Each byte expands into exactly one vector of 4 pixels
+    for (uint32_t i = 0; i < full_bytes; i++)
+    {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(expansion_table + source[i] * 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), pixels);
+    }
+
+    convert_2bpp_pixels(source, destination, full_bytes * 4, width, expansion_table);
+}
+
+static void convert_row_rgb565_sse2(const uint8_t* source, uint32_t* destination, uint32_t width,
+                                    [[maybe_unused]] const uint32_t* palette)
+{
+    const __m128i zero   = _mm_setzero_si128();
+    const __m128i mask_5 = _mm_set1_epi32(0x1F);
+    const __m128i mask_6 = _mm_set1_epi32(0x3F);
+    const __m128i alpha  = _mm_set1_epi32(static_cast<int>(OPAQUE_ALPHA));
+
+    uint32_t full_blocks = width / 8;
+
+    for (uint32_t i = 0; i < full_blocks; i++)
+    {
+        __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 16));
+
+        // Widen 8 16-bit pixels into two vectors of 4 32-bit pixels
+        __m128i halves[2] = { _mm_unpacklo_epi16(values, zero), _mm_unpackhi_epi16(values, zero) };
+
+        for (std::size_t half = 0; half < 2; half++)
+        {
+            __m128i r = _mm_and_si128(_mm_srli_epi32(halves[half], 11), mask_5);
+            __m128i g = _mm_and_si128(_mm_srli_epi32(halves[half], 5), mask_6);
+            __m128i b = _mm_and_si128(halves[half], mask_5);
+
+            r = _mm_or_si128(_mm_slli_epi32(r, 3), _mm_srli_epi32(r, 2));
+            g = _mm_or_si128(_mm_slli_epi32(g, 2), _mm_srli_epi32(g, 4));
+            b = _mm_or_si128(_mm_slli_epi32(b, 3), _mm_srli_epi32(b, 2));
+
+            __m128i pixels = _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)),
+                                          _mm_or_si128(_mm_slli_epi32(b, 16), alpha));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 8 + half * 4), pixels);
+        }
+    }
+
+    convert_rgb565_pixels(source, destination, full_blocks * 8, width);
+}
+
+static void convert_row_xrgb8888_sse2(const uint8_t* source, uint32_t* destination, uint32_t width,
+                                      [[maybe_unused]] const uint32_t* palette)
+{
+    const __m128i mask_byte = _mm_set1_epi32(0xFF);
+    const __m128i mask_g    = _mm_set1_epi32(0xFF00);
+    const __m128i alpha     = _mm_set1_epi32(static_cast<int>(OPAQUE_ALPHA));
+
+    uint32_t full_blocks = width / 4;
+
+    for (uint32_t i = 0; i < full_blocks; i++)
+    {
+        __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 16));
+
+        // Swap red and blue, keep green and replace the ignored byte with full opacity
+        __m128i r = _mm_and_si128(_mm_srli_epi32(values, 16), mask_byte);
+        __m128i g = _mm_and_si128(values, mask_g);
+        __m128i b = _mm_slli_epi32(_mm_and_si128(values, mask_byte), 16);
+
+        __m128i pixels = _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, alpha));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), pixels);
+    }
+
+    convert_xrgb8888_pixels(source, destination, full_blocks * 4, width);
+}
+
+#endif
+
+#ifdef AR_CONVERTER_AVX2
+
+/****************************************************************************************************
+ AVX2 kernels
+****************************************************************************************************/
+
+AR_CONVERTER_AVX2_TARGET static void convert_row_1bpp_avx2(const uint8_t* source, uint32_t* destination,
+                                                           uint32_t width, const uint32_t* palette)
+{
+    // Lane 0 is the leftmost pixel which is the most significant bit
+    const __m256i bits     = _mm256_set_epi32(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80);
+    const __m256i colour_0 = _mm256_set1_epi32(static_cast<int>(palette[0]));
+    const __m256i colour_1 = _mm256_set1_epi32(static_cast<int>(palette[1]));
+
+    uint32_t full_bytes = width / 8;
+
+    for (uint32_t i = 0; i < full_bytes; i++)
+    {
+        __m256i mask = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(source[i]), bits), bits);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * 8),
+                            _mm256_blendv_epi8(colour_0, colour_1, mask));
+    }
+
+    convert_1bpp_pixels(source, destination, full_bytes * 8, width, palette);
+}
+
+AR_CONVERTER_AVX2_TARGET static void convert_row_8bpp_avx2(const uint8_t* source, uint32_t* destination,
+                                                           uint32_t width, const uint32_t* palette)
+{
+    uint32_t full_blocks = width / 8;
+
+    for (uint32_t i = 0; i < full_blocks; i++)
+    {
+        // Widen 8 indices to 32 bits and look all of them up at once
+        __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + i * 8)));
+        __m256i pixels  = _mm256_i32gather_epi32(reinterpret_cast<const int*>(palette), indices, 4);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * 8), pixels);
+    }
+
+    for (uint32_t x = full_blocks * 8; x < width; x++)
+    {
+        destination[x] = palette[source[x]];
+    }
+}
+
+AR_CONVERTER_AVX2_TARGET static void convert_row_rgb565_avx2(const uint8_t* source, uint32_t* destination,
+                                                             uint32_t width, [[maybe_unused]] const uint32_t* palette)
+{
+    const __m256i mask_5 = _mm256_set1_epi32(0x1F);
+    const __m256i mask_6 = _mm256_set1_epi32(0x3F);
+    const __m256i alpha  = _mm256_set1_epi32(static_cast<int>(OPAQUE_ALPHA));
+
+    uint32_t full_blocks = width / 8;
+
+    for (uint32_t i = 0; i < full_blocks; i++)
+    {
+        __m256i values = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 16)));
+
+        __m256i r = _mm256_and_si256(_mm256_srli_epi32(values, 11), mask_5);
+        __m256i g = _mm256_and_si256(_mm256_srli_epi32(values, 5), mask_6);
+        __m256i b = _mm256_and_si256(values, mask_5);
+
+        r = _mm256_or_si256(_mm256_slli_epi32(r, 3), _mm256_srli_epi32(r, 2));
+        g = _mm256_or_si256(_mm256_slli_epi32(g, 2), _mm256_srli_epi32(g, 4));
+        b = _mm256_or_si256(_mm256_slli_epi32(b, 3), _mm256_srli_epi32(b, 2));
+
+        __m256i pixels = _mm256_or_si256(_mm256_or_si256(r, _mm256_slli_epi32(g, 8)),
+                                         _mm256_or_si256(_mm256_slli_epi32(b, 16), alpha));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * 8), pixels);
+    }
+
+    convert_rgb565_pixels(source, destination, full_blocks * 8, width);
+}
+
+AR_CONVERTER_AVX2_TARGET static void convert_row_xrgb8888_avx2(const uint8_t* source, uint32_t* destination,
+                                                               uint32_t width,
+                                                               [[maybe_unused]] const uint32_t* palette)
+{
+    // Byte shuffle within each pixel: R, G, B from positions 2, 1, 0, position 3 is cleared and replaced by alpha
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1,
+                                             2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    const __m256i alpha   = _mm256_set1_epi32(static_cast<int>(OPAQUE_ALPHA));
+
+    uint32_t full_blocks = width / 8;
+
+    for (uint32_t i = 0; i < full_blocks; i++)
+    {
+        __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i * 32));
+        __m256i pixels = _mm256_or_si256(_mm256_shuffle_epi8(values, shuffle), alpha);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * 8), pixels);
+    }
+
+    convert_xrgb8888_pixels(source, destination, full_blocks * 8, width);
+}
+
+#endif
+
+/****************************************************************************************************
+ pixel_converter
+****************************************************************************************************/
+
+ar::core::pixel_converter::pixel_converter(ar::core::pixel_converter::simd_level simd) :
+        _simd(std::min(simd, get_best_simd_level()))
+{
+    _row_fns[ar_pixel_format_rgba8888]     = convert_row_rgba8888;
+    _row_fns[ar_pixel_format_1bpp]         = convert_row_1bpp_scalar;
+    _row_fns[ar_pixel_format_2bpp_indexed] = convert_row_2bpp_scalar;
+    _row_fns[ar_pixel_format_8bpp_indexed] = convert_row_8bpp_scalar;
+    _row_fns[ar_pixel_format_rgb565]       = convert_row_rgb565_scalar;
+    _row_fns[ar_pixel_format_xrgb8888]     = convert_row_xrgb8888_scalar;
+
+#ifdef AR_CONVERTER_SSE2
+    // SSE2 has no gather, 8bpp stays scalar
+    if (_simd >= simd_level::sse2)
+    {
+        _row_fns[ar_pixel_format_1bpp]         = convert_row_1bpp_sse2;
+        _row_fns[ar_pixel_format_2bpp_indexed] = convert_row_2bpp_sse2;
+        _row_fns[ar_pixel_format_rgb565]       = convert_row_rgb565_sse2;
+        _row_fns[ar_pixel_format_xrgb8888]     = convert_row_xrgb8888_sse2;
+    }
+#endif
+
+#ifdef AR_CONVERTER_AVX2
+    // 2bpp is a plain table copy, wider registers do not help it
+    if (_simd == simd_level::avx2)
+    {
+        _row_fns[ar_pixel_format_1bpp]         = convert_row_1bpp_avx2;
+        _row_fns[ar_pixel_format_8bpp_indexed] = convert_row_8bpp_avx2;
+        _row_fns[ar_pixel_format_rgb565]       = convert_row_rgb565_avx2;
+        _row_fns[ar_pixel_format_xrgb8888]     = convert_row_xrgb8888_avx2;
+    }
+#endif
+}
+
+void ar::core::pixel_converter::convert(ar_pixel_format format, const void* source, std::size_t source_pitch,
+                                        const ar_pixel* palette, uint32_t width, uint32_t height, void* destination,
+                                        std::size_t destination_pitch)
+{
+    update_palette(format, palette);
+
+    row_fn convert_row = _row_fns.at(static_cast<std::size_t>(format));
+
+    const uint32_t* row_palette = format == ar_pixel_format_2bpp_indexed ? _expansion_table.data() : _palette.data();
+
+    const auto* source_row = static_cast<const uint8_t*>(source);
+    auto* destination_row  = static_cast<uint8_t*>(destination);
+
+    for (uint32_t y = 0; y < height; y++)
+    {
+        convert_row(source_row, reinterpret_cast<uint32_t*>(destination_row), width, row_palette);
+
+        source_row += source_pitch;
+        destination_row += destination_pitch;
+    }
+}
+
+ar::core::pixel_converter::simd_level ar::core::pixel_converter::get_simd_level() const
+{
+    return _simd;
+}
+
+std::size_t ar::core::pixel_converter::get_frame_size(ar_pixel_format format, uint32_t width, uint32_t height)
+{
+    std::size_t pitch;
+
+    switch (format)
+    {
+        case ar_pixel_format_1bpp:
+            pitch = (width + 7) / 8;
+            break;
+
+        case ar_pixel_format_2bpp_indexed:
+            pitch = (width + 3) / 4;
+            break;
+
+        case ar_pixel_format_8bpp_indexed:
+            pitch = width;
+            break;
+
+        case ar_pixel_format_rgb565:
+            pitch = width * sizeof(uint16_t);
+            break;
+
+        case ar_pixel_format_xrgb8888:
+            pitch = width * sizeof(uint32_t);
+            break;
+
+        case ar_pixel_format_rgba8888:
+        default:
+            pitch = width * sizeof(ar_pixel);
+            break;
+    }
+
+    return pitch * height;
+}
+
+ar::core::pixel_converter::simd_level ar::core::pixel_converter::get_best_simd_level()
+{
+#if defined(AR_CONVERTER_AVX2) && (defined(__GNUC__) || defined(__clang__))
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return simd_level::avx2;
+    }
+#elif defined(AR_CONVERTER_AVX2)
+    return simd_level::avx2;
+#endif
+
+#ifdef AR_CONVERTER_SSE2
+    return simd_level::sse2;
+#else
+    return simd_level::none;
+#endif
+}
+
+std::string ar::core::pixel_converter::get_simd_level_name(ar::core::pixel_converter::simd_level simd)
+{
+    switch (simd)
+    {
+        case simd_level::sse2:
+            return "SSE2";
+
+        case simd_level::avx2:
+            return "AVX2";
+
+        default:
+            return "None";
+    }
+}
+
+std::string ar::core::pixel_converter::get_pixel_format_name(ar_pixel_format format)
+{
+    switch (format)
+    {
+        case ar_pixel_format_1bpp:
+            return "1bpp";
+
+        case ar_pixel_format_2bpp_indexed:
+            return "2bpp indexed";
+
+        case ar_pixel_format_8bpp_indexed:
+            return "8bpp indexed";
+
+        case ar_pixel_format_rgb565:
+            return "RGB565";
+
+        case ar_pixel_format_xrgb8888:
+            return "XRGB8888";
+
+        case ar_pixel_format_rgba8888:
+        default:
+            return "RGBA8888";
+    }
+}
+
+void ar::core::pixel_converter::update_palette(ar_pixel_format format, const ar_pixel* palette)
+{
+    std::size_t colour_count;
+
+    switch (format)
+    {
+        case ar_pixel_format_1bpp:
+            colour_count = 2;
+            break;
+
+        case ar_pixel_format_2bpp_indexed:
+            colour_count = PIXELS_PER_2BPP_BYTE;
+            break;
+
+        case ar_pixel_format_8bpp_indexed:
+            colour_count = AR_PALETTE_SIZE;
+            break;
+
+        default:
+            return;
+    }
+
+    bool changed = false;
+
+    for (std::size_t i = 0; i < colour_count; i++)
+    {
+        uint32_t packed = pack_pixel(palette[i].r, palette[i].g, palette[i].b, palette[i].a);
+
+        if (packed != _palette[i])
+        {
+            _palette[i] = packed;
+            changed     = true;
+        }
+    }
+
+    if (format != ar_pixel_format_2bpp_indexed)
+    {
+        _expansion_table_valid = _expansion_table_valid && !changed;
+        return;
+    }
+
+    if (changed || !_expansion_table_valid)
+    {
+        for (std::size_t byte = 0; byte < 256; byte++)
+        {
+            for (std::size_t pixel = 0; pixel < PIXELS_PER_2BPP_BYTE; pixel++)
+            {
+                _expansion_table[byte * PIXELS_PER_2BPP_BYTE + pixel] = _palette[(byte >> (6 - pixel * 2)) & 0x3];
+            }
+        }
+
+        _expansion_table_valid = true;
+    }
+}
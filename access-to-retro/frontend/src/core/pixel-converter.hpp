@@ -0,0 +1,131 @@
+/**
+ * @file core/pixel-converter.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_FRONTEND_PIXEL_CONVERTER_HPP
+#define ACCESS_TO_RETRO_FRONTEND_PIXEL_CONVERTER_HPP
+
+#include <access-to-retro-dev/access-to-retro-dev.h>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <array>
+
+namespace ar::core
+{
+    /**
+     * @brief Converts frames from virtual console's native pixel format to 'ar_pixel' (R, G, B, A bytes)
+     * @details Virtual consoles present frames in the smallest format that fits them ('ar_pixel_format'), conversion
+     *          happens once per frame when the frame is uploaded to the texture. Each format has a row kernel for
+     *          every supported instruction set, the best one is selected when the converter is created.
+     */
+    class pixel_converter
+    {
+    public:
+        /// @brief Instruction sets that the row kernels can use
+        enum class simd_level
+        {
+            /// @brief Plain C++
+            none,
+
+            /// @brief SSE2, 4 pixels at once
+            sse2,
+
+            /// @brief AVX2, 8 pixels at once
+            avx2
+        };
+
+        /**
+         * @brief Default constructor
+         * @param simd Instruction set used by the kernels, best supported one is used if it's not supported
+         */
+        explicit pixel_converter(simd_level simd = simd_level::avx2);
+
+        /**
+         * @brief Convert a frame
+         * @param format Format of the source pixels
+         * @param source Source pixels, rows are 'source_pitch' bytes apart
+         * @param source_pitch Number of bytes between the starts of two source rows
+         * @param palette 'AR_PALETTE_SIZE' colours used by indexed formats, ignored by others
+         * @param width Width of the frame
+         * @param height Height of the frame
+         * @param destination Converted pixels, rows are 'destination_pitch' bytes apart
+         * @param destination_pitch Number of bytes between the starts of two destination rows
+         */
+        void convert(ar_pixel_format format, const void* source, std::size_t source_pitch, const ar_pixel* palette,
+                     uint32_t width, uint32_t height, void* destination, std::size_t destination_pitch);
+
+        /**
+         * @brief Get instruction set used by the kernels
+         * @return Instruction set that is actually used
+         */
+        [[nodiscard]] simd_level get_simd_level() const;
+
+        /**
+         * @brief Get number of bytes a frame takes in given format, this is what gets copied on every present
+         * @param format Format of the pixels
+         * @param width Width of the frame
+         * @param height Height of the frame
+         * @return Size of the frame in bytes
+         */
+        [[nodiscard]] static std::size_t get_frame_size(ar_pixel_format format, uint32_t width, uint32_t height);
+
+        /**
+         * @brief Get best instruction set supported by this CPU and build
+         * @return Best supported instruction set
+         */
+        [[nodiscard]] static simd_level get_best_simd_level();
+
+        /**
+         * @brief Get name of the instruction set, for logging
+         * @param simd Instruction set
+         * @return Name of the instruction set
+         */
+        [[nodiscard]] static std::string get_simd_level_name(simd_level simd);
+
+        /**
+         * @brief Get name of the pixel format, for logging
+         * @param format Pixel format
+         * @return Name of the pixel format
+         */
+        [[nodiscard]] static std::string get_pixel_format_name(ar_pixel_format format);
+
+    private:
+        /**
+         * @brief Function converting a single row
+         * @details Palette is passed as packed 'ar_pixel' values so that kernels can copy whole pixels. 2bpp kernels
+         *          get '_expansion_table' instead.
+         */
+        typedef void(* row_fn)(const uint8_t* source, uint32_t* destination, uint32_t width, const uint32_t* palette);
+
+        /// @brief Number of pixels stored in a single 2bpp byte
+        static constexpr std::size_t PIXELS_PER_2BPP_BYTE = 4;
+
+        /// @brief Instruction set used by the kernels
+        simd_level _simd;
+
+        /// @brief Row kernel for each 'ar_pixel_format'
+        std::array<row_fn, 6> _row_fns {};
+
+        /// @brief Palette of the previous frame as packed 'ar_pixel' values, used to skip rebuilding the table
+        std::array<uint32_t, AR_PALETTE_SIZE> _palette {};
+
+        /**
+         * @brief All 4 pixels of every possible 2bpp byte, turns the conversion into a single 16-byte copy per byte
+         * @remark Rebuilt when the first 4 palette colours change
+         */
+        std::array<uint32_t, 256 * PIXELS_PER_2BPP_BYTE> _expansion_table {};
+
+        /// @brief Whether '_expansion_table' matches '_palette'
+        bool _expansion_table_valid = false;
+
+        /**
+         * @brief Update '_palette' and rebuild '_expansion_table' if needed
+         * @param format Format of the frame
+         * @param palette Palette presented with the frame
+         */
+        void update_palette(ar_pixel_format format, const ar_pixel* palette);
+    };
+}
+
+#endif //ACCESS_TO_RETRO_FRONTEND_PIXEL_CONVERTER_HPP
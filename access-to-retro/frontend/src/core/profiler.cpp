@@ -0,0 +1,83 @@
+#include "util/logger.hpp"
+#include "profiler.hpp"
+
+ar::core::profiler::profiler(ar::core::dynamic_library& library)
+{
+    try
+    {
+        // Virtual consoles built against older library do not export profiling functions, this will throw for them
+        _begin_fn             = library.get_symbol<begin_fn>("ar_profile_begin");
+        _end_fn               = library.get_symbol<end_fn>("ar_profile_end");
+        _set_enabled_fn       = library.get_symbol<set_enabled_fn>("ar_profile_set_enabled");
+        _set_thread_name_fn   = library.get_symbol<set_thread_name_fn>("ar_profile_set_thread_name");
+        _write_trace_fn       = library.get_symbol<write_trace_fn>("ar_profile_write_trace");
+        _get_dropped_count_fn = library.get_symbol<get_dropped_count_fn>("ar_profile_get_dropped_count");
+        _clear_fn             = library.get_symbol<clear_fn>("ar_profile_clear");
+    }
+    catch (const ar::error::os_error& ex)
+    {
+        _begin_fn = nullptr;
+
+        LOG_DEBUG("core.profiler", "Profiling is not available: " + ex.get_logger_formatted_error());
+    }
+}
+
+bool ar::core::profiler::is_available() const
+{
+    return _begin_fn != nullptr;
+}
+
+bool ar::core::profiler::is_capturing() const
+{
+    return _capturing;
+}
+
+void ar::core::profiler::start_capture()
+{
+    if (!is_available())
+    {
+        throw ar::error::os_error("Virtual console was built without profiling support");
+    }
+
+    _clear_fn();
+    _set_enabled_fn(true);
+
+    _capturing = true;
+
+    LOG_INFO("Profiling capture started");
+}
+
+void ar::core::profiler::stop_capture(const std::filesystem::path& path)
+{
+    if (!_capturing)
+    {
+        return;
+    }
+
+    _capturing = false;
+    _set_enabled_fn(false);
+
+    ar_err_code result = _write_trace_fn(path.string().c_str());
+    if (result != 0)
+    {
+        throw ar::error::io_error(path.string(), "Unable to write profiling trace (error code " +
+                                                 std::to_string(result) + ")");
+    }
+
+    uint64_t dropped_count = _get_dropped_count_fn();
+    if (dropped_count != 0)
+    {
+        LOG_WARNING("Profiling trace is missing " + std::to_string(dropped_count) +
+                    " events, thread buffers were full");
+    }
+
+    LOG_INFO("Profiling trace written to '" + path.string() + "'");
+}
+
+void ar::core::profiler::set_thread_name(const char* name)
+{
+    if (is_available())
+    {
+        _set_thread_name_fn(name);
+    }
+}
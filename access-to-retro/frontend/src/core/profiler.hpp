@@ -0,0 +1,159 @@
+/**
+ * @file core/profiler.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_FRONTEND_PROFILER_HPP
+#define ACCESS_TO_RETRO_FRONTEND_PROFILER_HPP
+
+#include <access-to-retro-dev/access-to-retro-dev.h>
+#include <atomic>
+#include <filesystem>
+#include "dynamic-library.hpp"
+
+namespace ar::core
+{
+    /**
+     * @brief Records frontend's profiling zones into the virtual console's library and exports them as Chrome trace
+     * @details Zones of the frontend and of the virtual console end up in the same per-thread buffers of the library
+     *          ('ar_profile_begin'), so a single trace shows both. Zones are only passed to the library while a
+     *          capture is running, otherwise a zone is a single branch.
+     */
+    class profiler
+    {
+    public:
+        /**
+         * @brief Default constructor, profiling is unavailable if the library does not export profiling functions
+         * @param library Virtual console's library
+         */
+        explicit profiler(ar::core::dynamic_library& library);
+
+        profiler(const profiler&) = delete;
+        profiler& operator=(const profiler&) = delete;
+
+        /**
+         * @brief Check whether the virtual console's library supports profiling
+         * @return Whether captures can be started
+         */
+        [[nodiscard]] bool is_available() const;
+
+        /**
+         * @brief Check whether zones are being recorded
+         * @return Whether a capture is running
+         */
+        [[nodiscard]] bool is_capturing() const;
+
+        /**
+         * @brief Start recording zones, zones recorded by earlier captures are dropped
+         * @throws Exceptions:
+         *  - ar::error::os_error: When the virtual console's library does not support profiling
+         */
+        void start_capture();
+
+        /**
+         * @brief Stop recording zones and write them as Chrome trace (JSON)
+         * @param path Path of the trace, opened by 'chrome://tracing' and Perfetto
+         * @throws Exceptions:
+         *  - ar::error::io_error: When the trace could not be written
+         */
+        void stop_capture(const std::filesystem::path& path);
+
+        /**
+         * @brief Name the calling thread in traces
+         * @param name Name of the thread, has to stay valid until the trace is written (use string literals)
+         */
+        void set_thread_name(const char* name);
+
+    private:
+        friend class profile_zone;
+
+        /// @brief Access to Retro library function used to begin a zone
+        typedef void(* begin_fn)(const char*);
+
+        /// @brief Access to Retro library function used to end a zone
+        typedef void(* end_fn)();
+
+        /// @brief Access to Retro library function used to enable or disable recording
+        typedef void(* set_enabled_fn)(bool);
+
+        /// @brief Access to Retro library function used to name a thread
+        typedef void(* set_thread_name_fn)(const char*);
+
+        /// @brief Access to Retro library function used to write the trace
+        typedef ar_err_code(* write_trace_fn)(const char*);
+
+        /// @brief Access to Retro library function used to get the number of dropped events
+        typedef uint64_t(* get_dropped_count_fn)();
+
+        /// @brief Access to Retro library function used to drop recorded events, safe while threads record
+        typedef void(* clear_fn)();
+
+        /// @brief Function used to begin a zone, nullptr if profiling is unavailable
+        begin_fn _begin_fn = nullptr;
+
+        /// @brief Function used to end a zone
+        end_fn _end_fn = nullptr;
+
+        /// @brief Function used to enable or disable recording
+        set_enabled_fn _set_enabled_fn = nullptr;
+
+        /// @brief Function used to name a thread
+        set_thread_name_fn _set_thread_name_fn = nullptr;
+
+        /// @brief Function used to write the trace
+        write_trace_fn _write_trace_fn = nullptr;
+
+        /// @brief Function used to get the number of dropped events
+        get_dropped_count_fn _get_dropped_count_fn = nullptr;
+
+        /// @brief Function used to drop recorded events
+        clear_fn _clear_fn = nullptr;
+
+        /// @brief Whether a capture is running, checked by every zone
+        std::atomic_bool _capturing = false;
+    };
+
+    /**
+     * @brief Profiling zone lasting until the end of the scope
+     * @details Zone that began while no capture was running does not end either, so stopping or starting a capture in
+     *          the middle of a zone never leaves unmatched events from the frontend.
+     */
+    class profile_zone
+    {
+    public:
+        /**
+         * @brief Default constructor, begins the zone
+         * @param profiler Profiler of the running virtual console
+         * @param name Name of the zone, has to stay valid until the trace is written (use string literals)
+         */
+        profile_zone(ar::core::profiler& profiler, const char* name) :
+                _profiler(profiler),
+                _active(profiler._capturing.load(std::memory_order_relaxed))
+        {
+            if (_active)
+            {
+                _profiler._begin_fn(name);
+            }
+        }
+
+        /// @brief Ends the zone
+        ~profile_zone()
+        {
+            if (_active)
+            {
+                _profiler._end_fn();
+            }
+        }
+
+        profile_zone(const profile_zone&) = delete;
+        profile_zone& operator=(const profile_zone&) = delete;
+
+    private:
+        /// @brief Profiler the zone is recorded with
+        ar::core::profiler& _profiler;
+
+        /// @brief Whether the zone began
+        const bool _active;
+    };
+}
+
+#endif //ACCESS_TO_RETRO_FRONTEND_PROFILER_HPP
@@ -0,0 +1,32 @@
+#include <algorithm>
+#include "rate-controller.hpp"
+
+ar::core::rate_controller::rate_controller(double target_fill) :
+        _target_fill(target_fill),
+        _smoothed_fill(target_fill)
+{
+
+}
+
+double ar::core::rate_controller::update(double fill)
+{
+    _smoothed_fill += SMOOTHING * (fill - _smoothed_fill);
+
+    /*
+     * Proportional control, the speed changes linearly with the distance from the target:
+     *
+     * Empty queue       -> emulation runs faster by MAX_ADJUSTMENT
+     * Queue at target   -> emulation runs at nominal speed
+     * Queue 2x target   -> emulation runs slower by MAX_ADJUSTMENT
+     */
+    double error = (_target_fill - _smoothed_fill) / _target_fill;
+
+    _speed = 1.0 + std::clamp(error, -1.0, 1.0) * MAX_ADJUSTMENT;
+
+    return _speed;
+}
+
+double ar::core::rate_controller::get_speed() const
+{
+    return _speed;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file core/rate-controller.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_FRONTEND_RATE_CONTROLLER_HPP
+#define ACCESS_TO_RETRO_FRONTEND_RATE_CONTROLLER_HPP
+
+namespace ar::core
+{
+    /**
+     * @brief Dynamic rate control, keeps emulation speed locked to the audio device's clock
+     * @details Emulation is paced by the system timer while audio is consumed by the audio device's own clock, the two
+     *          are never exactly the same so the audio queue slowly fills up (latency grows, eventually overruns) or
+     *          drains (underruns, crackles). Instead of ever dropping or repeating samples, emulation speed is nudged by
+     *          a fraction of a percent towards keeping the queue at its target fill level. Such small change in speed
+     *          is not noticeable by the user, neither in picture nor in pitch.
+     */
+    class rate_controller
+    {
+    public:
+        /// @brief Maximum change of emulation speed (0.5%)
+        static constexpr double MAX_ADJUSTMENT = 0.005;
+
+        /**
+         * @brief Default constructor
+         * @param target_fill Number of queued audio frames that the controller aims for
+         */
+        explicit rate_controller(double target_fill);
+
+        /**
+         * @brief Update the controller with current fill level of the audio queue
+         * @remark Should be called once per emulated frame, right after the frame's samples were pushed
+         * @param fill Number of currently queued audio frames
+         * @return Emulation speed multiplier, in range (1 - MAX_ADJUSTMENT) to (1 + MAX_ADJUSTMENT)
+         */
+        double update(double fill);
+
+        /**
+         * @brief Get the last computed emulation speed multiplier
+         * @return Emulation speed multiplier
+         */
+        [[nodiscard]] double get_speed() const;
+
+    private:
+        /// @brief Weight of a new fill level sample in the moving average, audio is consumed in bursts so it is noisy
+        static constexpr double SMOOTHING = 0.05;
+
+        /// @brief Number of queued audio frames that the controller aims for
+        double _target_fill;
+
+        /// @brief Exponential moving average of the fill level
+        double _smoothed_fill;
+
+        /// @brief Last computed emulation speed multiplier
+        double _speed = 1.0;
+    };
+}
+
+#endif //ACCESS_TO_RETRO_FRONTEND_RATE_CONTROLLER_HPP
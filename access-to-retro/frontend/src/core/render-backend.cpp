@@ -0,0 +1,76 @@
+#include <algorithm>
+#include "sdl-render-backend.hpp"
+#include "cpu-blit-render-backend.hpp"
+#include "gl-render-backend.hpp"
+#include "render-backend.hpp"
+
+std::unique_ptr<ar::core::render_backend> ar::core::render_backend::create(ar::core::render_backend_type type,
+                                                                           SDL_Window* window, bool vsync)
+{
+    switch (type)
+    {
+        case render_backend_type::software:
+            return std::make_unique<ar::core::sdl_render_backend>(window, false, vsync);
+
+        case render_backend_type::cpu_blitter:
+            return std::make_unique<ar::core::cpu_blit_render_backend>(window);
+
+        case render_backend_type::opengl:
+            return std::make_unique<ar::core::gl_render_backend>(window, vsync);
+
+        case render_backend_type::accelerated:
+        default:
+            return std::make_unique<ar::core::sdl_render_backend>(window, true, vsync);
+    }
+}
+
+std::string ar::core::render_backend::get_type_name(ar::core::render_backend_type type)
+{
+    switch (type)
+    {
+        case render_backend_type::software:
+            return "SDL software";
+
+        case render_backend_type::cpu_blitter:
+            return "CPU blitter";
+
+        case render_backend_type::opengl:
+            return "OpenGL";
+
+        case render_backend_type::accelerated:
+        default:
+            return "SDL accelerated";
+    }
+}
+
+bool ar::core::render_backend::scales_frames() const
+{
+    return false;
+}
+
+SDL_Rect ar::core::render_backend::get_letterbox(uint32_t frame_width, uint32_t frame_height, uint32_t output_width,
+                                                 uint32_t output_height)
+{
+    SDL_Rect letterbox { 0, 0, static_cast<int>(output_width), static_cast<int>(output_height) };
+    if (frame_width == 0 || frame_height == 0)
+    {
+        return letterbox;
+    }
+
+    // Compare cross products to pick the limiting side without rounding errors
+    uint64_t width_by_height = static_cast<uint64_t>(output_width) * frame_height;
+    uint64_t height_by_width = static_cast<uint64_t>(output_height) * frame_width;
+
+    if (width_by_height > height_by_width)
+    {
+        letterbox.w = static_cast<int>(height_by_width / frame_height);
+        letterbox.x = (static_cast<int>(output_width) - letterbox.w) / 2;
+    }
+    else
+    {
+        letterbox.h = static_cast<int>(width_by_height / frame_width);
+        letterbox.y = (static_cast<int>(output_height) - letterbox.h) / 2;
+    }
+
+    return letterbox;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file core/render-backend.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_FRONTEND_RENDER_BACKEND_HPP
+#define ACCESS_TO_RETRO_FRONTEND_RENDER_BACKEND_HPP
+
+#include <SDL.h>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace ar::core
+{
+    /// @brief Render backends that can show frame buffer frames, value is the index stored in "rendering" setting
+    enum class render_backend_type
+    {
+        /// @brief SDL renderer using the GPU (OpenGL, Direct3D or Metal depending on the platform)
+        accelerated = 0,
+
+        /// @brief SDL's software renderer
+        software = 1,
+
+        /// @brief Frontend's own CPU blitter writing straight into the window surface
+        cpu_blitter = 2,
+
+        /// @brief Frontend's own OpenGL presenter streaming frames through pixel buffer objects
+        opengl = 3
+    };
+
+    /**
+     * @brief Shows frames converted to 'ar_pixel' (R, G, B, A bytes) in a window
+     * @details Frame is written into memory provided by the backend ('lock_frame') and shown scaled to the largest
+     *          rectangle with frame's aspect ratio that fits the window ('present'), the rest is black. All calls have
+     *          to be made from the thread that created the backend.
+     */
+    class render_backend
+    {
+    public:
+        virtual ~render_backend() = default;
+
+        /**
+         * @brief Get memory for the next frame
+         * @param width Width of the frame
+         * @param height Height of the frame
+         * @param pitch Set to the number of bytes between the starts of two rows
+         * @return Memory to write 'ar_pixel' rows into or nullptr if it could not be provided
+         */
+        virtual void* lock_frame(uint32_t width, uint32_t height, std::size_t& pitch) = 0;
+
+        /// @brief Finish writing the frame, must be called after each successful 'lock_frame'
+        virtual void unlock_frame() = 0;
+
+        /// @brief Show the last frame in the window
+        virtual void present() = 0;
+
+        /**
+         * @brief Get name of the backend, for logging
+         * @return Name of the backend
+         */
+        [[nodiscard]] virtual std::string get_name() const = 0;
+
+        /**
+         * @brief Get size of the area that frames are shown in, in pixels (can differ from window size on HiDPI)
+         * @param width Set to the width of the output
+         * @param height Set to the height of the output
+         */
+        virtual void get_output_size(uint32_t& width, uint32_t& height) = 0;
+
+        /**
+         * @brief Check whether the backend scales frames to the output itself
+         * @return True if frames should be locked in their own size, false if they should be scaled to the output
+         */
+        [[nodiscard]] virtual bool scales_frames() const;
+
+        /**
+         * @brief Create a render backend
+         * @param type Type of the backend
+         * @param window Window that the backend will show the frames in
+         * @param vsync Whether presenting should wait for vertical sync (if the backend supports it)
+         * @return Created backend
+         * @throws Exceptions:
+         *  - ar::error::os_error: When the backend could not be created for the window
+         */
+        static std::unique_ptr<render_backend> create(render_backend_type type, SDL_Window* window, bool vsync);
+
+        /**
+         * @brief Get name of the backend type, for logging
+         * @param type Type of the backend
+         * @return Name of the backend type
+         */
+        static std::string get_type_name(render_backend_type type);
+
+        /**
+         * @brief Get the largest rectangle with frame's aspect ratio that fits the output, centered
+         * @param frame_width Width of the frame
+         * @param frame_height Height of the frame
+         * @param output_width Width of the output
+         * @param output_height Height of the output
+         * @return Rectangle the frame should be shown in
+         */
+        static SDL_Rect get_letterbox(uint32_t frame_width, uint32_t frame_height, uint32_t output_width,
+                                      uint32_t output_height);
+    };
+}
+
+#endif //ACCESS_TO_RETRO_FRONTEND_RENDER_BACKEND_HPP
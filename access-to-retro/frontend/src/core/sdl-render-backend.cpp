@@ -0,0 +1,109 @@
+#include <algorithm>
+#include "error/os-error.hpp"
+#include "sdl-render-backend.hpp"
+
+ar::core::sdl_render_backend::sdl_render_backend(SDL_Window* window, bool accelerated, bool vsync) :
+        _accelerated(accelerated)
+{
+    Uint32 flags = accelerated ? SDL_RENDERER_ACCELERATED : SDL_RENDERER_SOFTWARE;
+    if (vsync)
+    {
+        flags |= SDL_RENDERER_PRESENTVSYNC;
+    }
+
+    _renderer = SDL_CreateRenderer(window, -1, flags);
+    if (_renderer == nullptr)
+    {
+        throw ar::error::os_error("Unable to create " + get_name() + " renderer. Error: " +
+                                  std::string(SDL_GetError()));
+    }
+
+    SDL_SetRenderDrawColor(_renderer, 0, 0, 0, 255);
+}
+
+ar::core::sdl_render_backend::~sdl_render_backend()
+{
+    if (_texture != nullptr)
+    {
+        SDL_DestroyTexture(_texture);
+    }
+
+    SDL_DestroyRenderer(_renderer);
+}
+
+void* ar::core::sdl_render_backend::lock_frame(uint32_t width, uint32_t height, std::size_t& pitch)
+{
+    if (_texture == nullptr || _texture_width != width || _texture_height != height)
+    {
+        if (_texture != nullptr)
+        {
+            SDL_DestroyTexture(_texture);
+        }
+
+        // 'ar_pixel' is laid out as R, G, B, A bytes which is what RGBA32 means on any endianness
+        _texture = SDL_CreateTexture(_renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING,
+                                     static_cast<int>(width), static_cast<int>(height));
+        if (_texture == nullptr)
+        {
+            return nullptr;
+        }
+
+        _texture_width  = width;
+        _texture_height = height;
+    }
+
+    void* pixels      = nullptr;
+    int texture_pitch = 0;
+
+    if (SDL_LockTexture(_texture, nullptr, &pixels, &texture_pitch) != 0)
+    {
+        return nullptr;
+    }
+
+    pitch = static_cast<std::size_t>(texture_pitch);
+
+    return pixels;
+}
+
+void ar::core::sdl_render_backend::unlock_frame()
+{
+    SDL_UnlockTexture(_texture);
+}
+
+void ar::core::sdl_render_backend::present()
+{
+    SDL_RenderClear(_renderer);
+
+    if (_texture != nullptr)
+    {
+        uint32_t output_width  = 0;
+        uint32_t output_height = 0;
+        get_output_size(output_width, output_height);
+
+        SDL_Rect destination = get_letterbox(_texture_width, _texture_height, output_width, output_height);
+        SDL_RenderCopy(_renderer, _texture, nullptr, &destination);
+    }
+
+    SDL_RenderPresent(_renderer);
+}
+
+std::string ar::core::sdl_render_backend::get_name() const
+{
+    return ar::core::render_backend::get_type_name(_accelerated ? render_backend_type::accelerated :
+                                                                 render_backend_type::software);
+}
+
+void ar::core::sdl_render_backend::get_output_size(uint32_t& width, uint32_t& height)
+{
+    int output_width  = 0;
+    int output_height = 0;
+
+    if (SDL_GetRendererOutputSize(_renderer, &output_width, &output_height) != 0)
+    {
+        output_width  = 0;
+        output_height = 0;
+    }
+
+    width  = static_cast<uint32_t>(std::max(output_width, 0));
+    height = static_cast<uint32_t>(std::max(output_height, 0));
+}
@@ -0,0 +1,60 @@
+/**
+ * @file core/sdl-render-backend.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_FRONTEND_SDL_RENDER_BACKEND_HPP
+#define ACCESS_TO_RETRO_FRONTEND_SDL_RENDER_BACKEND_HPP
+
+#include "render-backend.hpp"
+
+namespace ar::core
+{
+    /// @brief Render backend using SDL renderer and a streaming texture, the renderer stretches it into the letterbox
+    class sdl_render_backend : public render_backend
+    {
+    public:
+        /**
+         * @brief Default constructor
+         * @param window Window that the frames will be shown in
+         * @param accelerated Whether to use GPU accelerated renderer or SDL's software renderer
+         * @param vsync Whether presenting should wait for vertical sync
+         * @throws Exceptions:
+         *  - ar::error::os_error: When the renderer could not be created
+         */
+        sdl_render_backend(SDL_Window* window, bool accelerated, bool vsync);
+
+        /// @brief Destroys the texture and the renderer
+        ~sdl_render_backend() override;
+
+        sdl_render_backend(const sdl_render_backend&) = delete;
+        sdl_render_backend& operator=(const sdl_render_backend&) = delete;
+
+        void* lock_frame(uint32_t width, uint32_t height, std::size_t& pitch) override;
+
+        void unlock_frame() override;
+
+        void present() override;
+
+        [[nodiscard]] std::string get_name() const override;
+
+        void get_output_size(uint32_t& width, uint32_t& height) override;
+
+    private:
+        /// @brief Whether the renderer is GPU accelerated
+        bool _accelerated;
+
+        /// @brief SDL renderer owned by this backend
+        SDL_Renderer* _renderer = nullptr;
+
+        /// @brief Streaming texture holding the last frame
+        SDL_Texture* _texture = nullptr;
+
+        /// @brief Width of '_texture'
+        uint32_t _texture_width = 0;
+
+        /// @brief Height of '_texture'
+        uint32_t _texture_height = 0;
+    };
+}
+
+#endif //ACCESS_TO_RETRO_FRONTEND_SDL_RENDER_BACKEND_HPP
@@ -1,4 +1,5 @@
 #include <SDL.h>
+#include <chrono>
 #include "util/logger.hpp"
 #include "virtual-console.hpp"
 
@@ -89,6 +90,22 @@ ar::core::virtual_console::virtual_console(const std::string& path) :
     _author        = author_name;
     _rom_extension = rom_ext;
 
+    _profiler = std::make_unique<ar::core::profiler>(_library);
+
+    try
+    {
+        // Virtual consoles built against older library do not export clock speed functions, this will throw for them
+        _get_clock_speed_fn = _library.get_symbol<unsigned(*)()>("ar_get_vc_clock_speed");
+        _set_clock_speed_fn = _library.get_symbol<void(*)(unsigned)>("ar_set_vc_clock_speed");
+    }
+    catch (const ar::error::os_error& ex)
+    {
+        _get_clock_speed_fn = nullptr;
+        _set_clock_speed_fn = nullptr;
+
+        LOG_DEBUG("core.virtual_console", "Clock speed can't be changed: " + ex.get_logger_formatted_error());
+    }
+
     LOG_DEBUG("core.virtual_console", "Virtual console object with name '" + _name + "' created");
 }
 
@@ -112,7 +129,12 @@ ar::core::virtual_console::virtual_console(virtual_console&& other) noexcept :
         _render_thread(nullptr),
         _render_thread_fn(std::move(other._render_thread_fn)),
         _input_thread(nullptr),
-        _input_thread_fn(std::move(other._input_thread_fn))
+        _input_thread_fn(std::move(other._input_thread_fn)),
+        _audio_output(std::move(other._audio_output)),
+        _rate_controller(std::move(other._rate_controller)),
+        _profiler(std::move(other._profiler)),
+        _get_clock_speed_fn(std::move(other._get_clock_speed_fn)),
+        _set_clock_speed_fn(std::move(other._set_clock_speed_fn))
 {
 
 }
@@ -122,7 +144,8 @@ ar::core::virtual_console::~virtual_console()
     LOG_DEBUG("core.virtual_console", "Virtual console object with name '" + _name + " destroyed");
 }
 
-void ar::core::virtual_console::prepare_for_startup(std::unique_ptr<ar::core::executable_binary>& binary)
+void ar::core::virtual_console::prepare_for_startup(std::unique_ptr<ar::core::executable_binary>& binary,
+                                                    bool open_audio_output)
 {
     LOG_INFO("Preparing virtual console '" + _name + "' for startup..");
 
@@ -138,6 +161,11 @@ void ar::core::virtual_console::prepare_for_startup(std::unique_ptr<ar::core::ex
                                               std::to_string(vc_startup_res) + ")");
     }
 
+    if (open_audio_output)
+    {
+        create_audio_output();
+    }
+
     LOG_INFO("Virtual console '" + _name + "' is now ready to be started");
 }
 
@@ -145,42 +173,67 @@ void ar::core::virtual_console::create_and_run_threads()
 {
     _run_threads = true;
 
+    if (_audio_output != nullptr)
+    {
+        _audio_output->start();
+    }
+
     _main_thread = std::make_unique<std::thread>(
             [&]
             {
+                /*
+                 * Main thread drives emulation speed so it's paced using absolute deadlines, sleeping for the rest of
+                 * the frame time is only accurate to a millisecond and the error would add up every frame (16ms instead
+                 * of 16.6ms makes emulation 4% faster than intended).
+                 */
+                auto deadline = std::chrono::steady_clock::now();
+
+                _profiler->set_thread_name("main");
+
                 // Each time code in the loop runs it is refereed to as 'thread tick'
                 while (_run_threads)
                 {
-                    // Timer value at the start of the thread tick
-                    uint64_t start = SDL_GetPerformanceCounter();
-
-                    _main_thread_fn();
-
-                    // Timer value at the end of the thread tick
-                    uint64_t end = SDL_GetPerformanceCounter();
-
-                    // Calculate time elapsed from the beginning of the thread tick
-                    float elapsed = (float) (end - start) / (float) SDL_GetPerformanceFrequency() * 1000.0f;
-
-                    /*
-                     * Delay next thread tick by frame time minus time taken to render.
-                     *
-                     * Frame time is the time that each frame has on the screen, elapsed is the time already elapsed so subtract it
-                     */
-                    SDL_Delay(static_cast<uint32_t>(floor(_frame_time - elapsed)));
+                    {
+                        ar::core::profile_zone zone(*_profiler, "main thread tick");
+                        _main_thread_fn();
+                    }
+
+                    double frame_time = _frame_time;
+                    if (_rate_controller != nullptr)
+                    {
+                        // Thread tick has just pushed its audio, faster emulation means shorter frame time
+                        frame_time /= _rate_controller->update(_audio_output->get_queued_frames());
+                    }
+
+                    deadline += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                            std::chrono::duration<double, std::milli>(frame_time));
+
+                    // Thread tick took longer than frame time, do not try to catch up and continue from now
+                    auto now = std::chrono::steady_clock::now();
+                    if (deadline < now)
+                    {
+                        deadline = now;
+                    }
+
+                    std::this_thread::sleep_until(deadline);
                 }
             });
 
     _render_thread = std::make_unique<std::thread>(
             [&]
             {
+                _profiler->set_thread_name("render");
+
                 // Each time code in the loop runs it is refereed to as 'thread tick'
                 while (_run_threads)
                 {
                     // Timer value at the start of the thread tick
                     uint64_t start = SDL_GetPerformanceCounter();
 
-                    _render_thread_fn();
+                    {
+                        ar::core::profile_zone zone(*_profiler, "render thread tick");
+                        _render_thread_fn();
+                    }
 
                     // Timer value at the end of the thread tick
                     uint64_t end = SDL_GetPerformanceCounter();
@@ -200,13 +253,18 @@ void ar::core::virtual_console::create_and_run_threads()
     _input_thread = std::make_unique<std::thread>(
             [&]
             {
+                _profiler->set_thread_name("input");
+
                 // Each time code in the loop runs it is refereed to as 'thread tick'
                 while (_run_threads)
                 {
                     // Timer value at the start of the thread tick
                     uint64_t start = SDL_GetPerformanceCounter();
 
-                    _input_thread_fn();
+                    {
+                        ar::core::profile_zone zone(*_profiler, "input thread tick");
+                        _input_thread_fn();
+                    }
 
                     // Timer value at the end of the thread tick
                     uint64_t end = SDL_GetPerformanceCounter();
@@ -224,14 +282,46 @@ void ar::core::virtual_console::create_and_run_threads()
             });
 }
 
-void ar::core::virtual_console::quit_and_cleanup()
+void ar::core::virtual_console::run_frame()
+{
+    {
+        ar::core::profile_zone zone(*_profiler, "input thread tick");
+        _input_thread_fn();
+    }
+
+    {
+        ar::core::profile_zone zone(*_profiler, "main thread tick");
+        _main_thread_fn();
+    }
+
+    {
+        ar::core::profile_zone zone(*_profiler, "render thread tick");
+        _render_thread_fn();
+    }
+}
+
+void ar::core::virtual_console::stop_threads()
 {
     _run_threads = false;
 
-    // Join the threads
-    _main_thread->join();
-    _render_thread->join();
-    _input_thread->join();
+    // Join the threads, headless runs never create them
+    for (std::unique_ptr<std::thread>* thread : { &_main_thread, &_render_thread, &_input_thread })
+    {
+        if (*thread != nullptr)
+        {
+            (*thread)->join();
+            *thread = nullptr;
+        }
+    }
+}
+
+void ar::core::virtual_console::quit_and_cleanup()
+{
+    stop_threads();
+
+    // Audio device pulls from the library's queue which is freed by the quit function, close it first
+    _rate_controller = nullptr;
+    _audio_output    = nullptr;
 
     // Call developer's defined quit function
     _quit_fn();
@@ -239,6 +329,39 @@ void ar::core::virtual_console::quit_and_cleanup()
     LOG_INFO("Resources for virtual console '" + _name + "' deallocated");
 }
 
+void ar::core::virtual_console::create_audio_output()
+{
+    try
+    {
+        // Virtual consoles built against older library do not export audio functions, this will throw for them
+        auto is_audio_configured_fn = _library.get_symbol<bool(*)()>("ar_audio_is_configured");
+        if (!is_audio_configured_fn())
+        {
+            LOG_DEBUG("core.virtual_console", "Virtual console '" + _name + "' has not configured audio output");
+            return;
+        }
+
+        _audio_output = std::make_unique<ar::core::audio_output>(_library);
+
+        LOG_INFO("Audio output for virtual console '" + _name + "' opened with latency of " +
+                 std::to_string(_audio_output->get_device_latency()) + "ms");
+
+        /*
+         * Right after a thread tick the queue should hold that tick's audio plus some reserve for the device, device
+         * buffer for the frames being consumed and one more in case the device's timing is uneven
+         */
+        double frame_audio  = _audio_output->get_sample_rate() * _frame_time / 1000.0;
+        double device_audio = _audio_output->get_device_buffer_frames();
+
+        _rate_controller = std::make_unique<ar::core::rate_controller>(frame_audio + 2 * device_audio);
+    }
+    catch (const ar::error::os_error& ex)
+    {
+        // Audio is not essential, virtual console can still run without it
+        LOG_WARNING("Virtual console '" + _name + "' will run without audio: " + ex.get_logger_formatted_error());
+    }
+}
+
 std::string ar::core::virtual_console::get_path() const
 {
     return _path;
@@ -264,6 +387,34 @@ std::string ar::core::virtual_console::get_rom_extension() const
     return _rom_extension;
 }
 
+double ar::core::virtual_console::get_frame_time() const
+{
+    return _frame_time;
+}
+
+ar::core::profiler& ar::core::virtual_console::access_profiler()
+{
+    return *_profiler;
+}
+
+unsigned ar::core::virtual_console::get_clock_speed() const
+{
+    return _get_clock_speed_fn ? _get_clock_speed_fn() : 0;
+}
+
+void ar::core::virtual_console::set_clock_speed(unsigned clock_speed)
+{
+    // Virtual consoles with fixed clock speed report 0, changing it would make them read a clock speed they don't have
+    if (get_clock_speed() == 0)
+    {
+        return;
+    }
+
+    _set_clock_speed_fn(clock_speed);
+
+    LOG_INFO("Clock speed of '" + _name + "' set to " + std::to_string(clock_speed) + "hz");
+}
+
 unsigned ar::core::virtual_console::get_default_window_width() const
 {
     return _default_window_width;
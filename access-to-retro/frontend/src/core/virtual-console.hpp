@@ -11,6 +11,9 @@
 #include "helpers/types.hpp"
 #include "executable-binary.hpp"
 #include "dynamic-library.hpp"
+#include "audio-output.hpp"
+#include "profiler.hpp"
+#include "rate-controller.hpp"
 
 namespace ar::core
 {
@@ -46,17 +49,57 @@ namespace ar::core
         /**
          * @brief Prepares the virtual console for starting
          * @param binary Binary file with executable content to be linked
+         * @param open_audio_output Whether to open audio device for the virtual console, headless runs do not play
+         *                          the audio
          * @details Runs '_ar_vc_startup' function allocating virtual console and library resources
          * @warning Binary file is stored as reference, ownership remains with main window class
          * @warning If this function runs you must use 'quit_and_cleanup' later otherwise memory leak can happen
          * @throws Exceptions:
          *  - ar::core::virtual_console_error: 'ar_vc_startup' returned non-zero error code
          */
-        void prepare_for_startup(std::unique_ptr<ar::core::executable_binary>& binary);
+        void prepare_for_startup(std::unique_ptr<ar::core::executable_binary>& binary, bool open_audio_output = true);
 
         /// @brief Create developer's defined main, render and input threads and start them
         void create_and_run_threads();
 
+        /**
+         * @brief Stop and join the threads created by 'create_and_run_threads', none of the virtual console runs after
+         * @details Virtual console's resources are still allocated, 'quit_and_cleanup' frees them. Anything called from
+         *          virtual console's threads (e.g. the present callback) is safe to destroy once this returns.
+         */
+        void stop_threads();
+
+        /**
+         * @brief Run a single tick of input, main and render thread functions on the calling thread, without pacing
+         * @details Used instead of 'create_and_run_threads' to run the virtual console headless as fast as possible
+         */
+        void run_frame();
+
+        /**
+         * @brief Get the frame time as defined by the developer
+         * @return Time each frame is on the screen in milliseconds
+         */
+        [[nodiscard]] double get_frame_time() const;
+
+        /**
+         * @brief Access profiler recording zones of the virtual console and the frontend
+         * @return Profiler of the virtual console, see 'is_available' as older virtual consoles do not support it
+         */
+        [[nodiscard]] ar::core::profiler& access_profiler();
+
+        /**
+         * @brief Get the clock speed the virtual console runs at
+         * @return Clock speed in hz, 0 if the virtual console's clock speed can't be changed
+         */
+        [[nodiscard]] unsigned get_clock_speed() const;
+
+        /**
+         * @brief Change the clock speed while the game runs, virtual console applies it from its next frame
+         * @details Does nothing if the virtual console's clock speed can't be changed (see 'get_clock_speed')
+         * @param clock_speed Clock speed in hz
+         */
+        void set_clock_speed(unsigned clock_speed);
+
         /**
          * @brief Fetches the requested symbol's address by name and casts it to T
          * @throws Exceptions:
@@ -77,7 +120,7 @@ namespace ar::core
          * @brief Cleans up all the resources that were allocated by the virtual console
          * @details This function should only get called when the virtual console closes after it was started, that's
          *          why it's a separate method and not a destructor as a destructor would run even if virtual console
-         *          was not started yet.
+         *          was not started yet. Threads still running are stopped first (see 'stop_threads').
          */
         void quit_and_cleanup();
 
@@ -185,6 +228,24 @@ namespace ar::core
 
         /// @brief Function used to create 'input' thread
         std::function<void()> _input_thread_fn;
+
+        /// @brief Audio output of the virtual console, nullptr if the virtual console has not configured audio
+        std::unique_ptr<ar::core::audio_output> _audio_output = nullptr;
+
+        /// @brief Adjusts main thread's frame time to keep the audio queue filled, nullptr if there is no audio output
+        std::unique_ptr<ar::core::rate_controller> _rate_controller = nullptr;
+
+        /// @brief Records zones of all threads of the virtual console, heap allocated so it survives the move
+        std::unique_ptr<ar::core::profiler> _profiler = nullptr;
+
+        /// @brief Gets clock speed of the virtual console, empty for virtual consoles built against older library
+        std::function<unsigned()> _get_clock_speed_fn;
+
+        /// @brief Sets clock speed of the virtual console, empty for virtual consoles built against older library
+        std::function<void(unsigned)> _set_clock_speed_fn;
+
+        /// @brief Open audio output if the virtual console has configured audio in its startup function
+        void create_audio_output();
     };
 
     /// @brief Exception used by virtual_console class
@@ -1,6 +1,11 @@
+#include <algorithm>
 #include <cmath>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
 #include "helpers/qt-helper.hpp"
 #include "util/logger.hpp"
+#include "util/settings-manager.hpp"
 #include "sdl-graphics-widget.hpp"
 
 ar::gui::sdl_graphics_widget::sdl_graphics_widget(std::unique_ptr<ar::core::virtual_console>& virtual_console,
@@ -26,6 +31,15 @@ ar::gui::sdl_graphics_widget::sdl_graphics_widget(std::unique_ptr<ar::core::virt
 
 ar::gui::sdl_graphics_widget::~sdl_graphics_widget()
 {
+    // Zones are recorded in library's buffers, capture still running has to be written before it frees them
+    stop_profiling_capture();
+
+    // Main thread calls the presenter from 'ar_graphics_present', it has to be joined before the presenter is freed
+    _virtual_console->stop_threads();
+
+    // Present thread reads virtual console's frame buffer, it has to stop before the library frees it
+    _frame_presenter = nullptr;
+
     _virtual_console->quit_and_cleanup();
 
     _game->unload_file();
@@ -35,18 +49,26 @@ ar::gui::sdl_graphics_widget::~sdl_graphics_widget()
 
 void ar::gui::sdl_graphics_widget::initialise_sdl_objects()
 {
+    // Windows created from Qt's widgets only support OpenGL contexts if SDL is told so before creating them
+    if (read_render_backend_setting() == ar::core::render_backend_type::opengl)
+    {
+        SDL_SetHint(SDL_HINT_VIDEO_FOREIGN_WINDOW_OPENGL, "1");
+    }
+
     _sdl_window = SDL_CreateWindowFrom((void*) winId());
     if (_sdl_window == nullptr)
     {
         throw std::runtime_error("Unable to initialise SDL2 window");
     }
 
-    auto renderer_flags =
-#if defined(_WIN32)
-   SDL_RENDERER_SOFTWARE;
-#else
-    SDL_RENDERER_ACCELERATED;
-#endif
+    LOG_DEBUG("gui.sdl_graphics_widget", "SDL objects initialised");
+}
+
+void ar::gui::sdl_graphics_widget::create_sdl_renderer()
+{
+    // Virtual console draws itself, frontend's own backends are not an option here so it uses SDL's software renderer
+    auto renderer_flags = read_render_backend_setting() == ar::core::render_backend_type::accelerated ?
+                          SDL_RENDERER_ACCELERATED : SDL_RENDERER_SOFTWARE;
 
     _sdl_renderer = SDL_CreateRenderer(_sdl_window, -1, renderer_flags);
     if (_sdl_renderer == nullptr)
@@ -58,17 +80,170 @@ void ar::gui::sdl_graphics_widget::initialise_sdl_objects()
     SDL_SetRenderDrawColor(_sdl_renderer, 0, 0, 0, 255);
     SDL_RenderPresent(_sdl_renderer);
 
-    LOG_DEBUG("gui.sdl_graphics_widget", "SDL objects initialised");
+    LOG_DEBUG("gui.sdl_graphics_widget", "SDL renderer created");
 }
 
 void ar::gui::sdl_graphics_widget::destroy_sdl_objects()
 {
-    SDL_DestroyRenderer(_sdl_renderer);
+    if (_sdl_renderer != nullptr)
+    {
+        SDL_DestroyRenderer(_sdl_renderer);
+    }
+
     SDL_DestroyWindow(_sdl_window);
 
     LOG_DEBUG("gui.sdl_graphics_widget", "SDL objects destroyed");
 }
 
+ar::core::render_backend_type ar::gui::sdl_graphics_widget::read_render_backend_setting()
+{
+    // Accelerated renderer used to have problems with windows created from Qt's widgets on Windows
+    constexpr auto DEFAULT_BACKEND =
+#if defined(_WIN32)
+    ar::core::render_backend_type::software;
+#else
+    ar::core::render_backend_type::accelerated;
+#endif
+
+    return static_cast<ar::core::render_backend_type>(
+            read_index_setting("rendering", static_cast<int>(DEFAULT_BACKEND),
+                               static_cast<int>(ar::core::render_backend_type::opengl)));
+}
+
+ar::core::frame_scaler::filter ar::gui::sdl_graphics_widget::read_scaling_filter_setting()
+{
+    return static_cast<ar::core::frame_scaler::filter>(
+            read_index_setting("scaling_filter", static_cast<int>(ar::core::frame_scaler::filter::nearest),
+                               static_cast<int>(ar::core::frame_scaler::filter::xbr)));
+}
+
+ar::core::capture_format ar::gui::sdl_graphics_widget::read_frame_capture_setting()
+{
+    return static_cast<ar::core::capture_format>(
+            read_index_setting("frame_capture", static_cast<int>(ar::core::capture_format::disabled),
+                               static_cast<int>(ar::core::capture_format::png)));
+}
+
+std::unique_ptr<ar::core::frame_capture> ar::gui::sdl_graphics_widget::create_frame_capture()
+{
+    ar::core::capture_format format = read_frame_capture_setting();
+    if (format == ar::core::capture_format::disabled)
+    {
+        return nullptr;
+    }
+
+    std::string capture_path = ar::util::settings_manager::get_global_manager()->get_setting_or_set_if_not_exists
+            ("capture_path", "captures");
+
+    std::time_t now = std::time(nullptr);
+
+    std::ostringstream directory_name;
+    directory_name << _game->get_file_name() << "-" << std::put_time(std::localtime(&now), "%Y%m%d-%H%M%S");
+
+    try
+    {
+        return std::make_unique<ar::core::frame_capture>(std::filesystem::path(capture_path) / directory_name.str(),
+                                                         format, FRAME_RATE);
+    }
+    catch (const ar::error::io_error& ex)
+    {
+        // Game runs fine without it, capturing is not worth interrupting it
+        LOG_WARNING(ex.get_logger_formatted_error());
+    }
+
+    return nullptr;
+}
+
+void ar::gui::sdl_graphics_widget::toggle_profiling_capture()
+{
+    if (stop_profiling_capture())
+    {
+        return;
+    }
+
+    try
+    {
+        _virtual_console->access_profiler().start_capture();
+    }
+    catch (const ar::error::os_error& ex)
+    {
+        LOG_WARNING(ex.get_logger_formatted_error());
+    }
+}
+
+bool ar::gui::sdl_graphics_widget::stop_profiling_capture()
+{
+    ar::core::profiler& profiler = _virtual_console->access_profiler();
+    if (!profiler.is_capturing())
+    {
+        return false;
+    }
+
+    std::string profile_path = ar::util::settings_manager::get_global_manager()->get_setting_or_set_if_not_exists
+            ("profile_path", "traces");
+
+    std::time_t now = std::time(nullptr);
+
+    std::ostringstream file_name;
+    file_name << _game->get_file_name() << "-" << std::put_time(std::localtime(&now), "%Y%m%d-%H%M%S") << ".json";
+
+    // Failing to create the directory is reported by the trace write itself
+    std::error_code error;
+    std::filesystem::create_directories(profile_path, error);
+
+    try
+    {
+        profiler.stop_capture(std::filesystem::path(profile_path) / file_name.str());
+    }
+    catch (const ar::error::io_error& ex)
+    {
+        // Capture is stopped either way, only the trace is lost
+        LOG_WARNING(ex.get_logger_formatted_error());
+    }
+
+    return true;
+}
+
+void ar::gui::sdl_graphics_widget::change_clock_speed(bool faster)
+{
+    unsigned clock_speed = _virtual_console->get_clock_speed();
+    if (clock_speed == 0)
+    {
+        LOG_DEBUG("gui.sdl_graphics_widget", "Virtual console's clock speed can't be changed");
+        return;
+    }
+
+    // Steps are relative so they feel the same for slow and fast systems, slowing down undoes speeding up
+    clock_speed = faster ? clock_speed + std::max(clock_speed / 4, 1u) : std::max(clock_speed * 4 / 5, 1u);
+
+    _virtual_console->set_clock_speed(clock_speed);
+}
+
+int ar::gui::sdl_graphics_widget::read_index_setting(const std::string& key, int default_index, int max_index)
+{
+    std::string setting = ar::util::settings_manager::get_global_manager()->get_setting_or_set_if_not_exists
+            (key, std::to_string(default_index));
+
+    int index = -1;
+    try
+    {
+        index = std::stoi(setting);
+    }
+    catch (const std::logic_error&)
+    {
+        // Not a number, handled as any other invalid value
+    }
+
+    if (index < 0 || index > max_index)
+    {
+        LOG_WARNING("Invalid " + key + " setting (" + setting + "), using default value");
+
+        return default_index;
+    }
+
+    return index;
+}
+
 void ar::gui::sdl_graphics_widget::prepare_for_game_launch()
 {
     try
@@ -121,15 +296,12 @@ void ar::gui::sdl_graphics_widget::prepare_graphics()
         {
             LOG_DEBUG("gui.virtual_console", "Virtual Console graphics mode found to be: FRAME_BUFFER");
 
-            // Get the frame buffer getter fn
-            auto get_frame_buffer_obj =
-                         _virtual_console->get_symbol_from_library<ar::types::c_generic_memory_ptr(*)()>
-                                                 ("ar_graphics_get_frame_buffer");
-
-            // Get the frame buffer and cast the generic memory pointer to the frame buffer
-            _frame_buffer = (ar_frame_buffer*) get_frame_buffer_obj();
-
-            // TODO: Create thread that draws the buffer continuously
+            // Frame buffer is created during virtual console's startup, presenter only shows what gets presented
+            _frame_presenter = std::make_unique<ar::core::frame_presenter>(_virtual_console, _sdl_window,
+                                                                           read_render_backend_setting(),
+                                                                           read_scaling_filter_setting());
+            _frame_presenter->set_frame_capture(create_frame_capture());
+            _frame_presenter->start();
 
             break;
         }
@@ -150,6 +322,8 @@ void ar::gui::sdl_graphics_widget::prepare_graphics()
         {
             LOG_DEBUG("gui.virtual_console", "Virtual Console graphics mode found to be: SDL2");
 
+            create_sdl_renderer();
+
             // Get library's setter
             auto set_sdl_objects_fn =
             _virtual_console->get_symbol_from_library<void(*)(SDL_Window* , SDL_Renderer*)>("ar_graphics_set_sdl_objects");
@@ -170,21 +344,65 @@ void ar::gui::sdl_graphics_widget::prepare_graphics()
 
 void ar::gui::sdl_graphics_widget::keyPressEvent(QKeyEvent* event)
 {
-    _input_handler.key_press(QKeySequence(event->key()).toString().toStdString());
+    ar::core::profile_zone zone(_virtual_console->access_profiler(), "Qt key press event");
+
+    // Held keys generate repeated events, the key's status does not change so there is nothing to do
+    if (event->isAutoRepeat())
+    {
+        return;
+    }
+
+    // Reserved for the frontend, never passed to the virtual console
+    if (event->key() == Qt::Key_F12)
+    {
+        toggle_profiling_capture();
+
+        return;
+    }
+
+    if (event->key() == Qt::Key_F10 || event->key() == Qt::Key_F11)
+    {
+        change_clock_speed(event->key() == Qt::Key_F11);
+
+        return;
+    }
+
+    _input_handler.key_press(event->key());
 }
 
 void ar::gui::sdl_graphics_widget::keyReleaseEvent(QKeyEvent* event)
 {
-    _input_handler.key_release(QKeySequence(event->key()).toString().toStdString());
+    ar::core::profile_zone zone(_virtual_console->access_profiler(), "Qt key release event");
+
+    // Held keys generate repeated events, the key's status does not change so there is nothing to do
+    if (event->isAutoRepeat() || event->key() == Qt::Key_F10 || event->key() == Qt::Key_F11 ||
+        event->key() == Qt::Key_F12)
+    {
+        return;
+    }
+
+    _input_handler.key_release(event->key());
 }
 
-void ar::gui::sdl_graphics_widget::on_resize([[maybe_unused]] int w, [[maybe_unused]] int h)
+void ar::gui::sdl_graphics_widget::on_resize(int w, int h)
 {
-    // TODO: Do nothing for now
+    // SDL does not see resizes of foreign windows, this also recreates window surface and updates renderer's viewport
+    if (_sdl_window != nullptr)
+    {
+        SDL_SetWindowSize(_sdl_window, std::max(w, 1), std::max(h, 1));
+    }
+
+    // Present thread picks up the new output size and scales the last frame for it
+    if (_frame_presenter != nullptr)
+    {
+        _frame_presenter->request_redraw();
+    }
 }
 
 void ar::gui::sdl_graphics_widget::resizeEvent(QResizeEvent*)
 {
+    ar::core::profile_zone zone(_virtual_console->access_profiler(), "Qt resize event");
+
     // Get Qt's new sizes
     int w = static_cast<int>(QWidget::width());
     int h = static_cast<int>(QWidget::height());
@@ -13,6 +13,10 @@
 #include "core/executable-binary.hpp"
 #include "core/virtual-console.hpp"
 #include "core/input-handler.hpp"
+#include "core/frame-presenter.hpp"
+#include "core/render-backend.hpp"
+#include "core/frame-scaler.hpp"
+#include "core/frame-capture.hpp"
 
 namespace ar::gui
 {
@@ -72,7 +76,7 @@ namespace ar::gui
         /// @brief Emulated SDL window created from Qt's openGL widget
         SDL_Window* _sdl_window = nullptr;
 
-        /// @brief Basic SDL renderer
+        /// @brief Basic SDL renderer, only created for 'ar_graphics_method_sdl' (frame presenter owns its own)
         SDL_Renderer* _sdl_renderer = nullptr;
 
         /**
@@ -82,11 +86,74 @@ namespace ar::gui
          */
         void initialise_sdl_objects();
 
+        /**
+         * @brief Create SDL renderer used by virtual consoles with 'ar_graphics_method_sdl'
+         * @throws Exceptions:
+         *  - std::runtime_error: Unable to initialise SDL renderer
+         */
+        void create_sdl_renderer();
+
+        /**
+         * @brief Read render backend selected in "rendering" setting, the default is set if it does not exist
+         * @return Selected render backend
+         */
+        static ar::core::render_backend_type read_render_backend_setting();
+
+        /**
+         * @brief Read filter selected in "scaling_filter" setting, the default is set if it does not exist
+         * @return Selected scaling filter
+         */
+        static ar::core::frame_scaler::filter read_scaling_filter_setting();
+
+        /**
+         * @brief Read format selected in "frame_capture" setting, the default is set if it does not exist
+         * @return Selected capture format
+         */
+        static ar::core::capture_format read_frame_capture_setting();
+
+        /**
+         * @brief Create frame capture if it is enabled in the settings
+         * @details Frames are written into "capture_path" setting's directory (default "captures"), each run gets its
+         *          own subdirectory named after the game and the time it was started.
+         * @return Created capture or nullptr if capturing is disabled or its directory could not be created
+         */
+        std::unique_ptr<ar::core::frame_capture> create_frame_capture();
+
+        /**
+         * @brief Start profiling capture or stop the running one and write its trace, bound to F12
+         * @details Traces are written into "profile_path" setting's directory (default "traces"), named after the game
+         *          and the time the capture was stopped.
+         */
+        void toggle_profiling_capture();
+
+        /**
+         * @brief Stop profiling capture if it is running and write its trace, failed write is only logged
+         * @return Whether a capture was running
+         */
+        bool stop_profiling_capture();
+
+        /**
+         * @brief Make the game run faster or slower by a quarter of its clock speed, bound to F11 and F10
+         * @details Only the virtual console's clock speed changes, frame rate and timers stay the same. Nothing happens
+         *          for virtual consoles without adjustable clock speed.
+         * @param faster Whether to speed the game up, slows it down otherwise
+         */
+        void change_clock_speed(bool faster);
+
+        /**
+         * @brief Read a setting holding an index of a combo box item, the default is set if it does not exist
+         * @param key Name of the setting
+         * @param default_index Index used if the setting does not exist or is invalid
+         * @param max_index Largest valid index
+         * @return Index stored in the setting
+         */
+        static int read_index_setting(const std::string& key, int default_index, int max_index);
+
         /// @brief Destroy objects from sdl library
         void destroy_sdl_objects();
 
         /**
-         * @brief Handles resize event on SDL side - does nothing for now
+         * @brief Handles resize event on SDL side, resizes SDL window and lets frame presenter scale the last frame again
          * @param w New width
          * @param h New height
          */
@@ -108,11 +175,8 @@ namespace ar::gui
         /// @brief Access to Retro's graphics method, set using 'ar_graphics_set_method' by virtual console
         ar_graphics_method _graphics_method = ar_graphics_method_none;
 
-        /**
-         * @brief Frame buffer object from the Access to Retro library created by the developer if graphics mode is SDL
-         * @remark Freed by the library automatically
-         */
-        ar_frame_buffer* _frame_buffer = nullptr;
+        /// @brief Shows frames presented by virtual consoles with 'ar_graphics_method_frame_buffer'
+        std::unique_ptr<ar::core::frame_presenter> _frame_presenter = nullptr;
 
     };
 }
@@ -82,6 +82,26 @@ void ar::gui::settings_dialog::on_rendering_combo_box_currentIndexChanged(int in
     _settings_manager->set_setting("rendering", std::to_string(index));
 }
 
+void ar::gui::settings_dialog::on_scaling_filter_combo_box_currentIndexChanged(int index)
+{
+    if (!_ui_created)
+    {
+        return;
+    }
+
+    _settings_manager->set_setting("scaling_filter", std::to_string(index));
+}
+
+void ar::gui::settings_dialog::on_frame_capture_combo_box_currentIndexChanged(int index)
+{
+    if (!_ui_created)
+    {
+        return;
+    }
+
+    _settings_manager->set_setting("frame_capture", std::to_string(index));
+}
+
 void ar::gui::settings_dialog::on_rom_path_browse_button_clicked()
 {
     QString new_roms_path = QFileDialog::getExistingDirectory(this, ("Select Folder"), QDir::homePath());
@@ -199,6 +219,30 @@ void ar::gui::settings_dialog::populate_combo_boxes()
     {
         ui->default_source_tab_combo_box->setCurrentIndex(std::stoi(default_source_tab_setting_res.value()));
     }
+
+    // ****************** General : Rendering Mode ******************
+    // Items are in the order of 'ar::core::render_backend_type', applied when the next game is started
+    auto rendering_setting_res = _settings_manager->get_setting("rendering");
+    if (rendering_setting_res != std::nullopt)
+    {
+        ui->rendering_combo_box->setCurrentIndex(std::stoi(rendering_setting_res.value()));
+    }
+
+    // ****************** Graphics : Scaling Filter ******************
+    // Items are in the order of 'ar::core::frame_scaler::filter', applied when the next game is started
+    auto scaling_filter_setting_res = _settings_manager->get_setting("scaling_filter");
+    if (scaling_filter_setting_res != std::nullopt)
+    {
+        ui->scaling_filter_combo_box->setCurrentIndex(std::stoi(scaling_filter_setting_res.value()));
+    }
+
+    // ****************** Graphics : Frame Capture ******************
+    // Items are in the order of 'ar::core::capture_format', applied when the next game is started
+    auto frame_capture_setting_res = _settings_manager->get_setting("frame_capture");
+    if (frame_capture_setting_res != std::nullopt)
+    {
+        ui->frame_capture_combo_box->setCurrentIndex(std::stoi(frame_capture_setting_res.value()));
+    }
 }
 
 void ar::gui::settings_dialog::populate_paths()
@@ -50,6 +50,12 @@ namespace ar::gui
         /// @brief Runs when item inside rendering combo box changes
         void on_rendering_combo_box_currentIndexChanged(int index);
 
+        /// @brief Runs when item inside scaling filter combo box changes
+        void on_scaling_filter_combo_box_currentIndexChanged(int index);
+
+        /// @brief Runs when item inside frame capture combo box changes
+        void on_frame_capture_combo_box_currentIndexChanged(int index);
+
         // ****************** General Tab ******************
 
         /// @brief Runs when browse button (roms path)
@@ -0,0 +1,264 @@
+#include "headless-runner.hpp"
+#include <algorithm>
+#include <chrono>
+#include "core/frame-capture.hpp"
+#include "error/os-error.hpp"
+#include "util/logger.hpp"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Constructors & Destructors
+// ---------------------------------------------------------------------------------------------------------------------
+
+ar::run::headless_runner::headless_runner(std::unique_ptr<ar::core::virtual_console>& virtual_console,
+                                          std::unique_ptr<ar::core::executable_binary>& game) :
+        _virtual_console(virtual_console),
+        _game(game)
+{
+    prepare_graphics();
+
+    _game->load_to_memory();
+
+    // Set the binary file in access to retro library
+    auto set_binary_fn =
+            _virtual_console->get_symbol_from_library<void(*)(const ar_byte*, size_t)>("ar_create_executable");
+    set_binary_fn(_game->get_file_raw_bytes(), _game->get_file_size());
+
+    // Audio is drained instead of played, there is no reason to open a device
+    _virtual_console->prepare_for_startup(_game, false);
+
+    prepare_audio();
+
+    LOG_DEBUG("run.headless_runner", "Virtual console '" + _virtual_console->get_name() + "' ready to run headless");
+}
+
+ar::run::headless_runner::~headless_runner()
+{
+    if (_set_present_callback_fn != nullptr)
+    {
+        _set_present_callback_fn(nullptr, nullptr);
+    }
+
+    _virtual_console->quit_and_cleanup();
+    _game->unload_file();
+
+    if (_sdl_renderer != nullptr)
+    {
+        SDL_DestroyRenderer(_sdl_renderer);
+    }
+
+    if (_sdl_surface != nullptr)
+    {
+        SDL_FreeSurface(_sdl_surface);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Public functions
+// ---------------------------------------------------------------------------------------------------------------------
+
+ar::run::run_statistics ar::run::headless_runner::run(uint64_t frame_count)
+{
+    using clock = std::chrono::steady_clock;
+
+    ar::run::run_statistics statistics;
+    std::vector<double> frame_times;
+    frame_times.reserve(frame_count);
+
+    _presented_frame_count = 0;
+
+    clock::time_point run_start = clock::now();
+
+    for (uint64_t i = 0; i < frame_count; i++)
+    {
+        clock::time_point frame_start = clock::now();
+
+        _virtual_console->run_frame();
+        statistics.audio_frame_count += drain_audio();
+
+        frame_times.push_back(std::chrono::duration<double, std::milli>(clock::now() - frame_start).count());
+    }
+
+    statistics.elapsed_time = std::chrono::duration<double>(clock::now() - run_start).count();
+    statistics.frame_count = frame_count;
+    statistics.presented_frame_count = _presented_frame_count;
+    statistics.emulated_time = static_cast<double>(frame_count) * _virtual_console->get_frame_time() / 1000.0;
+
+    if (!frame_times.empty())
+    {
+        double total = 0.0;
+        for (double frame_time : frame_times)
+        {
+            total += frame_time;
+        }
+
+        std::sort(frame_times.begin(), frame_times.end());
+
+        std::size_t p99_index = std::min(frame_times.size() - 1, frame_times.size() * 99 / 100);
+
+        statistics.min_frame_time = frame_times.front();
+        statistics.mean_frame_time = total / static_cast<double>(frame_times.size());
+        statistics.p99_frame_time = frame_times[p99_index];
+        statistics.max_frame_time = frame_times.back();
+    }
+
+    if (_acquire_frame_fn != nullptr)
+    {
+        hash_final_frame(statistics);
+    }
+
+    return statistics;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Private functions
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ar::run::headless_runner::prepare_graphics()
+{
+    auto get_method_fn =
+            _virtual_console->get_symbol_from_library<ar_graphics_method(*)()>("ar_graphics_get_method");
+
+    ar_graphics_method method = get_method_fn();
+
+    switch (method)
+    {
+        case ar_graphics_method_frame_buffer:
+        {
+            LOG_DEBUG("run.headless_runner", "Virtual Console graphics mode found to be: FRAME_BUFFER");
+
+            // Nothing is shown, presents are only counted and the last presented frame is hashed after the run
+            _set_present_callback_fn = _virtual_console->get_symbol_from_library<set_present_callback_fn>
+                    ("ar_graphics_set_present_callback");
+            _set_present_callback_fn(on_frame_presented, this);
+
+            _acquire_frame_fn = _virtual_console->get_symbol_from_library<acquire_frame_fn>
+                    ("ar_graphics_acquire_frame");
+            _get_acquired_palette_fn = _virtual_console->get_symbol_from_library<get_acquired_palette_fn>
+                    ("ar_graphics_get_acquired_palette");
+            _get_frame_buffer_fn = _virtual_console->get_symbol_from_library<get_frame_buffer_fn>
+                    ("ar_graphics_get_frame_buffer");
+
+            break;
+        }
+
+        case ar_graphics_method_sdl:
+        {
+            LOG_DEBUG("run.headless_runner", "Virtual Console graphics mode found to be: SDL2");
+
+            // Software renderer draws into a surface in memory, no window or video driver is needed
+            _sdl_surface = SDL_CreateRGBSurfaceWithFormat(0, static_cast<int>(
+                                                                  _virtual_console->get_default_window_width()),
+                                                          static_cast<int>(
+                                                                  _virtual_console->get_default_window_height()),
+                                                          32, SDL_PIXELFORMAT_RGBA8888);
+            if (_sdl_surface == nullptr)
+            {
+                throw ar::core::virtual_console_error(_virtual_console->get_name(),
+                                                      "Unable to create offscreen surface (" +
+                                                      std::string(SDL_GetError()) + ")");
+            }
+
+            _sdl_renderer = SDL_CreateSoftwareRenderer(_sdl_surface);
+            if (_sdl_renderer == nullptr)
+            {
+                throw ar::core::virtual_console_error(_virtual_console->get_name(),
+                                                      "Unable to create offscreen renderer (" +
+                                                      std::string(SDL_GetError()) + ")");
+            }
+
+            auto set_sdl_objects_fn = _virtual_console->get_symbol_from_library<void(*)(SDL_Window*, SDL_Renderer*)>
+                    ("ar_graphics_set_sdl_objects");
+            set_sdl_objects_fn(nullptr, _sdl_renderer);
+
+            break;
+        }
+
+        case ar_graphics_method_open_gl_context:
+            throw ar::core::virtual_console_error(_virtual_console->get_name(),
+                                                  "OpenGL virtual consoles cannot run headless");
+
+        case ar_graphics_method_none:
+        default:
+            throw ar::core::virtual_console_error(_virtual_console->get_name(),
+                                                  "Invalid graphical mode set inside the virtual console (" +
+                                                  std::to_string(method) + ")");
+    }
+}
+
+void ar::run::headless_runner::prepare_audio()
+{
+    try
+    {
+        // Virtual consoles built against older library do not export audio functions, this will throw for them
+        auto is_audio_configured_fn = _virtual_console->get_symbol_from_library<bool(*)()>("ar_audio_is_configured");
+        if (!is_audio_configured_fn())
+        {
+            return;
+        }
+
+        auto get_channels_fn = _virtual_console->get_symbol_from_library<uint8_t(*)()>("ar_audio_get_channels");
+        auto get_format_fn = _virtual_console->get_symbol_from_library<ar_audio_format(*)()>("ar_audio_get_format");
+
+        _get_queued_frames_fn = _virtual_console->get_symbol_from_library<get_queued_frames_fn>
+                ("ar_audio_get_queued_frames");
+        _pull_samples_fn = _virtual_console->get_symbol_from_library<pull_samples_fn>("ar_audio_pull_samples");
+
+        std::size_t sample_size = get_format_fn() == ar_audio_format_f32 ? sizeof(float) : sizeof(int16_t);
+        _audio_frame_size = sample_size * get_channels_fn();
+    }
+    catch (const ar::error::os_error& ex)
+    {
+        LOG_DEBUG("run.headless_runner", "Virtual console does not export audio functions, " +
+                                         ex.get_logger_formatted_error());
+
+        _get_queued_frames_fn = nullptr;
+        _pull_samples_fn = nullptr;
+    }
+}
+
+void ar::run::headless_runner::hash_final_frame(ar::run::run_statistics& statistics)
+{
+    // Nothing is presented in between, acquiring once after the run gives the last presented frame
+    const void* frame = _acquire_frame_fn();
+    if (frame == nullptr)
+    {
+        return;
+    }
+
+    const ar_frame_buffer* frame_buffer = _get_frame_buffer_fn();
+
+    std::vector<ar_pixel> converted_frame(static_cast<std::size_t>(frame_buffer->width) * frame_buffer->height);
+    _pixel_converter.convert(frame_buffer->format, frame, frame_buffer->pitch, _get_acquired_palette_fn(),
+                             frame_buffer->width, frame_buffer->height, converted_frame.data(),
+                             frame_buffer->width * sizeof(ar_pixel));
+
+    statistics.has_final_frame = true;
+    statistics.final_frame_hash = ar::core::frame_capture::get_frame_hash(converted_frame.data(),
+                                                                          converted_frame.size());
+}
+
+uint64_t ar::run::headless_runner::drain_audio()
+{
+    if (_pull_samples_fn == nullptr)
+    {
+        return 0;
+    }
+
+    uint32_t queued_frames = _get_queued_frames_fn();
+    if (queued_frames == 0)
+    {
+        return 0;
+    }
+
+    if (_audio_buffer.size() < queued_frames * _audio_frame_size)
+    {
+        _audio_buffer.resize(queued_frames * _audio_frame_size);
+    }
+
+    return _pull_samples_fn(_audio_buffer.data(), queued_frames);
+}
+
+void ar::run::headless_runner::on_frame_presented(void* user_data)
+{
+    static_cast<ar::run::headless_runner*>(user_data)->_presented_frame_count++;
+}
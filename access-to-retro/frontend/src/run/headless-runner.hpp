@@ -0,0 +1,178 @@
+/**
+ * @file run/headless-runner.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_FRONTEND_HEADLESS_RUNNER_HPP
+#define ACCESS_TO_RETRO_FRONTEND_HEADLESS_RUNNER_HPP
+
+#include <access-to-retro-dev/access-to-retro-dev.h>
+#include <memory>
+#include <vector>
+#include <SDL.h>
+#include "core/executable-binary.hpp"
+#include "core/pixel-converter.hpp"
+#include "core/virtual-console.hpp"
+
+/// @brief Contains the headless runner, running virtual consoles from the command line without any window
+namespace ar::run
+{
+    /// @brief Timing and output of a headless run
+    struct run_statistics
+    {
+        /// @brief Number of frames that were run
+        uint64_t frame_count = 0;
+
+        /// @brief Number of frames presented by frame buffer virtual consoles
+        uint64_t presented_frame_count = 0;
+
+        /// @brief Number of audio frames (samples per channel) pushed by the virtual console
+        uint64_t audio_frame_count = 0;
+
+        /// @brief Wall clock time of the whole run in seconds
+        double elapsed_time = 0.0;
+
+        /// @brief Time the frames would take when paced by the frontend in seconds
+        double emulated_time = 0.0;
+
+        /// @brief Shortest frame in milliseconds
+        double min_frame_time = 0.0;
+
+        /// @brief Average frame in milliseconds
+        double mean_frame_time = 0.0;
+
+        /// @brief 99th percentile of frames in milliseconds
+        double p99_frame_time = 0.0;
+
+        /// @brief Longest frame in milliseconds
+        double max_frame_time = 0.0;
+
+        /// @brief Whether a frame buffer virtual console presented a frame and 'final_frame_hash' is set
+        bool has_final_frame = false;
+
+        /// @brief Hash of the last presented frame, same value as in frame capture's hash log
+        uint64_t final_frame_hash = 0;
+    };
+
+    /**
+     * @brief Runs a virtual console without a window and without pacing, as fast as possible
+     * @details Virtual console's thread functions are run on the calling thread one after another. Frame buffer
+     *          virtual consoles only have their presents counted, SDL ones draw into an offscreen software renderer.
+     *          Audio is not played, the sample queue is drained after every frame so that it never overruns.
+     */
+    class headless_runner
+    {
+    public:
+        /**
+         * @brief Default constructor, loads the game and starts the virtual console
+         * @param virtual_console Virtual console to run
+         * @param game Game that the virtual console will run
+         * @throws Exceptions:
+         *  - ar::error::io_error: When the game could not be loaded
+         *  - ar::core::virtual_console_error: When the virtual console could not be started or uses OpenGL
+         *  - ar::error::os_error: When the library does not export a required function
+         */
+        headless_runner(std::unique_ptr<ar::core::virtual_console>& virtual_console,
+                        std::unique_ptr<ar::core::executable_binary>& game);
+
+        /// @brief Stops the virtual console and frees the game
+        ~headless_runner();
+
+        headless_runner(const headless_runner&) = delete;
+        headless_runner& operator=(const headless_runner&) = delete;
+
+        /**
+         * @brief Run frames back to back
+         * @param frame_count Number of frames to run
+         * @return Statistics of the run
+         */
+        ar::run::run_statistics run(uint64_t frame_count);
+
+    private:
+        /// @brief Access to Retro library function used to set present callback
+        typedef void(* set_present_callback_fn)(ar_graphics_present_callback, void*);
+
+        /// @brief Access to Retro library function used to acquire the last presented frame
+        typedef const void*(* acquire_frame_fn)();
+
+        /// @brief Access to Retro library function used to get palette of the acquired frame
+        typedef const ar_pixel*(* get_acquired_palette_fn)();
+
+        /// @brief Access to Retro library function used to get the frame buffer
+        typedef ar_frame_buffer*(* get_frame_buffer_fn)();
+
+        /// @brief Access to Retro library function used to get number of queued audio frames
+        typedef uint32_t(* get_queued_frames_fn)();
+
+        /// @brief Access to Retro library function used to pull audio frames
+        typedef uint32_t(* pull_samples_fn)(void*, uint32_t);
+
+        /// @brief Virtual console that is run
+        std::unique_ptr<ar::core::virtual_console>& _virtual_console;
+
+        /// @brief Game that the virtual console runs
+        std::unique_ptr<ar::core::executable_binary>& _game;
+
+        /// @brief Function used to set present callback, nullptr if the virtual console does not use a frame buffer
+        set_present_callback_fn _set_present_callback_fn = nullptr;
+
+        /// @brief Function used to acquire the last presented frame, nullptr if the virtual console does not use a frame
+        ///        buffer
+        acquire_frame_fn _acquire_frame_fn = nullptr;
+
+        /// @brief Function used to get palette of the acquired frame
+        get_acquired_palette_fn _get_acquired_palette_fn = nullptr;
+
+        /// @brief Function used to get the frame buffer
+        get_frame_buffer_fn _get_frame_buffer_fn = nullptr;
+
+        /// @brief Converts the final frame before hashing
+        ar::core::pixel_converter _pixel_converter;
+
+        /// @brief Function used to get number of queued audio frames, nullptr if there is no audio
+        get_queued_frames_fn _get_queued_frames_fn = nullptr;
+
+        /// @brief Function used to pull audio frames, nullptr if there is no audio
+        pull_samples_fn _pull_samples_fn = nullptr;
+
+        /// @brief Size of a single audio frame in bytes
+        std::size_t _audio_frame_size = 0;
+
+        /// @brief Audio frames pulled from the queue, only kept so they do not have to be allocated every frame
+        std::vector<uint8_t> _audio_buffer;
+
+        /// @brief Surface that SDL virtual consoles draw into
+        SDL_Surface* _sdl_surface = nullptr;
+
+        /// @brief Software renderer drawing into '_sdl_surface'
+        SDL_Renderer* _sdl_renderer = nullptr;
+
+        /// @brief Number of frames presented since the last run started
+        uint64_t _presented_frame_count = 0;
+
+        /// @brief Give the virtual console somewhere to draw, depending on its graphics method
+        void prepare_graphics();
+
+        /// @brief Find the audio functions if the virtual console has configured audio
+        void prepare_audio();
+
+        /**
+         * @brief Hash the last presented frame into the statistics
+         * @param statistics Statistics of the finished run
+         */
+        void hash_final_frame(ar::run::run_statistics& statistics);
+
+        /**
+         * @brief Pull all queued audio frames
+         * @return Number of pulled frames
+         */
+        uint64_t drain_audio();
+
+        /**
+         * @brief Present callback set in the library, counts presented frames
+         * @param user_data Pointer to 'headless_runner' object
+         */
+        static void on_frame_presented(void* user_data);
+    };
+}
+
+#endif //ACCESS_TO_RETRO_FRONTEND_HEADLESS_RUNNER_HPP
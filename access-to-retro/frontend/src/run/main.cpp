@@ -0,0 +1,350 @@
+#include <SDL.h>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+#include "error/io-error.hpp"
+#include "error/os-error.hpp"
+#include "util/logger.hpp"
+#include "util/settings-manager.hpp"
+#include "headless-runner.hpp"
+#include "rom-sweep.hpp"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Internal helpers
+// ---------------------------------------------------------------------------------------------------------------------
+
+/// @brief Number of frames that are run when neither '--frames' nor '--seconds' is given, ten seconds at 60 frames
+///        per second
+constexpr uint64_t DEFAULT_FRAME_COUNT = 600;
+
+/// @brief Parsed command line
+struct run_arguments
+{
+    /// @brief Whether all games in a directory are run instead of a single one
+    bool sweep = false;
+
+    /// @brief Whether a single machine readable line is printed instead of the statistics
+    bool summary = false;
+
+    /// @brief Number of frames, 0 if not given
+    uint64_t frame_count = 0;
+
+    /// @brief Emulated seconds, 0 if not given
+    double seconds = 0.0;
+
+    /// @brief Number of parallel workers in a sweep, 0 for the number of hardware threads
+    unsigned jobs = 0;
+
+    /// @brief Seconds after which a sweep worker counts as hung
+    double timeout = 60.0;
+
+    /// @brief Path of the sweep report, empty if the report is not written
+    std::string report_path;
+
+    /// @brief Path of the profiling trace of a single run, empty if the run is not profiled
+    std::string profile_path;
+
+    /// @brief Virtual console and game, or directories of both in a sweep
+    std::vector<std::string> paths;
+
+    /// @brief Arguments passed to the logger
+    std::vector<std::string> logger_args;
+};
+
+/// @brief Print how to use the runner
+static void print_usage()
+{
+    std::fprintf(stderr, "usage: ar-run <virtual console> <game> [--frames N | --seconds S] [--summary] "
+                         "[--profile FILE.json] [-PRIORITY [-VERBOSITY]]\n"
+                         "       ar-run --sweep [<vc directory> <roms directory>] [--seconds S] [--jobs N] "
+                         "[--timeout S] [--report FILE.csv|FILE.json] [-PRIORITY [-VERBOSITY]]\n");
+}
+
+/**
+ * @brief Parse the command line
+ * @param args Arguments without the executable
+ * @param arguments Parsed arguments
+ * @return Whether the command line is valid
+ */
+static bool parse_arguments(const std::vector<std::string>& args, run_arguments& arguments)
+{
+    try
+    {
+        for (std::size_t i = 0; i < args.size(); i++)
+        {
+            bool has_value = i + 1 < args.size();
+
+            if (args[i] == "--sweep")
+            {
+                arguments.sweep = true;
+            }
+            else if (args[i] == "--summary")
+            {
+                arguments.summary = true;
+            }
+            else if (args[i] == "--frames" && has_value)
+            {
+                arguments.frame_count = std::stoull(args[++i]);
+            }
+            else if (args[i] == "--seconds" && has_value)
+            {
+                arguments.seconds = std::stod(args[++i]);
+            }
+            else if (args[i] == "--jobs" && has_value)
+            {
+                arguments.jobs = static_cast<unsigned>(std::stoul(args[++i]));
+            }
+            else if (args[i] == "--timeout" && has_value)
+            {
+                arguments.timeout = std::stod(args[++i]);
+            }
+            else if (args[i] == "--report" && has_value)
+            {
+                arguments.report_path = args[++i];
+            }
+            else if (args[i] == "--profile" && has_value)
+            {
+                arguments.profile_path = args[++i];
+            }
+            else if (args[i].starts_with("-"))
+            {
+                arguments.logger_args.push_back(args[i]);
+            }
+            else
+            {
+                arguments.paths.push_back(args[i]);
+            }
+        }
+    }
+    catch (const std::logic_error&)
+    {
+        return false;
+    }
+
+    if (arguments.sweep)
+    {
+        return arguments.paths.empty() || arguments.paths.size() == 2;
+    }
+
+    return arguments.paths.size() == 2;
+}
+
+/**
+ * @brief Print statistics of a finished run
+ * @param vc_name Name of the virtual console
+ * @param statistics Statistics returned by the runner
+ */
+static void print_statistics(const std::string& vc_name, const ar::run::run_statistics& statistics)
+{
+    double frames_per_second = statistics.elapsed_time > 0.0 ?
+                               static_cast<double>(statistics.frame_count) / statistics.elapsed_time : 0.0;
+    double real_time_multiple = statistics.elapsed_time > 0.0 ?
+                                statistics.emulated_time / statistics.elapsed_time : 0.0;
+
+    std::printf("virtual console:  %s\n", vc_name.c_str());
+    std::printf("frames:           %llu\n", static_cast<unsigned long long>(statistics.frame_count));
+    std::printf("wall time:        %.3f s\n", statistics.elapsed_time);
+    std::printf("frames/s:         %.1f (%.2fx real time)\n", frames_per_second, real_time_multiple);
+    std::printf("frame time ms:    min %.4f  mean %.4f  p99 %.4f  max %.4f\n", statistics.min_frame_time,
+                statistics.mean_frame_time, statistics.p99_frame_time, statistics.max_frame_time);
+    std::printf("presented frames: %llu\n", static_cast<unsigned long long>(statistics.presented_frame_count));
+    std::printf("audio frames:     %llu\n", static_cast<unsigned long long>(statistics.audio_frame_count));
+
+    if (statistics.has_final_frame)
+    {
+        std::printf("final frame hash: %016" PRIx64 "\n", statistics.final_frame_hash);
+    }
+}
+
+/**
+ * @brief Print the single line read by sweeps
+ * @param statistics Statistics returned by the runner
+ */
+static void print_summary(const ar::run::run_statistics& statistics)
+{
+    std::string hash = "-";
+    if (statistics.has_final_frame)
+    {
+        char hash_string[17];
+        std::snprintf(hash_string, sizeof(hash_string), "%016" PRIx64, statistics.final_frame_hash);
+        hash = hash_string;
+    }
+
+    std::printf("summary %llu %.6f %.6f %s\n", static_cast<unsigned long long>(statistics.frame_count),
+                statistics.elapsed_time, statistics.emulated_time, hash.c_str());
+}
+
+/**
+ * @brief Run a single game
+ * @param arguments Parsed arguments
+ * @return Exit code
+ */
+static int run_single(const run_arguments& arguments)
+{
+    // Nothing is initialised, software renderer and the library's audio queue work without any subsystem
+    if (SDL_Init(0) != 0)
+    {
+        std::fprintf(stderr, "Unable to initialise SDL2 library (%s)\n", SDL_GetError());
+        return 1;
+    }
+
+    int exit_code = 0;
+
+    try
+    {
+        auto virtual_console = std::make_unique<ar::core::virtual_console>(arguments.paths[0]);
+        auto game = std::make_unique<ar::core::executable_binary>(arguments.paths[1]);
+
+        uint64_t frame_count = DEFAULT_FRAME_COUNT;
+        if (arguments.frame_count != 0)
+        {
+            frame_count = arguments.frame_count;
+        }
+        else if (arguments.seconds > 0.0)
+        {
+            frame_count = static_cast<uint64_t>(std::ceil(arguments.seconds * 1000.0 /
+                                                          virtual_console->get_frame_time()));
+        }
+
+        ar::run::run_statistics statistics;
+        {
+            ar::run::headless_runner runner(virtual_console, game);
+
+            ar::core::profiler& profiler = virtual_console->access_profiler();
+            if (!arguments.profile_path.empty())
+            {
+                profiler.set_thread_name("main");
+                profiler.start_capture();
+            }
+
+            statistics = runner.run(frame_count);
+
+            // Runner's destructor quits the virtual console which frees recorded zones
+            if (!arguments.profile_path.empty())
+            {
+                profiler.stop_capture(arguments.profile_path);
+            }
+        }
+
+        if (arguments.summary)
+        {
+            print_summary(statistics);
+        }
+        else
+        {
+            print_statistics(virtual_console->get_name(), statistics);
+        }
+    }
+    catch (const ar::base_exception& ex)
+    {
+        std::fprintf(stderr, "%s\n", ex.get_logger_formatted_error().c_str());
+        exit_code = 1;
+    }
+
+    SDL_Quit();
+
+    return exit_code;
+}
+
+/**
+ * @brief Run every game in the roms directory
+ * @param arguments Parsed arguments
+ * @param runner_path Path of this executable
+ * @return Exit code, non-zero if any game did not finish successfully
+ */
+static int run_sweep(const run_arguments& arguments, const std::string& runner_path)
+{
+    ar::run::sweep_options options;
+    options.runner_path = runner_path;
+    options.jobs = arguments.jobs;
+    options.timeout = arguments.timeout;
+
+    if (arguments.seconds > 0.0)
+    {
+        options.seconds = arguments.seconds;
+    }
+
+    try
+    {
+        if (arguments.paths.empty())
+        {
+            // Same directories as the application uses
+            ar::util::settings_manager::configure();
+            auto settings_manager = ar::util::settings_manager::get_global_manager();
+
+            std::optional<std::string> vc_path = settings_manager->get_setting("vc_path");
+            std::optional<std::string> roms_path = settings_manager->get_setting("roms_path");
+            if (vc_path == std::nullopt || roms_path == std::nullopt)
+            {
+                std::fprintf(stderr, "Settings 'vc_path' and 'roms_path' are not set, pass the directories instead\n");
+                return 1;
+            }
+
+            options.vc_directory = vc_path.value();
+            options.roms_directory = roms_path.value();
+        }
+        else
+        {
+            options.vc_directory = arguments.paths[0];
+            options.roms_directory = arguments.paths[1];
+        }
+
+        ar::run::rom_sweep sweep(options);
+        std::vector<ar::run::sweep_result> results = sweep.run();
+
+        if (arguments.report_path.ends_with(".json"))
+        {
+            ar::run::rom_sweep::write_json_report(results, arguments.report_path);
+        }
+        else if (!arguments.report_path.empty())
+        {
+            ar::run::rom_sweep::write_csv_report(results, arguments.report_path);
+        }
+
+        std::map<std::string, std::size_t> status_counts;
+        for (const ar::run::sweep_result& result : results)
+        {
+            status_counts[result.status]++;
+
+            std::printf("%-8s %-32s %-32s %8.2fx %s\n", result.status.c_str(), result.virtual_console.c_str(),
+                        result.rom.c_str(), result.get_speed(),
+                        result.status == "ok" ? result.final_frame_hash.c_str() : result.message.c_str());
+        }
+
+        std::printf("games: %zu", results.size());
+        for (const auto& [status, count] : status_counts)
+        {
+            std::printf(", %s: %zu", status.c_str(), count);
+        }
+        std::printf("\n");
+
+        return status_counts["ok"] == results.size() ? 0 : 1;
+    }
+    catch (const ar::base_exception& ex)
+    {
+        std::fprintf(stderr, "%s\n", ex.get_logger_formatted_error().c_str());
+        return 1;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Entry point
+// ---------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    run_arguments arguments;
+    if (!parse_arguments(std::vector<std::string>(argv + 1, argv + argc), arguments))
+    {
+        print_usage();
+        return 1;
+    }
+
+    ar::util::logger::configure_based_on_args(arguments.logger_args);
+
+    return arguments.sweep ? run_sweep(arguments, argv[0]) : run_single(arguments);
+}
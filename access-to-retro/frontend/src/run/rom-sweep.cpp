@@ -0,0 +1,363 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include "core/virtual-console.hpp"
+#include "error/io-error.hpp"
+#include "helpers/cross-platform-helper.hpp"
+#include "helpers/io-helper.hpp"
+#include "util/logger.hpp"
+#include "rom-sweep.hpp"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Internal helpers
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Get last non-empty line of worker's output
+ * @param output Output of the worker
+ * @return Last line without the line ending
+ */
+static std::string get_last_line(const std::string& output)
+{
+    std::istringstream stream(output);
+    std::string line;
+    std::string last_line;
+
+    while (std::getline(stream, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+
+        if (!line.empty())
+        {
+            last_line = line;
+        }
+    }
+
+    return last_line;
+}
+
+/**
+ * @brief Escape a string for a CSV field
+ * @param value Field value
+ * @return Quoted field
+ */
+static std::string escape_csv(const std::string& value)
+{
+    std::string escaped = "\"";
+    for (char character : value)
+    {
+        escaped += character == '"' ? std::string("\"\"") : std::string(1, character);
+    }
+
+    return escaped + "\"";
+}
+
+/**
+ * @brief Escape a string for a JSON string
+ * @param value String value
+ * @return Quoted string
+ */
+static std::string escape_json(const std::string& value)
+{
+    std::string escaped = "\"";
+    for (char character : value)
+    {
+        switch (character)
+        {
+            case '"':
+                escaped += "\\\"";
+                break;
+
+            case '\\':
+                escaped += "\\\\";
+                break;
+
+            case '\n':
+                escaped += "\\n";
+                break;
+
+            case '\t':
+                escaped += "\\t";
+                break;
+
+            default:
+                if (static_cast<unsigned char>(character) < 0x20)
+                {
+                    char code[8];
+                    std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned>(character));
+                    escaped += code;
+                }
+                else
+                {
+                    escaped += character;
+                }
+                break;
+        }
+    }
+
+    return escaped + "\"";
+}
+
+/**
+ * @brief Open a report file for writing
+ * @param path Path of the report
+ * @return Opened stream
+ * @throws Exceptions:
+ *  - ar::error::io_error: When the file could not be opened
+ */
+static std::ofstream open_report(const std::filesystem::path& path)
+{
+    std::ofstream report(path, std::ios::trunc);
+    if (!report)
+    {
+        throw ar::error::io_error(path.string(), "Unable to open sweep report for writing");
+    }
+
+    return report;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Constructors & Destructors
+// ---------------------------------------------------------------------------------------------------------------------
+
+ar::run::rom_sweep::rom_sweep(ar::run::sweep_options options) :
+        _options(std::move(options))
+{
+    std::vector<std::pair<std::filesystem::path, std::string>> vc_extensions;
+    std::vector<std::filesystem::path> rom_paths;
+
+    try
+    {
+        for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(_options.vc_directory))
+        {
+            std::string file_name = entry.path().filename().string();
+            if (!entry.is_regular_file() || !ar::helpers::cross_platform::check_vc_os_compatibility(file_name))
+            {
+                continue;
+            }
+
+            // Only the extensions are needed here, games run in workers loading the library on their own
+            try
+            {
+                ar::core::virtual_console virtual_console(entry.path().string());
+                vc_extensions.emplace_back(entry.path(), virtual_console.get_rom_extension());
+            }
+            catch (const ar::base_exception& ex)
+            {
+                LOG_WARNING("Skipping virtual console '" + file_name + "' in sweep: " + ex.get_logger_formatted_error());
+            }
+        }
+
+        for (const std::filesystem::directory_entry& entry :
+                std::filesystem::directory_iterator(_options.roms_directory))
+        {
+            if (entry.is_regular_file() && entry.path().has_extension())
+            {
+                rom_paths.push_back(entry.path());
+            }
+        }
+    }
+    catch (const std::filesystem::filesystem_error& ex)
+    {
+        throw ar::error::io_error(ex.path1().string(), std::string("Unable to read sweep directory: ") + ex.what());
+    }
+
+    // Directory order is unspecified, sorted order keeps reports comparable between sweeps
+    std::sort(vc_extensions.begin(), vc_extensions.end());
+    std::sort(rom_paths.begin(), rom_paths.end());
+
+    for (const std::filesystem::path& rom_path : rom_paths)
+    {
+        for (const auto& [vc_path, rom_extension] : vc_extensions)
+        {
+            if (ar::helpers::io::is_extension_part_of_extensions_string(rom_path.extension().string(), rom_extension))
+            {
+                _jobs.push_back({ vc_path, rom_path });
+            }
+        }
+    }
+
+    LOG_INFO("Sweep matched " + std::to_string(_jobs.size()) + " games from " + std::to_string(rom_paths.size()) +
+             " files to " + std::to_string(vc_extensions.size()) + " virtual consoles");
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Public functions
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::vector<ar::run::sweep_result> ar::run::rom_sweep::run()
+{
+    std::vector<ar::run::sweep_result> results(_jobs.size());
+
+    unsigned worker_count = _options.jobs != 0 ? _options.jobs : std::max(1u, std::thread::hardware_concurrency());
+    worker_count = static_cast<unsigned>(std::min<std::size_t>(worker_count, std::max<std::size_t>(_jobs.size(), 1)));
+
+    // Each thread only waits for its current worker process, next job is taken from the shared index
+    std::atomic_size_t next_job = 0;
+    std::vector<std::thread> threads;
+
+    for (unsigned i = 0; i < worker_count; i++)
+    {
+        threads.emplace_back([this, &results, &next_job]
+        {
+            for (std::size_t job = next_job++; job < _jobs.size(); job = next_job++)
+            {
+                results[job] = run_job(_jobs[job]);
+
+                LOG_INFO(results[job].status + ": " + results[job].virtual_console + " " + results[job].rom);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    return results;
+}
+
+std::size_t ar::run::rom_sweep::get_job_count() const
+{
+    return _jobs.size();
+}
+
+void ar::run::rom_sweep::write_csv_report(const std::vector<ar::run::sweep_result>& results,
+                                          const std::filesystem::path& path)
+{
+    std::ofstream report = open_report(path);
+
+    report << "virtual_console,rom,status,exit_code,frames,elapsed_seconds,emulated_seconds,speed,final_frame_hash,"
+              "message\n";
+
+    for (const ar::run::sweep_result& result : results)
+    {
+        report << escape_csv(result.virtual_console) << "," << escape_csv(result.rom) << "," << result.status << ","
+               << result.exit_code << "," << result.frame_count << "," << result.elapsed_time << ","
+               << result.emulated_time << "," << result.get_speed() << "," << result.final_frame_hash << ","
+               << escape_csv(result.message) << "\n";
+    }
+
+    if (!report)
+    {
+        throw ar::error::io_error(path.string(), "Unable to write sweep report");
+    }
+}
+
+void ar::run::rom_sweep::write_json_report(const std::vector<ar::run::sweep_result>& results,
+                                           const std::filesystem::path& path)
+{
+    std::ofstream report = open_report(path);
+
+    report << "[\n";
+
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        const ar::run::sweep_result& result = results[i];
+
+        report << "  {\"virtual_console\": " << escape_json(result.virtual_console)
+               << ", \"rom\": " << escape_json(result.rom)
+               << ", \"status\": " << escape_json(result.status)
+               << ", \"exit_code\": " << result.exit_code
+               << ", \"frames\": " << result.frame_count
+               << ", \"elapsed_seconds\": " << result.elapsed_time
+               << ", \"emulated_seconds\": " << result.emulated_time
+               << ", \"speed\": " << result.get_speed()
+               << ", \"final_frame_hash\": "
+               << (result.final_frame_hash.empty() ? "null" : escape_json(result.final_frame_hash))
+               << ", \"message\": " << escape_json(result.message) << "}"
+               << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+
+    report << "]\n";
+
+    if (!report)
+    {
+        throw ar::error::io_error(path.string(), "Unable to write sweep report");
+    }
+}
+
+double ar::run::sweep_result::get_speed() const
+{
+    return elapsed_time > 0.0 ? emulated_time / elapsed_time : 0.0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Private functions
+// ---------------------------------------------------------------------------------------------------------------------
+
+ar::run::sweep_result ar::run::rom_sweep::run_job(const sweep_job& job) const
+{
+    ar::run::sweep_result result;
+    result.virtual_console = job.vc_path.filename().string();
+    result.rom = job.rom_path.filename().string();
+
+    ar::run::worker_status status;
+    std::string output;
+
+    try
+    {
+        ar::run::worker_process worker(_options.runner_path, { job.vc_path.string(), job.rom_path.string(),
+                                                               "--seconds", std::to_string(_options.seconds),
+                                                               "--summary" });
+
+        status = worker.wait(std::chrono::milliseconds(static_cast<int64_t>(_options.timeout * 1000.0)));
+        result.exit_code = worker.get_exit_code();
+        output = worker.get_output();
+    }
+    catch (const ar::error::os_error& ex)
+    {
+        result.status = "failed";
+        result.message = ex.get_logger_formatted_error();
+
+        return result;
+    }
+
+    std::string last_line = get_last_line(output);
+
+    switch (status)
+    {
+        case ar::run::worker_status::timed_out:
+        {
+            std::ostringstream message;
+            message << "Killed after " << _options.timeout << " seconds";
+
+            result.status = "hung";
+            result.message = message.str();
+            return result;
+        }
+
+        case ar::run::worker_status::crashed:
+            result.status = "crashed";
+            result.message = last_line;
+            return result;
+
+        case ar::run::worker_status::exited:
+        default:
+            break;
+    }
+
+    // Summary line: "summary <frames> <elapsed seconds> <emulated seconds> <final frame hash or '-'>"
+    std::istringstream summary(last_line);
+    std::string tag;
+    std::string hash;
+
+    if (result.exit_code != 0 || !(summary >> tag >> result.frame_count >> result.elapsed_time >> result.emulated_time
+                                   >> hash) || tag != "summary")
+    {
+        result.status = "failed";
+        result.message = last_line;
+        return result;
+    }
+
+    result.status = "ok";
+    result.final_frame_hash = hash == "-" ? "" : hash;
+
+    return result;
+}
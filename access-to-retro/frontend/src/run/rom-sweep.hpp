@@ -0,0 +1,149 @@
+/**
+ * @file run/rom-sweep.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_FRONTEND_ROM_SWEEP_HPP
+#define ACCESS_TO_RETRO_FRONTEND_ROM_SWEEP_HPP
+
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "worker-process.hpp"
+
+namespace ar::run
+{
+    /// @brief Settings of a sweep
+    struct sweep_options
+    {
+        /// @brief Directory with '.vc' files
+        std::filesystem::path vc_directory;
+
+        /// @brief Directory with games
+        std::filesystem::path roms_directory;
+
+        /// @brief Path of this executable, workers are started from it
+        std::string runner_path;
+
+        /// @brief Emulated seconds each game runs for
+        double seconds = 10.0;
+
+        /// @brief Number of games running at the same time, 0 uses the number of hardware threads
+        unsigned jobs = 0;
+
+        /// @brief Wall clock seconds after which a worker counts as hung and gets killed
+        double timeout = 60.0;
+    };
+
+    /// @brief Result of a single game
+    struct sweep_result
+    {
+        /// @brief File name of the virtual console
+        std::string virtual_console;
+
+        /// @brief File name of the game
+        std::string rom;
+
+        /// @brief "ok", "failed" (worker reported an error), "crashed" or "hung"
+        std::string status;
+
+        /// @brief Exit code, signal number or exception code of the worker
+        int exit_code = 0;
+
+        /// @brief Number of frames that were run
+        uint64_t frame_count = 0;
+
+        /// @brief Wall clock time of the run in seconds
+        double elapsed_time = 0.0;
+
+        /// @brief Time the frames would take when paced by the frontend in seconds
+        double emulated_time = 0.0;
+
+        /// @brief Hash of the last presented frame in hex, empty if the virtual console did not present one
+        std::string final_frame_hash;
+
+        /// @brief Last line the worker wrote when it did not finish successfully
+        std::string message;
+
+        /**
+         * @brief Get how many times faster than real time the game ran
+         * @return Emulated time divided by elapsed time, 0 if the run did not finish
+         */
+        [[nodiscard]] double get_speed() const;
+    };
+
+    /**
+     * @brief Runs every game in a directory with every virtual console supporting its extension
+     * @details Each game runs in its own worker process (the runner itself in summary mode), so crashes are contained
+     *          and the same virtual console can run several games at once. A watchdog kills workers exceeding the
+     *          timeout and reports them as hung.
+     */
+    class rom_sweep
+    {
+    public:
+        /**
+         * @brief Default constructor, matches games to virtual consoles
+         * @param options Settings of the sweep
+         * @throws Exceptions:
+         *  - ar::error::io_error: When one of the directories could not be read
+         */
+        explicit rom_sweep(ar::run::sweep_options options);
+
+        /**
+         * @brief Run all matched games
+         * @return Results in the order games were matched
+         */
+        std::vector<ar::run::sweep_result> run();
+
+        /**
+         * @brief Get number of matched games
+         * @return Number of runs the sweep does
+         */
+        [[nodiscard]] std::size_t get_job_count() const;
+
+        /**
+         * @brief Write results as CSV, one row per game
+         * @param results Results of the sweep
+         * @param path Path of the report
+         * @throws Exceptions:
+         *  - ar::error::io_error: When the file could not be written
+         */
+        static void write_csv_report(const std::vector<ar::run::sweep_result>& results,
+                                     const std::filesystem::path& path);
+
+        /**
+         * @brief Write results as JSON array, one object per game
+         * @param results Results of the sweep
+         * @param path Path of the report
+         * @throws Exceptions:
+         *  - ar::error::io_error: When the file could not be written
+         */
+        static void write_json_report(const std::vector<ar::run::sweep_result>& results,
+                                      const std::filesystem::path& path);
+
+    private:
+        /// @brief Game matched to a virtual console
+        struct sweep_job
+        {
+            /// @brief Path of the virtual console
+            std::filesystem::path vc_path;
+
+            /// @brief Path of the game
+            std::filesystem::path rom_path;
+        };
+
+        /// @brief Settings of the sweep
+        ar::run::sweep_options _options;
+
+        /// @brief Matched games
+        std::vector<sweep_job> _jobs;
+
+        /**
+         * @brief Run a single game in a worker and parse its summary
+         * @param job Game to run
+         * @return Result of the game
+         */
+        ar::run::sweep_result run_job(const sweep_job& job) const;
+    };
+}
+
+#endif //ACCESS_TO_RETRO_FRONTEND_ROM_SWEEP_HPP
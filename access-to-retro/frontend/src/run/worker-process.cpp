@@ -0,0 +1,231 @@
+#if defined(__linux__) || defined(__APPLE__)
+
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <csignal>
+#include <cerrno>
+#include <cstring>
+
+#endif
+
+#include <thread>
+#include "worker-process.hpp"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Constructors & Destructors
+// ---------------------------------------------------------------------------------------------------------------------
+
+ar::run::worker_process::worker_process(const std::string& executable, const std::vector<std::string>& args)
+{
+#if defined(__linux__) || defined(__APPLE__)
+    int pipe_fds[2];
+    if (pipe(pipe_fds) != 0)
+    {
+        throw ar::error::os_error("Unable to create pipe for worker process (" + std::string(strerror(errno)) + ")");
+    }
+
+    // Arguments are prepared before forking, child should only call async-signal-safe functions
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(executable.c_str()));
+    for (const std::string& arg : args)
+    {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    _pid = fork();
+    if (_pid < 0)
+    {
+        close(pipe_fds[0]);
+        close(pipe_fds[1]);
+
+        throw ar::error::os_error("Unable to fork worker process (" + std::string(strerror(errno)) + ")");
+    }
+
+    if (_pid == 0)
+    {
+        dup2(pipe_fds[1], STDOUT_FILENO);
+        dup2(pipe_fds[1], STDERR_FILENO);
+        close(pipe_fds[0]);
+        close(pipe_fds[1]);
+
+        execvp(executable.c_str(), argv.data());
+
+        // Only reached when exec failed
+        _exit(127);
+    }
+
+    close(pipe_fds[1]);
+    _output_fd = pipe_fds[0];
+
+    // Output is read while polling for exit, reads must not wait for the child
+    fcntl(_output_fd, F_SETFL, fcntl(_output_fd, F_GETFL) | O_NONBLOCK);
+#elif defined(_WIN32)
+    SECURITY_ATTRIBUTES security_attributes {};
+    security_attributes.nLength = sizeof(SECURITY_ATTRIBUTES);
+    security_attributes.bInheritHandle = TRUE;
+
+    HANDLE write_pipe = nullptr;
+    if (!CreatePipe(&_output_pipe, &write_pipe, &security_attributes, 0))
+    {
+        throw ar::error::os_error("Unable to create pipe for worker process (id=" +
+                                  std::to_string(GetLastError()) + ")");
+    }
+
+    // Only the write end is inherited by the child
+    SetHandleInformation(_output_pipe, HANDLE_FLAG_INHERIT, 0);
+
+    // Windows passes a single command line, every argument is quoted
+    std::string command_line = "\"" + executable + "\"";
+    for (const std::string& arg : args)
+    {
+        command_line += " \"" + arg + "\"";
+    }
+
+    STARTUPINFOA startup_info {};
+    startup_info.cb = sizeof(STARTUPINFOA);
+    startup_info.dwFlags = STARTF_USESTDHANDLES;
+    startup_info.hStdOutput = write_pipe;
+    startup_info.hStdError = write_pipe;
+    startup_info.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+
+    BOOL created = CreateProcessA(nullptr, command_line.data(), nullptr, nullptr, TRUE, CREATE_NO_WINDOW, nullptr,
+                                  nullptr, &startup_info, &_process_information);
+    CloseHandle(write_pipe);
+
+    if (!created)
+    {
+        CloseHandle(_output_pipe);
+
+        throw ar::error::os_error("Unable to create worker process (id=" + std::to_string(GetLastError()) + ")");
+    }
+#endif
+
+    _running = true;
+}
+
+ar::run::worker_process::~worker_process()
+{
+    if (_running)
+    {
+        kill();
+    }
+
+#if defined(__linux__) || defined(__APPLE__)
+    close(_output_fd);
+#elif defined(_WIN32)
+    CloseHandle(_output_pipe);
+    CloseHandle(_process_information.hThread);
+    CloseHandle(_process_information.hProcess);
+#endif
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Public functions
+// ---------------------------------------------------------------------------------------------------------------------
+
+ar::run::worker_status ar::run::worker_process::wait(std::chrono::milliseconds timeout)
+{
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (_running)
+    {
+        read_output();
+
+#if defined(__linux__) || defined(__APPLE__)
+        int status = 0;
+        if (waitpid(_pid, &status, WNOHANG) == _pid)
+        {
+            _running = false;
+            read_output();
+
+            if (WIFSIGNALED(status))
+            {
+                _exit_code = WTERMSIG(status);
+                return ar::run::worker_status::crashed;
+            }
+
+            _exit_code = WEXITSTATUS(status);
+            return ar::run::worker_status::exited;
+        }
+#elif defined(_WIN32)
+        if (WaitForSingleObject(_process_information.hProcess, 0) == WAIT_OBJECT_0)
+        {
+            _running = false;
+            read_output();
+
+            DWORD exit_code = 0;
+            GetExitCodeProcess(_process_information.hProcess, &exit_code);
+            _exit_code = static_cast<int>(exit_code);
+
+            // Unhandled exceptions end the process with their NTSTATUS error code (for ex: 0xC0000005)
+            return (exit_code & 0xC0000000) == 0xC0000000 ? ar::run::worker_status::crashed :
+                   ar::run::worker_status::exited;
+        }
+#endif
+
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            kill();
+            return ar::run::worker_status::timed_out;
+        }
+
+        std::this_thread::sleep_for(POLL_INTERVAL);
+    }
+
+    return ar::run::worker_status::exited;
+}
+
+int ar::run::worker_process::get_exit_code() const
+{
+    return _exit_code;
+}
+
+const std::string& ar::run::worker_process::get_output() const
+{
+    return _output;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Private functions
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ar::run::worker_process::read_output()
+{
+    char buffer[4096];
+
+#if defined(__linux__) || defined(__APPLE__)
+    ssize_t read_size = 0;
+    while ((read_size = read(_output_fd, buffer, sizeof(buffer))) > 0)
+    {
+        _output.append(buffer, static_cast<std::size_t>(read_size));
+    }
+#elif defined(_WIN32)
+    DWORD available = 0;
+    while (PeekNamedPipe(_output_pipe, nullptr, 0, nullptr, &available, nullptr) && available > 0)
+    {
+        DWORD read_size = 0;
+        if (!ReadFile(_output_pipe, buffer, sizeof(buffer), &read_size, nullptr) || read_size == 0)
+        {
+            break;
+        }
+
+        _output.append(buffer, read_size);
+    }
+#endif
+}
+
+void ar::run::worker_process::kill()
+{
+#if defined(__linux__) || defined(__APPLE__)
+    ::kill(_pid, SIGKILL);
+    waitpid(_pid, nullptr, 0);
+#elif defined(_WIN32)
+    TerminateProcess(_process_information.hProcess, 1);
+    WaitForSingleObject(_process_information.hProcess, INFINITE);
+#endif
+
+    _running = false;
+    read_output();
+}
@@ -0,0 +1,115 @@
+/**
+ * @file run/worker-process.hpp
+ */
+
+#ifndef ACCESS_TO_RETRO_FRONTEND_WORKER_PROCESS_HPP
+#define ACCESS_TO_RETRO_FRONTEND_WORKER_PROCESS_HPP
+
+#if defined(__linux__) || defined(__APPLE__)
+
+#include <sys/types.h>
+
+#elif defined(_WIN32)
+
+#include <windows.h>
+
+#endif
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include "error/os-error.hpp"
+
+namespace ar::run
+{
+    /// @brief How a worker process ended
+    enum class worker_status
+    {
+        /// @brief Returned from main, see exit code
+        exited,
+
+        /// @brief Terminated by a signal (POSIX) or an unhandled exception (Windows)
+        crashed,
+
+        /// @brief Did not finish in time and was killed
+        timed_out
+    };
+
+    /**
+     * @brief Child process whose standard output and error are collected into a string
+     * @details Virtual consoles keep their state in the library's globals and the same library file is only loaded
+     *          once per process, so running several games at the same time needs separate processes.
+     */
+    class worker_process
+    {
+    public:
+        /**
+         * @brief Default constructor, starts the process
+         * @param executable Path of the executable, searched in PATH if it does not contain a directory
+         * @param args Arguments passed to the executable, without the executable itself
+         * @throws Exceptions:
+         *  - ar::error::os_error: When the process could not be started
+         */
+        worker_process(const std::string& executable, const std::vector<std::string>& args);
+
+        /// @brief Kills the process if it is still running
+        ~worker_process();
+
+        worker_process(const worker_process&) = delete;
+        worker_process& operator=(const worker_process&) = delete;
+
+        /**
+         * @brief Collect output until the process ends, kill it once the timeout passes
+         * @param timeout Longest time the process can run, measured from the call
+         * @return How the process ended
+         */
+        ar::run::worker_status wait(std::chrono::milliseconds timeout);
+
+        /**
+         * @brief Get exit code of an exited process, signal number or exception code of a crashed one
+         * @return Exit code
+         */
+        [[nodiscard]] int get_exit_code() const;
+
+        /**
+         * @brief Get everything the process wrote to standard output and error
+         * @return Collected output
+         */
+        [[nodiscard]] const std::string& get_output() const;
+
+    private:
+        /// @brief Time between checks whether the process ended
+        static constexpr std::chrono::milliseconds POLL_INTERVAL = std::chrono::milliseconds(5);
+
+#if defined(__linux__) || defined(__APPLE__)
+        /// @brief Process ID of the child
+        pid_t _pid = -1;
+
+        /// @brief Read end of the pipe connected to child's standard output and error
+        int _output_fd = -1;
+#elif defined(_WIN32)
+        /// @brief Child process information
+        PROCESS_INFORMATION _process_information {};
+
+        /// @brief Read end of the pipe connected to child's standard output and error
+        HANDLE _output_pipe = nullptr;
+#endif
+
+        /// @brief Whether the process is still running
+        bool _running = false;
+
+        /// @brief Exit code, signal number or exception code
+        int _exit_code = 0;
+
+        /// @brief Output collected so far
+        std::string _output;
+
+        /// @brief Append whatever the process wrote since the last call to '_output', never blocks
+        void read_output();
+
+        /// @brief Kill the process and wait for it to end
+        void kill();
+    };
+}
+
+#endif //ACCESS_TO_RETRO_FRONTEND_WORKER_PROCESS_HPP
@@ -0,0 +1,249 @@
+/**
+ * @file tests/audio-resampler-tests.cpp
+ * @details Tests of the audio resampler, each one is registered as its own CTest test:
+ *           - simd: noise resampled with every instruction set supported by the CPU has to match the plain C++ dot
+ *             product within float rounding, for several conversions and uneven block sizes
+ *           - set_rates: rates change between blocks (rate control nudges and changes that rebuild the filter), a
+ *             sine wave has to come out continuous, every output frame is compared with the sine at its input time
+ *
+ *          Usage: ar_audio_resampler_test <simd|set_rates>
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <numbers>
+#include <string>
+#include <vector>
+#include <cmath>
+#include "core/audio-resampler.hpp"
+
+/// @brief Number of interleaved channels
+static constexpr uint32_t CHANNELS = 2;
+
+/// @brief Output frames read per block, cycled through so that blocks end at every kind of position
+static constexpr std::size_t BLOCK_FRAMES[] = { 256, 1, 100, 333, 64, 17 };
+
+/// @brief Number of blocks each resampler produces
+static constexpr std::size_t BLOCK_COUNT = 60;
+
+/// @brief Largest ratio of input rate to output rate used by the tests
+static constexpr double MAX_RATIO = 4.0;
+
+/// @brief Largest difference between the output of SIMD and scalar dot products, they only sum in different order
+static constexpr float SIMD_TOLERANCE = 1e-5f;
+
+/// @brief Largest difference between the output and the ideal sine, passband ripple and phase interpolation
+static constexpr double SINE_TOLERANCE = 2e-3;
+
+/// @brief Sample rate of the input in 'set_rates' test (virtual console)
+static constexpr double INPUT_RATE = 48000.0;
+
+/// @brief Frequency of the sine in 'set_rates' test, far below every cutoff
+static constexpr double SINE_FREQUENCY = 440.0;
+
+/**
+ * @brief Get next value of a xorshift generator, fixed seed keeps the input the same on every run
+ * @param state State of the generator, must not be 0
+ * @return Next pseudo random value
+ */
+static uint32_t next_random(uint32_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+
+    return state;
+}
+
+/**
+ * @brief Create a resampler able to take the largest block at 'MAX_RATIO'
+ * @param simd Instruction set of the resampler
+ * @return Resampler
+ */
+static ar::core::audio_resampler create_resampler(ar::core::audio_resampler::simd_level simd)
+{
+    std::size_t max_block = *std::max_element(std::begin(BLOCK_FRAMES), std::end(BLOCK_FRAMES));
+
+    return { CHANNELS, static_cast<std::size_t>(std::ceil(static_cast<double>(max_block) * MAX_RATIO)) +
+                       ar::core::audio_resampler::TAPS + 1, simd };
+}
+
+/**
+ * @brief Resample white noise block by block
+ * @param simd Instruction set of the resampler
+ * @param input_rate Sample rate of the input
+ * @param output_rate Sample rate of the output
+ * @return All output frames, interleaved
+ */
+static std::vector<float> resample_noise(ar::core::audio_resampler::simd_level simd, double input_rate,
+                                         double output_rate)
+{
+    ar::core::audio_resampler resampler = create_resampler(simd);
+    resampler.set_rates(input_rate, output_rate);
+
+    uint32_t random = 0xC0FFEE;
+    std::vector<float> input;
+    std::vector<float> output;
+
+    for (std::size_t block = 0; block < BLOCK_COUNT; block++)
+    {
+        std::size_t frames = BLOCK_FRAMES[block % std::size(BLOCK_FRAMES)];
+
+        input.resize(resampler.get_required_input_frames(frames) * CHANNELS);
+        for (float& sample : input)
+        {
+            sample = static_cast<float>(next_random(random)) / 2147483648.0f - 1.0f;
+        }
+
+        resampler.push_input(input.data(), input.size() / CHANNELS);
+
+        output.resize(output.size() + frames * CHANNELS);
+        resampler.read_output(output.data() + output.size() - frames * CHANNELS, frames);
+    }
+
+    return output;
+}
+
+/**
+ * @brief SIMD dot products match the scalar one
+ * @return true if the test passed
+ */
+static bool simd_test()
+{
+    using simd_level = ar::core::audio_resampler::simd_level;
+
+    // Conversions, input rate -> output rate, up to 'MAX_RATIO'
+    const std::vector<std::pair<double, double>> conversions = {
+            { 48000.0, 48000.0 },
+            { 44100.0, 48000.0 },
+            { 48000.0, 44100.0 },
+            { 22050.0, 48000.0 },
+            { 48000.0 * 1.005, 48000.0 },
+            { 192000.0, 48000.0 },
+    };
+
+    simd_level best = ar::core::audio_resampler::get_best_simd_level();
+    bool passed = true;
+
+    for (const auto& [input_rate, output_rate] : conversions)
+    {
+        std::vector<float> expected = resample_noise(simd_level::none, input_rate, output_rate);
+
+        for (simd_level simd : { simd_level::sse, simd_level::avx })
+        {
+            if (simd > best)
+            {
+                continue;
+            }
+
+            std::vector<float> output = resample_noise(simd, input_rate, output_rate);
+
+            for (std::size_t i = 0; i < expected.size(); i++)
+            {
+                if (!(std::abs(output[i] - expected[i]) <= SIMD_TOLERANCE))
+                {
+                    std::cerr << ar::core::audio_resampler::get_simd_level_name(simd) << " " << input_rate
+                              << "hz -> " << output_rate << "hz: sample " << i << " is " << output[i]
+                              << ", scalar dot product gives " << expected[i] << std::endl;
+                    passed = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (passed)
+    {
+        std::cout << conversions.size() << " conversions up to " << ar::core::audio_resampler::get_simd_level_name(best)
+                  << " match the scalar dot product" << std::endl;
+    }
+
+    return passed;
+}
+
+/**
+ * @brief Output stays continuous when the rates change between blocks
+ * @return true if the test passed
+ */
+static bool set_rates_test()
+{
+    // Output rate of consecutive blocks: rate control nudges, then changes that rebuild the filter and back
+    const std::vector<double> output_rates = {
+            48000.0, 48000.0 * 1.002, 48000.0 * 0.997, 44100.0, 22050.0, 12000.0, 96000.0, 48000.0,
+    };
+
+    ar::core::audio_resampler resampler = create_resampler(ar::core::audio_resampler::get_best_simd_level());
+
+    constexpr double ANGULAR_FREQUENCY = 2.0 * std::numbers::pi * SINE_FREQUENCY / INPUT_RATE;
+
+    // Output frame lies between the two middle taps of its filter window
+    constexpr double FILTER_DELAY = ar::core::audio_resampler::TAPS / 2 - 1;
+
+    std::size_t input_frames = 0;
+    std::size_t output_frames = 0;
+    double input_position = 0.0;
+    std::vector<float> input;
+    std::vector<float> output;
+
+    for (std::size_t block = 0; block < BLOCK_COUNT; block++)
+    {
+        double output_rate = output_rates[block % output_rates.size()];
+        std::size_t frames = BLOCK_FRAMES[block % std::size(BLOCK_FRAMES)];
+
+        resampler.set_rates(INPUT_RATE, output_rate);
+
+        input.resize(resampler.get_required_input_frames(frames) * CHANNELS);
+        for (std::size_t i = 0; i < input.size() / CHANNELS; i++)
+        {
+            double angle = ANGULAR_FREQUENCY * static_cast<double>(input_frames++);
+
+            input[i * CHANNELS + 0] = static_cast<float>(std::sin(angle));
+            input[i * CHANNELS + 1] = static_cast<float>(std::cos(angle));
+        }
+
+        resampler.push_input(input.data(), input.size() / CHANNELS);
+
+        output.resize(frames * CHANNELS);
+        resampler.read_output(output.data(), frames);
+
+        // Dropped, repeated or misplaced input frames shift the phase of the sine
+        for (std::size_t i = 0; i < frames; i++, output_frames++)
+        {
+            double angle = ANGULAR_FREQUENCY * (input_position + FILTER_DELAY);
+
+            double sine_error   = std::abs(output[i * CHANNELS + 0] - std::sin(angle));
+            double cosine_error = std::abs(output[i * CHANNELS + 1] - std::cos(angle));
+
+            if (!(std::max(sine_error, cosine_error) <= SINE_TOLERANCE))
+            {
+                std::cerr << "Block " << block << " (" << output_rate << "hz), output frame " << output_frames
+                          << " is off the sine by " << std::max(sine_error, cosine_error) << std::endl;
+                return false;
+            }
+
+            input_position += INPUT_RATE / output_rate;
+        }
+    }
+
+    std::cout << output_frames << " output frames over " << BLOCK_COUNT << " blocks with changing rates follow the "
+              << "input sine" << std::endl;
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    std::string test = argc == 2 ? argv[1] : "";
+
+    if (test == "simd")
+    {
+        return simd_test() ? 0 : 1;
+    }
+
+    if (test == "set_rates")
+    {
+        return set_rates_test() ? 0 : 1;
+    }
+
+    std::cerr << "Usage: " << argv[0] << " <simd|set_rates>" << std::endl;
+    return 1;
+}
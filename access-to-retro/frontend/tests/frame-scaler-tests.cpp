@@ -0,0 +1,169 @@
+/**
+ * @file tests/frame-scaler-tests.cpp
+ * @details Scales frames with every filter using the plain C++ kernels and the SSE2 ones, then compares the scaled
+ *          rows byte for byte. Frames are drawn from a few colours so that the filters find edges and equal
+ *          neighbours, their widths are not multiples of 4 so that the scalar remainder of each row runs too.
+ *          Destination rows are padded with a canary that no filter may overwrite.
+ *
+ *          Usage: ar_frame_scaler_test
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include "core/frame-scaler.hpp"
+
+/// @brief Frame sizes to scale, width x height
+static const std::vector<std::pair<uint32_t, uint32_t>> g_frame_sizes = {
+        { 1,   1 },
+        { 5,   3 },
+        { 7,   7 },
+        { 13,  9 },
+        { 64,  32 },
+        { 67,  33 },
+};
+
+/// @brief Output sizes as multiples of the frame size (in tenths), below 10 the filter's own factor is used
+static const std::vector<uint32_t> g_output_scales = { 10, 20, 35, 60, 75 };
+
+/// @brief Filters to compare
+static const std::vector<ar::core::frame_scaler::filter> g_filters = {
+        ar::core::frame_scaler::filter::nearest,
+        ar::core::frame_scaler::filter::scale2x,
+        ar::core::frame_scaler::filter::scale3x,
+        ar::core::frame_scaler::filter::xbr,
+};
+
+/// @brief Colours most pixels are drawn from, packed 'ar_pixel' values
+static constexpr uint32_t COLOURS[] = { 0xFF000000, 0xFFFFFFFF, 0xFF2040C0, 0xFF30C020 };
+
+/// @brief Bytes added after every destination row, filled with 'CANARY'
+static constexpr std::size_t DESTINATION_PADDING = 16;
+
+/// @brief Value of destination bytes before scaling, padding has to keep it
+static constexpr uint8_t CANARY = 0xCD;
+
+/// @brief Number of frames each scaler scales one after another, buffers of the previous frame are reused
+static constexpr std::size_t FRAME_COUNT = 2;
+
+/**
+ * @brief Get next value of a xorshift generator, fixed seed keeps the frames the same on every run
+ * @param state State of the generator, must not be 0
+ * @return Next pseudo random value
+ */
+static uint32_t next_random(uint32_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+
+    return state;
+}
+
+/**
+ * @brief Frames scaled by a single scaler
+ * @param simd Instruction set of the scaler
+ * @param scaling_filter Filter to use
+ * @param frames Frames to scale one after another, each 'frame_width' x 'frame_height' pixels
+ * @param frame_width Width of the frames
+ * @param frame_height Height of the frames
+ * @param output_width Width of the area that the frames will be shown in
+ * @param output_height Height of the area that the frames will be shown in
+ * @param scaled_width Set to the width of the scaled frames
+ * @param scaled_height Set to the height of the scaled frames
+ * @return Destination memory of every frame, one after another, padding included
+ */
+static std::vector<uint8_t> scale(ar::core::frame_scaler::simd_level simd,
+                                  ar::core::frame_scaler::filter scaling_filter,
+                                  const std::vector<std::vector<uint32_t>>& frames, uint32_t frame_width,
+                                  uint32_t frame_height, uint32_t output_width, uint32_t output_height,
+                                  uint32_t& scaled_width, uint32_t& scaled_height)
+{
+    ar::core::frame_scaler scaler(scaling_filter, simd);
+
+    scaler.get_scaled_size(frame_width, frame_height, output_width, output_height, scaled_width, scaled_height);
+
+    std::size_t destination_pitch = scaled_width * sizeof(uint32_t) + DESTINATION_PADDING;
+    std::size_t frame_size        = destination_pitch * scaled_height;
+
+    std::vector<uint8_t> destination(frame_size * frames.size(), CANARY);
+    for (std::size_t frame = 0; frame < frames.size(); frame++)
+    {
+        scaler.scale(frames[frame].data(), frame_width, frame_height, output_width, output_height,
+                     destination.data() + frame * frame_size, destination_pitch);
+    }
+
+    return destination;
+}
+
+int main()
+{
+    using simd_level = ar::core::frame_scaler::simd_level;
+
+    if (ar::core::frame_scaler::get_best_simd_level() < simd_level::sse2)
+    {
+        std::cout << "SSE2 is not supported, there is nothing to compare" << std::endl;
+        return 0;
+    }
+
+    uint32_t random = 0xC0FFEE;
+    uint32_t compared = 0;
+    bool failed = false;
+
+    for (const auto& [frame_width, frame_height] : g_frame_sizes)
+    {
+        // Mostly a few colours, every tenth pixel is any colour so that xBR's distances vary too
+        std::vector<std::vector<uint32_t>> frames(FRAME_COUNT, std::vector<uint32_t>(frame_width * frame_height));
+        for (std::vector<uint32_t>& frame : frames)
+        {
+            for (uint32_t& pixel : frame)
+            {
+                uint32_t value = next_random(random);
+                pixel = value % 10 == 0 ? value | 0xFF000000 : COLOURS[(value >> 8) % std::size(COLOURS)];
+            }
+        }
+
+        for (uint32_t output_scale : g_output_scales)
+        {
+            uint32_t output_width  = frame_width * output_scale / 10;
+            uint32_t output_height = frame_height * output_scale / 10;
+
+            for (ar::core::frame_scaler::filter scaling_filter : g_filters)
+            {
+                uint32_t scaled_width  = 0;
+                uint32_t scaled_height = 0;
+                std::vector<uint8_t> expected = scale(simd_level::none, scaling_filter, frames, frame_width,
+                                                      frame_height, output_width, output_height, scaled_width,
+                                                      scaled_height);
+                std::vector<uint8_t> scaled   = scale(simd_level::sse2, scaling_filter, frames, frame_width,
+                                                      frame_height, output_width, output_height, scaled_width,
+                                                      scaled_height);
+                compared++;
+
+                auto mismatch = std::mismatch(expected.begin(), expected.end(), scaled.begin());
+                if (mismatch.first != expected.end())
+                {
+                    std::size_t row_size   = scaled_width * sizeof(uint32_t) + DESTINATION_PADDING;
+                    std::size_t frame_size = row_size * scaled_height;
+                    std::size_t offset     = static_cast<std::size_t>(mismatch.first - expected.begin());
+
+                    std::cerr << ar::core::frame_scaler::get_filter_name(scaling_filter) << " " << frame_width
+                              << "x" << frame_height << " to " << output_width << "x" << output_height
+                              << ": frame " << offset / frame_size << " row " << offset % frame_size / row_size
+                              << " byte " << offset % row_size << " is "
+                              << static_cast<int>(*mismatch.second) << ", scalar kernel wrote "
+                              << static_cast<int>(*mismatch.first) << std::endl;
+                    failed = true;
+                }
+            }
+        }
+    }
+
+    if (failed)
+    {
+        return 1;
+    }
+
+    std::cout << compared << " scaled frame sizes match the scalar kernels" << std::endl;
+    return 0;
+}
@@ -0,0 +1,166 @@
+/**
+ * @file tests/pixel-converter-tests.cpp
+ * @details Converts frames of every 'ar_pixel_format' with every instruction set supported by the CPU and compares
+ *          the converted frames byte for byte with the plain C++ kernels. Widths are not multiples of the vector
+ *          widths so that the scalar tails run too, source rows are padded and start at odd addresses and destination
+ *          rows are padded with a canary that no kernel may overwrite.
+ *
+ *          Usage: ar_pixel_converter_test
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+#include <vector>
+#include "core/pixel-converter.hpp"
+
+/// @brief Frame sizes to convert, width x height
+static const std::vector<std::pair<uint32_t, uint32_t>> g_sizes = {
+        { 1,   1 },
+        { 3,   2 },
+        { 7,   3 },
+        { 13,  5 },
+        { 31,  2 },
+        { 33,  4 },
+        { 64,  32 },
+        { 69,  3 },
+        { 161, 7 },
+};
+
+/// @brief Formats to convert
+static const std::vector<ar_pixel_format> g_formats = {
+        ar_pixel_format_1bpp,
+        ar_pixel_format_2bpp_indexed,
+        ar_pixel_format_8bpp_indexed,
+        ar_pixel_format_rgb565,
+        ar_pixel_format_xrgb8888,
+        ar_pixel_format_rgba8888,
+};
+
+/// @brief Bytes added after every source row, odd so that rows of wider formats are misaligned too
+static constexpr std::size_t SOURCE_PADDING = 5;
+
+/// @brief Bytes added after every destination row, filled with 'CANARY'
+static constexpr std::size_t DESTINATION_PADDING = 12;
+
+/// @brief Value of destination bytes before the conversion, padding has to keep it
+static constexpr uint8_t CANARY = 0xCD;
+
+/**
+ * @brief Get next value of a xorshift generator, fixed seed keeps the frames the same on every run
+ * @param state State of the generator, must not be 0
+ * @return Next pseudo random value
+ */
+static uint32_t next_random(uint32_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+
+    return state;
+}
+
+/**
+ * @brief Frame converted by a single converter
+ * @param simd Instruction set of the converter
+ * @param format Format of the source frame
+ * @param source Source pixels, rows are 'source_pitch' bytes apart
+ * @param source_pitch Number of bytes between the starts of two source rows
+ * @param palettes Palettes of consecutive frames, the converter has to notice each change
+ * @param width Width of the frame
+ * @param height Height of the frame
+ * @return Destination memory of every frame, one after another, padding included
+ */
+static std::vector<uint8_t> convert(ar::core::pixel_converter::simd_level simd, ar_pixel_format format,
+                                    const uint8_t* source, std::size_t source_pitch,
+                                    const std::vector<std::vector<ar_pixel>>& palettes, uint32_t width,
+                                    uint32_t height)
+{
+    ar::core::pixel_converter converter(simd);
+
+    std::size_t destination_pitch = width * sizeof(ar_pixel) + DESTINATION_PADDING;
+    std::size_t frame_size        = destination_pitch * height;
+
+    std::vector<uint8_t> destination(frame_size * palettes.size(), CANARY);
+    for (std::size_t frame = 0; frame < palettes.size(); frame++)
+    {
+        converter.convert(format, source, source_pitch, palettes[frame].data(), width, height,
+                          destination.data() + frame * frame_size, destination_pitch);
+    }
+
+    return destination;
+}
+
+int main()
+{
+    using simd_level = ar::core::pixel_converter::simd_level;
+
+    simd_level best = ar::core::pixel_converter::get_best_simd_level();
+    uint32_t random = 0xC0FFEE;
+    uint32_t compared = 0;
+    bool failed = false;
+
+    // Two different palettes and the second one again, converters cache tables built from the palette
+    std::vector<std::vector<ar_pixel>> palettes(3, std::vector<ar_pixel>(AR_PALETTE_SIZE));
+    for (std::size_t i = 0; i < 2; i++)
+    {
+        for (ar_pixel& colour : palettes[i])
+        {
+            uint32_t value = next_random(random);
+            colour = { static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8),
+                       static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 24) };
+        }
+    }
+    palettes[2] = palettes[1];
+
+    for (const auto& [width, height] : g_sizes)
+    {
+        for (ar_pixel_format format : g_formats)
+        {
+            std::size_t row_size     = ar::core::pixel_converter::get_frame_size(format, width, height) / height;
+            std::size_t source_pitch = row_size + SOURCE_PADDING;
+
+            // First byte is skipped so that the frame starts at an odd address
+            std::vector<uint8_t> source(1 + source_pitch * height);
+            for (uint8_t& byte : source)
+            {
+                byte = static_cast<uint8_t>(next_random(random));
+            }
+
+            std::vector<uint8_t> expected = convert(simd_level::none, format, source.data() + 1, source_pitch,
+                                                    palettes, width, height);
+
+            for (simd_level simd : { simd_level::sse2, simd_level::avx2 })
+            {
+                if (simd > best)
+                {
+                    continue;
+                }
+
+                std::vector<uint8_t> converted = convert(simd, format, source.data() + 1, source_pitch, palettes,
+                                                         width, height);
+                compared++;
+
+                auto mismatch = std::mismatch(expected.begin(), expected.end(), converted.begin());
+                if (mismatch.first != expected.end())
+                {
+                    std::cerr << ar::core::pixel_converter::get_simd_level_name(simd) << " "
+                              << ar::core::pixel_converter::get_pixel_format_name(format) << " " << width << "x"
+                              << height << ": byte " << (mismatch.first - expected.begin()) << " is "
+                              << static_cast<int>(*mismatch.second) << ", scalar kernel wrote "
+                              << static_cast<int>(*mismatch.first) << std::endl;
+                    failed = true;
+                }
+            }
+        }
+    }
+
+    if (failed)
+    {
+        return 1;
+    }
+
+    std::cout << compared << " conversions up to " << ar::core::pixel_converter::get_simd_level_name(best)
+              << " match the scalar kernels" << std::endl;
+    return 0;
+}